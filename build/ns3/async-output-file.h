@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ASYNC_OUTPUT_FILE_H
+#define ASYNC_OUTPUT_FILE_H
+
+#include <string>
+#include <fstream>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief A binary output file written by a background thread
+ *
+ * Data is appended to an in-memory buffer.  When the buffer is full, it is
+ * handed to a writer thread shared by all the AsyncOutputFile objects, and
+ * the simulation goes on with a new buffer.  The number of buffers waiting
+ * for the writer thread is bounded: when the bound is reached, the thread
+ * handing a full buffer waits until the writer thread has written one of
+ * them, so that the memory used stays bounded even when the disk is slower
+ * than the simulation.
+ *
+ * When ns-3 is built without thread support, the full buffers are written
+ * by the simulation thread; they are still written by large chunks.
+ *
+ * Close, or the destructor, waits until all the data of the file has been
+ * written.  The writer thread is started when a file is opened while no
+ * other file is open, and joined when the last open file is closed; the
+ * files must therefore be opened and closed by the same thread.
+ */
+class AsyncOutputFile
+{
+public:
+  AsyncOutputFile ();
+  ~AsyncOutputFile ();
+
+  /**
+   * Create a new file, or truncate an existing file, and open it for writing.
+   *
+   * \param filename the name of the file
+   * \param bufferSize the size of the buffers handed to the writer thread
+   * \return true if the file could be opened
+   */
+  bool Open (std::string const &filename, uint32_t bufferSize = 1 << 20);
+
+  /**
+   * \return true if the file is open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * \return true if the file could not be opened or if an error occurred
+   * while writing it
+   */
+  bool Fail (void) const;
+
+  /**
+   * Append data to the file.
+   *
+   * \param data the data
+   * \param size the size of the data, in bytes
+   */
+  void Write (const void *data, uint32_t size);
+
+  /**
+   * Make room for data at the end of the file, to be filled in by the caller
+   * before the next call to a method of this object.
+   *
+   * \param size the size of the data, in bytes
+   * \return a pointer to the room
+   */
+  uint8_t *Append (uint32_t size);
+
+  /**
+   * Hand the buffered data to the writer thread, even if the buffer is not
+   * full.
+   */
+  void Flush (void);
+
+  /**
+   * Write all the buffered data and close the file.
+   */
+  void Close (void);
+
+  /**
+   * Set the maximum number of full buffers waiting for the writer thread,
+   * for all the files.
+   *
+   * \param maxPendingBuffers the maximum number of buffers
+   */
+  static void SetMaxPendingBuffers (uint32_t maxPendingBuffers);
+
+private:
+  friend class AsyncFileWriter;
+
+  /// Copy constructor, not implemented
+  AsyncOutputFile (const AsyncOutputFile &);
+  /**
+   * Assignment operator, not implemented
+   * \returns this object
+   */
+  AsyncOutputFile & operator = (const AsyncOutputFile &);
+
+  std::ofstream m_file;     //!< The file, written by the writer thread
+  std::string m_buffer;     //!< The buffer being filled
+  uint32_t m_bufferSize;    //!< The size at which the buffer is handed over
+  bool m_open;              //!< The file is open, protected by the mutex of the writer thread
+  /// The number of buffers of this file not written yet, protected by
+  /// the mutex of the writer thread
+  uint32_t m_pending;
+  bool m_fail;              //!< A write failed, protected by the mutex of the writer thread
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_OUTPUT_FILE_H */
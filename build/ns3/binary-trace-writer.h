@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_WRITER_H
+#define BINARY_TRACE_WRITER_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <istream>
+#include <unordered_map>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief Write packet trace events as binary records
+ *
+ * This is the binary counterpart of the text written by the default trace
+ * sinks of AsciiTraceHelper.  Rather than printing the packet, each event is
+ * written as a fixed-size record holding the time, the node and device
+ * identifiers (when the trace context provides them), the event type, the
+ * packet uid and the packet size.  When packet metadata is enabled (see
+ * Packet::EnablePrinting) and the header digest is enabled, the record is
+ * followed by the list of the headers, trailers and payload of the packet,
+ * with the serialized bytes of the headers and trailers, which is enough to
+ * print the packet later.  Trace contexts and TypeId names are written once
+ * per file, and referred to by identifiers afterwards.
+ *
+ * PrintAscii converts a binary trace back to the text the default trace
+ * sinks would have written; the print-binary-trace utility program uses
+ * it.
+ *
+ * All the values are written in the byte order of the host.
+ */
+class BinaryTraceWriter
+{
+public:
+  /// The trace events, with the character used in the text traces
+  enum Event
+  {
+    ENQUEUE = '+',  //!< A packet is enqueued in a device queue
+    DEQUEUE = '-',  //!< A packet is dequeued from a device queue
+    DROP = 'd',     //!< A packet is dropped
+    RECEIVE = 'r'   //!< A packet is received by a device
+  };
+
+  /**
+   * Write the header of a binary trace to a stream.
+   *
+   * \param os the stream, opened in binary mode
+   * \param headerDigest whether to write the headers of the packets
+   */
+  BinaryTraceWriter (std::ostream *os, bool headerDigest = true);
+
+  /**
+   * Set the node and device identifiers recorded with the events written
+   * without trace context, for a stream holding the events of a single
+   * device.  By default, these events have no node and device
+   * identifiers.
+   *
+   * \param node the node identifier
+   * \param device the device identifier (index of the device in the node)
+   */
+  void SetDevice (uint32_t node, uint32_t device);
+
+  /**
+   * Write an event without trace context.  The node and device identifiers
+   * set by SetDevice, if any, are recorded with the event.
+   *
+   * \param event the event
+   * \param p the packet
+   */
+  void Write (Event event, Ptr<const Packet> p);
+
+  /**
+   * Write an event with a trace context.  If the context starts with
+   * /NodeList/[node]/DeviceList/[device], the node and device identifiers
+   * are recorded with the event.
+   *
+   * \param event the event
+   * \param context the trace context
+   * \param p the packet
+   */
+  void Write (Event event, std::string const &context, Ptr<const Packet> p);
+
+  /**
+   * Print a binary trace as text, in the format of the default trace sinks
+   * of AsciiTraceHelper.
+   *
+   * The TypeIds of the headers and trailers must be registered in the
+   * calling program to print them as Packet::Print does; otherwise only
+   * their name is printed.
+   *
+   * \param is the binary trace
+   * \param os the stream to print to
+   * \return false if the input is not a binary trace
+   */
+  static bool PrintAscii (std::istream &is, std::ostream &os);
+
+private:
+  /// A trace context already written to the file
+  struct Context
+  {
+    uint32_t id;     //!< The identifier of the context in the file
+    uint32_t node;   //!< The node identifier, or 0xffffffff
+    uint32_t device; //!< The device identifier, or 0xffffffff
+  };
+
+  /**
+   * Write an event record.
+   *
+   * \param event the event
+   * \param context the context, or 0 if none
+   * \param p the packet
+   */
+  void WriteEvent (Event event, const Context *context, Ptr<const Packet> p);
+
+  /**
+   * Write the name of a TypeId, the first time it is used.
+   *
+   * \param tid the TypeId
+   */
+  void WriteTypeId (TypeId tid);
+
+  std::ostream *m_os;                    //!< The output stream
+  bool m_headerDigest;                   //!< Whether to write the headers of the packets
+  std::string m_record;                  //!< The record being built
+  uint32_t m_node;                       //!< The node identifier of the events without context
+  uint32_t m_device;                     //!< The device identifier of the events without context
+  /// The contexts written to the file
+  std::unordered_map<std::string, Context> m_contexts;
+  std::vector<bool> m_typeIds;           //!< The TypeIds written to the file, by uid
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_WRITER_H */
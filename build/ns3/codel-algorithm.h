@@ -0,0 +1,376 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 Andrew McGregor
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Codel, the COntrolled DELay Queueing discipline
+ * Based on ns2 simulation code presented by Kathie Nichols
+ *
+ * This port based on linux kernel code by
+ * Authors:	Dave Täht <d@taht.net>
+ *		Eric Dumazet <edumazet@google.com>
+ *
+ * Ported to ns-3 by: Andrew McGregor <andrewmcgr@gmail.com>
+ */
+
+#ifndef CODEL_ALGORITHM_H
+#define CODEL_ALGORITHM_H
+
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/queue-item.h"
+
+namespace ns3 {
+
+/**
+ * Number of bits discarded from the time representation.
+ * The time is assumed to be in nanoseconds.
+ */
+static const int  CODEL_SHIFT = 10;
+
+#define REC_INV_SQRT_BITS (8 * sizeof(uint16_t))
+#define REC_INV_SQRT_SHIFT (32 - REC_INV_SQRT_BITS)
+
+/**
+ * \ingroup traffic-control
+ *
+ * Performs a reciprocal divide, similar to the
+ * Linux kernel reciprocal_divide function
+ * \param A numerator
+ * \param R reciprocal of the denominator B
+ * \return the value of A/B
+ */
+/* borrowed from the linux kernel */
+inline uint32_t
+CoDelReciprocalDivide (uint32_t A, uint32_t R)
+{
+  return (uint32_t)(((uint64_t)A * R) >> 32);
+}
+
+/* end kernel borrowings */
+
+/**
+ * \ingroup traffic-control
+ *
+ * Return the unsigned 32-bit integer representation of the input Time
+ * object, in CoDel time representation
+ * \param t the input Time Object
+ * \return the unsigned 32-bit integer representation
+ */
+inline uint32_t
+CoDelTime (Time t)
+{
+  return (t.GetNanoSeconds () >> CODEL_SHIFT);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Check if CoDel time a is successive to b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is greater than b
+ */
+inline bool
+CoDelTimeAfter (uint32_t a, uint32_t b)
+{
+  return  ((int)(a) - (int)(b) > 0);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Check if CoDel time a is successive or equal to b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is greater than or equal to b
+ */
+inline bool
+CoDelTimeAfterEq (uint32_t a, uint32_t b)
+{
+  return ((int)(a) - (int)(b) >= 0);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Check if CoDel time a is preceding b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is less than b
+ */
+inline bool
+CoDelTimeBefore (uint32_t a, uint32_t b)
+{
+  return  ((int)(a) - (int)(b) < 0);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Check if CoDel time a is preceding or equal to b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is less than or equal to b
+ */
+inline bool
+CoDelTimeBeforeEq (uint32_t a, uint32_t b)
+{
+  return ((int)(a) - (int)(b) <= 0);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Calculate the reciprocal square root of count by using Newton's method
+ * http://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Iterative_methods_for_reciprocal_square_roots
+ * recInvSqrt (new) = (recInvSqrt (old) / 2) * (3 - count * recInvSqrt^2)
+ * \param count the CoDel count
+ * \param recInvSqrt the current reciprocal inverse square root
+ * \return the new reciprocal inverse square root
+ */
+inline uint16_t
+CoDelNewtonStep (uint32_t count, uint16_t recInvSqrt)
+{
+  uint32_t invsqrt = ((uint32_t) recInvSqrt) << REC_INV_SQRT_SHIFT;
+  uint32_t invsqrt2 = ((uint64_t) invsqrt * invsqrt) >> 32;
+  uint64_t val = (3ll << 32) - ((uint64_t) count * invsqrt2);
+
+  val >>= 2; /* avoid overflow */
+  val = (val * invsqrt) >> (32 - 2 + 1);
+  return val >> REC_INV_SQRT_SHIFT;
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * Determine the time for next drop
+ * CoDel control law is t + interval/sqrt(count).
+ * Here, we use the recInvSqrt calculated by Newton's method in
+ * CoDelNewtonStep to avoid both sqrt() and divide operations
+ * \param t current next drop time
+ * \param interval the CoDel interval, in CoDel time representation
+ * \param recInvSqrt the reciprocal inverse square root
+ * \return the new next drop time
+ */
+inline uint32_t
+CoDelControlLaw (uint32_t t, uint32_t interval, uint16_t recInvSqrt)
+{
+  return t + CoDelReciprocalDivide (interval, recInvSqrt << REC_INV_SQRT_SHIFT);
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The CoDel state of a queue
+ */
+struct CoDelState
+{
+  CoDelState ()
+    : count (0),
+      lastCount (0),
+      dropping (false),
+      recInvSqrt (~0U >> REC_INV_SQRT_SHIFT),
+      firstAboveTime (0),
+      dropNext (0)
+  {
+  }
+
+  uint32_t count;           //!< Number of packets dropped since entering drop state
+  uint32_t lastCount;       //!< Last number of packets dropped since entering drop state
+  bool dropping;            //!< True if in dropping state
+  uint16_t recInvSqrt;      //!< Reciprocal inverse square root
+  uint32_t firstAboveTime;  //!< Time to declare sojourn time above target
+  uint32_t dropNext;        //!< Time to drop next packet
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The parameters of the CoDel algorithm
+ */
+struct CoDelParameters
+{
+  CoDelParameters ()
+    : target (0),
+      interval (0),
+      minBytes (0)
+  {
+  }
+
+  uint32_t target;    //!< Target queue delay, in CoDel time representation
+  uint32_t interval;  //!< Sliding minimum time window width, in CoDel time representation
+  uint32_t minBytes;  //!< Minimum bytes in queue to allow a packet drop
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Determine whether a packet is OK to be dropped. The packet
+ * may not be actually dropped (depending on the drop state)
+ *
+ * The State type has the members of CoDelState, and the Queue type the
+ * methods of the queue of CoDelDequeue.
+ *
+ * \param state the CoDel state of the queue
+ * \param params the CoDel parameters
+ * \param queue the queue the packet was removed from
+ * \param item The packet that is considered
+ * \param now The current time, in CoDel time representation
+ * \returns True if it is OK to drop the packet (sojourn time above target for at least interval)
+ */
+template <class State, class Queue>
+bool
+CoDelOkToDrop (State &state, const CoDelParameters &params, Queue &queue,
+               Ptr<QueueDiscItem> item, uint32_t now)
+{
+  if (!item)
+    {
+      state.firstAboveTime = 0;
+      return false;
+    }
+
+  uint32_t sojournTime = CoDelTime (Simulator::Now () - item->GetTimeStamp ());
+
+  if (CoDelTimeBefore (sojournTime, params.target) || queue.GetNBytes () < params.minBytes)
+    {
+      // went below so we'll stay below for at least interval
+      state.firstAboveTime = 0;
+      return false;
+    }
+  bool okToDrop = false;
+  if (state.firstAboveTime == 0)
+    {
+      // just went above from below. If we stay above for at least
+      // interval we'll say it's ok to drop
+      state.firstAboveTime = now + params.interval;
+    }
+  else if (CoDelTimeAfter (now, state.firstAboveTime))
+    {
+      okToDrop = true;
+    }
+  return okToDrop;
+}
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Remove a packet from a queue based on its CoDel state
+ * If we are in dropping state, check if we could leave the dropping state
+ * or if we should perform next drop
+ * If we are not currently in dropping state, check if we need to enter the state
+ * and drop the first packet
+ *
+ * The State type has the members of CoDelState; they can be TracedValues.
+ * The Queue type provides:
+ * - Ptr<QueueDiscItem> Pop (void), removing the packet at the head of the
+ *   queue, or returning 0 if the queue is empty;
+ * - uint32_t GetNBytes (void), returning the number of bytes in the queue;
+ * - void Drop (Ptr<QueueDiscItem> item), dropping a packet removed from the
+ *   queue because its sojourn time exceeded the target.
+ *
+ * \param state the CoDel state of the queue
+ * \param params the CoDel parameters
+ * \param queue the queue
+ * \returns The packet that is examined, or 0 if the queue is or becomes empty
+ */
+template <class State, class Queue>
+Ptr<QueueDiscItem>
+CoDelDequeue (State &state, const CoDelParameters &params, Queue &queue)
+{
+  Ptr<QueueDiscItem> item = queue.Pop ();
+  if (!item)
+    {
+      // Leave dropping state when queue is empty
+      state.dropping = false;
+      return 0;
+    }
+  uint32_t now = CoDelTime (Simulator::Now ());
+
+  // Determine if item should be dropped
+  bool okToDrop = CoDelOkToDrop (state, params, queue, item, now);
+
+  if (state.dropping)
+    { // In the dropping state (sojourn time has gone above target and hasn't come down yet)
+      // Check if we can leave the dropping state or next drop should occur
+      if (!okToDrop)
+        {
+          /* sojourn time fell below target - leave dropping state */
+          state.dropping = false;
+        }
+      else if (CoDelTimeAfterEq (now, state.dropNext))
+        {
+          while (state.dropping && CoDelTimeAfterEq (now, state.dropNext))
+            {
+              // It's time for the next drop. Drop the current packet and
+              // dequeue the next. The dequeue might take us out of dropping
+              // state. If not, schedule the next drop.
+              // A large amount of packets in queue might result in drop
+              // rates so high that the next drop should happen now,
+              // hence the while loop.
+              queue.Drop (item);
+
+              ++state.count;
+              state.recInvSqrt = CoDelNewtonStep (state.count, state.recInvSqrt);
+              item = queue.Pop ();
+
+              if (!CoDelOkToDrop (state, params, queue, item, now))
+                {
+                  /* leave dropping state */
+                  state.dropping = false;
+                }
+              else
+                {
+                  /* schedule the next drop */
+                  state.dropNext = CoDelControlLaw (state.dropNext, params.interval, state.recInvSqrt);
+                }
+            }
+        }
+    }
+  else if (okToDrop)
+    {
+      // Not in the dropping state
+      // Drop the first packet and enter dropping state unless the queue is empty
+      queue.Drop (item);
+
+      item = queue.Pop ();
+
+      CoDelOkToDrop (state, params, queue, item, now);
+      state.dropping = true;
+      /*
+       * if min went above target close to when we last went below it
+       * assume that the drop rate that controlled the queue on the
+       * last cycle is a good starting point to control it now.
+       */
+      int delta = state.count - state.lastCount;
+      if (delta > 1 && CoDelTimeBefore (now - state.dropNext, 16 * params.interval))
+        {
+          state.count = delta;
+          state.recInvSqrt = CoDelNewtonStep (state.count, state.recInvSqrt);
+        }
+      else
+        {
+          state.count = 1;
+          state.recInvSqrt = ~0U >> REC_INV_SQRT_SHIFT;
+        }
+      state.lastCount = state.count;
+      state.dropNext = CoDelControlLaw (now, params.interval, state.recInvSqrt);
+    }
+  return item;
+}
+
+} // namespace ns3
+
+#endif /* CODEL_ALGORITHM_H */
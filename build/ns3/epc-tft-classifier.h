@@ -0,0 +1,130 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Nicola Baldo  <nbaldo@cttc.es>
+ */
+
+
+#ifndef EPC_TFT_CLASSIFIER_H
+#define EPC_TFT_CLASSIFIER_H
+
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/epc-tft.h"
+
+#include <map>
+#include <vector>
+
+
+namespace ns3 {
+
+class EpcTft;
+class Packet;
+
+/**
+ * \brief classifies IP packets accoding to Traffic Flow Templates (TFTs)
+ * 
+ * \note this implementation works with IPv4 only.
+ */
+class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
+{
+public:
+  
+  EpcTftClassifier ();
+  
+  /** 
+   * add a TFT to the Classifier
+   *
+   * The packet filters of the TFT are compiled when the next packet is
+   * classified.  They are compiled again if filters are added to the TFT
+   * afterwards.
+   * 
+   * \param tft the TFT to be added
+   * \param id the ID of the bearer which will be classified by specified TFT classifier
+   * 
+   */
+  void Add (Ptr<EpcTft> tft, uint32_t id);
+
+  /** 
+   * delete an existing TFT from the classifier
+   * 
+   * \param id the identifier of the TFT to be deleted
+   */
+  void Delete (uint32_t id);
+  
+
+  /** 
+   * classify an IP packet
+   * 
+   * The packets which do not hold the ports, such as the non-first IPv4
+   * fragments, only match the packet filters whose port ranges are both
+   * 0-65535.
+   *
+   * \param p the IP packet. It is assumed that the outmost header is an IPv4 header.
+   * \param direction the EPC TFT direction (can be downlink, uplink or bi-directional)
+   * 
+   * \return the identifier (>0) of the first TFT that matches with the IP packet; 0 if no TFT matched.
+   */
+  uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction);
+  
+protected:
+  
+  std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
+
+private:
+
+  /// A packet filter with its addresses masked, for a direction
+  struct CompiledFilter
+  {
+    uint32_t id; ///< the ID of the TFT of the filter
+    uint32_t remoteAddress; ///< the masked address of the remote host
+    uint32_t remoteMask; ///< the address mask of the remote host
+    uint32_t localAddress; ///< the masked address of the UE
+    uint32_t localMask; ///< the address mask of the UE
+    uint16_t remotePortStart; ///< start of the port number range of the remote host
+    uint16_t remotePortEnd; ///< end of the port number range of the remote host
+    uint16_t localPortStart; ///< start of the port number range of the UE
+    uint16_t localPortEnd; ///< end of the port number range of the UE
+    bool anyPort; ///< whether both port number ranges are 0-65535
+    uint8_t typeOfService; ///< the masked type of service
+    uint8_t typeOfServiceMask; ///< type of service field mask
+  };
+
+  /**
+   * Rebuild the filter tables of both directions from the TFTs
+   */
+  void Compile ();
+
+  /**
+   * \return the number of packet filters of all the TFTs
+   */
+  uint32_t GetNumPacketFilters () const;
+
+  /// the filters applying to uplink packets, in the order of evaluation
+  std::vector<CompiledFilter> m_uplinkFilters;
+  /// the filters applying to downlink packets, in the order of evaluation
+  std::vector<CompiledFilter> m_downlinkFilters;
+  bool m_compiled; ///< whether the filter tables match the TFT map
+  uint32_t m_numCompiledFilters; ///< the number of packet filters of the TFTs when compiled
+};
+
+
+
+} // namespace ns3
+  
+#endif /* TFT_CLASSIFIER_H */ 
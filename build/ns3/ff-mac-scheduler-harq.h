@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_HARQ_H
+#define FF_MAC_SCHEDULER_HARQ_H
+
+#include <ns3/ff-mac-common.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/lte-rnti-map.h>
+#include <vector>
+#include <set>
+
+#define HARQ_PROC_NUM 8
+#define HARQ_DL_TIMEOUT 11
+
+namespace ns3 {
+
+
+typedef std::vector < uint8_t > DlHarqProcessesStatus_t; ///< DL HARQ process status vector
+typedef std::vector < uint8_t > DlHarqProcessesTimer_t; ///< DL HARQ process timer vector
+typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t; ///< DL HARQ process DCI buffer vector
+typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; ///< vector of the LCs and layers per UE
+typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t; ///< vector of the 8 HARQ processes per UE
+
+typedef std::vector < UlDciListElement_s > UlHarqProcessesDciBuffer_t; ///< UL HARQ process DCI buffer vector
+typedef std::vector < uint8_t > UlHarqProcessesStatus_t; ///< UL HARQ process status vector
+
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief The HARQ processes of the UEs of a FF MAC scheduler
+ *
+ * This class holds the DL and UL HARQ buffers of the UEs and implements
+ * the part of the HARQ procedures that does not depend on the scheduling
+ * policy: the choice of the DL processes, their timeout, the
+ * retransmissions requested by the HARQ feedback and the UL process ids.
+ * The schedulers store the new transmissions in the buffers themselves.
+ */
+class FfMacSchedulerHarq
+{
+public:
+  FfMacSchedulerHarq ();
+
+  /**
+   * \brief Create the HARQ buffers of a UE
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void AddUe (uint16_t rnti);
+
+  /**
+   * \brief Remove the HARQ buffers of a UE
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void RemoveUe (uint16_t rnti);
+
+  /// Remove the HARQ buffers of all the UEs and the buffered feedback
+  void Clear ();
+
+  /**
+   * \brief Return the availability of free process for the RNTI specified
+   *
+   * \param rnti the RNTI of the UE
+   * \return true if a DL HARQ process is free
+   */
+  bool HarqProcessAvailability (uint16_t rnti);
+
+  /**
+   * \brief Update and return a new process Id for the RNTI specified
+   *
+   * \param rnti the RNTI of the UE
+   * \param harqOn whether HARQ is enabled
+   * \return the process id, 0 if HARQ is disabled
+   */
+  uint8_t UpdateHarqProcessId (uint16_t rnti, bool harqOn);
+
+  /**
+   * \brief Refresh the DL HARQ processes according to the timers
+   */
+  void RefreshHarqProcesses ();
+
+  /**
+   * \brief Move the UL HARQ process of every UE to the next TTI
+   */
+  void UpdateUlHarqProcessIds ();
+
+  /**
+   * \brief Process the DL HARQ feedback and schedule the retransmissions
+   *
+   * The feedback of the UEs whose retransmission does not fit in the
+   * available RBGs is buffered until the next TTI.
+   *
+   * \param dlInfoList the DL HARQ feedback received in this TTI
+   * \param harqOn whether HARQ is enabled; if not, the feedback is ignored
+   * \param rbgNum the number of RBGs
+   * \param rbgMap the map of the allocated RBGs, updated
+   * \param rbgAllocatedNum the number of allocated RBGs, updated
+   * \param rntiAllocated the UEs already allocated, updated
+   * \param ret the parameters of the DL configuration, where the
+   * retransmissions are added
+   */
+  void ProcessDlHarqFeedback (const std::vector <struct DlInfoListElement_s>& dlInfoList, bool harqOn,
+                              int rbgNum, std::vector <bool>& rbgMap, uint16_t& rbgAllocatedNum,
+                              std::set <uint16_t>& rntiAllocated,
+                              FfMacSchedSapUser::SchedDlConfigIndParameters& ret);
+
+  /**
+   * \brief Process the UL HARQ feedback and schedule the retransmissions
+   *
+   * \param ulInfoList the UL HARQ feedback received in this TTI
+   * \param rbMap the map of the allocated RBs, updated
+   * \param rbAllocatedNum the number of allocated RBs, updated
+   * \param rbgAllocationMap the RNTI allocated to each RB, updated
+   * \param rntiAllocated the UEs already allocated, updated
+   * \param ret the parameters of the UL configuration, where the
+   * retransmissions are added
+   */
+  void ProcessUlHarqFeedback (const std::vector <struct UlInfoListElement_s>& ulInfoList,
+                              std::vector <bool>& rbMap, uint16_t& rbAllocatedNum,
+                              std::vector <uint16_t>& rbgAllocationMap,
+                              std::set <uint16_t>& rntiAllocated,
+                              FfMacSchedSapUser::SchedUlConfigIndParameters& ret);
+
+  LteRntiMap <uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
+  // HARQ status
+  // 0: process Id available
+  // x>0: process Id equal to `x` transmission count
+  LteRntiMap <DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
+  LteRntiMap <DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer
+  LteRntiMap <DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
+  LteRntiMap <DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
+  std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
+
+  LteRntiMap <uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
+  //HARQ status
+  // 0: process Id available
+  // x>0: process Id equal to `x` transmission count
+  LteRntiMap <UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
+  LteRntiMap <UlHarqProcessesDciBuffer_t> m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_HARQ_H */
@@ -0,0 +1,261 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Pasquale Imputato <p.imputato@gmail.com>
+ *          Stefano Avallone <stefano.avallone@unina.it>
+ */
+
+#ifndef FQ_CODEL_QUEUE_DISC
+#define FQ_CODEL_QUEUE_DISC
+
+#include "ns3/queue-disc.h"
+#include "ns3/object-factory.h"
+#include "codel-algorithm.h"
+#include <list>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A flow queue used by the FqCoDel queue disc
+ */
+
+class FqCoDelFlow : public QueueDiscClass {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqCoDelFlow constructor
+   */
+  FqCoDelFlow ();
+
+  virtual ~FqCoDelFlow ();
+
+  /**
+   * \enum FlowStatus
+   * \brief Used to determine the status of this flow queue
+   */
+  enum FlowStatus
+    {
+      INACTIVE,
+      NEW_FLOW,
+      OLD_FLOW
+    };
+
+  /**
+   * \brief Set the deficit for this flow
+   * \param deficit the deficit for this flow
+   */
+  void SetDeficit (uint32_t deficit);
+  /**
+   * \brief Get the deficit for this flow
+   * \return the deficit for this flow
+   */
+  int32_t GetDeficit (void) const;
+  /**
+   * \brief Increase the deficit for this flow
+   * \param deficit the amount by which the deficit is to be increased
+   */
+  void IncreaseDeficit (int32_t deficit);
+  /**
+   * \brief Set the status for this flow
+   * \param status the status for this flow
+   */
+  void SetStatus (FlowStatus status);
+  /**
+   * \brief Get the status of this flow
+   * \return the status of this flow
+   */
+  FlowStatus GetStatus (void) const;
+
+private:
+  int32_t m_deficit;    //!< the deficit for this flow
+  FlowStatus m_status;  //!< the status of this flow
+};
+
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A FqCoDel packet queue disc
+ *
+ * By default, every flow queue is a FqCoDelFlow class having a CoDelQueueDisc
+ * as child queue disc, which are created when the first packet of the flow is
+ * received. If the UseFlowTable attribute is set to true, flows are instead
+ * stored in a flat table, allocated at initialization time, of Flows slots.
+ * Each slot stores the packets of a flow (in a packet pool shared by all the
+ * flows), the scheduling state and the CoDel state of the flow, and the links
+ * of the (intrusive) lists of new and old flows. The flow table allows to
+ * handle a large number of flows without allocating objects for each flow,
+ * and provides the same behavior, except that no class is created (hence
+ * flows cannot be inspected through the classes of the queue disc) and
+ * packets dropped by CoDel are accounted with the TARGET_EXCEEDED_DROP reason.
+ */
+
+class FqCoDelQueueDisc : public QueueDisc {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqCoDelQueueDisc constructor
+   */
+  FqCoDelQueueDisc ();
+
+  virtual ~FqCoDelQueueDisc ();
+
+   /**
+    * \brief Set the quantum value.
+    *
+    * \param quantum The number of bytes each queue gets to dequeue on each round of the scheduling algorithm
+    */
+   void SetQuantum (uint32_t quantum);
+
+   /**
+    * \brief Get the quantum value.
+    *
+    * \returns The number of bytes each queue gets to dequeue on each round of the scheduling algorithm
+    */
+   uint32_t GetQuantum (void) const;
+
+  // Reasons for dropping packets
+  static constexpr const char* UNCLASSIFIED_DROP = "Unclassified drop";  //!< No packet filter able to classify packet
+  static constexpr const char* OVERLIMIT_DROP = "Overlimit drop";        //!< Overlimit dropped packets
+  static constexpr const char* TARGET_EXCEEDED_DROP = "Target exceeded drop";  //!< Sojourn time above target (flow table only)
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual Ptr<const QueueDiscItem> DoPeek (void) const;
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  /**
+   * \brief Drop a packet from the head of the queue with the largest current byte count
+   * \return the index of the queue with the largest current byte count
+   */
+  uint32_t FqCoDelDrop (void);
+
+  /**
+   * \brief A packet stored in the flow table
+   */
+  struct FlowTableEntry
+  {
+    Ptr<QueueDiscItem> item;  //!< the packet
+    int32_t next;             //!< index of the next entry of the flow (or of the free list)
+  };
+
+  /**
+   * \brief A slot of the flow table, storing a flow queue and its CoDel state
+   */
+  struct FlowSlot
+  {
+    int32_t head;                    //!< index of the first packet of the flow (-1 if none)
+    int32_t tail;                    //!< index of the last packet of the flow (-1 if none)
+    int32_t next;                    //!< index of the next slot in the list of new or old flows
+    uint32_t packets;                //!< number of packets of the flow
+    uint32_t bytes;                  //!< number of bytes of the flow
+    int32_t deficit;                 //!< the deficit of the flow
+    FqCoDelFlow::FlowStatus status;  //!< the status of the flow
+    CoDelState codel;                //!< the CoDel state of the flow
+  };
+
+  /**
+   * \brief An intrusive list of flow slots
+   */
+  struct FlowList
+  {
+    int32_t head;  //!< index of the first slot (-1 if the list is empty)
+    int32_t tail;  //!< index of the last slot (-1 if the list is empty)
+  };
+
+  /**
+   * \brief Enqueue a packet in the flow table
+   * \param item the packet
+   * \param h the index of the flow slot
+   */
+  void FlowTableEnqueue (Ptr<QueueDiscItem> item, uint32_t h);
+  /**
+   * \brief Dequeue a packet from the flow table
+   * \return the dequeued packet, or 0 if no packet is available
+   */
+  Ptr<QueueDiscItem> FlowTableDequeue (void);
+  /**
+   * \brief Peek the next packet to dequeue from the flow table
+   * \return the next packet, or 0 if no packet is available
+   */
+  Ptr<const QueueDiscItem> FlowTablePeek (void) const;
+  /**
+   * \brief Drop packets from the head of the fat flow of the flow table
+   * \return the index of the slot of the fat flow
+   */
+  uint32_t FlowTableDrop (void);
+  /**
+   * \brief Remove the packet at the head of the given flow slot
+   * \param slot the flow slot
+   * \return the removed packet, or 0 if the flow is empty
+   */
+  Ptr<QueueDiscItem> FlowTablePop (FlowSlot &slot);
+  /**
+   * \brief Append a slot to a list of flows
+   * \param list the list
+   * \param index the index of the slot
+   */
+  void FlowListPushBack (FlowList &list, int32_t index);
+  /**
+   * \brief Remove the first slot of a list of flows
+   * \param list the list
+   */
+  void FlowListPopFront (FlowList &list);
+
+  class FlowSlotOps;  //!< A flow slot, as seen by CoDelDequeue
+
+  std::string m_interval;    //!< CoDel interval attribute
+  std::string m_target;      //!< CoDel target attribute
+  uint32_t m_limit;          //!< Maximum number of packets in the queue disc
+  uint32_t m_quantum;        //!< Deficit assigned to flows at each round
+  uint32_t m_flows;          //!< Number of flow queues
+  uint32_t m_dropBatchSize;  //!< Max number of packets dropped from the fat flow
+  bool m_useFlowTable;       //!< True to store flows in the flow table
+
+  std::list<Ptr<FqCoDelFlow> > m_newFlows;    //!< The list of new flows
+  std::list<Ptr<FqCoDelFlow> > m_oldFlows;    //!< The list of old flows
+
+  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
+
+  ObjectFactory m_flowFactory;         //!< Factory to create a new flow
+  ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
+
+  std::vector<FlowSlot> m_flowSlots;        //!< The flow table
+  std::vector<FlowTableEntry> m_entries;    //!< The pool of packets stored in the flow table
+  int32_t m_freeEntry;                      //!< Index of the first free entry of the pool (-1 if none)
+  FlowList m_newFlowSlots;                  //!< The list of new flows of the flow table
+  FlowList m_oldFlowSlots;                  //!< The list of old flows of the flow table
+  CoDelParameters m_codelParams;            //!< CoDel parameters of the flows of the flow table
+};
+
+} // namespace ns3
+
+#endif /* FQ_CODEL_QUEUE_DISC */
@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary logging backend declarations.
+ */
+
+namespace ns3 {
+
+class LogComponent;
+template <typename T>
+class Ptr;
+
+/**
+ * \ingroup logging
+ * \defgroup logging-binary Binary logging
+ *
+ * \brief Record log messages in a binary file, to be formatted offline.
+ *
+ * When the binary backend is enabled with LogBinaryEnable() (or with
+ * the NS_LOG_BINARY environment variable, set to the name of the file),
+ * the NS_LOG macros of the enabled log components no longer format
+ * the messages on \c std::clog. Each message is instead recorded as
+ * the identifier of the log statement (its file, line, function and
+ * log component are written once to the file), the log level, the
+ * simulation time, the simulation context and the raw bytes of the
+ * values streamed into the message. The records are appended to a
+ * buffer owned by the calling thread, without locking, and the buffer
+ * is written to the file when it is full.
+ *
+ * The \c print-binary-log program in \c utils formats the file as the
+ * text logging would (with all the prefixes enabled):
+ * \code
+ *   $ NS_LOG="Ipv4L3Protocol=level_all" NS_LOG_BINARY=run.blog ./waf --run ...
+ *   $ ./waf --run "print-binary-log --file=run.blog"
+ * \endcode
+ *
+ * Integers, floating point values, characters, strings and pointers
+ * (including Ptr) are recorded as such. Other values are formatted with
+ * their output operator when they are logged. Among the stream
+ * manipulators, only \c std::hex, \c std::oct and \c std::dec are
+ * recorded. The context appended by NS_LOG_APPEND_CONTEXT is not
+ * recorded: the simulation context (usually the node id) is recorded
+ * instead. The values are recorded in the byte order of the host.
+ */
+
+/**
+ * \ingroup logging-binary
+ * A log statement, identified in the binary log by a unique number.
+ */
+struct LogSite
+{
+  const char *file;      //!< The file of the log statement
+  int line;              //!< The line of the log statement
+  const char *function;  //!< The function of the log statement
+  uint32_t id;           //!< The identifier, or zero if not yet assigned
+};
+
+/**
+ * \ingroup logging-binary
+ * The tags of the records and values written in a binary log.
+ */
+enum LogBinaryTag
+{
+  LOG_BINARY_SITE = 1,     //!< Definition of a LogSite
+  LOG_BINARY_RECORD,       //!< A log message
+  LOG_BINARY_INT,          //!< A signed integer (8 bytes)
+  LOG_BINARY_UINT,         //!< An unsigned integer (8 bytes)
+  LOG_BINARY_DOUBLE,       //!< A floating point value (8 bytes)
+  LOG_BINARY_CHAR,         //!< A character (1 byte)
+  LOG_BINARY_BOOL,         //!< A boolean (1 byte)
+  LOG_BINARY_POINTER,      //!< A pointer (8 bytes)
+  LOG_BINARY_STRING,       //!< A string (4 bytes length and characters)
+  LOG_BINARY_TEXT,         //!< A value formatted when logged (as a string)
+  LOG_BINARY_HEX,          //!< std::hex
+  LOG_BINARY_OCT,          //!< std::oct
+  LOG_BINARY_DEC           //!< std::dec
+};
+
+/**
+ * \ingroup logging-binary
+ * The buffer of binary log records of a thread.
+ */
+struct LogBinaryBuffer
+{
+  uint8_t *data;       //!< The bytes
+  uint32_t size;       //!< The size of \c data
+  uint32_t committed;  //!< The number of bytes of complete records
+  uint32_t end;        //!< The number of bytes written
+};
+
+/**
+ * \ingroup logging-binary
+ * Whether the binary backend is enabled.
+ * \internal
+ * Use LogBinaryIsEnabled() instead.
+ */
+extern bool g_logBinaryEnabled;
+
+/**
+ * \ingroup logging-binary
+ * Check if the binary logging backend is enabled.
+ * \returns \c true if log messages are recorded in a binary log.
+ */
+inline bool
+LogBinaryIsEnabled (void)
+{
+  return g_logBinaryEnabled;
+}
+
+/**
+ * \ingroup logging-binary
+ * Record the log messages in a binary file instead of printing them.
+ *
+ * \param [in] filename The name of the file.
+ * \param [in] bufferSize The size of the buffer of each thread, in bytes.
+ */
+void LogBinaryEnable (std::string filename, uint32_t bufferSize = 1 << 20);
+
+/**
+ * \ingroup logging-binary
+ * Write the buffered records, close the binary log and print the log
+ * messages again.
+ */
+void LogBinaryDisable (void);
+
+/**
+ * \ingroup logging-binary
+ * Write the records buffered by all the threads to the binary log.
+ *
+ * This is done when the binary log is disabled and when the program
+ * exits; call it if the records are needed before.
+ */
+void LogBinaryFlush (void);
+
+/**
+ * \ingroup logging-binary
+ * Function signature for getting the time and the context of a record.
+ *
+ * \param [out] time The simulation time, in nanoseconds.
+ * \param [out] context The simulation context, or 0xffffffff.
+ */
+typedef void (*LogBinaryStamper)(int64_t *time, uint32_t *context);
+
+/**
+ * \ingroup logging-binary
+ * Set the LogBinaryStamper function, as done for LogTimePrinter.
+ * \param [in] stamper The LogBinaryStamper function.
+ */
+void LogSetBinaryStamper (LogBinaryStamper stamper);
+
+/**
+ * \ingroup logging-binary
+ * Format the log messages of a binary log.
+ *
+ * Each message is printed on a line, as the text logging would print
+ * it with all the prefixes (time, context, function and level) enabled.
+ *
+ * \param [in] is The binary log.
+ * \param [out] os The stream to print the messages on.
+ * \returns \c false if \c is is not a valid binary log.
+ */
+bool LogBinaryPrint (std::istream &is, std::ostream &os);
+
+/**
+ * \ingroup logging-binary
+ * Write a log message in the binary log.
+ *
+ * The message is built by streaming values into a temporary LogRecord,
+ * as they would be streamed into \c std::clog, and the record is
+ * committed when the LogRecord is destroyed. This is what the NS_LOG
+ * macros do when the binary backend is enabled.
+ */
+class LogRecord
+{
+public:
+  /**
+   * Start a record.
+   *
+   * \param [in] component The log component.
+   * \param [in] level The log level.
+   * \param [in] site The log statement.
+   */
+  LogRecord (const LogComponent &component, int32_t level, LogSite *site);
+  /** Commit the record. */
+  ~LogRecord ();
+
+  /**
+   * \name Append a value to the record.
+   * \param [in] v The value.
+   * \returns This LogRecord.
+   */
+  /**@{*/
+  LogRecord & operator<< (bool v) { return WriteFixed (LOG_BINARY_BOOL, (uint8_t) v); }
+  LogRecord & operator<< (char v) { return WriteFixed (LOG_BINARY_CHAR, v); }
+  LogRecord & operator<< (signed char v) { return WriteFixed (LOG_BINARY_CHAR, v); }
+  LogRecord & operator<< (unsigned char v) { return WriteFixed (LOG_BINARY_CHAR, v); }
+  LogRecord & operator<< (short v) { return WriteFixed (LOG_BINARY_INT, (int64_t) v); }
+  LogRecord & operator<< (unsigned short v) { return WriteFixed (LOG_BINARY_UINT, (uint64_t) v); }
+  LogRecord & operator<< (int v) { return WriteFixed (LOG_BINARY_INT, (int64_t) v); }
+  LogRecord & operator<< (unsigned int v) { return WriteFixed (LOG_BINARY_UINT, (uint64_t) v); }
+  LogRecord & operator<< (long v) { return WriteFixed (LOG_BINARY_INT, (int64_t) v); }
+  LogRecord & operator<< (unsigned long v) { return WriteFixed (LOG_BINARY_UINT, (uint64_t) v); }
+  LogRecord & operator<< (long long v) { return WriteFixed (LOG_BINARY_INT, (int64_t) v); }
+  LogRecord & operator<< (unsigned long long v) { return WriteFixed (LOG_BINARY_UINT, (uint64_t) v); }
+  LogRecord & operator<< (float v) { return WriteFixed (LOG_BINARY_DOUBLE, (double) v); }
+  LogRecord & operator<< (double v) { return WriteFixed (LOG_BINARY_DOUBLE, v); }
+  LogRecord & operator<< (long double v) { return WriteFixed (LOG_BINARY_DOUBLE, (double) v); }
+  LogRecord & operator<< (const char *v) { return WriteString (LOG_BINARY_STRING, v, std::strlen (v)); }
+  LogRecord & operator<< (char *v) { return WriteString (LOG_BINARY_STRING, v, std::strlen (v)); }
+  LogRecord & operator<< (const std::string &v) { return WriteString (LOG_BINARY_STRING, v.data (), v.size ()); }
+  LogRecord & operator<< (std::ios_base & (*manipulator)(std::ios_base &));
+  LogRecord & operator<< (std::ostream & (*manipulator)(std::ostream &));
+  template <typename T>
+  LogRecord & operator<< (T *v);
+  template <typename T>
+  LogRecord & operator<< (const Ptr<T> &v);
+  template <typename T>
+  LogRecord & operator<< (const T &v);
+  /**@}*/
+
+private:
+  /**
+   * Append a tagged value of fixed size.
+   * \param [in] tag The tag.
+   * \param [in] v The value.
+   * \returns This LogRecord.
+   */
+  template <typename T>
+  LogRecord & WriteFixed (uint8_t tag, T v);
+  /**
+   * Append a tagged string.
+   * \param [in] tag The tag.
+   * \param [in] s The characters.
+   * \param [in] n The number of characters.
+   * \returns This LogRecord.
+   */
+  LogRecord & WriteString (uint8_t tag, const char *s, uint32_t n);
+  /**
+   * Append bytes.
+   * \param [in] bytes The bytes.
+   * \param [in] n The number of bytes.
+   */
+  void Write (const void *bytes, uint32_t n);
+
+  /**
+   * The buffer of the thread; the record starts at the end of the
+   * complete records of the buffer.
+   */
+  LogBinaryBuffer *m_buffer;
+};
+
+/**
+ * \ingroup logging-binary
+ * Make room in a buffer, by writing its complete records to the binary
+ * log or by growing it.
+ * \internal
+ * Used by LogRecord.
+ *
+ * \param [in,out] buffer The buffer.
+ * \param [in] n The number of bytes needed after the end of the buffer.
+ */
+void LogBinaryMakeRoom (LogBinaryBuffer *buffer, uint32_t n);
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+inline void
+LogRecord::Write (const void *bytes, uint32_t n)
+{
+  if (m_buffer->end + n > m_buffer->size)
+    {
+      LogBinaryMakeRoom (m_buffer, n);
+    }
+  std::memcpy (m_buffer->data + m_buffer->end, bytes, n);
+  m_buffer->end += n;
+}
+
+template <typename T>
+LogRecord &
+LogRecord::WriteFixed (uint8_t tag, T v)
+{
+  Write (&tag, 1);
+  Write (&v, sizeof (v));
+  return *this;
+}
+
+inline LogRecord &
+LogRecord::WriteString (uint8_t tag, const char *s, uint32_t n)
+{
+  Write (&tag, 1);
+  Write (&n, 4);
+  Write (s, n);
+  return *this;
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (T *v)
+{
+  return WriteFixed (LOG_BINARY_POINTER, (uint64_t) (uintptr_t) v);
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (const Ptr<T> &v)
+{
+  return WriteFixed (LOG_BINARY_POINTER, (uint64_t) (uintptr_t) PeekPointer (v));
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (const T &v)
+{
+  std::ostringstream oss;
+  // A few output operators take a non-const reference; they do not
+  // modify the value either.
+  oss << const_cast<T &> (v);
+  std::string s = oss.str ();
+  if (s.empty ())
+    {
+      // std::setw and the like
+      return *this;
+    }
+  return WriteString (LOG_BINARY_TEXT, s.data (), s.size ());
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -0,0 +1,269 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_RNTI_MAP_H
+#define LTE_RNTI_MAP_H
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief A map from the RNTIs of the UEs to their state
+ *
+ * The values are stored in a vector indexed by the RNTI, so that a
+ * lookup costs one access to contiguous memory, and the RNTIs in use
+ * are kept in a sorted vector, so that an iteration visits only the UEs
+ * present, in increasing order of RNTI as with a std::map.
+ *
+ * The class provides the subset of the interface of std::map used by the
+ * schedulers. An iterator refers to its element by RNTI: erasing an
+ * element does not invalidate the iterators to the other elements, but
+ * inserting an element may move the values, like in a std::vector.
+ */
+template <class T>
+class LteRntiMap
+{
+public:
+  /// the element type, with the RNTI first and the value second
+  typedef std::pair<uint16_t, T> value_type;
+
+  /// Iterator over the elements, in increasing order of RNTI
+  class iterator
+  {
+public:
+    iterator ()
+      : m_map (0),
+        m_pos (0),
+        m_rnti (0),
+        m_end (true)
+    {
+    }
+    /**
+     * Constructor
+     *
+     * \param map the map
+     * \param pos the position of the RNTI of the element in the sorted
+     * RNTIs, or their number for the iterator past the last element
+     */
+    iterator (LteRntiMap<T> *map, uint32_t pos)
+      : m_map (map),
+        m_pos (pos),
+        m_rnti (0),
+        m_end (pos >= map->m_rntis.size ())
+    {
+      if (!m_end)
+        {
+          m_rnti = map->m_rntis[pos];
+        }
+    }
+    /// \return the element
+    value_type& operator* () const
+    {
+      return m_map->m_values[m_rnti];
+    }
+    /// \return a pointer to the element
+    value_type* operator-> () const
+    {
+      return &m_map->m_values[m_rnti];
+    }
+    /// \return the iterator to the next element
+    iterator& operator++ ()
+    {
+      const std::vector<uint16_t> &rntis = m_map->m_rntis;
+      // the position is only a hint: elements may have been erased
+      // since the iterator was created
+      if (m_pos < rntis.size () && rntis[m_pos] == m_rnti)
+        {
+          ++m_pos;
+        }
+      else
+        {
+          m_pos = std::upper_bound (rntis.begin (), rntis.end (), m_rnti) - rntis.begin ();
+        }
+      m_end = m_pos >= rntis.size ();
+      if (!m_end)
+        {
+          m_rnti = rntis[m_pos];
+        }
+      return *this;
+    }
+    /// \return the iterator before the increment
+    iterator operator++ (int)
+    {
+      iterator old = *this;
+      ++(*this);
+      return old;
+    }
+    /**
+     * \param o the other iterator
+     * \return true if both iterators refer to the same element
+     */
+    bool operator== (const iterator &o) const
+    {
+      return m_end ? o.m_end : (!o.m_end && m_rnti == o.m_rnti);
+    }
+    /**
+     * \param o the other iterator
+     * \return true if the iterators refer to different elements
+     */
+    bool operator!= (const iterator &o) const
+    {
+      return !(*this == o);
+    }
+
+private:
+    friend class LteRntiMap<T>;
+    LteRntiMap<T> *m_map; ///< the map
+    uint32_t m_pos; ///< the position of the RNTI in the sorted RNTIs
+    uint16_t m_rnti; ///< the RNTI of the element
+    bool m_end; ///< whether the iterator is past the last element
+  };
+
+  /// \return the iterator to the element with the lowest RNTI
+  iterator begin ()
+  {
+    return iterator (this, 0);
+  }
+  /// \return the iterator past the last element
+  iterator end ()
+  {
+    return iterator (this, m_rntis.size ());
+  }
+  /// \return the number of elements
+  uint32_t size () const
+  {
+    return m_rntis.size ();
+  }
+  /// \return true if there are no elements
+  bool empty () const
+  {
+    return m_rntis.empty ();
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return 1 if the RNTI is in the map, 0 otherwise
+   */
+  uint32_t count (uint16_t rnti) const
+  {
+    return (rnti < m_used.size () && m_used[rnti]) ? 1 : 0;
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return the iterator to the element of the RNTI, or end () if missing
+   */
+  iterator find (uint16_t rnti)
+  {
+    if (!count (rnti))
+      {
+        return end ();
+      }
+    return iterator (this, std::lower_bound (m_rntis.begin (), m_rntis.end (), rnti) - m_rntis.begin ());
+  }
+
+  /**
+   * Insert an element if its RNTI is not in the map
+   *
+   * \param value the element
+   * \return the iterator to the element of the RNTI and whether the
+   * element was inserted
+   */
+  std::pair<iterator, bool> insert (const value_type &value)
+  {
+    uint16_t rnti = value.first;
+    if (count (rnti))
+      {
+        return std::make_pair (find (rnti), false);
+      }
+    if (rnti >= m_used.size ())
+      {
+        m_used.resize (rnti + 1, false);
+        m_values.resize (rnti + 1);
+      }
+    m_used[rnti] = true;
+    m_values[rnti] = value;
+    std::vector<uint16_t>::iterator pos = std::lower_bound (m_rntis.begin (), m_rntis.end (), rnti);
+    pos = m_rntis.insert (pos, rnti);
+    return std::make_pair (iterator (this, pos - m_rntis.begin ()), true);
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return the value of the RNTI, inserted with the default value if
+   * the RNTI is not in the map
+   */
+  T& operator[] (uint16_t rnti)
+  {
+    if (!count (rnti))
+      {
+        insert (value_type (rnti, T ()));
+      }
+    return m_values[rnti].second;
+  }
+
+  /**
+   * Erase the element of an RNTI
+   *
+   * \param rnti the RNTI
+   * \return the number of erased elements
+   */
+  uint32_t erase (uint16_t rnti)
+  {
+    if (!count (rnti))
+      {
+        return 0;
+      }
+    m_used[rnti] = false;
+    // release the memory held by the value
+    m_values[rnti] = value_type ();
+    m_rntis.erase (std::lower_bound (m_rntis.begin (), m_rntis.end (), rnti));
+    return 1;
+  }
+
+  /**
+   * Erase the element an iterator refers to
+   *
+   * \param it the iterator
+   */
+  void erase (iterator it)
+  {
+    erase (it.m_rnti);
+  }
+
+  /// Erase all the elements
+  void clear ()
+  {
+    m_used.clear ();
+    m_values.clear ();
+    m_rntis.clear ();
+  }
+
+private:
+  std::vector<value_type> m_values; ///< the elements, indexed by RNTI
+  std::vector<bool> m_used; ///< whether each RNTI is in the map
+  std::vector<uint16_t> m_rntis; ///< the RNTIs in the map, sorted
+};
+
+} // namespace ns3
+
+#endif /* LTE_RNTI_MAP_H */
@@ -0,0 +1,248 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jaume Nin <jnin@cttc.es>
+ */
+
+#ifndef LTE_STATS_CALCULATOR_H_
+#define LTE_STATS_CALCULATOR_H_
+
+#include "ns3/object.h"
+#include "ns3/string.h"
+#include "ns3/event-id.h"
+#include <map>
+#include <vector>
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Base class for ***StatsCalculator classes. Provides
+ * basic functionality to parse and store IMSI and CellId.
+ * Also stores names of output files and keeps the output
+ * streams of the derived classes open for the whole simulation.
+ */
+
+class LteStatsCalculator : public Object
+{
+public:
+  /**
+   * Constructor
+   */
+  LteStatsCalculator ();
+
+  /**
+   * Destructor
+   */
+  virtual ~LteStatsCalculator ();
+
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Set the name of the file where the uplink statistics will be stored.
+   *
+   * \param outputFilename string with the name of the file
+   */
+  void SetUlOutputFilename (std::string outputFilename);
+
+  /**
+   * Get the name of the file where the uplink statistics will be stored.
+   * @return the name of the file where the uplink statistics will be stored
+   */
+  std::string GetUlOutputFilename (void);
+
+  /**
+   * Set the name of the file where the downlink statistics will be stored.
+   *
+   * @param outputFilename string with the name of the file
+   */
+  void SetDlOutputFilename (std::string outputFilename);
+
+  /**
+   * Get the name of the file where the downlink statistics will be stored.
+   * @return the name of the file where the downlink statistics will be stored
+   */
+  std::string GetDlOutputFilename (void);
+
+  /**
+   * Checks if there is an already stored IMSI for the given path
+   * @param path Path in the attribute system to check
+   * @return true if the path exists, false otherwise
+   */
+  bool ExistsImsiPath (std::string path);
+
+  /**
+   * Stores the (path, imsi) pairs in a map
+   * @param path Path in the attribute system to store
+   * @param imsi IMSI value to store
+   */
+  void SetImsiPath (std::string path, uint64_t imsi);
+
+  /**
+   * Retrieves the imsi information for the given path
+   * @param path Path in the attribute system to get
+   * @return the IMSI associated with the given path
+   */
+  uint64_t GetImsiPath (std::string path);
+
+  /**
+   * Checks if there is an already stored cell id for the given path
+   * @param path Path in the attribute system to check
+   * @return true if the path exists, false otherwise
+   */
+  bool ExistsCellIdPath (std::string path);
+
+  /**
+   * Stores the (path, cellId) pairs in a map
+   * @param path Path in the attribute system to store
+   * @param cellId cell id value to store
+   */
+  void SetCellIdPath (std::string path, uint16_t cellId);
+
+  /**
+   * Retrieves the cell id information for the given path
+   * @param path Path in the attribute system to get
+   * @return the cell ID associated with the given path
+   */
+  uint16_t GetCellIdPath (std::string path);
+
+protected:
+  // inherited from Object
+  virtual void DoDispose (void);
+
+  /**
+   * Makes sure that the given output stream is open. The first time
+   * the stream is used, the file is created and the column descriptions
+   * are written to it; the stream is then kept open, so that the
+   * statistics lines are buffered instead of reopening the file in
+   * append mode for each of them. All the streams opened this way are
+   * flushed at Simulator::Destroy and when the calculator is disposed.
+   *
+   * @param outFile the output stream, owned by the derived class
+   * @param filename the name of the file to be created
+   * @param header the column descriptions, without the end of line
+   * @return true if the stream is open and can be written
+   */
+  bool OpenOutputFile (std::ofstream& outFile, std::string filename, std::string header);
+
+  /**
+   * Flushes the buffered output of all the streams opened with
+   * OpenOutputFile ()
+   */
+  void FlushOutputFiles (void);
+
+  /**
+   * Retrieves IMSI from Enb RLC path in the attribute system
+   * @param path Path in the attribute system to get
+   * @return the IMSI associated with the given path
+   */
+  static uint64_t FindImsiFromEnbRlcPath (std::string path);
+
+  /**
+   * Retrieves IMSI from Ue PHY path in the attribute system
+   * @param path Path in the attribute system to get
+   * @return the IMSI associated with the given path
+   */
+  static uint64_t FindImsiFromUePhy (std::string path);
+
+  /**
+   * Retrieves IMSI from LteNetDevice path in the attribute system
+   * @param path Path in the attribute system to get
+   * @return the IMSI associated with the given path
+   */
+  static uint64_t FindImsiFromLteNetDevice (std::string path);
+
+  /**
+   * Retrieves CellId from Enb RLC path in the attribute system
+   * @param path Path in the attribute system to get
+   * @return the CellId associated with the given path
+   */
+  static uint16_t FindCellIdFromEnbRlcPath (std::string path);
+
+  /**
+   * Retrieves IMSI from Enb MAC path in the attribute system
+   * @param path Path in the attribute system to get
+   * @param rnti RNTI of UE for which IMSI is needed
+   * @return the IMSI associated with the given path and RNTI
+   */
+  static uint64_t FindImsiFromEnbMac (std::string path, uint16_t rnti);
+
+  /**
+   * Retrieves CellId from Enb MAC path in the attribute system
+   * @param path Path in the attribute system to get
+   * @param rnti RNTI of UE for which CellId is needed
+   * @return the CellId associated with the given path and RNTI
+   */
+  static uint16_t FindCellIdFromEnbMac (std::string path, uint16_t rnti);
+
+  /**
+   * Retrieves IMSI from path for Enb in the attribute system
+   * @param path Path in the attribute system to get
+   * @param rnti RNTI of UE for which IMSI is needed
+   * @return the IMSI associated with the given path and RNTI
+   */
+  static uint64_t FindImsiForEnb (std::string path, uint16_t rnti);
+
+  /**
+   * Retrieves IMSI from path for Ue in the attribute system
+   * @param path Path in the attribute system to get
+   * @param rnti RNTI of UE for which IMSI is needed
+   * @return the IMSI associated with the given path and RNTI
+   */
+  static uint64_t FindImsiForUe (std::string path, uint16_t rnti);
+
+private:
+  /**
+   * List of IMSI by path in the attribute system
+   */
+  std::map<std::string, uint64_t> m_pathImsiMap;
+
+  /**
+   * List of CellId by path in the attribute system
+   */
+  std::map<std::string, uint16_t> m_pathCellIdMap;
+
+  /**
+   * Name of the file where the downlink results will be saved
+   */
+  std::string m_dlOutputFilename;
+
+  /**
+   * Name of the file where the uplink results will be saved
+   */
+  std::string m_ulOutputFilename;
+
+  /**
+   * Output streams opened by OpenOutputFile ()
+   */
+  std::vector<std::ofstream *> m_outputFiles;
+
+  /**
+   * Event flushing the output streams at Simulator::Destroy
+   */
+  EventId m_flushEvent;
+};
+
+} // namespace ns3
+
+#endif /* LTE_STATS_CALCULATOR_H_ */
@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Marco Miozzo <marco.miozzo@cttc.es>
+ */
+
+#ifndef PF_FF_MAC_SCHEDULER_H
+#define PF_FF_MAC_SCHEDULER_H
+
+#include <ns3/lte-common.h>
+#include <ns3/ff-mac-csched-sap.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-harq.h>
+#include <ns3/lte-rnti-map.h>
+#include <vector>
+#include <map>
+#include <ns3/nstime.h>
+#include <ns3/lte-amc.h>
+#include <ns3/lte-ffr-sap.h>
+
+// value for SINR outside the range defined by FF-API, used to indicate that there
+// is no CQI for this element
+#define NO_SINR -5000
+
+
+namespace ns3 {
+
+
+/// pfsFlowPerf_t structure
+struct pfsFlowPerf_t
+{
+  Time flowStart; ///< flow start time
+  unsigned long totalBytesTransmitted; ///< total bytes transmitted
+  unsigned int lastTtiBytesTrasmitted; ///< last total bytes transmitted
+  double lastAveragedThroughput; ///< last averaged throughput
+};
+
+
+/**
+ * \ingroup ff-api
+ * \brief Implements the SCHED SAP and CSCHED SAP for a Proportional Fair scheduler
+ *
+ * This class implements the interface defined by the FfMacScheduler abstract class
+ */
+
+class PfFfMacScheduler : public FfMacScheduler
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * Creates the MAC Scheduler interface implementation
+   */
+  PfFfMacScheduler ();
+
+  /**
+   * Destructor
+   */
+  virtual ~PfFfMacScheduler ();
+
+  // inherited from Object
+  virtual void DoDispose (void);
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from FfMacScheduler
+  virtual void SetFfMacCschedSapUser (FfMacCschedSapUser* s);
+  virtual void SetFfMacSchedSapUser (FfMacSchedSapUser* s);
+  virtual FfMacCschedSapProvider* GetFfMacCschedSapProvider ();
+  virtual FfMacSchedSapProvider* GetFfMacSchedSapProvider ();
+
+  // FFR SAPs
+  virtual void SetLteFfrSapProvider (LteFfrSapProvider* s);
+  virtual LteFfrSapUser* GetLteFfrSapUser ();
+
+  /// allow MemberCschedSapProvider<PfFfMacScheduler> class friend access
+  friend class MemberCschedSapProvider<PfFfMacScheduler>;
+  /// allow MemberSchedSapProvider<PfFfMacScheduler> class friend access  
+  friend class MemberSchedSapProvider<PfFfMacScheduler>;
+
+  /**
+   * \brief transmission mode configuration update
+   *
+   * \param rnti the RNTI
+   * \param txMode the transmit mode
+   */
+  void TransmissionModeConfigurationUpdate (uint16_t rnti, uint8_t txMode);
+
+private:
+  //
+  // Implementation of the CSCHED API primitives
+  // (See 4.1 for description of the primitives)
+  //
+
+  /**
+   * \brief CSched cell config request
+   *
+   * \param params FfMacCschedSapProvider::CschedCellConfigReqParameters
+   */
+  void DoCschedCellConfigReq (const struct FfMacCschedSapProvider::CschedCellConfigReqParameters& params);
+
+  /**
+   * \brief CSched UE config request
+   *
+   * \param params FfMacCschedSapProvider::CschedUeConfigReqParameters
+   */
+  void DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
+
+  /**
+   * \brief CSched LC config request
+   *
+   * \param params FfMacCschedSapProvider::CschedLcConfigReqParameters
+   */
+  void DoCschedLcConfigReq (const struct FfMacCschedSapProvider::CschedLcConfigReqParameters& params);
+
+  /**
+   * \brief CSched LC release request
+   *
+   * \param params FfMacCschedSapProvider::CschedLcReleaseReqParameters
+   */
+  void DoCschedLcReleaseReq (const struct FfMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+
+  /**
+   * \brief CSched UE release request
+   *
+   * \param params FfMacCschedSapProvider::CschedLcReleaseReqParameters
+   */
+  void DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+
+  //
+  // Implementation of the SCHED API primitives
+  // (See 4.2 for description of the primitives)
+  //
+
+  /**
+   * \brief Sched DL RLC buffer request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlRlcBufferReqParameters
+   */
+  void DoSchedDlRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+
+  /**
+   * \brief Sched DL paging buffer request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlPagingBufferReqParameters
+   */
+  void DoSchedDlPagingBufferReq (const struct FfMacSchedSapProvider::SchedDlPagingBufferReqParameters& params);
+
+  /**
+   * \brief Sched DL MAC buffer request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlMacBufferReqParameters
+   */
+  void DoSchedDlMacBufferReq (const struct FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params);
+
+  /**
+   * \brief Sched DL trigger request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlTriggerReqParameters
+   */
+  void DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::SchedDlTriggerReqParameters& params);
+
+  /**
+   * \brief Sched DL RACH info request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlRachInfoReqParameters
+   */
+  void DoSchedDlRachInfoReq (const struct FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params);
+
+  /**
+   * \brief Sched DL CQI info request
+   *
+   * \param params FfMacSchedSapProvider::SchedDlCqiInfoReqParameters
+   */
+  void DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+
+  /**
+   * \brief Sched UL trigger request
+   *
+   * \param params FfMacSchedSapProvider::SchedUlTriggerReqParameters
+   */
+  void DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::SchedUlTriggerReqParameters& params);
+
+  /**
+   * \brief Sched UL noise interference request
+   *
+   * \param params FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters
+   */
+  void DoSchedUlNoiseInterferenceReq (const struct FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params);
+
+  /**
+   * \brief Sched UL SR info request
+   *
+   * \param params FfMacSchedSapProvider::SchedUlSrInfoReqParameters
+   */
+  void DoSchedUlSrInfoReq (const struct FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params);
+
+  /**
+   * \brief Sched UL MAC control info request
+   *
+   * \param params FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters
+   */
+  void DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+
+  /**
+   * \brief Sched UL CQI info request
+   *
+   * \param params FfMacSchedSapProvider::SchedUlCqiInfoReqParameters
+   */
+  void DoSchedUlCqiInfoReq (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+
+  /**
+   * \brief Get RBG size
+   *
+   * \param dlbandwidth dDL bandwidth
+   * \returns the RBG size
+   */
+  int GetRbgSize (int dlbandwidth);
+
+  /**
+   * \brief LC active per flow
+   *
+   * \param rnti the RNTI
+   * \returns the LC acive per flow
+   */
+  unsigned int LcActivePerFlow (uint16_t rnti);
+
+  /**
+   * \brief Estimate UL SINR
+   *
+   * \param rnti the RNTI
+   * \param rb the RB
+   * \returns the SINR
+   */
+  double EstimateUlSinr (uint16_t rnti, uint16_t rb);
+
+  /// Refresh DL CQI maps
+  void RefreshDlCqiMaps (void);
+  /// Refresh UL CQI maps
+  void RefreshUlCqiMaps (void);
+
+  /**
+   * \brief Update DL RCL buffer info
+   *
+   * \param rnti the RNTI
+   * \param lcid the LCID
+   * \param size the size
+   */
+  void UpdateDlRlcBufferInfo (uint16_t rnti, uint8_t lcid, uint16_t size);
+  /**
+   * \brief Update UL RCL buffer info
+   *
+   * \param rnti the RNTI
+   * \param size the size
+   */
+  void UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size);
+
+  Ptr<LteAmc> m_amc; ///< AMC
+
+  /**
+   * Vectors of UE's LC info
+  */
+  std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
+
+
+  /**
+  * Map of UE statistics (per RNTI basis) in downlink
+  */
+  LteRntiMap <pfsFlowPerf_t> m_flowStatsDl;
+
+  /**
+  * Map of UE statistics (per RNTI basis)
+  */
+  LteRntiMap <pfsFlowPerf_t> m_flowStatsUl;
+
+
+  /**
+  * Map of UE's DL CQI P01 received
+  */
+  LteRntiMap <uint8_t> m_p10CqiRxed;
+  /**
+  * Map of UE's timers on DL CQI P01 received
+  */
+  LteRntiMap <uint32_t> m_p10CqiTimers;
+
+  /**
+  * Map of UE's DL CQI A30 received
+  */
+  LteRntiMap <SbMeasResult_s> m_a30CqiRxed;
+  /**
+  * Map of UE's timers on DL CQI A30 received
+  */
+  LteRntiMap <uint32_t> m_a30CqiTimers;
+
+  /**
+  * Map of previous allocated UE per RBG
+  * (used to retrieve info from UL-CQI)
+  */
+  std::map <uint16_t, std::vector <uint16_t> > m_allocationMaps;
+
+  /**
+  * Map of UEs' UL-CQI per RBG
+  */
+  std::map <uint16_t, std::vector <double> > m_ueCqi;
+  /**
+  * Map of UEs' timers on UL-CQI per RBG
+  */
+  LteRntiMap <uint32_t> m_ueCqiTimers;
+
+  /**
+  * Map of UE's buffer status reports received
+  */
+  LteRntiMap <uint32_t> m_ceBsrRxed;
+
+  // MAC SAPs
+  FfMacCschedSapUser* m_cschedSapUser; ///< CSched SAP user
+  FfMacSchedSapUser* m_schedSapUser; ///< Sched SAP user
+  FfMacCschedSapProvider* m_cschedSapProvider; ///< CSched SAP provider
+  FfMacSchedSapProvider* m_schedSapProvider; ///< Sched SAP provider
+
+  // FFR SAPs
+  LteFfrSapUser* m_ffrSapUser; ///< FFR SAP user
+  LteFfrSapProvider* m_ffrSapProvider; ///< FFR SAP provider
+
+  // Internal parameters
+  FfMacCschedSapProvider::CschedCellConfigReqParameters m_cschedCellConfig; ///< CSched cell config
+
+
+  double m_timeWindow; ///< time window
+
+  uint16_t m_nextRntiUl; ///< RNTI of the next user to be served next scheduling in UL
+
+  uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
+
+  LteRntiMap <uint8_t> m_uesTxMode; ///< txMode of the UEs
+
+  // HARQ attributes
+  /**
+  * m_harqOn when false inhibit te HARQ mechanisms (by default active)
+  */
+  bool m_harqOn;
+  FfMacSchedulerHarq m_harq; ///< HARQ processes of the UEs
+
+
+  // RACH attributes
+  std::vector <struct RachListElement_s> m_rachList; ///< RACH list
+  std::vector <uint16_t> m_rachAllocationMap; ///< RACH allocation map
+  uint8_t m_ulGrantMcs; ///< MCS for UL grant (default 0)
+
+};
+
+} // namespace ns3
+
+#endif /* PF_FF_MAC_SCHEDULER_H */
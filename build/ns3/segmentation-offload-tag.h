@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Packet tag marking a super-segment built with segmentation offload
+ *
+ * A transport protocol that supports segmentation offload (e.g., TCP with
+ * the TcpSocketBase::Tso attribute enabled) can hand down to the lower layers
+ * a single packet carrying several segments worth of payload. The packet is
+ * marked with this tag, that records the size of each segment and the total
+ * payload carried. Devices supporting segmentation offload (see
+ * NetDevice::SupportsSegmentationOffload) transmit such a packet with the
+ * timing of the equivalent train of segments, while the split is performed
+ * lazily, only where it is really needed (at the receiving transport protocol
+ * or by the IP layer for devices that do not support the offload).
+ *
+ * Since the single segments never exist on the channel, a receive error
+ * model cannot drop them individually: the segments that should have been
+ * corrupted are marked as lost in this tag instead (see
+ * ErrorModel::IsCorruptSegmented) and are discarded at the time of the split.
+ *
+ * A super-segment can carry at most MAX_SEGMENTS segments.
+ */
+class SegmentationOffloadTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+
+  static const uint32_t MAX_SEGMENTS = 64; //!< Maximum number of segments in a super-segment
+
+  SegmentationOffloadTag ();
+
+  /**
+   * \brief Constructor
+   * \param segmentSize the payload size of each segment (but the last one)
+   * \param payloadSize the total payload size of the super-segment
+   */
+  SegmentationOffloadTag (uint16_t segmentSize, uint32_t payloadSize);
+
+  /**
+   * \brief Set the payload size of each segment (but the last one)
+   * \param segmentSize the segment size
+   */
+  void SetSegmentSize (uint16_t segmentSize);
+  /**
+   * \brief Get the payload size of each segment (but the last one)
+   * \return the segment size
+   */
+  uint16_t GetSegmentSize (void) const;
+  /**
+   * \brief Set the total payload size of the super-segment
+   * \param payloadSize the payload size
+   */
+  void SetPayloadSize (uint32_t payloadSize);
+  /**
+   * \brief Get the total payload size of the super-segment
+   * \return the payload size
+   */
+  uint32_t GetPayloadSize (void) const;
+  /**
+   * \brief Get the number of segments carried by the super-segment
+   * \return the number of segments
+   */
+  uint32_t GetSegmentCount (void) const;
+  /**
+   * \brief Get the payload size of a given segment
+   * \param index the index of the segment
+   * \return the payload size of the segment
+   */
+  uint32_t GetSegmentPayloadSize (uint32_t index) const;
+  /**
+   * \brief Compute the number of bytes needed to transmit all the segments
+   *
+   * Each segment carries a copy of the headers (and trailers) that are
+   * present in the super-segment.
+   *
+   * \param packetSize the size of the super-segment, including all headers
+   * \return the total number of bytes of the segments
+   */
+  uint32_t GetSegmentedSize (uint32_t packetSize) const;
+  /**
+   * \brief Mark a segment as lost
+   * \param index the index of the segment
+   */
+  void SetLost (uint32_t index);
+  /**
+   * \brief Check whether a segment has been marked as lost
+   * \param index the index of the segment
+   * \return true if the segment is lost
+   */
+  bool IsLost (uint32_t index) const;
+  /**
+   * \brief Check whether any segment has been marked as lost
+   * \return true if at least a segment is lost
+   */
+  bool IsAnyLost (void) const;
+  /**
+   * \brief Check whether all the segments have been marked as lost
+   * \return true if all the segments are lost
+   */
+  bool IsAllLost (void) const;
+
+private:
+  uint16_t m_segmentSize;   //!< Payload size of each segment
+  uint32_t m_payloadSize;   //!< Total payload size
+  uint64_t m_lostSegments;  //!< Bitmap of the lost segments
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
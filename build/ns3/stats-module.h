@@ -0,0 +1,34 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_STATS
+    
+
+// Module headers:
+#include "average.h"
+#include "basic-data-calculators.h"
+#include "boolean-probe.h"
+#include "columnar-aggregator.h"
+#include "data-calculator.h"
+#include "data-collection-object.h"
+#include "data-collector.h"
+#include "data-output-interface.h"
+#include "double-probe.h"
+#include "file-aggregator.h"
+#include "file-helper.h"
+#include "get-wildcard-matches.h"
+#include "gnuplot-aggregator.h"
+#include "gnuplot-helper.h"
+#include "gnuplot.h"
+#include "omnet-data-output.h"
+#include "probe.h"
+#include "sqlite-data-output.h"
+#include "time-data-calculators.h"
+#include "time-probe.h"
+#include "time-series-adaptor.h"
+#include "uinteger-16-probe.h"
+#include "uinteger-32-probe.h"
+#include "uinteger-8-probe.h"
+#endif
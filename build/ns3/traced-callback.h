@@ -0,0 +1,729 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef TRACED_CALLBACK_H
+#define TRACED_CALLBACK_H
+
+#include <list>
+#include <vector>
+#include "callback.h"
+
+/**
+ * \file
+ * \ingroup tracing
+ * ns3::TracedCallback declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup tracing
+ * \brief Invoke a sink connected to a TracedCallback with
+ * TracedCallback::ConnectSink().
+ *
+ * The sink is called through a plain function pointer to an instance
+ * of Invoke(), hence without the virtual call made by Callback. The
+ * partial specializations drop the trailing \c empty arguments, as
+ * done by CallbackImpl.
+ *
+ * \tparam SINK \explicit Type of the sink.
+ * \tparam T1 \explicit Type of the first argument to the sink.
+ * \tparam T2 \explicit Type of the second argument to the sink.
+ * \tparam T3 \explicit Type of the third argument to the sink.
+ * \tparam T4 \explicit Type of the fourth argument to the sink.
+ * \tparam T5 \explicit Type of the fifth argument to the sink.
+ * \tparam T6 \explicit Type of the sixth argument to the sink.
+ * \tparam T7 \explicit Type of the seventh argument to the sink.
+ * \tparam T8 \explicit Type of the eighth argument to the sink.
+ */
+template <typename SINK,
+          typename T1, typename T2,
+          typename T3, typename T4,
+          typename T5, typename T6,
+          typename T7, typename T8>
+struct TracedCallbackSinkInvoker
+{
+  /**
+   * Invoke the sink.
+   * \param [in] sink The sink.
+   * \param [in] a1 The first argument.
+   * \param [in] a2 The second argument.
+   * \param [in] a3 The third argument.
+   * \param [in] a4 The fourth argument.
+   * \param [in] a5 The fifth argument.
+   * \param [in] a6 The sixth argument.
+   * \param [in] a7 The seventh argument.
+   * \param [in] a8 The eighth argument.
+   */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 7 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6, a7);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 6 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 5 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 4 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 3 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 2 arguments.
+ */
+template <typename SINK, typename T1, typename T2>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 1 argument.
+ */
+template <typename SINK, typename T1>
+struct TracedCallbackSinkInvoker<SINK,T1,empty,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, empty, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 0 arguments.
+ */
+template <typename SINK>
+struct TracedCallbackSinkInvoker<SINK,empty,empty,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, empty, empty, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) ();
+  }
+};
+
+/**
+ * \ingroup tracing
+ * \brief Forward calls to a chain of Callback
+ *
+ * An TracedCallback has almost exactly the same API as a normal
+ * Callback but instead of forwarding calls to a single function
+ * (as a Callback normally does), it forwards calls to a chain
+ * of Callback.  Connect adds a Callback at the end of the chain
+ * of callbacks.  Disconnect removes a Callback from the chain of callbacks.
+ *
+ * This is a functor: the chain of Callbacks is invoked by
+ * calling one of the \c operator() forms with the appropriate
+ * number of arguments.
+ *
+ * \tparam T1 \explicit Type of the first argument to the functor.
+ * \tparam T2 \explicit Type of the second argument to the functor.
+ * \tparam T3 \explicit Type of the third argument to the functor.
+ * \tparam T4 \explicit Type of the fourth argument to the functor.
+ * \tparam T5 \explicit Type of the fifth argument to the functor.
+ * \tparam T6 \explicit Type of the sixth argument to the functor.
+ * \tparam T7 \explicit Type of the seventh argument to the functor.
+ * \tparam T8 \explicit Type of the eighth argument to the functor.
+ */
+template<typename T1 = empty, typename T2 = empty, 
+         typename T3 = empty, typename T4 = empty,
+         typename T5 = empty, typename T6 = empty,
+         typename T7 = empty, typename T8 = empty>
+class TracedCallback 
+{
+public:
+  /** Constructor. */
+  TracedCallback ();
+  /**
+   * Append a Callback to the chain (without a context).
+   *
+   * \param [in] callback Callback to add to chain.
+   */
+  void ConnectWithoutContext (const CallbackBase & callback);
+  /**
+   * Append a Callback to the chain with a context.
+   *
+   * The context string will be provided as the first argument
+   * to the Callback.
+   *
+   * \param [in] callback Callback to add to chain.
+   * \param [in] path Context string to provide when invoking the Callback.
+   */
+  void Connect (const CallbackBase & callback, std::string path);
+  /**
+   * Remove from the chain a Callback which was connected without a context.
+   *
+   * \param [in] callback Callback to remove from the chain.
+   */
+  void DisconnectWithoutContext (const CallbackBase & callback);
+  /**
+   * Remove from the chain a Callback which was connected with a context.
+   *
+   * \param [in] callback Callback to remove from the chain.
+   * \param [in] path Context path which was used to connect the Callback.
+   */
+  void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * Append a sink to the chain (without a context).
+   *
+   * The sink is an object whose \c operator() takes the arguments of
+   * this TracedCallback. Unlike a Callback, the sink is invoked without
+   * a virtual call, which makes a difference for trace sources fired
+   * for every packet. The sink is not copied: the caller must keep it
+   * alive until it is disconnected or this TracedCallback is destroyed.
+   *
+   * \tparam SINK \deduced Type of the sink.
+   * \param [in] sink The sink to add to the chain.
+   */
+  template <typename SINK>
+  void ConnectSink (SINK *sink);
+  /**
+   * Remove from the chain a sink which was connected with ConnectSink().
+   *
+   * \tparam SINK \deduced Type of the sink.
+   * \param [in] sink The sink to remove from the chain.
+   */
+  template <typename SINK>
+  void DisconnectSink (SINK *sink);
+  /**
+   * \name Functors taking various numbers of arguments.
+   *
+   * The version selected is determined by the number of arguments
+   * at the point where the Callback is invoked in the class
+   * which fires the Callback.
+   */
+  /**@{*/
+  /** Functor which invokes the chain of Callbacks. */
+  void operator() (void) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   */
+  void operator() (T1 a1) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \tparam T4 \deduced Type of the fourth argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   * \param [in] a4 The fourth argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3, T4 a4) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \tparam T4 \deduced Type of the fourth argument to the functor.
+   * \tparam T5 \deduced Type of the fifth argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   * \param [in] a4 The fourth argument to the functor.
+   * \param [in] a5 The fifth argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \tparam T4 \deduced Type of the fourth argument to the functor.
+   * \tparam T5 \deduced Type of the fifth argument to the functor.
+   * \tparam T6 \deduced Type of the sixth argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   * \param [in] a4 The fourth argument to the functor.
+   * \param [in] a5 The fifth argument to the functor.
+   * \param [in] a6 The sixth argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \tparam T4 \deduced Type of the fourth argument to the functor.
+   * \tparam T5 \deduced Type of the fifth argument to the functor.
+   * \tparam T6 \deduced Type of the sixth argument to the functor.
+   * \tparam T7 \deduced Type of the seventh argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   * \param [in] a4 The fourth argument to the functor.
+   * \param [in] a5 The fifth argument to the functor.
+   * \param [in] a6 The sixth argument to the functor.
+   * \param [in] a7 The seventh argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const;
+  /**
+   * \copybrief operator()()
+   * \tparam T1 \deduced Type of the first argument to the functor.
+   * \tparam T2 \deduced Type of the second argument to the functor.
+   * \tparam T3 \deduced Type of the third argument to the functor.
+   * \tparam T4 \deduced Type of the fourth argument to the functor.
+   * \tparam T5 \deduced Type of the fifth argument to the functor.
+   * \tparam T6 \deduced Type of the sixth argument to the functor.
+   * \tparam T7 \deduced Type of the seventh argument to the functor.
+   * \tparam T8 \deduced Type of the eighth argument to the functor.
+   * \param [in] a1 The first argument to the functor.
+   * \param [in] a2 The second argument to the functor.
+   * \param [in] a3 The third argument to the functor.
+   * \param [in] a4 The fourth argument to the functor.
+   * \param [in] a5 The fifth argument to the functor.
+   * \param [in] a6 The sixth argument to the functor.
+   * \param [in] a7 The seventh argument to the functor.
+   * \param [in] a8 The eighth argument to the functor.
+   */
+  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const;
+  /**@}*/
+
+  /**
+   *  TracedCallback signature for POD.
+   *
+   * \param [in] value Value of the traced variable.
+   * @{
+   */
+  // Uint32Callback appears to be the only one used at the moment.
+  // Feel free to add typedef's for any other POD you need.
+  typedef void (* Uint32Callback)(const uint32_t value);
+  /**@}*/
+
+  
+private:
+  /**
+   * An element of the chain: either a Callback, or a sink connected
+   * with ConnectSink() and its invoker.
+   */
+  struct Entry
+  {
+    /** The Callback, if \c invoke is zero. */
+    Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> callback;
+    /** The invoker of the sink, or zero. */
+    void (*invoke)(void *,T1,T2,T3,T4,T5,T6,T7,T8);
+    /** The sink. */
+    void *sink;
+  };
+  /**
+   * Container type for holding the chain of Callbacks.
+   *
+   * The chain is browsed by index when it is invoked, hence a Callback
+   * may connect other Callbacks to this TracedCallback while it runs.
+   */
+  typedef std::vector<Entry> CallbackList;
+  /** The chain of Callbacks. */
+  CallbackList m_callbackList;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::TracedCallback ()
+  : m_callbackList () 
+{
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectWithoutContext (const CallbackBase & callback)
+{
+  Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> cb;
+  if (!cb.Assign (callback))
+    NS_FATAL_ERROR_NO_MSG();
+  Entry entry;
+  entry.callback = cb;
+  entry.invoke = 0;
+  entry.sink = 0;
+  m_callbackList.push_back (entry);
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Connect (const CallbackBase & callback, std::string path)
+{
+  Callback<void,std::string,T1,T2,T3,T4,T5,T6,T7,T8> cb;
+  if (!cb.Assign (callback))
+    NS_FATAL_ERROR ("when connecting to " << path);
+  Entry entry;
+  entry.callback = cb.Bind (path);
+  entry.invoke = 0;
+  entry.sink = 0;
+  m_callbackList.push_back (entry);
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectWithoutContext (const CallbackBase & callback)
+{
+  for (typename CallbackList::iterator i = m_callbackList.begin ();
+       i != m_callbackList.end (); /* empty */)
+    {
+      if (i->invoke == 0 && i->callback.IsEqual (callback))
+        {
+          i = m_callbackList.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Disconnect (const CallbackBase & callback, std::string path)
+{
+  Callback<void,std::string,T1,T2,T3,T4,T5,T6,T7,T8> cb;
+  if (!cb.Assign (callback))
+    NS_FATAL_ERROR ("when disconnecting from " << path);
+  Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
+  DisconnectWithoutContext (realCb);
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+template <typename SINK>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectSink (SINK *sink)
+{
+  Entry entry;
+  entry.invoke = &TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,T8>::Invoke;
+  entry.sink = sink;
+  m_callbackList.push_back (entry);
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+template <typename SINK>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectSink (SINK *sink)
+{
+  void (*invoke)(void *,T1,T2,T3,T4,T5,T6,T7,T8) = &TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,T8>::Invoke;
+  for (typename CallbackList::iterator i = m_callbackList.begin ();
+       i != m_callbackList.end (); /* empty */)
+    {
+      if (i->invoke == invoke && i->sink == sink)
+        {
+          i = m_callbackList.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (void) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, T1 (), T2 (), T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback ();
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, T2 (), T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, a7, T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6, a7);
+        }
+    }
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const
+{
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
+    {
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, a7, a8);
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6, a7, a8);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* TRACED_CALLBACK_H */
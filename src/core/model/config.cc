@@ -27,6 +27,8 @@
 #include "log.h"
 
 #include <sstream>
+#include <algorithm>
+#include <map>
 
 /**
  * \file
@@ -150,6 +152,9 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into a set of
+ * index ranges.
  */
 class ArrayMatcher
 {
@@ -167,7 +172,23 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (uint32_t i) const;
+  /**
+   * Get the indices matching the Config Path, if there are fewer of them
+   * than items in the container.
+   *
+   * \param [in] n The number of items in the container.
+   * \param [out] indices The matching indices lower than \p n, in
+   *              increasing order.
+   * \returns \c false if every item of the container has to be checked.
+   */
+  bool GetIndices (uint32_t n, std::vector<uint32_t> *indices) const;
 private:
+  /**
+   * Parse a Config path specification.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -178,78 +199,114 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Whether every index matches. */
+  bool m_any;
+  /** The ranges [min, max] of matching indices. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (uint32_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      m_any = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      Parse (element.substr (0, tmp-0));
+      Parse (element.substr (tmp+1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min) && 
           StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
+          min <= max)
         {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
-        }
-      else
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+      NS_LOG_DEBUG ("Array "<<i<<" matches *");
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it = m_ranges.begin (); it != m_ranges.end (); it++)
+    {
+      if (i >= it->first && i <= it->second)
+        {
+          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
+bool
+ArrayMatcher::GetIndices (uint32_t n, std::vector<uint32_t> *indices) const
+{
+  NS_LOG_FUNCTION (this << n << indices);
+  if (m_any)
+    {
+      return false;
+    }
+  uint64_t count = 0;
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it = m_ranges.begin (); it != m_ranges.end (); it++)
+    {
+      if (it->first < n)
+        {
+          count += std::min (it->second, n - 1) - it->first + 1;
+        }
+    }
+  if (count >= n)
+    {
+      return false;
+    }
+  indices->clear ();
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it = m_ranges.begin (); it != m_ranges.end (); it++)
+    {
+      for (uint64_t i = it->first; i < n && i <= it->second; i++)
+        {
+          indices->push_back (i);
+        }
+    }
+  std::sort (indices->begin (), indices->end ());
+  indices->erase (std::unique (indices->begin (), indices->end ()), indices->end ());
+  return true;
+}
 
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
@@ -261,6 +318,298 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * An element of a compiled Config path.
+ *
+ * Depending on the objects found while resolving the path, an element
+ * may be used as a name, a GetObject request or an array index, hence
+ * all of them are parsed in advance.
+ */
+class CompiledPath::Element
+{
+public:
+  /**
+   * Construct from a path element.
+   *
+   * \param [in] element The element.
+   */
+  Element (std::string element);
+
+  /** The element. */
+  std::string item;
+  /** Whether the element is a GetObject request ($TypeId). */
+  bool isGetObject;
+  /** The name of the TypeId of a GetObject request. */
+  std::string tidName;
+  /** Whether the TypeId of a GetObject request exists. */
+  bool tidFound;
+  /** The TypeId of a GetObject request. */
+  TypeId tid;
+  /** The element, used as an array index. */
+  ArrayMatcher matcher;
+};
+
+CompiledPath::Element::Element (std::string element)
+  : item (element),
+    isGetObject (element.find ("$") == 0),
+    tidFound (false),
+    matcher (element)
+{
+  if (isGetObject)
+    {
+      tidName = element.substr (1, element.size () - 1);
+      tidFound = TypeId::LookupByNameFailSafe (tidName, &tid);
+    }
+}
+
+/**
+ * \ingroup config-impl
+ * Split a Config path into its elements, after making sure that it
+ * starts and ends with a '/'.
+ *
+ * \param [in] path The Config path.
+ * \param [out] elements The elements of the path.
+ */
+static void
+SplitPath (std::string path, std::vector<std::string> *elements)
+{
+  NS_LOG_FUNCTION (path << elements);
+
+  // ensure that we start and end with a '/'
+  std::string::size_type tmp = path.find ("/");
+  if (tmp != 0)
+    {
+      // no slash at start
+      path = "/" + path;
+    }
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
+    {
+      // no slash at end
+      path = path + "/";
+    }
+
+  std::string::size_type cur = 0;
+  std::string::size_type next = path.find ("/", cur + 1);
+  while (next != std::string::npos)
+    {
+      elements->push_back (path.substr (cur + 1, next - (cur + 1)));
+      cur = next;
+      next = path.find ("/", cur + 1);
+    }
+}
+
+CompiledPath::CompiledPath ()
+  : m_objectPathN (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CompiledPath::CompiledPath (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  std::vector<std::string> elements;
+  SplitPath (path, &elements);
+  for (std::vector<std::string>::const_iterator it = elements.begin (); it != elements.end (); it++)
+    {
+      m_elements.push_back (new Element (*it));
+    }
+
+  // Set and Connect use the last element as the name of the attribute
+  // or trace source
+  std::string::size_type slash = path.find_last_of ("/");
+  std::vector<std::string> objectPath;
+  if (slash != std::string::npos)
+    {
+      m_objectPath = path.substr (0, slash);
+      SplitPath (m_objectPath, &objectPath);
+      m_leaf = path.substr (slash + 1, path.size () - (slash + 1));
+    }
+  else
+    {
+      m_leaf = path;
+    }
+  NS_ASSERT (objectPath.size () <= m_elements.size ());
+  m_objectPathN = objectPath.size ();
+}
+
+CompiledPath::CompiledPath (const CompiledPath &o)
+  : m_path (o.m_path),
+    m_objectPathN (o.m_objectPathN),
+    m_objectPath (o.m_objectPath),
+    m_leaf (o.m_leaf)
+{
+  NS_LOG_FUNCTION (this << &o);
+  for (std::vector<Element *>::const_iterator it = o.m_elements.begin (); it != o.m_elements.end (); it++)
+    {
+      m_elements.push_back (new Element (**it));
+    }
+}
+
+CompiledPath &
+CompiledPath::operator= (const CompiledPath &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  if (this != &o)
+    {
+      CompiledPath tmp (o);
+      m_path = tmp.m_path;
+      m_elements.swap (tmp.m_elements);
+      m_objectPathN = tmp.m_objectPathN;
+      m_objectPath = tmp.m_objectPath;
+      m_leaf = tmp.m_leaf;
+    }
+  return *this;
+}
+
+CompiledPath::~CompiledPath ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Element *>::iterator it = m_elements.begin (); it != m_elements.end (); it++)
+    {
+      delete *it;
+    }
+  m_elements.clear ();
+}
+
+std::string
+CompiledPath::GetPath (void) const
+{
+  return m_path;
+}
+
+uint32_t
+CompiledPath::GetN (void) const
+{
+  return m_elements.size ();
+}
+
+const CompiledPath::Element &
+CompiledPath::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_elements.size ());
+  return *m_elements[i];
+}
+
+uint32_t
+CompiledPath::GetObjectPathN (void) const
+{
+  return m_objectPathN;
+}
+
+std::string
+CompiledPath::GetObjectPath (void) const
+{
+  return m_objectPath;
+}
+
+std::string
+CompiledPath::GetLeaf (void) const
+{
+  return m_leaf;
+}
+
+/**
+ * \ingroup config-impl
+ * An attribute which a Config path can go through, i.e., an attribute
+ * holding a pointer to an object or a container of objects.
+ */
+struct PathAttribute
+{
+  std::string name;                        //!< The attribute name
+  uint32_t flags;                          //!< The attribute flags
+  Ptr<const AttributeAccessor> accessor;   //!< The attribute accessor
+  bool isPointer;                          //!< Whether the attribute holds a pointer
+  /** The container accessor, if the attribute holds a container. */
+  const ObjectPtrContainerAccessor *container;
+};
+
+/**
+ * \ingroup config-impl
+ * Get the attributes of a TypeId (and its parents) a Config path element
+ * can go through.
+ *
+ * Looking for the attributes requires to browse all the attributes of the
+ * TypeId and of its parents and to inspect their checkers. This is done
+ * once per TypeId and path element and the result is cached.
+ *
+ * \param [in] tid The TypeId of the object.
+ * \param [in] item The path element (an attribute name or "*").
+ * \returns The matching attributes, in the order they are declared,
+ *          starting with the TypeId itself.
+ */
+static const std::vector<PathAttribute> &
+LookupPathAttributes (TypeId tid, const std::string &item)
+{
+  NS_LOG_FUNCTION (tid << item);
+
+  typedef std::map<std::pair<uint16_t, std::string>, std::vector<PathAttribute> > Cache;
+  static Cache cache;
+
+  std::pair<uint16_t, std::string> key = std::make_pair (tid.GetUid (), item);
+  Cache::const_iterator it = cache.find (key);
+  if (it != cache.end ())
+    {
+      return it->second;
+    }
+
+  std::vector<PathAttribute> &attributes = cache[key];
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = tid.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.flags = info.flags;
+          attribute.accessor = info.accessor;
+          attribute.isPointer = (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0);
+          attribute.container = 0;
+          if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.container = dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info.accessor));
+              NS_ASSERT_MSG (attribute.container != 0, "Attribute " << info.name << " of " << tid.GetName ()
+                             << " has an object container checker but not an object container accessor");
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+          if (attribute.isPointer || attribute.container != 0)
+            {
+              attributes.push_back (attribute);
+            }
+        }
+
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+
+  return attributes;
+}
+
+/**
+ * \ingroup config-impl
+ * Compare the indices of two items of a container.
+ *
+ * \param [in] a The first item.
+ * \param [in] b The second item.
+ * \returns \c true if the index of \p a is lower than the index of \p b.
+ */
+static bool
+CompareIndex (const std::pair<uint32_t, Ptr<Object> > &a, const std::pair<uint32_t, Ptr<Object> > &b)
+{
+  return a.first < b.first;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -269,11 +618,12 @@ class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from a compiled Config path.
    *
-   * \param [in] path The Config path.
+   * \param [in] path The compiled Config path.
+   * \param [in] n The number of elements of the path to resolve.
    */
-  Resolver (std::string path);
+  Resolver (const CompiledPath &path, uint32_t n);
   /** Destructor. */
   virtual ~Resolver ();
 
@@ -287,23 +637,23 @@ public:
   void Resolve (Ptr<Object> root);
   
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] i The index of the next element of the Config path.
    * \param [in] root The object corresponding to the current positon
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (uint32_t i, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] i The index of the element of the Config path
+   *               holding the index.
+   * \param [in] root The object holding the container.
+   * \param [in] attribute The container attribute.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (uint32_t i, Ptr<Object> root, const PathAttribute &attribute);
   /**
    * Handle one object found on the path.
    *
@@ -326,47 +676,31 @@ private:
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The compiled Config path. */
+  const CompiledPath &m_path;
+  /** The number of elements of the path to resolve. */
+  uint32_t m_n;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (const CompiledPath &path, uint32_t n)
+  : m_path (path),
+    m_n (n)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << path.GetPath () << n);
+  NS_ASSERT (n <= path.GetN ());
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
-{
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
-}
 
 void 
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -392,13 +726,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (uint32_t i, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << i << root);
 
-  if (next == std::string::npos)
+  if (i == m_n)
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -414,8 +746,8 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const CompiledPath::Element &element = m_path.Get (i);
+  const std::string &item = element.item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -426,11 +758,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (i + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -447,7 +778,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (i + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -463,82 +794,66 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (element.isGetObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      NS_LOG_DEBUG ("GetObject="<<element.tidName<<" on path="<<GetResolvedPath ());
+      TypeId tid = element.tidFound ? element.tid : TypeId::LookupByName (element.tidName);
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject ("<<tidString<<") failed on path="<<GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject ("<<element.tidName<<") failed on path="<<GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (i + 1, object);
       m_workStack.pop_back ();
     }
   else 
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
+      const std::vector<PathAttribute> &attributes = LookupPathAttributes (root->GetInstanceTypeId (), item);
       bool foundMatch = false;
       
-      do
+      for (std::vector<PathAttribute>::const_iterator it = attributes.begin (); it != attributes.end (); it++)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          const PathAttribute &attribute = *it;
+          if (attribute.isPointer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<attribute.name<<" on path="<<GetResolvedPath ());
+              PointerValue ptr;
+              if ((attribute.flags & TypeId::ATTR_GET) && attribute.accessor->HasGetter ())
                 {
-                  continue;
+                  attribute.accessor->Get (PeekPointer (root), ptr);
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (ptr != 0)
+              else
                 {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue ptr;
-                  root->GetAttribute (info.name, ptr);
-                  Ptr<Object> object = ptr.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
+                  // let GetAttribute report the error
+                  root->GetAttribute (attribute.name, ptr);
                 }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
+              Ptr<Object> object = ptr.Get<Object> ();
+              if (object == 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
+                  continue;
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              m_workStack.push_back (attribute.name);
+              DoResolve (i + 1, object);
+              m_workStack.pop_back ();
             }
+          if (attribute.container != 0)
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<attribute.name<<" on path="<<GetResolvedPath ());
+              foundMatch = true;
+              m_workStack.push_back (attribute.name);
+              DoArrayResolve (i + 1, root, attribute);
+              m_workStack.pop_back ();
+            }
+        }
 
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
-      
       if (!foundMatch)
         {
           NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
@@ -548,29 +863,86 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (uint32_t i, Ptr<Object> root, const PathAttribute &attribute)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << i << root << attribute.name);
+  if (i == m_n)
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  uint32_t n;
+  if (!(attribute.flags & TypeId::ATTR_GET) || !attribute.container->GetN (PeekPointer (root), &n))
+    {
+      // let GetAttribute report the error
+      ObjectPtrContainerValue container;
+      root->GetAttribute (attribute.name, container);
+      return;
+    }
+
+  const ArrayMatcher &matcher = m_path.Get (i).matcher;
+  std::vector<std::pair<uint32_t, Ptr<Object> > > items;
+
+  // If the path selects a few indices, try to fetch the corresponding
+  // items directly. This works if the index of each item is its
+  // position in the container, which is the case for vectors and for
+  // maps whose keys are 0 to n-1. The last item is checked first, since
+  // the items with an index larger than n-1 would be missed otherwise.
+  std::vector<uint32_t> indices;
+  bool direct = matcher.GetIndices (n, &indices);
+  if (direct && n > 0)
+    {
+      uint32_t index;
+      attribute.container->GetItem (PeekPointer (root), n - 1, &index);
+      direct = (index == n - 1);
+    }
+  for (std::vector<uint32_t>::const_iterator it = indices.begin (); direct && it != indices.end (); it++)
+    {
+      uint32_t index;
+      Ptr<Object> object = attribute.container->GetItem (PeekPointer (root), *it, &index);
+      direct = (index == *it);
+      items.push_back (std::make_pair (index, object));
+    }
 
-  ArrayMatcher matcher = ArrayMatcher (item);
-  ObjectPtrContainerValue::Iterator it;
-  for (it = container.Begin (); it != container.End (); ++it)
+  if (!direct)
     {
-      if (matcher.Matches ((*it).first))
+      // Check the index of every item in the container
+      items.clear ();
+      bool sorted = true;
+      for (uint32_t k = 0; k < n; k++)
+        {
+          uint32_t index;
+          Ptr<Object> object = attribute.container->GetItem (PeekPointer (root), k, &index);
+          if (!items.empty () && index <= items.back ().first)
+            {
+              sorted = false;
+            }
+          items.push_back (std::make_pair (index, object));
+        }
+      if (!sorted)
+        {
+          // visit the items in increasing index order and, as done by
+          // ObjectPtrContainerValue, keep only the first item per index
+          std::stable_sort (items.begin (), items.end (), CompareIndex);
+          std::vector<std::pair<uint32_t, Ptr<Object> > > unique;
+          for (uint32_t k = 0; k < items.size (); k++)
+            {
+              if (unique.empty () || unique.back ().first != items[k].first)
+                {
+                  unique.push_back (items[k]);
+                }
+            }
+          items.swap (unique);
+        }
+    }
+
+  for (uint32_t k = 0; k < items.size (); k++)
+    {
+      if (direct || matcher.Matches (items[k].first))
         {
           std::ostringstream oss;
-          oss << (*it).first;
+          oss << items[k].first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (i + 1, items[k].second);
           m_workStack.pop_back ();
         }
     }
@@ -583,18 +955,18 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
 class ConfigImpl : public Singleton<ConfigImpl>
 {
 public:
-  /** \copydoc Config::Set() */
-  void Set (std::string path, const AttributeValue &value);
-  /** \copydoc Config::ConnectWithoutContext() */
-  void ConnectWithoutContext (std::string path, const CallbackBase &cb);
-  /** \copydoc Config::Connect() */
-  void Connect (std::string path, const CallbackBase &cb);
-  /** \copydoc Config::DisconnectWithoutContext() */
-  void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
-  /** \copydoc Config::Disconnect() */
-  void Disconnect (std::string path, const CallbackBase &cb);
-  /** \copydoc Config::LookupMatches() */
-  MatchContainer LookupMatches (std::string path);
+  /** \copydoc Config::Set(const CompiledPath&,const AttributeValue&) */
+  void Set (const CompiledPath &path, const AttributeValue &value);
+  /** \copydoc Config::ConnectWithoutContext(const CompiledPath&,const CallbackBase&) */
+  void ConnectWithoutContext (const CompiledPath &path, const CallbackBase &cb);
+  /** \copydoc Config::Connect(const CompiledPath&,const CallbackBase&) */
+  void Connect (const CompiledPath &path, const CallbackBase &cb);
+  /** \copydoc Config::DisconnectWithoutContext(const CompiledPath&,const CallbackBase&) */
+  void DisconnectWithoutContext (const CompiledPath &path, const CallbackBase &cb);
+  /** \copydoc Config::Disconnect(const CompiledPath&,const CallbackBase&) */
+  void Disconnect (const CompiledPath &path, const CallbackBase &cb);
+  /** \copydoc Config::LookupMatches(const CompiledPath&) */
+  MatchContainer LookupMatches (const CompiledPath &path);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -608,13 +980,13 @@ public:
 
 private:
   /**
-   * Break a Config path into the leading path and the last leaf token.
-   * \param [in] path The Config path.
-   * \param [in,out] root The leading part of the \p path,
-   *   up to the final slash.
-   * \param [in,out] leaf The trailing part of the \p path.
+   * Find the objects matching the first elements of a Config path.
+   * \param [in] path The compiled Config path.
+   * \param [in] n The number of elements to match.
+   * \param [in] pathString The path reported by the returned container.
+   * \returns The matching objects.
    */
-  void ParsePath (std::string path, std::string *root, std::string *leaf) const;
+  MatchContainer LookupMatches (const CompiledPath &path, uint32_t n, std::string pathString);
 
   /** Container type to hold the root Config path tokens. */
   typedef std::vector<Ptr<Object> > Roots;
@@ -625,75 +997,60 @@ private:
 };  // class ConfigImpl
 
 void 
-ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
+ConfigImpl::Set (const CompiledPath &path, const AttributeValue &value)
 {
-  NS_LOG_FUNCTION (this << path << root << leaf);
+  NS_LOG_FUNCTION (this << path.GetPath () << &value);
 
-  std::string::size_type slash = path.find_last_of ("/");
-  NS_ASSERT (slash != std::string::npos);
-  *root = path.substr (0, slash);
-  *leaf = path.substr (slash+1, path.size ()-(slash+1));
-  NS_LOG_FUNCTION (path << *root << *leaf);
+  MatchContainer container = LookupMatches (path, path.GetObjectPathN (), path.GetObjectPath ());
+  container.Set (path.GetLeaf (), value);
 }
-
-void 
-ConfigImpl::Set (std::string path, const AttributeValue &value)
+void
+ConfigImpl::ConnectWithoutContext (const CompiledPath &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &value);
-
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.Set (leaf, value);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  MatchContainer container = LookupMatches (path, path.GetObjectPathN (), path.GetObjectPath ());
+  container.ConnectWithoutContext (path.GetLeaf (), cb);
 }
-void 
-ConfigImpl::ConnectWithoutContext (std::string path, const CallbackBase &cb)
+void
+ConfigImpl::DisconnectWithoutContext (const CompiledPath &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.ConnectWithoutContext (leaf, cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  MatchContainer container = LookupMatches (path, path.GetObjectPathN (), path.GetObjectPath ());
+  container.DisconnectWithoutContext (path.GetLeaf (), cb);
 }
-void 
-ConfigImpl::DisconnectWithoutContext (std::string path, const CallbackBase &cb)
+void
+ConfigImpl::Connect (const CompiledPath &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.DisconnectWithoutContext (leaf, cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+
+  MatchContainer container = LookupMatches (path, path.GetObjectPathN (), path.GetObjectPath ());
+  container.Connect (path.GetLeaf (), cb);
 }
-void 
-ConfigImpl::Connect (std::string path, const CallbackBase &cb)
+void
+ConfigImpl::Disconnect (const CompiledPath &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
 
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.Connect (leaf, cb);
+  MatchContainer container = LookupMatches (path, path.GetObjectPathN (), path.GetObjectPath ());
+  container.Disconnect (path.GetLeaf (), cb);
 }
-void 
-ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
-{
-  NS_LOG_FUNCTION (this << path << &cb);
 
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.Disconnect (leaf, cb);
+MatchContainer
+ConfigImpl::LookupMatches (const CompiledPath &path)
+{
+  NS_LOG_FUNCTION (this << path.GetPath ());
+  return LookupMatches (path, path.GetN (), path.GetPath ());
 }
 
 MatchContainer 
-ConfigImpl::LookupMatches (std::string path)
+ConfigImpl::LookupMatches (const CompiledPath &path, uint32_t n, std::string pathString)
 {
-  NS_LOG_FUNCTION (this << path);
+  NS_LOG_FUNCTION (this << path.GetPath () << n << pathString);
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const CompiledPath &path, uint32_t n)
+      : Resolver (path, n)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path)
     {
@@ -702,7 +1059,7 @@ ConfigImpl::LookupMatches (std::string path)
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver (path, n);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -715,7 +1072,7 @@ ConfigImpl::LookupMatches (std::string path)
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  return MatchContainer (resolver.m_objects, resolver.m_contexts, pathString);
 }
 
 void 
@@ -777,7 +1134,7 @@ void Reset (void)
 void Set (std::string path, const AttributeValue &value)
 {
   NS_LOG_FUNCTION (path << &value);
-  ConfigImpl::Get ()->Set (path, value);
+  ConfigImpl::Get ()->Set (CompiledPath (path), value);
 }
 void SetDefault (std::string name, const AttributeValue &value)
 {
@@ -832,30 +1189,60 @@ bool SetGlobalFailSafe (std::string name, const AttributeValue &value)
 void ConnectWithoutContext (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->ConnectWithoutContext (path, cb);
+  ConfigImpl::Get ()->ConnectWithoutContext (CompiledPath (path), cb);
 }
 void DisconnectWithoutContext (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->DisconnectWithoutContext (path, cb);
+  ConfigImpl::Get ()->DisconnectWithoutContext (CompiledPath (path), cb);
 }
 void 
 Connect (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->Connect (path, cb);
+  ConfigImpl::Get ()->Connect (CompiledPath (path), cb);
 }
 void 
 Disconnect (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->Disconnect (path, cb);
+  ConfigImpl::Get ()->Disconnect (CompiledPath (path), cb);
 }
 MatchContainer LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (path);
+  return ConfigImpl::Get ()->LookupMatches (CompiledPath (path));
+}
+MatchContainer LookupMatches (const CompiledPath &path)
+{
+  NS_LOG_FUNCTION (path.GetPath ());
   return ConfigImpl::Get ()->LookupMatches (path);
 }
+void Set (const CompiledPath &path, const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (path.GetPath () << &value);
+  ConfigImpl::Get ()->Set (path, value);
+}
+void ConnectWithoutContext (const CompiledPath &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path.GetPath () << &cb);
+  ConfigImpl::Get ()->ConnectWithoutContext (path, cb);
+}
+void DisconnectWithoutContext (const CompiledPath &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path.GetPath () << &cb);
+  ConfigImpl::Get ()->DisconnectWithoutContext (path, cb);
+}
+void Connect (const CompiledPath &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path.GetPath () << &cb);
+  ConfigImpl::Get ()->Connect (path, cb);
+}
+void Disconnect (const CompiledPath &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path.GetPath () << &cb);
+  ConfigImpl::Get ()->Disconnect (path, cb);
+}
 
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
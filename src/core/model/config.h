@@ -250,6 +250,93 @@ private:
   std::string m_path;
 };
 
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, to be used many times.
+ *
+ * Config::Set, Config::Connect and the other functions taking a path
+ * string parse the path at each call. When the same path is used many
+ * times (e.g., by helpers connecting trace sinks), it can be compiled
+ * once into a CompiledPath and passed to the overloads of these
+ * functions taking a CompiledPath:
+ *
+ * \code
+ *   Config::CompiledPath path ("/NodeList/0/DeviceList/1/TxQueue/Drop");
+ *   Config::Connect (path, MakeCallback (&DropSink));
+ * \endcode
+ *
+ * A CompiledPath only depends on the path string, hence it remains valid
+ * when objects are added to or removed from the simulation. For the same
+ * reason, it only saves the parsing of the path: a wildcard element still
+ * visits every item of its container at each use, so resolving a wildcard
+ * path costs as much as walking the object graph below it.
+ */
+class CompiledPath
+{
+public:
+  CompiledPath ();
+  /**
+   * Parse a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  explicit CompiledPath (std::string path);
+  /**
+   * Copy constructor.
+   *
+   * \param [in] o The path to copy.
+   */
+  CompiledPath (const CompiledPath &o);
+  /**
+   * Assignment operator.
+   *
+   * \param [in] o The path to copy.
+   * \returns This path.
+   */
+  CompiledPath & operator= (const CompiledPath &o);
+  ~CompiledPath ();
+
+  /**
+   * \returns The path string this path was compiled from.
+   */
+  std::string GetPath (void) const;
+
+  /** Compiled path element, defined by the implementation. */
+  class Element;
+
+  /**
+   * \returns The number of elements of the path, once canonicalized
+   *          (i.e., with a leading and a trailing slash).
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param [in] i The index of the element.
+   * \returns The requested element.
+   */
+  const Element & Get (uint32_t i) const;
+  /**
+   * \returns The number of elements leading to the objects owning the
+   *          attribute or trace source named by the last element (i.e.,
+   *          the elements before the last slash of the path).
+   */
+  uint32_t GetObjectPathN (void) const;
+  /**
+   * \returns The leading part of the path, up to the last slash.
+   */
+  std::string GetObjectPath (void) const;
+  /**
+   * \returns The trailing part of the path, after the last slash.
+   */
+  std::string GetLeaf (void) const;
+
+private:
+  std::string m_path;                 //!< The path string
+  std::vector<Element *> m_elements;  //!< The elements of the path
+  uint32_t m_objectPathN;             //!< Number of elements before the last slash
+  std::string m_objectPath;           //!< The part of the path before the last slash
+  std::string m_leaf;                 //!< The part of the path after the last slash
+};
+
 /**
  * \ingroup config
  * \param [in] path The path to perform a match against
@@ -258,6 +345,54 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \param [in] path The compiled path to perform a match against
+ * \returns A container which contains all the objects which match the input
+ *          path.
+ */
+MatchContainer LookupMatches (const CompiledPath &path);
+/**
+ * \ingroup config
+ * \param [in] path A compiled path to match attributes.
+ * \param [in] value The value to set in all matching attributes.
+ *
+ * \copydetails Set(std::string,const AttributeValue&)
+ */
+void Set (const CompiledPath &path, const AttributeValue &value);
+/**
+ * \ingroup config
+ * \param [in] path A compiled path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ *
+ * \copydetails ConnectWithoutContext(std::string,const CallbackBase&)
+ */
+void ConnectWithoutContext (const CompiledPath &path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A compiled path to match trace sources.
+ * \param [in] cb The callback to disconnect from the matching trace sources.
+ *
+ * \copydetails DisconnectWithoutContext(std::string,const CallbackBase&)
+ */
+void DisconnectWithoutContext (const CompiledPath &path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A compiled path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ *
+ * \copydetails Connect(std::string,const CallbackBase&)
+ */
+void Connect (const CompiledPath &path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A compiled path to match trace sources.
+ * \param [in] cb The callback to disconnect from the matching trace sources.
+ *
+ * \copydetails Disconnect(std::string,const CallbackBase&)
+ */
+void Disconnect (const CompiledPath &path, const CallbackBase &cb);
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -0,0 +1,660 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log.h"
+#include "log-binary.h"
+#include "fatal-error.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging-binary
+ * Binary logging backend implementation.
+ */
+
+// Note: the logging macros are not used in this file, since they
+// would recurse into the binary backend.
+
+namespace ns3 {
+
+bool g_logBinaryEnabled = false;
+
+namespace {
+
+/**
+ * \ingroup logging-binary
+ * The magic number at the start of a binary log.
+ */
+const char g_logBinaryMagic[8] = { 'N', 'S', '3', 'L', 'O', 'G', '0', '1' };
+
+/**
+ * \ingroup logging-binary
+ * The size of the header of a record: tag, length, site, level, time
+ * and context.
+ */
+const uint32_t LOG_BINARY_RECORD_HEADER = 1 + 4 + 4 + 4 + 8 + 4;
+
+/**
+ * \ingroup logging-binary
+ * The buffers of a thread, one per nesting level of the records (a
+ * value streamed into a record may log while it is formatted).
+ */
+struct LogBinaryThread
+{
+  std::vector<LogBinaryBuffer *> buffers;  //!< The buffers
+  uint32_t depth;                          //!< The number of open records
+};
+
+/**
+ * \ingroup logging-binary
+ * The state of the binary logging backend.
+ *
+ * A std::mutex is used rather than a SystemMutex, since SystemMutex logs.
+ */
+struct LogBinaryState
+{
+  std::mutex mutex;                         //!< Protects the other members
+  std::FILE *file;                          //!< The binary log
+  uint32_t bufferSize;                      //!< The initial size of the buffers
+  uint32_t nextSiteId;                      //!< The identifier of the next LogSite
+  std::vector<LogSite *> sites;             //!< The LogSites with an identifier
+  std::vector<LogBinaryBuffer *> buffers;   //!< The buffers of all the threads
+  LogBinaryStamper stamper;                 //!< The LogBinaryStamper
+};
+
+/**
+ * \ingroup logging-binary
+ * Get the state of the binary logging backend.
+ *
+ * The state is never destroyed, so that the log messages of the static
+ * destructors do not use a destroyed state.
+ *
+ * \returns The state.
+ */
+LogBinaryState *
+GetState (void)
+{
+  static LogBinaryState *state = 0;
+  if (state == 0)
+    {
+      state = new LogBinaryState ();
+      state->file = 0;
+      state->bufferSize = 1 << 20;
+      state->nextSiteId = 1;
+      state->stamper = 0;
+    }
+  return state;
+}
+
+/**
+ * \ingroup logging-binary
+ * The buffers of the calling thread.
+ */
+thread_local LogBinaryThread *g_logBinaryThread = 0;
+
+/**
+ * \ingroup logging-binary
+ * Get the buffer of the calling thread for a new record.
+ * \returns The buffer.
+ */
+LogBinaryBuffer *
+OpenBuffer (void)
+{
+  if (g_logBinaryThread == 0)
+    {
+      g_logBinaryThread = new LogBinaryThread ();
+      g_logBinaryThread->depth = 0;
+    }
+  LogBinaryThread *thread = g_logBinaryThread;
+  if (thread->depth == thread->buffers.size ())
+    {
+      LogBinaryState *state = GetState ();
+      LogBinaryBuffer *buffer = new LogBinaryBuffer ();
+      std::lock_guard<std::mutex> lock (state->mutex);
+      buffer->size = state->bufferSize;
+      buffer->data = static_cast<uint8_t *> (std::malloc (buffer->size));
+      buffer->committed = 0;
+      buffer->end = 0;
+      state->buffers.push_back (buffer);
+      thread->buffers.push_back (buffer);
+    }
+  return thread->buffers[thread->depth++];
+}
+
+/**
+ * \ingroup logging-binary
+ * Write the complete records of a buffer to the binary log.
+ *
+ * Must be called with the state mutex held. The records are discarded
+ * if no binary log is open.
+ *
+ * \param [in] state The state.
+ * \param [in,out] buffer The buffer.
+ */
+void
+WriteCommitted (LogBinaryState *state, LogBinaryBuffer *buffer)
+{
+  if (state->file != 0 && buffer->committed > 0)
+    {
+      std::fwrite (buffer->data, 1, buffer->committed, state->file);
+    }
+  std::memmove (buffer->data, buffer->data + buffer->committed,
+                buffer->end - buffer->committed);
+  buffer->end -= buffer->committed;
+  buffer->committed = 0;
+}
+
+/**
+ * \ingroup logging-binary
+ * Write a string of a site definition.
+ * \param [in] file The binary log.
+ * \param [in] s The string.
+ */
+void
+WriteSiteString (std::FILE *file, const std::string &s)
+{
+  uint32_t n = s.size ();
+  std::fwrite (&n, 4, 1, file);
+  std::fwrite (s.data (), 1, n, file);
+}
+
+/**
+ * \ingroup logging-binary
+ * Give an identifier to a LogSite and write its definition in the
+ * binary log.
+ *
+ * \param [in] component The log component of the site.
+ * \param [in,out] site The site.
+ */
+void
+RegisterSite (const LogComponent &component, LogSite *site)
+{
+  LogBinaryState *state = GetState ();
+  std::lock_guard<std::mutex> lock (state->mutex);
+  if (site->id != 0)
+    {
+      return;
+    }
+  site->id = state->nextSiteId++;
+  state->sites.push_back (site);
+  if (state->file == 0)
+    {
+      return;
+    }
+  std::string name = component.Name ();
+  std::string file = site->file;
+  std::string function = site->function;
+  uint8_t tag = LOG_BINARY_SITE;
+  uint32_t length = 4 + (4 + name.size ()) + (4 + file.size ()) + 4 + (4 + function.size ());
+  uint32_t line = site->line;
+  std::fwrite (&tag, 1, 1, state->file);
+  std::fwrite (&length, 4, 1, state->file);
+  std::fwrite (&site->id, 4, 1, state->file);
+  WriteSiteString (state->file, name);
+  WriteSiteString (state->file, file);
+  std::fwrite (&line, 4, 1, state->file);
+  WriteSiteString (state->file, function);
+}
+
+/**
+ * \ingroup logging-binary
+ * Close the binary log when the program exits, and open it at start
+ * up if the NS_LOG_BINARY environment variable is set.
+ */
+class LogBinaryCloser
+{
+public:
+  LogBinaryCloser ()
+  {
+    char *envVar = std::getenv ("NS_LOG_BINARY");
+    if (envVar != 0 && *envVar != 0)
+      {
+        LogBinaryEnable (envVar);
+      }
+  }
+  ~LogBinaryCloser ()
+  {
+    LogBinaryDisable ();
+  }
+} g_logBinaryCloser;  //!< Closes the binary log at exit.
+
+
+/**
+ * \ingroup logging-binary
+ * A LogSite, as read from a binary log.
+ */
+struct LogBinarySiteInfo
+{
+  std::string component;  //!< The name of the log component
+  std::string function;   //!< The function of the log statement
+};
+
+/**
+ * \ingroup logging-binary
+ * Read values from the body of a record of a binary log.
+ */
+class LogBinaryCursor
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] body The body of the record.
+   */
+  LogBinaryCursor (const std::string &body)
+    : m_body (body),
+      m_offset (0)
+  {}
+  /**
+   * Read a value of fixed size.
+   * \param [out] v The value.
+   * \returns \c false if the record is too short.
+   */
+  template <typename T>
+  bool Read (T *v)
+  {
+    if (m_offset + sizeof (T) > m_body.size ())
+      {
+        return false;
+      }
+    std::memcpy (v, m_body.data () + m_offset, sizeof (T));
+    m_offset += sizeof (T);
+    return true;
+  }
+  /**
+   * Read a string.
+   * \param [out] v The string.
+   * \returns \c false if the record is too short.
+   */
+  bool ReadString (std::string *v)
+  {
+    uint32_t n;
+    if (!Read (&n) || m_offset + n > m_body.size ())
+      {
+        return false;
+      }
+    v->assign (m_body.data () + m_offset, n);
+    m_offset += n;
+    return true;
+  }
+  /**
+   * \returns \c true if all the record has been read.
+   */
+  bool IsAtEnd (void) const
+  {
+    return m_offset == m_body.size ();
+  }
+private:
+  const std::string &m_body;  //!< The body of the record
+  std::size_t m_offset;       //!< The offset of the next value
+};
+
+/**
+ * \ingroup logging-binary
+ * Format a log message of a binary log.
+ *
+ * \param [in] sites The sites defined so far.
+ * \param [in,out] cursor The body of the record, after its tag and length.
+ * \param [out] os The stream to print the message on.
+ * \returns \c false if the record is not valid.
+ */
+bool
+PrintRecord (const std::map<uint32_t, LogBinarySiteInfo> &sites,
+             LogBinaryCursor &cursor, std::ostream &os)
+{
+  uint32_t id;
+  int32_t level;
+  int64_t time;
+  uint32_t context;
+  if (!cursor.Read (&id) || !cursor.Read (&level)
+      || !cursor.Read (&time) || !cursor.Read (&context))
+    {
+      return false;
+    }
+  std::map<uint32_t, LogBinarySiteInfo>::const_iterator site = sites.find (id);
+  if (site == sites.end ())
+    {
+      return false;
+    }
+  bool isFunction = (level == LOG_FUNCTION);
+  std::ostringstream msg;
+  bool first = true;
+  while (!cursor.IsAtEnd ())
+    {
+      uint8_t tag;
+      cursor.Read (&tag);
+      if (tag == LOG_BINARY_HEX || tag == LOG_BINARY_OCT || tag == LOG_BINARY_DEC)
+        {
+          msg << (tag == LOG_BINARY_HEX ? std::hex : tag == LOG_BINARY_OCT ? std::oct : std::dec);
+          continue;
+        }
+      if (isFunction && !first)
+        {
+          msg << ", ";
+        }
+      first = false;
+      bool ok = true;
+      switch (tag)
+        {
+        case LOG_BINARY_INT:
+          {
+            int64_t v;
+            ok = cursor.Read (&v);
+            msg << v;
+          }
+          break;
+        case LOG_BINARY_UINT:
+          {
+            uint64_t v;
+            ok = cursor.Read (&v);
+            msg << v;
+          }
+          break;
+        case LOG_BINARY_DOUBLE:
+          {
+            double v;
+            ok = cursor.Read (&v);
+            msg << v;
+          }
+          break;
+        case LOG_BINARY_CHAR:
+          {
+            char v;
+            ok = cursor.Read (&v);
+            msg << v;
+          }
+          break;
+        case LOG_BINARY_BOOL:
+          {
+            uint8_t v;
+            ok = cursor.Read (&v);
+            msg << (v != 0);
+          }
+          break;
+        case LOG_BINARY_POINTER:
+          {
+            uint64_t v;
+            ok = cursor.Read (&v);
+            msg << reinterpret_cast<const void *> (static_cast<uintptr_t> (v));
+          }
+          break;
+        case LOG_BINARY_STRING:
+          {
+            std::string v;
+            ok = cursor.ReadString (&v);
+            if (isFunction)
+              {
+                // as done by ParameterLogger
+                msg << "\"" << v << "\"";
+              }
+            else
+              {
+                msg << v;
+              }
+          }
+          break;
+        case LOG_BINARY_TEXT:
+          {
+            std::string v;
+            ok = cursor.ReadString (&v);
+            msg << v;
+          }
+          break;
+        default:
+          ok = false;
+          break;
+        }
+      if (!ok)
+        {
+          return false;
+        }
+    }
+
+  if (time != std::numeric_limits<int64_t>::min ())
+    {
+      os << "+" << std::fixed << std::setprecision (9) << time / 1e9 << "s ";
+      if (context == 0xffffffff)
+        {
+          os << "-1 ";
+        }
+      else
+        {
+          os << context << " ";
+        }
+    }
+  os << site->second.component << ":" << site->second.function;
+  if (isFunction)
+    {
+      os << "(" << msg.str () << ")" << std::endl;
+    }
+  else
+    {
+      os << "(): [" << LogComponent::GetLevelLabel (static_cast<enum LogLevel> (level))
+         << "] " << msg.str () << std::endl;
+    }
+  return true;
+}
+
+} // unnamed namespace
+
+
+void
+LogBinaryEnable (std::string filename, uint32_t bufferSize)
+{
+  LogBinaryDisable ();
+  LogBinaryState *state = GetState ();
+  std::lock_guard<std::mutex> lock (state->mutex);
+  state->file = std::fopen (filename.c_str (), "wb");
+  if (state->file == 0)
+    {
+      NS_FATAL_ERROR ("Can not open binary log \"" << filename << "\"");
+    }
+  std::fwrite (g_logBinaryMagic, 1, sizeof (g_logBinaryMagic), state->file);
+  state->bufferSize = bufferSize < 4096 ? 4096 : bufferSize;
+  g_logBinaryEnabled = true;
+}
+
+void
+LogBinaryFlush (void)
+{
+  LogBinaryState *state = GetState ();
+  std::lock_guard<std::mutex> lock (state->mutex);
+  for (std::vector<LogBinaryBuffer *>::iterator i = state->buffers.begin ();
+       i != state->buffers.end (); i++)
+    {
+      WriteCommitted (state, *i);
+    }
+  if (state->file != 0)
+    {
+      std::fflush (state->file);
+    }
+}
+
+void
+LogBinaryDisable (void)
+{
+  if (!g_logBinaryEnabled)
+    {
+      return;
+    }
+  LogBinaryFlush ();
+  LogBinaryState *state = GetState ();
+  std::lock_guard<std::mutex> lock (state->mutex);
+  g_logBinaryEnabled = false;
+  std::fclose (state->file);
+  state->file = 0;
+  // The sites will be defined again in the next binary log
+  for (std::vector<LogSite *>::iterator i = state->sites.begin ();
+       i != state->sites.end (); i++)
+    {
+      (*i)->id = 0;
+    }
+  state->sites.clear ();
+  state->nextSiteId = 1;
+}
+
+void
+LogSetBinaryStamper (LogBinaryStamper stamper)
+{
+  GetState ()->stamper = stamper;
+}
+
+void
+LogBinaryMakeRoom (LogBinaryBuffer *buffer, uint32_t n)
+{
+  LogBinaryState *state = GetState ();
+  std::lock_guard<std::mutex> lock (state->mutex);
+  WriteCommitted (state, buffer);
+  if (buffer->end + n > buffer->size)
+    {
+      // A single record does not fit in the buffer
+      while (buffer->end + n > buffer->size)
+        {
+          buffer->size *= 2;
+        }
+      buffer->data = static_cast<uint8_t *> (std::realloc (buffer->data, buffer->size));
+    }
+}
+
+LogRecord::LogRecord (const LogComponent &component, int32_t level, LogSite *site)
+{
+  if (site->id == 0)
+    {
+      RegisterSite (component, site);
+    }
+  m_buffer = OpenBuffer ();
+  int64_t time = std::numeric_limits<int64_t>::min ();
+  uint32_t context = 0xffffffff;
+  LogBinaryStamper stamper = GetState ()->stamper;
+  if (stamper != 0)
+    {
+      (*stamper)(&time, &context);
+    }
+  uint8_t header[LOG_BINARY_RECORD_HEADER];
+  header[0] = LOG_BINARY_RECORD;
+  // The length is written when the record is committed
+  std::memcpy (header + 5, &site->id, 4);
+  std::memcpy (header + 9, &level, 4);
+  std::memcpy (header + 13, &time, 8);
+  std::memcpy (header + 21, &context, 4);
+  Write (header, LOG_BINARY_RECORD_HEADER);
+}
+
+LogRecord::~LogRecord ()
+{
+  uint32_t length = m_buffer->end - m_buffer->committed - 5;
+  std::memcpy (m_buffer->data + m_buffer->committed + 1, &length, 4);
+  m_buffer->committed = m_buffer->end;
+  LogBinaryThread *thread = g_logBinaryThread;
+  thread->depth--;
+  if (thread->depth > 0)
+    {
+      // A record logged while another one was built: write it now, after
+      // the records committed before it, to keep the binary log in order
+      LogBinaryState *state = GetState ();
+      std::lock_guard<std::mutex> lock (state->mutex);
+      for (uint32_t i = 0; i <= thread->depth; i++)
+        {
+          WriteCommitted (state, thread->buffers[i]);
+        }
+    }
+}
+
+LogRecord &
+LogRecord::operator<< (std::ios_base & (*manipulator)(std::ios_base &))
+{
+  uint8_t tag;
+  if (manipulator == static_cast<std::ios_base & (*)(std::ios_base &)> (std::hex))
+    {
+      tag = LOG_BINARY_HEX;
+    }
+  else if (manipulator == static_cast<std::ios_base & (*)(std::ios_base &)> (std::oct))
+    {
+      tag = LOG_BINARY_OCT;
+    }
+  else if (manipulator == static_cast<std::ios_base & (*)(std::ios_base &)> (std::dec))
+    {
+      tag = LOG_BINARY_DEC;
+    }
+  else
+    {
+      return *this;
+    }
+  Write (&tag, 1);
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (std::ostream & (*manipulator)(std::ostream &))
+{
+  // std::endl, std::flush and the like
+  return *this;
+}
+
+bool
+LogBinaryPrint (std::istream &is, std::ostream &os)
+{
+  char magic[sizeof (g_logBinaryMagic)];
+  if (!is.read (magic, sizeof (magic))
+      || std::memcmp (magic, g_logBinaryMagic, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+  std::map<uint32_t, LogBinarySiteInfo> sites;
+  std::string body;
+  uint8_t tag;
+  while (is.read (reinterpret_cast<char *> (&tag), 1))
+    {
+      uint32_t length;
+      if (!is.read (reinterpret_cast<char *> (&length), 4))
+        {
+          return false;
+        }
+      body.resize (length);
+      if (length > 0 && !is.read (&body[0], length))
+        {
+          return false;
+        }
+      LogBinaryCursor cursor (body);
+      if (tag == LOG_BINARY_SITE)
+        {
+          uint32_t id;
+          uint32_t line;
+          std::string file;
+          LogBinarySiteInfo site;
+          if (!cursor.Read (&id) || !cursor.ReadString (&site.component)
+              || !cursor.ReadString (&file) || !cursor.Read (&line)
+              || !cursor.ReadString (&site.function))
+            {
+              return false;
+            }
+          sites[id] = site;
+        }
+      else if (tag != LOG_BINARY_RECORD || !PrintRecord (sites, cursor, os))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -90,6 +90,20 @@
     }                                                           \
 
 
+/**
+ * \ingroup logging
+ * Start a record of the binary log (see \ref logging-binary).
+ *
+ * The values of the message are then streamed into the record.
+ * \internal
+ * Logging implementation macro; should not be called directly.
+ */
+#define NS_LOG_BINARY_RECORD(level)                             \
+  static ns3::LogSite ns3LogSite =                              \
+    { __FILE__, __LINE__, __FUNCTION__, 0 };                    \
+  ns3::LogRecord (g_log, level, &ns3LogSite)
+
+
 #ifndef NS_LOG_APPEND_CONTEXT
 /**
  * \ingroup logging
@@ -155,12 +169,19 @@
     {                                                           \
       if (g_log.IsEnabled (level))                              \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          NS_LOG_APPEND_FUNC_PREFIX;                            \
-          NS_LOG_APPEND_LEVEL_PREFIX (level);                   \
-          std::clog << msg << std::endl;                        \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              NS_LOG_BINARY_RECORD (level) << msg;              \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              NS_LOG_APPEND_FUNC_PREFIX;                        \
+              NS_LOG_APPEND_LEVEL_PREFIX (level);               \
+              std::clog << msg << std::endl;                    \
+            }                                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -179,11 +200,18 @@
     {                                                           \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "()" << std::endl;       \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              NS_LOG_BINARY_RECORD (ns3::LOG_FUNCTION);         \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              std::clog << g_log.Name () << ":"                 \
+                        << __FUNCTION__ << "()" << std::endl;   \
+            }                                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -216,13 +244,21 @@
     {                                                           \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "(";                     \
-          ns3::ParameterLogger (std::clog) << parameters;       \
-          std::clog << ")" << std::endl;                        \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              NS_LOG_BINARY_RECORD (ns3::LOG_FUNCTION)          \
+                << parameters;                                  \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              std::clog << g_log.Name () << ":"                 \
+                        << __FUNCTION__ << "(";                 \
+              ns3::ParameterLogger (std::clog) << parameters;   \
+              std::clog << ")" << std::endl;                    \
+            }                                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -510,9 +510,17 @@ ParameterLogger::operator<< <std::string>(const std::string param);
 template<>
 ParameterLogger&
 ParameterLogger::operator<< <const char *>(const char * param);
+
+inline bool
+LogComponent::IsEnabled (const enum LogLevel level) const
+{
+  return (level & m_levels) ? 1 : 0;
+}
   
 } // namespace ns3
 
 /**@}*/  // \ingroup logging
 
+#include "log-binary.h"
+
 #endif /* NS3_LOG_H */
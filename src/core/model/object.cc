@@ -97,11 +97,12 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  m_aggregates->mask = 0;
+  m_aggregates->table = 0;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -120,6 +121,8 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the lookup table may refer to this object
+  ClearLookupTable (m_aggregates);
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -132,10 +135,11 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   m_aggregates->n = 1;
+  m_aggregates->mask = 0;
+  m_aggregates->table = 0;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,30 +155,18 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
-  uint32_t n = m_aggregates->n;
-  TypeId objectTid = Object::GetTypeId ();
-  for (uint32_t i = 0; i < n; i++)
+  if (m_aggregates->table == 0)
     {
-      Object *current = m_aggregates->buffer[i];
-      TypeId cur = current->GetInstanceTypeId ();
-      while (cur != tid && cur != objectTid)
-        {
-          cur = cur.GetParent ();
-        }
-      if (cur == tid)
+      BuildLookupTable (m_aggregates);
+    }
+  uint16_t uid = tid.GetUid ();
+  uint32_t mask = m_aggregates->mask;
+  const struct AggregateEntry *table = m_aggregates->table;
+  for (uint32_t i = uid & mask; table[i].uid != 0; i = (i + 1) & mask)
+    {
+      if (table[i].uid == uid)
         {
-          // This is an attempt to 'cache' the result of this lookup.
-          // the idea is that if we perform a lookup for a TypeId on this object,
-          // we are likely to perform the same lookup later so, we make sure
-          // that the aggregate array is sorted by the number of accesses
-          // to each object.
-
-          // first, increment the access count
-          current->m_getObjectCount++;
-          // then, update the sort
-          UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
-          return const_cast<Object *> (current);
+          return const_cast<Object *> (table[i].object);
         }
     }
   return 0;
@@ -236,18 +228,57 @@ restart:
     }
 }
 void
-Object::UpdateSortedArray (struct Aggregates *aggregates, uint32_t j) const
+Object::BuildLookupTable (struct Aggregates *aggregates)
 {
-  NS_LOG_FUNCTION (this << aggregates << j);
-  while (j > 0 && 
-         aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j-1]->m_getObjectCount)
+  NS_LOG_FUNCTION (aggregates);
+  ClearLookupTable (aggregates);
+
+  // collect the TypeIds implemented by each aggregate
+  std::vector<std::pair<uint16_t, Object *> > entries;
+  TypeId objectTid = Object::GetTypeId ();
+  for (uint32_t i = 0; i < aggregates->n; i++)
     {
-      Object *tmp = aggregates->buffer[j-1];
-      aggregates->buffer[j-1] = aggregates->buffer[j];
-      aggregates->buffer[j] = tmp;
-      j--;
+      Object *current = aggregates->buffer[i];
+      TypeId cur = current->GetInstanceTypeId ();
+      entries.push_back (std::make_pair (cur.GetUid (), current));
+      while (cur != objectTid && cur.GetParent () != cur)
+        {
+          cur = cur.GetParent ();
+          entries.push_back (std::make_pair (cur.GetUid (), current));
+        }
+    }
+
+  // keep the table at most half full, so that the probe sequences are short
+  uint32_t size = 8;
+  while (size < 2 * entries.size ())
+    {
+      size *= 2;
+    }
+  aggregates->mask = size - 1;
+  aggregates->table = (struct AggregateEntry *) std::calloc (size, sizeof (struct AggregateEntry));
+  for (std::vector<std::pair<uint16_t, Object *> >::const_iterator it = entries.begin (); it != entries.end (); it++)
+    {
+      uint32_t i = it->first & aggregates->mask;
+      while (aggregates->table[i].uid != 0 && aggregates->table[i].uid != it->first)
+        {
+          i = (i + 1) & aggregates->mask;
+        }
+      // the first aggregate implementing a TypeId wins
+      if (aggregates->table[i].uid == 0)
+        {
+          aggregates->table[i].uid = it->first;
+          aggregates->table[i].object = it->second;
+        }
     }
 }
+void
+Object::ClearLookupTable (struct Aggregates *aggregates)
+{
+  NS_LOG_FUNCTION (aggregates);
+  std::free (aggregates->table);
+  aggregates->table = 0;
+  aggregates->mask = 0;
+}
 void 
 Object::AggregateObject (Ptr<Object> o)
 {
@@ -263,6 +294,8 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates = 
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
   aggregates->n = total;
+  aggregates->mask = 0;
+  aggregates->table = 0;
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -281,7 +314,6 @@ Object::AggregateObject (Ptr<Object> o)
                           other->GetInstanceTypeId () <<
                           " on objects of type " << typeId);
         }
-      UpdateSortedArray (aggregates, m_aggregates->n + i);
     }
 
   // keep track of the old aggregate buffers for the iteration
@@ -314,6 +346,8 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
+  ClearLookupTable (a);
+  ClearLookupTable (b);
   std::free (a);
   std::free (b);
 }
@@ -340,6 +374,7 @@ Object::SetTypeId (TypeId tid)
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (Check ());
   m_tid = tid;
+  ClearLookupTable (m_aggregates);
 }
 
 void
@@ -320,6 +320,21 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /**
+   * An entry of the TypeId lookup table of the aggregates.
+   *
+   * The table is an open-addressed hash table mapping the uid of each
+   * TypeId implemented by an aggregate (the TypeId of the aggregate and
+   * all its parents) to the aggregate. When several aggregates implement
+   * the same TypeId, the first one in the aggregate array is stored.
+   */
+  struct AggregateEntry {
+    /** The TypeId uid, or zero for an empty entry. */
+    uint16_t uid;
+    /** The aggregate implementing the TypeId. */
+    Object *object;
+  };
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -335,6 +350,13 @@ private:
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The size of \c table minus one (the size is a power of two). */
+    uint32_t mask;
+    /**
+     * The TypeId lookup table of the aggregates, built on the first
+     * call to DoGetObject(), or zero.
+     */
+    struct AggregateEntry *table;
     /** The array of Objects. */
     Object *buffer[1];
   };
@@ -387,12 +409,18 @@ private:
   void Construct (const AttributeConstructionList &attributes);
 
   /**
-   * Keep the list of aggregates in most-recently-used order
+   * Build the TypeId lookup table of a list of aggregates.
    *
    * \param [in,out] aggregates The list of aggregated Objects.
-   * \param [in] i The most recently used entry in the list.
    */
-  void UpdateSortedArray (struct Aggregates *aggregates, uint32_t i) const;
+  static void BuildLookupTable (struct Aggregates *aggregates);
+  /**
+   * Release the TypeId lookup table of a list of aggregates, which
+   * will be built again on the next lookup.
+   *
+   * \param [in,out] aggregates The list of aggregated Objects.
+   */
+  static void ClearLookupTable (struct Aggregates *aggregates);
   /**
    * Attempt to delete this Object.
    *
@@ -424,14 +452,6 @@ private:
    * so the size of the array is indirectly a reference count.
    */
   struct Aggregates * m_aggregates;
-  /**
-   * The number of times the Object was accessed with a
-   * call to GetObject().
-   *
-   * This integer is used to implement a heuristic to sort
-   * the array of aggregates in most-frequently accessed order.
-   */
-  uint32_t m_getObjectCount;
 };
 
 template <typename T>
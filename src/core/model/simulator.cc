@@ -132,6 +132,21 @@ NodePrinter (std::ostream &os)
     }
 }
 
+/**
+ * \ingroup logging
+ * Default binary log stamper implementation.
+ *
+ * \param [out] time The simulation time, in nanoseconds.
+ * \param [out] context The simulation context (Simulator::NO_CONTEXT
+ *             is 0xffffffff, as expected by the binary log).
+ */
+static void
+BinaryStamper (int64_t *time, uint32_t *context)
+{
+  *time = Simulator::Now ().GetNanoSeconds ();
+  *context = Simulator::GetContext ();
+}
+
 /**
  * \ingroup simulator
  * \brief Get the static SimulatorImpl instance.
@@ -182,6 +197,7 @@ static SimulatorImpl * GetImpl (void)
 //
       LogSetTimePrinter (&TimePrinter);
       LogSetNodePrinter (&NodePrinter);
+      LogSetBinaryStamper (&BinaryStamper);
     }
   return *pimpl;
 }
@@ -203,6 +219,7 @@ Simulator::Destroy (void)
    */
   LogSetTimePrinter (0);
   LogSetNodePrinter (0);
+  LogSetBinaryStamper (0);
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
@@ -419,6 +436,7 @@ Simulator::SetImplementation (Ptr<SimulatorImpl> impl)
 //
   LogSetTimePrinter (&TimePrinter);
   LogSetNodePrinter (&NodePrinter);
+  LogSetBinaryStamper (&BinaryStamper);
 }
 
 Ptr<SimulatorImpl>
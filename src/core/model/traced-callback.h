@@ -22,6 +22,7 @@
 #define TRACED_CALLBACK_H
 
 #include <list>
+#include <vector>
 #include "callback.h"
 
 /**
@@ -32,6 +33,163 @@
 
 namespace ns3 {
 
+/**
+ * \ingroup tracing
+ * \brief Invoke a sink connected to a TracedCallback with
+ * TracedCallback::ConnectSink().
+ *
+ * The sink is called through a plain function pointer to an instance
+ * of Invoke(), hence without the virtual call made by Callback. The
+ * partial specializations drop the trailing \c empty arguments, as
+ * done by CallbackImpl.
+ *
+ * \tparam SINK \explicit Type of the sink.
+ * \tparam T1 \explicit Type of the first argument to the sink.
+ * \tparam T2 \explicit Type of the second argument to the sink.
+ * \tparam T3 \explicit Type of the third argument to the sink.
+ * \tparam T4 \explicit Type of the fourth argument to the sink.
+ * \tparam T5 \explicit Type of the fifth argument to the sink.
+ * \tparam T6 \explicit Type of the sixth argument to the sink.
+ * \tparam T7 \explicit Type of the seventh argument to the sink.
+ * \tparam T8 \explicit Type of the eighth argument to the sink.
+ */
+template <typename SINK,
+          typename T1, typename T2,
+          typename T3, typename T4,
+          typename T5, typename T6,
+          typename T7, typename T8>
+struct TracedCallbackSinkInvoker
+{
+  /**
+   * Invoke the sink.
+   * \param [in] sink The sink.
+   * \param [in] a1 The first argument.
+   * \param [in] a2 The second argument.
+   * \param [in] a3 The third argument.
+   * \param [in] a4 The fourth argument.
+   * \param [in] a5 The fifth argument.
+   * \param [in] a6 The sixth argument.
+   * \param [in] a7 The seventh argument.
+   * \param [in] a8 The eighth argument.
+   */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 7 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6, a7);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 6 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5, a6);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 5 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4, typename T5>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4, a5);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 4 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3, typename T4>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, T4 a4, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3, a4);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 3 arguments.
+ */
+template <typename SINK, typename T1, typename T2, typename T3>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,T3,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, T3 a3, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2, a3);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 2 arguments.
+ */
+template <typename SINK, typename T1, typename T2>
+struct TracedCallbackSinkInvoker<SINK,T1,T2,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, T2 a2, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1, a2);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 1 argument.
+ */
+template <typename SINK, typename T1>
+struct TracedCallbackSinkInvoker<SINK,T1,empty,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, T1 a1, empty, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) (a1);
+  }
+};
+
+/**
+ * \ingroup tracing
+ * TracedCallbackSinkInvoker for a sink taking 0 arguments.
+ */
+template <typename SINK>
+struct TracedCallbackSinkInvoker<SINK,empty,empty,empty,empty,empty,empty,empty,empty>
+{
+  /** \copydoc TracedCallbackSinkInvoker::Invoke */
+  static void Invoke (void *sink, empty, empty, empty, empty, empty, empty, empty, empty)
+  {
+    (*static_cast<SINK *> (sink)) ();
+  }
+};
+
 /**
  * \ingroup tracing
  * \brief Forward calls to a chain of Callback
@@ -93,6 +251,28 @@ public:
    * \param [in] path Context path which was used to connect the Callback.
    */
   void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * Append a sink to the chain (without a context).
+   *
+   * The sink is an object whose \c operator() takes the arguments of
+   * this TracedCallback. Unlike a Callback, the sink is invoked without
+   * a virtual call, which makes a difference for trace sources fired
+   * for every packet. The sink is not copied: the caller must keep it
+   * alive until it is disconnected or this TracedCallback is destroyed.
+   *
+   * \tparam SINK \deduced Type of the sink.
+   * \param [in] sink The sink to add to the chain.
+   */
+  template <typename SINK>
+  void ConnectSink (SINK *sink);
+  /**
+   * Remove from the chain a sink which was connected with ConnectSink().
+   *
+   * \tparam SINK \deduced Type of the sink.
+   * \param [in] sink The sink to remove from the chain.
+   */
+  template <typename SINK>
+  void DisconnectSink (SINK *sink);
   /**
    * \name Functors taking various numbers of arguments.
    *
@@ -222,19 +402,26 @@ public:
 
   
 private:
+  /**
+   * An element of the chain: either a Callback, or a sink connected
+   * with ConnectSink() and its invoker.
+   */
+  struct Entry
+  {
+    /** The Callback, if \c invoke is zero. */
+    Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> callback;
+    /** The invoker of the sink, or zero. */
+    void (*invoke)(void *,T1,T2,T3,T4,T5,T6,T7,T8);
+    /** The sink. */
+    void *sink;
+  };
   /**
    * Container type for holding the chain of Callbacks.
    *
-   * \tparam T1 \deduced Type of the first argument to the functor.
-   * \tparam T2 \deduced Type of the second argument to the functor.
-   * \tparam T3 \deduced Type of the third argument to the functor.
-   * \tparam T4 \deduced Type of the fourth argument to the functor.
-   * \tparam T5 \deduced Type of the fifth argument to the functor.
-   * \tparam T6 \deduced Type of the sixth argument to the functor.
-   * \tparam T7 \deduced Type of the seventh argument to the functor.
-   * \tparam T8 \deduced Type of the eighth argument to the functor.
+   * The chain is browsed by index when it is invoked, hence a Callback
+   * may connect other Callbacks to this TracedCallback while it runs.
    */
-  typedef std::list<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
+  typedef std::vector<Entry> CallbackList;
   /** The chain of Callbacks. */
   CallbackList m_callbackList;
 };
@@ -266,7 +453,11 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectWithoutContext (const CallbackBa
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> cb;
   if (!cb.Assign (callback))
     NS_FATAL_ERROR_NO_MSG();
-  m_callbackList.push_back (cb);
+  Entry entry;
+  entry.callback = cb;
+  entry.invoke = 0;
+  entry.sink = 0;
+  m_callbackList.push_back (entry);
 }
 template<typename T1, typename T2,
          typename T3, typename T4,
@@ -278,8 +469,11 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Connect (const CallbackBase & callback,
   Callback<void,std::string,T1,T2,T3,T4,T5,T6,T7,T8> cb;
   if (!cb.Assign (callback))
     NS_FATAL_ERROR ("when connecting to " << path);
-  Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  Entry entry;
+  entry.callback = cb.Bind (path);
+  entry.invoke = 0;
+  entry.sink = 0;
+  m_callbackList.push_back (entry);
 }
 template<typename T1, typename T2, 
          typename T3, typename T4,
@@ -291,7 +485,7 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectWithoutContext (const Callbac
   for (typename CallbackList::iterator i = m_callbackList.begin ();
        i != m_callbackList.end (); /* empty */)
     {
-      if ((*i).IsEqual (callback))
+      if (i->invoke == 0 && i->callback.IsEqual (callback))
         {
           i = m_callbackList.erase (i);
         }
@@ -314,6 +508,41 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Disconnect (const CallbackBase & callba
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
   DisconnectWithoutContext (realCb);
 }
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+template <typename SINK>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectSink (SINK *sink)
+{
+  Entry entry;
+  entry.invoke = &TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,T8>::Invoke;
+  entry.sink = sink;
+  m_callbackList.push_back (entry);
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+template <typename SINK>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectSink (SINK *sink)
+{
+  void (*invoke)(void *,T1,T2,T3,T4,T5,T6,T7,T8) = &TracedCallbackSinkInvoker<SINK,T1,T2,T3,T4,T5,T6,T7,T8>::Invoke;
+  for (typename CallbackList::iterator i = m_callbackList.begin ();
+       i != m_callbackList.end (); /* empty */)
+    {
+      if (i->invoke == invoke && i->sink == sink)
+        {
+          i = m_callbackList.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
 template<typename T1, typename T2, 
          typename T3, typename T4,
          typename T5, typename T6,
@@ -321,10 +550,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (void) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)();
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, T1 (), T2 (), T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback ();
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -334,10 +570,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, T2 (), T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -347,10 +590,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, T3 (), T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -360,10 +610,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, T4 (), T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -373,10 +630,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, T5 (), T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -386,10 +650,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, T6 (), T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -399,10 +670,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, T7 (), T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -412,10 +690,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, a7, T8 ());
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6, a7);
+        }
     }
 }
 template<typename T1, typename T2, 
@@ -425,10 +710,17 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7, a8);
+      const Entry &entry = m_callbackList[i];
+      if (entry.invoke != 0)
+        {
+          entry.invoke (entry.sink, a1, a2, a3, a4, a5, a6, a7, a8);
+        }
+      else
+        {
+          entry.callback (a1, a2, a3, a4, a5, a6, a7, a8);
+        }
     }
 }
 
@@ -27,6 +27,7 @@
 #include "ns3/singleton.h"
 #include "ns3/object.h"
 #include "ns3/object-vector.h"
+#include "ns3/object-map.h"
 #include "ns3/names.h"
 #include "ns3/pointer.h"
 #include "ns3/log.h"
@@ -821,6 +822,188 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * An object holding a map of objects, whose keys are not their positions.
+ */
+class ConfigMapTestObject : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Add a node to the map
+   * \param key the key of the node
+   * \param node the node
+   */
+  void AddNode (uint32_t key, Ptr<ConfigTestObject> node);
+
+private:
+  std::map<uint32_t, Ptr<ConfigTestObject> > m_nodes; //!< Nodes attribute target.
+};
+
+TypeId
+ConfigMapTestObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ConfigMapTestObject")
+    .SetParent<Object> ()
+    .AddAttribute ("Nodes", "",
+                   ObjectMapValue (),
+                   MakeObjectMapAccessor (&ConfigMapTestObject::m_nodes),
+                   MakeObjectMapChecker<ConfigTestObject> ())
+  ;
+  return tid;
+}
+
+void
+ConfigMapTestObject::AddNode (uint32_t key, Ptr<ConfigTestObject> node)
+{
+  m_nodes[key] = node;
+}
+
+/**
+ * \ingroup config-tests
+ * Test for the resolution of compiled paths, which must match the
+ * same objects as the equivalent path strings.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CompiledPathConfigTestCase ();
+  /** Destructor. */
+  virtual ~CompiledPathConfigTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check that a compiled path and a path string match the same objects
+   * \param path the path
+   * \param expected the expected number of matches
+   */
+  void CheckLookup (std::string path, uint32_t expected);
+
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace (int16_t oldValue, int16_t newValue)
+  {
+    m_newValue = newValue;
+  }
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase ()
+  : TestCase ("Check that compiled paths match the same objects as path strings")
+{
+}
+
+void
+CompiledPathConfigTestCase::CheckLookup (std::string path, uint32_t expected)
+{
+  Config::MatchContainer fromString = Config::LookupMatches (path);
+  Config::MatchContainer fromCompiled = Config::LookupMatches (Config::CompiledPath (path));
+  NS_TEST_ASSERT_MSG_EQ (fromString.GetN (), expected, "Unexpected number of matches for " << path);
+  NS_TEST_ASSERT_MSG_EQ (fromCompiled.GetN (), expected, "Unexpected number of matches for compiled " << path);
+  NS_TEST_EXPECT_MSG_EQ (fromCompiled.GetPath (), fromString.GetPath (), "Unexpected path");
+  for (uint32_t i = 0; i < expected; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (fromCompiled.Get (i), fromString.Get (i), "Unexpected match for " << path);
+      NS_TEST_EXPECT_MSG_EQ (fromCompiled.GetMatchedPath (i), fromString.GetMatchedPath (i),
+                             "Unexpected context for " << path);
+    }
+}
+
+void
+CompiledPathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  //
+  // Create a root namespace object with a vector of four objects and
+  // a map of three objects aggregated to the object under the root.
+  // The other test cases use NodeA, hence NodeB is used here to not
+  // match the objects of their root namespace objects.
+  //
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeB (a);
+
+  std::vector<Ptr<ConfigTestObject> > nodes;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      nodes.push_back (CreateObject<ConfigTestObject> ());
+      a->AddNodeB (nodes[i]);
+    }
+  Ptr<ConfigMapTestObject> map = CreateObject<ConfigMapTestObject> ();
+  a->AggregateObject (map);
+  Ptr<ConfigTestObject> key2 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> key5 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> key7 = CreateObject<ConfigTestObject> ();
+  map->AddNode (7, key7);
+  map->AddNode (2, key2);
+  map->AddNode (5, key5);
+
+  CheckLookup ("/NodeB/NodesB/*", 4);
+  CheckLookup ("/NodeB/NodesB/2", 1);
+  CheckLookup ("/NodeB/NodesB/3|1", 2);
+  CheckLookup ("/NodeB/NodesB/[2-9]", 2);
+  CheckLookup ("/NodeB/NodesB/4", 0);
+  CheckLookup ("/NodeB/$ConfigMapTestObject/Nodes/*", 3);
+  CheckLookup ("/NodeB/$ConfigMapTestObject/Nodes/5", 1);
+  CheckLookup ("/NodeB/$ConfigMapTestObject/Nodes/0|7", 1);
+  CheckLookup ("/NodeB/$ConfigMapTestObject/Nodes/[1-2]", 1);
+  CheckLookup ("/NodeB/$ConfigMapTestObject/Nodes/1", 0);
+  CheckLookup ("/NodeB/*/*", 4);
+
+  //
+  // Use the same compiled path several times, and through copies
+  //
+  Config::CompiledPath path ("/NodeB/NodesB/[1-2]|7/A");
+  Config::Set (path, IntegerValue (-3));
+  Config::CompiledPath copy (path);
+  Config::CompiledPath assigned;
+  assigned = copy;
+  NS_TEST_EXPECT_MSG_EQ (assigned.GetPath (), "/NodeB/NodesB/[1-2]|7/A", "Unexpected path");
+  NS_TEST_EXPECT_MSG_EQ (assigned.GetLeaf (), "A", "Unexpected leaf");
+  Config::Set (assigned, IntegerValue (-4));
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      nodes[i]->GetAttribute ("A", iv);
+      NS_TEST_EXPECT_MSG_EQ (iv.Get (), (i == 1 || i == 2 ? -4 : 10), "Object Attribute \"A\" not set as expected");
+    }
+
+  Config::Set (Config::CompiledPath ("/NodeB/$ConfigMapTestObject/Nodes/5/A"), IntegerValue (-5));
+  key5->GetAttribute ("A", iv);
+  NS_TEST_EXPECT_MSG_EQ (iv.Get (), -5, "Object Attribute \"A\" not set as expected");
+  key2->GetAttribute ("A", iv);
+  NS_TEST_EXPECT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set");
+
+  //
+  // Connect and disconnect with the same compiled path
+  //
+  Config::CompiledPath source ("/NodeB/$ConfigMapTestObject/Nodes/7/Source");
+  Config::ConnectWithoutContext (source, MakeCallback (&CompiledPathConfigTestCase::Trace, this));
+  m_newValue = 0;
+  key7->SetAttribute ("Source", IntegerValue (-6));
+  NS_TEST_EXPECT_MSG_EQ (m_newValue, -6, "Trace did not fire as expected");
+  Config::DisconnectWithoutContext (source, MakeCallback (&CompiledPathConfigTestCase::Trace, this));
+  m_newValue = 0;
+  key7->SetAttribute ("Source", IntegerValue (-7));
+  NS_TEST_EXPECT_MSG_EQ (m_newValue, 0, "Trace unexpectedly fired");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -839,6 +1022,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new CompiledPathConfigTestCase);
 }
 
 /**
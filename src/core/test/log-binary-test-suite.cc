@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LogBinaryTestSuite");
+
+/**
+ * Check that the messages recorded in a binary log are printed back
+ * as the text logging would print them.
+ */
+class LogBinaryTestCase : public TestCase
+{
+public:
+  LogBinaryTestCase ();
+  virtual ~LogBinaryTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Log messages of all kinds.
+   * \param a An integer.
+   * \param s A string.
+   */
+  void LogAll (int a, std::string s);
+  /**
+   * Log a message with a value whose formatting logs too.
+   */
+  void LogNested (void);
+  /**
+   * Log many messages, to fill the buffer.
+   * \param n The number of messages.
+   */
+  void LogMany (uint32_t n);
+};
+
+/**
+ * A value which logs when it is formatted.
+ */
+struct LoggingValue
+{
+  int v;  //!< The value
+};
+
+/**
+ * Output operator.
+ * \param os The output stream.
+ * \param value The value.
+ * \returns The output stream.
+ */
+static std::ostream &
+operator << (std::ostream &os, const LoggingValue &value)
+{
+  NS_LOG_INFO ("formatting " << value.v);
+  return os << "value " << value.v;
+}
+
+LogBinaryTestCase::LogBinaryTestCase ()
+  : TestCase ("Check binary logging")
+{
+}
+
+void
+LogBinaryTestCase::LogAll (int a, std::string s)
+{
+  NS_LOG_FUNCTION (a << s << "text" << 'c');
+  NS_LOG_DEBUG ("a=" << a << " hex=" << std::hex << 255 << std::dec << " " << 2.5
+                << " " << true << " " << (uint64_t) 12345678901234ULL << std::endl);
+  NS_LOG_LOGIC ("time " << Seconds (1.5) << " null " << (Object *) 0);
+  NS_LOG_WARN ("warning " << (int16_t) -3);
+}
+
+void
+LogBinaryTestCase::LogNested (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  LoggingValue value = { 7 };
+  NS_LOG_INFO ("nested " << value);
+}
+
+void
+LogBinaryTestCase::LogMany (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      NS_LOG_LOGIC ("message " << i);
+    }
+}
+
+void
+LogBinaryTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("log-binary.blog");
+  // No simulation time and context before the simulator is created
+  Simulator::Destroy ();
+  LogComponentEnable ("LogBinaryTestSuite", LOG_LEVEL_ALL);
+  LogBinaryEnable (filename, 4096);
+  LogAll (-42, "str");
+  Simulator::ScheduleWithContext (3, Seconds (2), &LogBinaryTestCase::LogNested, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  LogMany (1000);
+  LogBinaryDisable ();
+  LogComponentDisable ("LogBinaryTestSuite", LOG_LEVEL_ALL);
+
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  std::ostringstream os;
+  NS_TEST_ASSERT_MSG_EQ (LogBinaryPrint (is, os), true, "Invalid binary log");
+
+  std::istringstream lines (os.str ());
+  std::string line;
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "LogBinaryTestSuite:LogAll(-42, \"str\", \"text\", c)",
+                         "Wrong function message");
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "LogBinaryTestSuite:LogAll(): [DEBUG] a=-42 hex=ff 2.5 1 12345678901234",
+                         "Wrong debug message");
+  std::getline (lines, line);
+  std::ostringstream time;
+  time << Seconds (1.5);
+  NS_TEST_ASSERT_MSG_EQ (line, "LogBinaryTestSuite:LogAll(): [LOGIC] time " + time.str () + " null 0",
+                         "Wrong logic message");
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "LogBinaryTestSuite:LogAll(): [WARN ] warning -3",
+                         "Wrong warning message");
+  // The message logged while formatting a value comes first
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "+2.000000000s 3 LogBinaryTestSuite:LogNested()",
+                         "Wrong function message without arguments");
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "+2.000000000s 3 LogBinaryTestSuite:operator<<(): [INFO ] formatting 7",
+                         "Wrong nested message");
+  std::getline (lines, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "+2.000000000s 3 LogBinaryTestSuite:LogNested(): [INFO ] nested value 7",
+                         "Wrong message with a formatted value");
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      std::ostringstream expected;
+      expected << "LogBinaryTestSuite:LogMany(): [LOGIC] message " << i;
+      std::getline (lines, line);
+      NS_TEST_ASSERT_MSG_EQ (line, expected.str (), "Wrong message " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (std::getline (lines, line).eof (), true, "Unexpected message");
+}
+
+/**
+ * The binary logging test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+public:
+  LogBinaryTestSuite ();
+};
+
+LogBinaryTestSuite::LogBinaryTestSuite ()
+  : TestSuite ("log-binary", UNIT)
+{
+#ifdef NS3_LOG_ENABLE
+  AddTestCase (new LogBinaryTestCase, TestCase::QUICK);
+#endif
+}
+
+static LogBinaryTestSuite logBinaryTestSuite;
@@ -398,6 +398,73 @@ AggregateObjectTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookup of aggregated Objects by TypeId, including the TypeIds
+ * of their parents, as the aggregation changes.
+ */
+class GetObjectByTypeIdTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  GetObjectByTypeIdTestCase ();
+  /** Destructor. */
+  virtual ~GetObjectByTypeIdTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectByTypeIdTestCase::GetObjectByTypeIdTestCase ()
+  : TestCase ("Check Object lookup by TypeId across aggregations")
+{
+}
+
+GetObjectByTypeIdTestCase::~GetObjectByTypeIdTestCase ()
+{
+}
+
+void
+GetObjectByTypeIdTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (DerivedA::GetTypeId ()), derivedA,
+                         "Cannot GetObject by TypeId for DerivedA");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseA::GetTypeId ()), derivedA,
+                         "Cannot GetObject by parent TypeId for DerivedA");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (Object::GetTypeId ()), derivedA,
+                         "Cannot GetObject by Object TypeId for DerivedA");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseB::GetTypeId ()), 0,
+                         "GetObject by TypeId of unrelated type returns nonzero pointer");
+
+  //
+  // The lookups above must not prevent to find the new aggregates
+  //
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<Object> (BaseA::GetTypeId ()), 0,
+                         "GetObject by TypeId of unrelated type returns nonzero pointer");
+  derivedA->AggregateObject (derivedB);
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseB::GetTypeId ()), derivedB,
+                         "Cannot GetObject by parent TypeId for aggregated DerivedB");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (DerivedB::GetTypeId ()), derivedB,
+                         "Cannot GetObject by TypeId for aggregated DerivedB");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<Object> (BaseA::GetTypeId ()), derivedA,
+                         "Cannot GetObject by parent TypeId for aggregated DerivedA");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<Object> (DerivedA::GetTypeId ()), derivedA,
+                         "Cannot GetObject by TypeId for aggregated DerivedA");
+
+  //
+  // Repeated lookups keep returning the same Objects
+  //
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<Object> (Object::GetTypeId ()), derivedA,
+                             "GetObject by Object TypeId does not return the first aggregate");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB,
+                             "Cannot GetObject for aggregated DerivedB");
+    }
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -489,6 +556,7 @@ ObjectTestSuite::ObjectTestSuite ()
 {
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
+  AddTestCase (new GetObjectByTypeIdTestCase);
   AddTestCase (new ObjectFactoryTestCase);
 }
 
@@ -18,6 +18,7 @@
 
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -108,6 +109,119 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class SinkTracedCallbackTestCase : public TestCase
+{
+public:
+  SinkTracedCallbackTestCase ();
+  virtual ~SinkTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  class Sink
+  {
+  public:
+    Sink (std::vector<int> *calls, int id);
+    void operator() (uint8_t a, double b);
+  private:
+    std::vector<int> *m_calls;
+    int m_id;
+  };
+
+  void CbOne (uint8_t a, double b);
+  void CbConnect (uint8_t a, double b);
+
+  std::vector<int> m_calls;
+  TracedCallback<uint8_t, double> m_trace;
+};
+
+SinkTracedCallbackTestCase::SinkTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback operation with sinks and reentrant connections")
+{
+}
+
+SinkTracedCallbackTestCase::Sink::Sink (std::vector<int> *calls, int id)
+  : m_calls (calls),
+    m_id (id)
+{
+}
+
+void
+SinkTracedCallbackTestCase::Sink::operator() (uint8_t a, double b)
+{
+  m_calls->push_back (m_id + a);
+}
+
+void
+SinkTracedCallbackTestCase::CbOne (uint8_t a, double b)
+{
+  m_calls.push_back (10 + a);
+}
+
+void
+SinkTracedCallbackTestCase::CbConnect (uint8_t a, double b)
+{
+  m_calls.push_back (30 + a);
+  // Grow the chain while it is being invoked
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      m_trace.ConnectWithoutContext (MakeCallback (&SinkTracedCallbackTestCase::CbOne, this));
+    }
+}
+
+void
+SinkTracedCallbackTestCase::DoRun (void)
+{
+  Sink sinkTwo (&m_calls, 20);
+  Sink sinkFour (&m_calls, 40);
+
+  //
+  // Sinks and Callbacks are invoked in the order they are connected
+  //
+  m_trace.ConnectSink (&sinkTwo);
+  m_trace.ConnectWithoutContext (MakeCallback (&SinkTracedCallbackTestCase::CbOne, this));
+  m_trace.ConnectSink (&sinkFour);
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 3, "Unexpected number of calls");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[0], 21, "Sink two not called first");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[1], 11, "Callback CbOne not called second");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[2], 41, "Sink four not called third");
+
+  //
+  // Disconnecting a sink leaves the other sink and the Callback connected
+  //
+  m_trace.DisconnectSink (&sinkTwo);
+  m_calls.clear ();
+  m_trace (2, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 2, "Unexpected number of calls");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[0], 12, "Callback CbOne not called first");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[1], 42, "Sink four not called second");
+
+  //
+  // Disconnecting a Callback does not disconnect the sinks
+  //
+  m_trace.DisconnectWithoutContext (MakeCallback (&SinkTracedCallbackTestCase::CbOne, this));
+  m_calls.clear ();
+  m_trace (3, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 1, "Unexpected number of calls");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[0], 43, "Sink four not called");
+  m_trace.DisconnectSink (&sinkFour);
+
+  //
+  // A Callback connecting other Callbacks while the chain is invoked:
+  // as with a list, the new Callbacks are invoked in the same round
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&SinkTracedCallbackTestCase::CbConnect, this));
+  m_calls.clear ();
+  m_trace (4, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 9, "Unexpected number of calls");
+  NS_TEST_ASSERT_MSG_EQ (m_calls[0], 34, "Callback CbConnect not called first");
+  for (uint32_t i = 1; i < m_calls.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_calls[i], 14, "Callback CbOne not called");
+    }
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -118,6 +232,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new SinkTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -30,6 +30,8 @@
 #include "ns3/names.h"
 
 #include "ns3/trace-helper.h"
+#include "ns3/binary-trace-writer.h"
+#include "ns3/node.h"
 #include "csma-helper.h"
 
 #include <string>
@@ -162,7 +164,20 @@ CsmaHelper::EnableAsciiInternal (
           filename = asciiTraceHelper.GetFilenameFromDevice (prefix, device);
         }
 
-      Ptr<OutputStreamWrapper> theStream = asciiTraceHelper.CreateFileStream (filename);
+      //
+      // Only the default trace sinks are hooked below, so the file may hold
+      // binary records rather than text.
+      //
+      Ptr<OutputStreamWrapper> theStream;
+      if (AsciiTraceHelper::IsBinaryFormat ())
+        {
+          theStream = asciiTraceHelper.CreateBinaryFileStream (filename);
+          theStream->GetBinaryTraceWriter ()->SetDevice (device->GetNode ()->GetId (), device->GetIfIndex ());
+        }
+      else
+        {
+          theStream = asciiTraceHelper.CreateFileStream (filename);
+        }
 
       //
       // The MacRx trace source provides our "r" event.
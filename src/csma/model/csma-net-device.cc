@@ -30,6 +30,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "csma-net-device.h"
 #include "csma-channel.h"
 #include "ns3/net-device-queue-interface.h"
@@ -558,7 +559,21 @@ CsmaNetDevice::TransmitStart (void)
           m_txMachineState = BUSY;
           m_phyTxBeginTrace (m_currentPkt);
 
-          Time tEvent = m_bps.CalculateBytesTxTime (m_currentPkt->GetSize ());
+          Time tEvent;
+          SegmentationOffloadTag tso;
+          if (m_currentPkt->PeekPacketTag (tso))
+            {
+              //
+              // A segmentation-offloaded packet holds the channel for the
+              // time needed to transmit the train of segments it stands for.
+              //
+              tEvent = m_bps.CalculateBytesTxTime (tso.GetSegmentedSize (m_currentPkt->GetSize ()))
+                + m_tInterframeGap * (tso.GetSegmentCount () - 1);
+            }
+          else
+            {
+              tEvent = m_bps.CalculateBytesTxTime (m_currentPkt->GetSize ());
+            }
           NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << tEvent.GetSeconds () << "sec");
           Simulator::Schedule (tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
@@ -749,7 +764,7 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
       return;
     }
 
-  if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (packet) )
+  if (m_receiveErrorModel && m_receiveErrorModel->IsCorruptSegmented (packet) )
     {
       NS_LOG_LOGIC ("Dropping pkt due to error model ");
       m_phyRxDropTrace (packet);
@@ -1084,6 +1099,17 @@ CsmaNetDevice::SupportsSendFrom () const
   return true;
 }
 
+bool
+CsmaNetDevice::SupportsSegmentationOffload () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  //
+  // In 802.3 mode the length field cannot describe frames larger than
+  // the MTU, hence only DIX encapsulation can carry super-segments.
+  //
+  return m_encapMode == DIX;
+}
+
 int64_t
 CsmaNetDevice::AssignStreams (int64_t stream)
 {
@@ -328,6 +328,15 @@ public:
   virtual void SetPromiscReceiveCallback (PromiscReceiveCallback cb);
   virtual bool SupportsSendFrom (void) const;
 
+  /**
+   * \brief Check whether this device can transmit segmentation-offloaded packets
+   *
+   * Only devices using DIX encapsulation support segmentation offload.
+   *
+   * \return true if the device supports segmentation offload, false otherwise.
+   */
+  virtual bool SupportsSegmentationOffload (void) const;
+
  /**
   * Assign a fixed random variable stream number to the random variables
   * used by this model.  Return the number of streams (possibly zero) that
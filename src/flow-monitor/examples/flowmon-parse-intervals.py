@@ -0,0 +1,62 @@
+from __future__ import division
+from __future__ import print_function
+import sys
+import struct
+
+## Reads the interval reports written by FlowMonitor::EnableIntervalReports
+## and prints them as comma separated values, one line per flow and interval.
+
+## the record of a flow: flowId, txPackets, rxPackets, lostPackets,
+## droppedPackets, timesForwarded, txBytes, rxBytes, droppedBytes,
+## delaySum (ns), jitterSum (ns)
+FLOW_RECORD = struct.Struct('<6I3Q2q')
+## the header of a report: time (ns), number of flows
+REPORT_HEADER = struct.Struct('<qI')
+## the header of the file: magic, interval (ns)
+FILE_HEADER = struct.Struct('<8sq')
+MAGIC = b'NS3FMON1'
+
+
+## Read the interval reports of a file
+# @param f the file
+# @return the interval, in nanoseconds, and a generator of (time, records) tuples
+def read_reports(f):
+    magic, interval = FILE_HEADER.unpack(f.read(FILE_HEADER.size))
+    if magic != MAGIC:
+        raise ValueError("not a FlowMonitor interval report file")
+    def reports():
+        while True:
+            data = f.read(REPORT_HEADER.size)
+            if len(data) < REPORT_HEADER.size:
+                return
+            time, n_flows = REPORT_HEADER.unpack(data)
+            data = f.read(n_flows * FLOW_RECORD.size)
+            records = [FLOW_RECORD.unpack_from(data, i * FLOW_RECORD.size) for i in range(n_flows)]
+            yield time, records
+    return interval, reports()
+
+
+def main(argv):
+    if len(argv) != 2:
+        print("usage: %s <interval report file>" % argv[0], file=sys.stderr)
+        return 1
+    with open(argv[1], 'rb') as f:
+        interval, reports = read_reports(f)
+        print("time,flowId,txPackets,rxPackets,lostPackets,droppedPackets,timesForwarded,"
+              "txBytes,rxBytes,droppedBytes,rxBitrate,meanDelay")
+        previous = 0
+        for time, records in reports:
+            duration = (time - previous) * 1e-9
+            previous = time
+            for (flow_id, tx_packets, rx_packets, lost_packets, dropped_packets, times_forwarded,
+                 tx_bytes, rx_bytes, dropped_bytes, delay_sum, jitter_sum) in records:
+                bitrate = rx_bytes * 8 / duration if duration > 0 else 0
+                delay = delay_sum * 1e-9 / rx_packets if rx_packets else 0
+                print("%.9f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.1f,%.9f"
+                      % (time * 1e-9, flow_id, tx_packets, rx_packets, lost_packets, dropped_packets,
+                         times_forwarded, tx_bytes, rx_bytes, dropped_bytes, bitrate, delay))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -24,6 +24,7 @@
 #include "ns3/double.h"
 #include <fstream>
 #include <sstream>
+#include <iterator>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
 
@@ -79,6 +80,24 @@ FlowMonitor::GetInstanceTypeId (void) const
   return GetTypeId ();
 }
 
+FlowMonitor::ReportedCounters::ReportedCounters ()
+  : txBytes (0),
+    rxBytes (0),
+    droppedBytes (0),
+    txPackets (0),
+    rxPackets (0),
+    lostPackets (0),
+    droppedPackets (0),
+    timesForwarded (0)
+{
+}
+
+FlowMonitor::TrackedFlow::TrackedFlow ()
+  : stats (0),
+    nTracked (0)
+{
+}
+
 FlowMonitor::FlowMonitor ()
   : m_enabled (false)
 {
@@ -99,15 +118,30 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_reportEvent.Cancel ();
+  m_finalReportEvent.Cancel ();
+  if (m_intervalFile.is_open ())
+    {
+      m_intervalFile.close ();
+    }
   Object::DoDispose ();
 }
 
+inline FlowMonitor::TrackedFlow&
+FlowMonitor::GetTrackedFlow (FlowId flowId)
+{
+  if (flowId >= m_trackedFlows.size ())
+    {
+      m_trackedFlows.resize (flowId + 1);
+    }
+  return m_trackedFlows[flowId];
+}
+
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
-  FlowStatsContainerI iter;
-  iter = m_flowStats.find (flowId);
-  if (iter == m_flowStats.end ())
+  TrackedFlow &flow = GetTrackedFlow (flowId);
+  if (flow.stats == 0)
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
       ref.delaySum = Seconds (0);
@@ -123,11 +157,61 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
-      return ref;
+      flow.stats = &ref;
     }
-  else
+  return *flow.stats;
+}
+
+bool
+FlowMonitor::FindTrackedPacket (const TrackedFlow &flow, FlowPacketId packetId, std::size_t *index)
+{
+  std::size_t n = flow.packets.size ();
+  *index = 0;
+  if (n == 0)
+    {
+      return false;
+    }
+  // the differences between packet identifiers are computed modulo 2^32
+  FlowPacketId first = flow.packets[0].packetId;
+  uint32_t offset = packetId - first;
+  if (offset >= 0x80000000)
+    {
+      // the packet precedes the first packet
+      return false;
+    }
+  if (offset < n && flow.packets[offset].packetId == packetId)
+    {
+      *index = offset;
+      return true;
+    }
+  // some packet identifiers were not reported (e.g., while the monitor
+  // was stopped): binary search
+  std::size_t low = 0;
+  std::size_t high = n;
+  while (low < high)
+    {
+      std::size_t middle = (low + high) / 2;
+      if ((uint32_t)(flow.packets[middle].packetId - first) < offset)
+        {
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle;
+        }
+    }
+  *index = low;
+  return (low < n && flow.packets[low].packetId == packetId);
+}
+
+void
+FlowMonitor::UntrackPacket (TrackedFlow &flow, std::size_t index)
+{
+  flow.packets[index].tracked = false;
+  flow.nTracked--;
+  while (!flow.packets.empty () && !flow.packets.front ().tracked)
     {
-      return iter->second;
+      flow.packets.pop_front ();
     }
 }
 
@@ -140,7 +224,31 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  TrackedFlow &flow = GetTrackedFlow (flowId);
+  std::size_t index;
+  if (!FindTrackedPacket (flow, packetId, &index))
+    {
+      TrackedPacket packet;
+      packet.packetId = packetId;
+      packet.tracked = false;
+      if (index == flow.packets.size ())
+        {
+          flow.packets.push_back (packet);
+        }
+      else
+        {
+          // not reported in sequence
+          RingBuffer<TrackedPacket>::ConstIterator pos = flow.packets.begin ();
+          std::advance (pos, index);
+          flow.packets.insert (pos, packet);
+        }
+    }
+  TrackedPacket &tracked = flow.packets[index];
+  if (!tracked.tracked)
+    {
+      tracked.tracked = true;
+      flow.nTracked++;
+    }
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
@@ -167,19 +275,20 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
     {
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
-  if (tracked == m_trackedPackets.end ())
+  TrackedFlow &flow = GetTrackedFlow (flowId);
+  std::size_t index;
+  if (!FindTrackedPacket (flow, packetId, &index) || !flow.packets[index].tracked)
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
       return;
     }
 
-  tracked->second.timesForwarded++;
-  tracked->second.lastSeenTime = Simulator::Now ();
+  TrackedPacket &tracked = flow.packets[index];
+  tracked.timesForwarded++;
+  tracked.lastSeenTime = Simulator::Now ();
 
-  Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
+  Time delay = (Simulator::Now () - tracked.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 }
 
@@ -191,8 +300,9 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked == m_trackedPackets.end ())
+  TrackedFlow &flow = GetTrackedFlow (flowId);
+  std::size_t index;
+  if (!FindTrackedPacket (flow, packetId, &index) || !flow.packets[index].tracked)
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
@@ -200,7 +310,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     }
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
+  Time delay = (now - flow.packets[index].firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
   FlowStats &stats = GetStatsForFlow (flowId);
@@ -239,12 +349,12 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
+  stats.timesForwarded += flow.packets[index].timesForwarded;
 
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  UntrackPacket (flow, index); // we don't need to track this packet anymore
 }
 
 void
@@ -269,14 +379,15 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked != m_trackedPackets.end ())
+  TrackedFlow &flow = GetTrackedFlow (flowId);
+  std::size_t index;
+  if (FindTrackedPacket (flow, packetId, &index) && flow.packets[index].tracked)
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      UntrackPacket (flow, index);
     }
 }
 
@@ -292,22 +403,40 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  for (std::vector<TrackedFlow>::iterator flow = m_trackedFlows.begin ();
+       flow != m_trackedFlows.end (); flow++)
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      for (std::size_t i = 0; i < flow->packets.size (); i++)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          TrackedPacket &tracked = flow->packets[i];
+          if (tracked.tracked && now - tracked.lastSeenTime >= maxDelay)
+            {
+              // packet is considered lost, add it to the loss statistics
+              NS_ASSERT (flow->stats != 0);
+              flow->stats->lostPackets++;
+
+              // we won't track it anymore
+              tracked.tracked = false;
+              flow->nTracked--;
+            }
         }
-      else
+      if (flow->packets.size () > 2 * flow->nTracked)
+        {
+          // release the packets which are not tracked anymore, so that
+          // the memory used by a flow is bounded by its tracked packets
+          RingBuffer<TrackedPacket> packets;
+          for (std::size_t i = 0; i < flow->packets.size (); i++)
+            {
+              if (flow->packets[i].tracked)
+                {
+                  packets.push_back (flow->packets[i]);
+                }
+            }
+          std::swap (flow->packets, packets);
+        }
+      while (!flow->packets.empty () && !flow->packets.front ().tracked)
         {
-          iter++;
+          flow->packets.pop_front ();
         }
     }
 }
@@ -500,5 +629,124 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
 }
 
 
-} // namespace ns3
+namespace {
+
+/**
+ * Append an integer to a buffer, in little endian order
+ * \param buffer the buffer
+ * \param value the integer
+ * \param size the size of the integer, in bytes
+ */
+void
+AppendLittleEndian (std::string &buffer, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+    {
+      buffer.push_back (static_cast<char> ((value >> (8 * i)) & 0xff));
+    }
+}
+
+} // unnamed namespace
+
+void
+FlowMonitor::EnableIntervalReports (std::string fileName, Time interval)
+{
+  NS_LOG_FUNCTION (this << fileName << interval);
+  NS_ASSERT_MSG (interval.IsStrictlyPositive (), "The report interval must be positive");
+  NS_ASSERT_MSG (!m_intervalFile.is_open (), "Interval reports are already enabled");
+  m_intervalFile.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_intervalFile.is_open ())
+    {
+      NS_FATAL_ERROR ("Can not open interval report file " << fileName);
+    }
+  m_reportInterval = interval;
+
+  std::string header ("NS3FMON1");
+  AppendLittleEndian (header, interval.GetNanoSeconds (), 8);
+  m_intervalFile.write (header.data (), header.size ());
+  m_reportEvent = Simulator::Schedule (interval, &FlowMonitor::PeriodicIntervalReport, this);
+  m_finalReportEvent = Simulator::ScheduleDestroy (&FlowMonitor::FinalIntervalReport, this);
+}
+
+void
+FlowMonitor::PeriodicIntervalReport ()
+{
+  WriteIntervalReport ();
+  m_reportEvent = Simulator::Schedule (m_reportInterval, &FlowMonitor::PeriodicIntervalReport, this);
+}
 
+void
+FlowMonitor::FinalIntervalReport ()
+{
+  NS_LOG_FUNCTION (this);
+  m_reportEvent.Cancel ();
+  WriteIntervalReport ();
+  m_intervalFile.close ();
+}
+
+void
+FlowMonitor::WriteIntervalReport ()
+{
+  NS_LOG_FUNCTION (this);
+  CheckForLostPackets ();
+
+  std::string records;
+  uint32_t nFlows = 0;
+  for (FlowId flowId = 0; flowId < m_trackedFlows.size (); flowId++)
+    {
+      TrackedFlow &flow = m_trackedFlows[flowId];
+      if (flow.stats == 0)
+        {
+          continue;
+        }
+      const FlowStats &stats = *flow.stats;
+      ReportedCounters &reported = flow.reported;
+      uint64_t droppedBytes = 0;
+      uint32_t droppedPackets = 0;
+      for (uint32_t reason = 0; reason < stats.bytesDropped.size (); reason++)
+        {
+          droppedBytes += stats.bytesDropped[reason];
+          droppedPackets += stats.packetsDropped[reason];
+        }
+      if (stats.txPackets == reported.txPackets
+          && stats.rxPackets == reported.rxPackets
+          && stats.lostPackets == reported.lostPackets
+          && droppedPackets == reported.droppedPackets
+          && stats.timesForwarded == reported.timesForwarded)
+        {
+          continue;
+        }
+
+      AppendLittleEndian (records, flowId, 4);
+      AppendLittleEndian (records, stats.txPackets - reported.txPackets, 4);
+      AppendLittleEndian (records, stats.rxPackets - reported.rxPackets, 4);
+      AppendLittleEndian (records, stats.lostPackets - reported.lostPackets, 4);
+      AppendLittleEndian (records, droppedPackets - reported.droppedPackets, 4);
+      AppendLittleEndian (records, stats.timesForwarded - reported.timesForwarded, 4);
+      AppendLittleEndian (records, stats.txBytes - reported.txBytes, 8);
+      AppendLittleEndian (records, stats.rxBytes - reported.rxBytes, 8);
+      AppendLittleEndian (records, droppedBytes - reported.droppedBytes, 8);
+      AppendLittleEndian (records, (stats.delaySum - reported.delaySum).GetNanoSeconds (), 8);
+      AppendLittleEndian (records, (stats.jitterSum - reported.jitterSum).GetNanoSeconds (), 8);
+      nFlows++;
+
+      reported.delaySum = stats.delaySum;
+      reported.jitterSum = stats.jitterSum;
+      reported.txBytes = stats.txBytes;
+      reported.rxBytes = stats.rxBytes;
+      reported.droppedBytes = droppedBytes;
+      reported.txPackets = stats.txPackets;
+      reported.rxPackets = stats.rxPackets;
+      reported.lostPackets = stats.lostPackets;
+      reported.droppedPackets = droppedPackets;
+      reported.timesForwarded = stats.timesForwarded;
+    }
+
+  std::string header;
+  AppendLittleEndian (header, Simulator::Now ().GetNanoSeconds (), 8);
+  AppendLittleEndian (header, nFlows, 4);
+  m_intervalFile.write (header.data (), header.size ());
+  m_intervalFile.write (records.data (), records.size ());
+}
+
+} // namespace ns3
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -31,6 +32,7 @@
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
+#include "ns3/ring-buffer.h"
 
 namespace ns3 {
 
@@ -256,6 +258,31 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// \brief Write the flow statistics of each interval to a binary file
+  ///
+  /// Every \p interval, and when the simulator is destroyed, a report
+  /// is appended to the file. No final report is written if the
+  /// FlowMonitor is disposed before Simulator::Destroy is called. The
+  /// report holds, for each flow active during the interval, the
+  /// variation of its counters since the previous report: transmitted,
+  /// received, lost and dropped packets, transmitted, received and
+  /// dropped bytes, times forwarded, and sum of the delays and jitters.
+  /// The statistics returned by GetFlowStats are not affected. The file
+  /// can be read with the flowmon-parse-intervals.py script of the
+  /// flow-monitor examples.
+  ///
+  /// The file starts with the magic string "NS3FMON1" and the interval
+  /// (int64, in nanoseconds). Each report is made of the time of the
+  /// report (int64, in nanoseconds) and of the number of flows (uint32),
+  /// followed by a record per flow: flowId, txPackets, rxPackets,
+  /// lostPackets, droppedPackets and timesForwarded (uint32), txBytes,
+  /// rxBytes and droppedBytes (uint64), delaySum and jitterSum (int64, in
+  /// nanoseconds). All the values are little endian.
+  ///
+  /// \param fileName name or path of the output file that will be created
+  /// \param interval the interval between two reports
+  void EnableIntervalReports (std::string fileName, Time interval);
+
 
 protected:
 
@@ -267,17 +294,48 @@ private:
   /// Structure to represent a single tracked packet data
   struct TrackedPacket
   {
+    FlowPacketId packetId; //!< the packet identifier
+    bool tracked; //!< false once the packet has been received, dropped or considered lost
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
   };
 
+  /// The counters of a flow at the time of the last interval report
+  struct ReportedCounters
+  {
+    ReportedCounters ();
+    Time delaySum; //!< Sum of the delays
+    Time jitterSum; //!< Sum of the jitters
+    uint64_t txBytes; //!< Transmitted bytes
+    uint64_t rxBytes; //!< Received bytes
+    uint64_t droppedBytes; //!< Dropped bytes
+    uint32_t txPackets; //!< Transmitted packets
+    uint32_t rxPackets; //!< Received packets
+    uint32_t lostPackets; //!< Lost packets
+    uint32_t droppedPackets; //!< Dropped packets
+    uint32_t timesForwarded; //!< Number of forwardings
+  };
+
+  /// Structure to represent the tracked packets of a flow
+  struct TrackedFlow
+  {
+    TrackedFlow ();
+    FlowStats *stats; //!< the stats of the flow (0 until the first report)
+    /// The packets, sorted by packet identifier. Since a flow assigns its
+    /// packet identifiers in sequence, the position of a packet is usually
+    /// its identifier minus the identifier of the first packet. Untracked
+    /// packets are removed from the head, or by CheckForLostPackets.
+    RingBuffer<TrackedPacket> packets;
+    uint32_t nTracked; //!< the number of tracked packets in the buffer
+    ReportedCounters reported; //!< the counters of the flow in the last interval report
+  };
+
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
 
-  /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-  TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /// FlowId --> TrackedFlow
+  std::vector<TrackedFlow> m_trackedFlows;
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -298,8 +356,40 @@ private:
   /// \returns the stats of the flow
   FlowStats& GetStatsForFlow (FlowId flowId);
 
+  /// Get the tracked packets of a given flow
+  /// \param flowId the Flow identification
+  /// \returns the tracked packets of the flow
+  TrackedFlow& GetTrackedFlow (FlowId flowId);
+
+  /// Search for a packet of a flow
+  /// \param flow the tracked packets of the flow
+  /// \param packetId the packet identifier
+  /// \param index the position of the packet, or the position where it
+  ///        should be inserted if it is not found
+  /// \returns true if the packet is in the buffer (tracked or not)
+  static bool FindTrackedPacket (const TrackedFlow &flow, FlowPacketId packetId, std::size_t *index);
+
+  /// Stop tracking a packet
+  /// \param flow the tracked packets of the flow
+  /// \param index the position of the packet
+  static void UntrackPacket (TrackedFlow &flow, std::size_t index);
+
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Append an interval report to the interval report file
+  void WriteIntervalReport ();
+
+  /// Periodic function to write the interval reports
+  void PeriodicIntervalReport ();
+
+  /// Write the last interval report and close the file, when the simulator is destroyed
+  void FinalIntervalReport ();
+
+  std::ofstream m_intervalFile; //!< The interval report file
+  Time m_reportInterval; //!< The interval between two reports
+  EventId m_reportEvent; //!< Next interval report event
+  EventId m_finalReportEvent; //!< Last interval report event, run by Simulator::Destroy
 };
 
 
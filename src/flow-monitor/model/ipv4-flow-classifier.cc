@@ -96,6 +96,17 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 
 
 
+std::size_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &tuple) const
+{
+  const uint64_t k = 0x9e3779b97f4a7c15ULL;
+  uint64_t h = Ipv4AddressHash () (tuple.sourceAddress);
+  h = h * k + Ipv4AddressHash () (tuple.destinationAddress);
+  h = h * k + ((uint64_t (tuple.protocol) << 32) | (uint32_t (tuple.sourcePort) << 16) | tuple.destinationPort);
+  return h ^ (h >> 32);
+}
+
+
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
 }
@@ -148,35 +159,46 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
+  std::pair<std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
+  FlowState *flow;
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
+      NS_ASSERT (newFlowId == m_flows.size () + 1);
       insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      m_flows.push_back (FlowState ());
+      flow = &m_flows.back ();
+      flow->tuple = tuple;
+      flow->lastPacketId = 0;
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      flow = &m_flows[insert.first->second - 1];
+      flow->lastPacketId++;
     }
 
-  // increment the counter of packets with the same DSCP value
+  // increment the counter of packets with the same DSCP value (a flow
+  // rarely uses more than one or two DSCP values)
   Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
+  std::vector<DscpCount>::iterator dscpCount = flow->dscpCounts.begin ();
+  while (dscpCount != flow->dscpCounts.end () && dscpCount->first != dscp)
+    {
+      dscpCount++;
+    }
+  if (dscpCount == flow->dscpCounts.end ())
+    {
+      flow->dscpCounts.push_back (DscpCount (dscp, 1));
+    }
+  else
     {
-      m_flowDscpMap[insert.first->second][dscp] ++;
+      dscpCount->second++;
     }
 
   *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_packetId = flow->lastPacketId;
 
   return true;
 }
@@ -185,17 +207,11 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
-  return retval;
+  return m_flows[flowId - 1].tuple;
 }
 
 bool
@@ -208,15 +224,14 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  // sort by DSCP value first, as done by the map formerly used to count them
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (m_flows[flowId - 1].dscpCounts);
+  std::sort (v.begin (), v.end ());
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -226,9 +241,18 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
 {
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
+  // the flows are listed in FiveTuple order
+  std::vector<std::pair<FiveTuple, FlowId> > flows;
+  flows.reserve (m_flows.size ());
+  for (uint32_t i = 0; i < m_flows.size (); i++)
+    {
+      flows.push_back (std::make_pair (m_flows[i].tuple, i + 1));
+    }
+  std::sort (flows.begin (), flows.end ());
+
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::vector<std::pair<FiveTuple, FlowId> >::const_iterator
+       iter = flows.begin (); iter != flows.end (); iter++)
     {
       Indent (os, indent);
       os << "<Flow flowId=\"" << iter->second << "\""
@@ -239,17 +263,13 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
          << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      std::vector<DscpCount> dscpCounts (m_flows[iter->second - 1].dscpCounts);
+      std::sort (dscpCounts.begin (), dscpCounts.end ());
+      for (std::vector<DscpCount>::const_iterator i = dscpCounts.begin (); i != dscpCounts.end (); i++)
         {
-          for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
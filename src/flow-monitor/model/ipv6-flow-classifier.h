@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "ns3/ipv6-header.h"
 #include "ns3/flow-classifier.h"
@@ -50,6 +52,14 @@ public:
     uint16_t destinationPort;       //!< Destination port
   };
 
+  /// Hash function for FiveTuple
+  struct FiveTupleHash
+  {
+    /// \param tuple the FiveTuple
+    /// \returns the hash of the FiveTuple
+    std::size_t operator() (const FiveTuple &tuple) const;
+  };
+
   Ipv6FlowClassifier ();
 
   /// \brief try to classify the packet into flow-id and packet-id
@@ -93,12 +103,22 @@ public:
 
 private:
 
-  /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> > m_flowDscpMap;
+  /// A (DSCP value, packet count) pair
+  typedef std::pair<Ipv6Header::DscpType, uint32_t> DscpCount;
+
+  /// State of a flow
+  struct FlowState
+  {
+    FiveTuple tuple;                     //!< The FiveTuple of the flow
+    FlowPacketId lastPacketId;           //!< The identifier of the last packet
+    std::vector<DscpCount> dscpCounts;   //!< The packet counts of the DSCP values seen
+  };
+
+  /// Map FiveTuples to FlowIds
+  std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// The state of the flows, indexed by FlowId - 1 (FlowIds are assigned
+  /// in sequence by this classifier)
+  std::vector<FlowState> m_flows;
 
 };
 
@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Ipv4FlowClassifier Test: flow and packet identifiers, DSCP counts
+ */
+class Ipv4FlowClassifierTestCase : public TestCase
+{
+public:
+  Ipv4FlowClassifierTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4FlowClassifierTestCase::Ipv4FlowClassifierTestCase ()
+  : TestCase ("Ipv4FlowClassifier")
+{
+}
+
+void
+Ipv4FlowClassifierTestCase::DoRun (void)
+{
+  Ipv4FlowClassifier classifier;
+  uint8_t ports[4] = { 0x04, 0xd2, 0x00, 0x50 }; // 1234 -> 80
+  Ptr<Packet> payload = Create<Packet> (ports, 4);
+
+  const uint32_t nFlows = 1000;
+  for (uint32_t round = 0; round < 3; round++)
+    {
+      for (uint32_t i = 0; i < nFlows; i++)
+        {
+          Ipv4Header header;
+          header.SetSource (Ipv4Address (0x0a000000 + i));
+          header.SetDestination (Ipv4Address ("10.1.0.1"));
+          header.SetProtocol (17);
+          header.SetDscp (round == 2 && i % 2 ? Ipv4Header::DSCP_EF : Ipv4Header::DscpDefault);
+          uint32_t flowId;
+          uint32_t packetId;
+          bool classified = classifier.Classify (header, payload, &flowId, &packetId);
+          NS_TEST_ASSERT_MSG_EQ (classified, true, "UDP packet not classified");
+          NS_TEST_ASSERT_MSG_EQ (flowId, i + 1, "Unexpected flow identifier");
+          NS_TEST_ASSERT_MSG_EQ (packetId, round, "Unexpected packet identifier");
+        }
+    }
+
+  Ipv4FlowClassifier::FiveTuple tuple = classifier.FindFlow (8);
+  NS_TEST_EXPECT_MSG_EQ (tuple.sourceAddress, Ipv4Address ("10.0.0.7"), "Unexpected source address");
+  NS_TEST_EXPECT_MSG_EQ (tuple.sourcePort, 1234, "Unexpected source port");
+  NS_TEST_EXPECT_MSG_EQ (tuple.destinationPort, 80, "Unexpected destination port");
+
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > dscp = classifier.GetDscpCounts (8);
+  NS_TEST_ASSERT_MSG_EQ (dscp.size (), 2, "Unexpected number of DSCP values");
+  NS_TEST_EXPECT_MSG_EQ (dscp[0].first, Ipv4Header::DscpDefault, "The most used DSCP value should come first");
+  NS_TEST_EXPECT_MSG_EQ (dscp[0].second, 2, "Unexpected packet count");
+  NS_TEST_EXPECT_MSG_EQ (dscp[1].first, Ipv4Header::DSCP_EF, "Unexpected DSCP value");
+  NS_TEST_EXPECT_MSG_EQ (dscp[1].second, 1, "Unexpected packet count");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief A FlowProbe which only reports to the FlowMonitor
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor Test: packets received out of order, dropped, lost,
+ * and packet identifiers not reported in sequence
+ */
+class FlowMonitorTrackingTestCase : public TestCase
+{
+public:
+  FlowMonitorTrackingTestCase ();
+  virtual void DoRun (void);
+};
+
+FlowMonitorTrackingTestCase::FlowMonitorTrackingTestCase ()
+  : TestCase ("FlowMonitor packet tracking")
+{
+}
+
+void
+FlowMonitorTrackingTestCase::DoRun (void)
+{
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+
+  // flow 1: 100 packets forwarded once; packet 50 is dropped, the even
+  // packets are received, then the odd ones in reverse order, except 99
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      monitor->ReportFirstTx (probe, 1, i, 100);
+      monitor->ReportForwarding (probe, 1, i, 100);
+    }
+  monitor->ReportDrop (probe, 1, 50, 100, 0);
+  for (uint32_t i = 0; i < 100; i += 2)
+    {
+      monitor->ReportLastRx (probe, 1, i, 100);
+    }
+  for (uint32_t i = 97; i < 100; i -= 2)
+    {
+      monitor->ReportLastRx (probe, 1, i, 100);
+    }
+
+  // flow 2: packet identifiers with gaps, and not in sequence
+  monitor->ReportFirstTx (probe, 2, 10, 200);
+  monitor->ReportFirstTx (probe, 2, 20, 200);
+  monitor->ReportFirstTx (probe, 2, 15, 200);
+  monitor->ReportFirstTx (probe, 2, 5, 200);
+  monitor->ReportLastRx (probe, 2, 20, 200);
+  monitor->ReportLastRx (probe, 2, 12, 200); // unknown
+  monitor->ReportLastRx (probe, 2, 15, 200);
+  monitor->ReportLastRx (probe, 2, 5, 200);
+
+  monitor->CheckForLostPackets (Seconds (0));
+
+  const FlowMonitor::FlowStatsContainer &stats = monitor->GetFlowStats ();
+  FlowMonitor::FlowStatsContainerCI flow1 = stats.find (1);
+  NS_TEST_ASSERT_MSG_EQ ((flow1 != stats.end ()), true, "No stats for flow 1");
+  NS_TEST_EXPECT_MSG_EQ (flow1->second.txPackets, 100, "Unexpected number of transmitted packets");
+  NS_TEST_EXPECT_MSG_EQ (flow1->second.rxPackets, 98, "Unexpected number of received packets");
+  NS_TEST_EXPECT_MSG_EQ (flow1->second.lostPackets, 2, "Packets 50 (dropped) and 99 should be lost");
+  NS_TEST_EXPECT_MSG_EQ (flow1->second.timesForwarded, 98, "Unexpected number of forwardings");
+
+  FlowMonitor::FlowStatsContainerCI flow2 = stats.find (2);
+  NS_TEST_ASSERT_MSG_EQ ((flow2 != stats.end ()), true, "No stats for flow 2");
+  NS_TEST_EXPECT_MSG_EQ (flow2->second.txPackets, 4, "Unexpected number of transmitted packets");
+  NS_TEST_EXPECT_MSG_EQ (flow2->second.rxPackets, 3, "Unexpected number of received packets");
+  NS_TEST_EXPECT_MSG_EQ (flow2->second.lostPackets, 1, "Packet 10 should be lost");
+
+  // lost packets are not tracked anymore
+  monitor->ReportLastRx (probe, 1, 99, 100);
+  monitor->ReportLastRx (probe, 2, 10, 200);
+  NS_TEST_EXPECT_MSG_EQ (flow1->second.rxPackets, 98, "A lost packet should not be received");
+  NS_TEST_EXPECT_MSG_EQ (flow2->second.rxPackets, 3, "A lost packet should not be received");
+
+  monitor->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor Test: binary interval reports
+ */
+class FlowMonitorIntervalReportTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param useHelper whether the FlowMonitor is owned by a FlowMonitorHelper,
+   *        destroyed after the simulator, rather than by the test
+   */
+  FlowMonitorIntervalReportTestCase (bool useHelper);
+  virtual void DoRun (void);
+private:
+  /**
+   * Report the packets of the flows and run the simulation
+   * \param monitor the FlowMonitor
+   * \param fileName the name of the report file
+   */
+  static void RunReports (Ptr<FlowMonitor> monitor, std::string fileName);
+  /**
+   * Read a little endian integer from the report file
+   * \param is the report file
+   * \param size the size of the integer, in bytes
+   * \return the integer
+   */
+  static uint64_t Read (std::istream &is, uint32_t size);
+
+  bool m_useHelper; //!< Whether the FlowMonitor is owned by a FlowMonitorHelper
+};
+
+FlowMonitorIntervalReportTestCase::FlowMonitorIntervalReportTestCase (bool useHelper)
+  : TestCase (useHelper ? "FlowMonitor interval reports with FlowMonitorHelper" : "FlowMonitor interval reports"),
+    m_useHelper (useHelper)
+{
+}
+
+uint64_t
+FlowMonitorIntervalReportTestCase::Read (std::istream &is, uint32_t size)
+{
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      value |= static_cast<uint64_t> (static_cast<uint8_t> (is.get ())) << (8 * i);
+    }
+  return value;
+}
+
+void
+FlowMonitorIntervalReportTestCase::RunReports (Ptr<FlowMonitor> monitor, std::string fileName)
+{
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  monitor->EnableIntervalReports (fileName, Seconds (1));
+
+  // first interval: flow 1 delivers one packet in 100 ms
+  Simulator::Schedule (MilliSeconds (500), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 0, 100);
+  Simulator::Schedule (MilliSeconds (600), &FlowMonitor::ReportLastRx, monitor, probe, 1, 0, 100);
+  // second interval: flow 1 sends a packet, flow 2 delivers one in 200 ms
+  Simulator::Schedule (MilliSeconds (1500), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (MilliSeconds (1500), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 0, 200);
+  Simulator::Schedule (MilliSeconds (1700), &FlowMonitor::ReportLastRx, monitor, probe, 2, 0, 200);
+  // third interval and last partial interval: nothing happens
+  Simulator::Stop (Seconds (3.5));
+  Simulator::Run ();
+  // the last report is written by Simulator::Destroy
+  Simulator::Destroy ();
+}
+
+void
+FlowMonitorIntervalReportTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flowmon-intervals.bin");
+  if (m_useHelper)
+    {
+      FlowMonitorHelper helper;
+      RunReports (helper.GetMonitor (), fileName);
+    }
+  else
+    {
+      Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+      RunReports (monitor, fileName);
+      monitor->Dispose ();
+    }
+
+  std::ifstream is (fileName.c_str (), std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (is.good (), true, "Can not open " << fileName);
+  char magic[8];
+  is.read (magic, 8);
+  NS_TEST_EXPECT_MSG_EQ (std::string (magic, 8), "NS3FMON1", "Unexpected magic string");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<int64_t> (Read (is, 8)), Seconds (1).GetNanoSeconds (), "Unexpected interval");
+
+  const uint32_t expectedFlows[4] = { 1, 2, 0, 0 };
+  const Time expectedTimes[4] = { Seconds (1), Seconds (2), Seconds (3), Seconds (3.5) };
+  for (uint32_t report = 0; report < 4; report++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (static_cast<int64_t> (Read (is, 8)), expectedTimes[report].GetNanoSeconds (), "Unexpected time of report " << report);
+      NS_TEST_ASSERT_MSG_EQ (Read (is, 4), expectedFlows[report], "Unexpected number of flows in report " << report);
+      for (uint32_t flow = 0; flow < expectedFlows[report]; flow++)
+        {
+          uint32_t flowId = Read (is, 4);
+          uint32_t txPackets = Read (is, 4);
+          uint32_t rxPackets = Read (is, 4);
+          uint32_t lostPackets = Read (is, 4);
+          uint32_t droppedPackets = Read (is, 4);
+          uint32_t timesForwarded = Read (is, 4);
+          uint64_t txBytes = Read (is, 8);
+          uint64_t rxBytes = Read (is, 8);
+          uint64_t droppedBytes = Read (is, 8);
+          int64_t delaySum = Read (is, 8);
+          int64_t jitterSum = Read (is, 8);
+          // flow 1 has one packet in flight in the second report
+          bool delivered = (report == 0 || flowId == 2);
+          NS_TEST_EXPECT_MSG_EQ (flowId, flow + 1, "Unexpected flow in report " << report);
+          NS_TEST_EXPECT_MSG_EQ (txPackets, 1, "Unexpected transmitted packets");
+          NS_TEST_EXPECT_MSG_EQ (rxPackets, (delivered ? 1 : 0), "Unexpected received packets");
+          NS_TEST_EXPECT_MSG_EQ (lostPackets + droppedPackets + timesForwarded, 0, "Unexpected packet counters");
+          NS_TEST_EXPECT_MSG_EQ (txBytes, 100 * flowId, "Unexpected transmitted bytes");
+          NS_TEST_EXPECT_MSG_EQ (rxBytes, (delivered ? 100 * flowId : 0), "Unexpected received bytes");
+          NS_TEST_EXPECT_MSG_EQ (droppedBytes, 0, "Unexpected dropped bytes");
+          NS_TEST_EXPECT_MSG_EQ (delaySum, (delivered ? MilliSeconds (100 * flowId).GetNanoSeconds () : 0), "Unexpected delay sum");
+          NS_TEST_EXPECT_MSG_EQ (jitterSum, 0, "Unexpected jitter sum");
+        }
+    }
+  is.peek ();
+  NS_TEST_EXPECT_MSG_EQ (is.eof (), true, "Unexpected data at the end of the file");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new Ipv4FlowClassifierTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorTrackingTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorIntervalReportTestCase (false), TestCase::QUICK);
+  AddTestCase (new FlowMonitorIntervalReportTestCase (true), TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
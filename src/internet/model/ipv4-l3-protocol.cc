@@ -33,6 +33,7 @@
 #include "ns3/boolean.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/segmentation-offload-tag.h"
 
 #include "loopback-net-device.h"
 #include "arp-l3-protocol.h"
@@ -41,6 +42,10 @@
 #include "icmpv4-l4-protocol.h"
 #include "ipv4-interface.h"
 #include "ipv4-raw-socket-impl.h"
+#include "tcp-l4-protocol.h"
+#include "tcp-header.h"
+
+#include <functional>
 
 namespace ns3 {
 
@@ -50,6 +55,36 @@ const uint16_t Ipv4L3Protocol::PROT_NUMBER = 0x0800;
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv4L3Protocol);
 
+/**
+ * \brief Concatenate the parts of a packet being reassembled
+ *
+ * Appending the parts one by one to the same packet copies the bytes
+ * gathered so far at each step. Merging adjacent parts pairwise instead
+ * copies each byte a logarithmic number of times.
+ *
+ * \param parts the parts of the packet, in order (modified)
+ * \return the reassembled packet
+ */
+static Ptr<Packet>
+ConcatenateParts (std::vector<Ptr<Packet> > &parts)
+{
+  NS_ASSERT (!parts.empty ());
+  while (parts.size () > 1)
+    {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < parts.size (); i += 2, n++)
+        {
+          parts[n] = parts[i];
+          if (i + 1 < parts.size ())
+            {
+              parts[n]->AddAtEnd (parts[i + 1]);
+            }
+        }
+      parts.resize (n);
+    }
+  return parts.front ();
+}
+
 TypeId 
 Ipv4L3Protocol::GetTypeId (void)
 {
@@ -307,17 +342,13 @@ Ipv4L3Protocol::DoDispose (void)
       it->second = 0;
     }
 
-  for (MapFragmentsTimers_t::iterator it = m_fragmentsTimers.begin (); it != m_fragmentsTimers.end (); it++)
+  m_fragments.clear ();
+  m_timeoutEventList.clear ();
+  if (m_timeoutEvent.IsRunning ())
     {
-      if (it->second.IsRunning ())
-        {
-          it->second.Cancel ();
-        }
+      m_timeoutEvent.Cancel ();
     }
 
-  m_fragments.clear ();
-  m_fragmentsTimers.clear ();
-
   Object::DoDispose ();
 }
 
@@ -925,12 +956,28 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   Ptr<Ipv4Interface> outInterface = GetInterface (interface);
   NS_LOG_LOGIC ("Send via NetDevice ifIndex " << outDev->GetIfIndex () << " ipv4InterfaceIndex " << interface);
 
+  // Super-segments are split here only if the device can not transmit them,
+  // and are never fragmented
+  SegmentationOffloadTag tso;
+  bool isOffloaded = packet->PeekPacketTag (tso);
+
   if (!route->GetGateway ().IsEqual (Ipv4Address ("0.0.0.0")))
     {
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to gateway " << route->GetGateway ());
-          if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
+          if (isOffloaded && !outDev->SupportsSegmentationOffload ())
+            {
+              std::list<Ipv4PayloadHeaderPair> listSegments;
+              DoSegmentation (packet, ipHeader, listSegments);
+              for ( std::list<Ipv4PayloadHeaderPair>::iterator it = listSegments.begin (); it != listSegments.end (); it++ )
+                {
+                  CallTxTrace (it->second, it->first, m_node->GetObject<Ipv4> (), interface);
+                  outInterface->Send (it->first, it->second, route->GetGateway ());
+                }
+            }
+          else if (!isOffloaded
+                   && packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
             {
               std::list<Ipv4PayloadHeaderPair> listFragments;
               DoFragmentation (packet, ipHeader, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -957,7 +1004,19 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to destination " << ipHeader.GetDestination ());
-          if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
+          if (isOffloaded && !outDev->SupportsSegmentationOffload ())
+            {
+              std::list<Ipv4PayloadHeaderPair> listSegments;
+              DoSegmentation (packet, ipHeader, listSegments);
+              for ( std::list<Ipv4PayloadHeaderPair>::iterator it = listSegments.begin (); it != listSegments.end (); it++ )
+                {
+                  NS_LOG_LOGIC ("Sending segment " << *(it->first) );
+                  CallTxTrace (it->second, it->first, m_node->GetObject<Ipv4> (), interface);
+                  outInterface->Send (it->first, it->second, ipHeader.GetDestination ());
+                }
+            }
+          else if (!isOffloaded
+                   && packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
             {
               std::list<Ipv4PayloadHeaderPair> listFragments;
               DoFragmentation (packet, ipHeader, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -1489,6 +1548,63 @@ Ipv4L3Protocol::DoFragmentation (Ptr<Packet> packet, const Ipv4Header & ipv4Head
   return;
 }
 
+void
+Ipv4L3Protocol::DoSegmentation (Ptr<Packet> packet, const Ipv4Header & ipv4Header, std::list<Ipv4PayloadHeaderPair>& listSegments)
+{
+  NS_LOG_FUNCTION (this << *packet << &listSegments);
+
+  NS_ASSERT_MSG (ipv4Header.GetProtocol () == TcpL4Protocol::PROT_NUMBER,
+                 "Segmentation offload is only supported for TCP.");
+
+  Ptr<Packet> p = packet->Copy ();
+  SegmentationOffloadTag tso;
+  p->RemovePacketTag (tso);
+  TcpHeader tcpHeader;
+  p->RemoveHeader (tcpHeader);
+  NS_ASSERT (p->GetSize () == tso.GetPayloadSize ());
+
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < tso.GetSegmentCount (); ++i)
+    {
+      uint32_t size = tso.GetSegmentPayloadSize (i);
+      if (tso.IsLost (i))
+        {
+          // corrupted on a previous hop
+          offset += size;
+          continue;
+        }
+
+      Ptr<Packet> segment = p->CreateFragment (offset, size);
+
+      TcpHeader segmentTcpHeader = tcpHeader;
+      segmentTcpHeader.SetSequenceNumber (tcpHeader.GetSequenceNumber () + SequenceNumber32 (offset));
+      if (i != tso.GetSegmentCount () - 1)
+        {
+          // FIN and PSH only belong to the last segment
+          segmentTcpHeader.SetFlags (tcpHeader.GetFlags () & ~(TcpHeader::FIN | TcpHeader::PSH));
+        }
+      if (Node::ChecksumEnabled ())
+        {
+          segmentTcpHeader.EnableChecksums ();
+          segmentTcpHeader.InitializeChecksum (ipv4Header.GetSource (), ipv4Header.GetDestination (),
+                                               TcpL4Protocol::PROT_NUMBER);
+        }
+      segment->AddHeader (segmentTcpHeader);
+
+      Ipv4Header segmentHeader = ipv4Header;
+      segmentHeader.SetPayloadSize (segment->GetSize ());
+      if (Node::ChecksumEnabled ())
+        {
+          segmentHeader.EnableChecksum ();
+        }
+
+      NS_LOG_LOGIC ("New segment " << segmentHeader << " " << segmentTcpHeader);
+      listSegments.push_back (Ipv4PayloadHeaderPair (segment, segmentHeader));
+
+      offset += size;
+    }
+}
+
 bool
 Ipv4L3Protocol::ProcessFragment (Ptr<Packet>& packet, Ipv4Header& ipHeader, uint32_t iif)
 {
@@ -1496,9 +1612,8 @@ Ipv4L3Protocol::ProcessFragment (Ptr<Packet>& packet, Ipv4Header& ipHeader, uint
 
   uint64_t addressCombination = uint64_t (ipHeader.GetSource ().Get ()) << 32 | uint64_t (ipHeader.GetDestination ().Get ());
   uint32_t idProto = uint32_t (ipHeader.GetIdentification ()) << 16 | uint32_t (ipHeader.GetProtocol ());
-  std::pair<uint64_t, uint32_t> key;
+  FragmentKey_t key;
   bool ret = false;
-  Ptr<Packet> p = packet->Copy ();
 
   key.first = addressCombination;
   key.second = idProto;
@@ -1510,9 +1625,7 @@ Ipv4L3Protocol::ProcessFragment (Ptr<Packet>& packet, Ipv4Header& ipHeader, uint
     {
       fragments = Create<Fragments> ();
       m_fragments.insert (std::make_pair (key, fragments));
-      m_fragmentsTimers[key] = Simulator::Schedule (m_fragmentExpirationTimeout,
-                                                    &Ipv4L3Protocol::HandleFragmentsTimeout, this,
-                                                    key, ipHeader, iif);
+      fragments->SetTimeoutIter (SetTimeout (key, ipHeader, iif));
     }
   else
     {
@@ -1521,19 +1634,17 @@ Ipv4L3Protocol::ProcessFragment (Ptr<Packet>& packet, Ipv4Header& ipHeader, uint
 
   NS_LOG_LOGIC ("Adding fragment - Size: " << packet->GetSize ( ) << " - Offset: " << (ipHeader.GetFragmentOffset ()) );
 
-  fragments->AddFragment (p, ipHeader.GetFragmentOffset (), !ipHeader.IsLastFragment () );
+  // The caller hands over a private copy of the packet, which can be
+  // stored as is
+  fragments->AddFragment (packet, ipHeader.GetFragmentOffset (), !ipHeader.IsLastFragment () );
 
   if ( fragments->IsEntire () )
     {
       packet = fragments->GetPacket ();
+      NS_LOG_LOGIC ("Removing the fragments from the expiration list at " << Simulator::Now ().GetSeconds () << " due to complete packet");
+      m_timeoutEventList.erase (fragments->GetTimeoutIter ());
       fragments = 0;
       m_fragments.erase (key);
-      if (m_fragmentsTimers[key].IsRunning ())
-        {
-          NS_LOG_LOGIC ("Stopping WaitFragmentsTimer at " << Simulator::Now ().GetSeconds () << " due to complete packet");
-          m_fragmentsTimers[key].Cancel ();
-        }
-      m_fragmentsTimers.erase (key);
       ret = true;
     }
 
@@ -1556,12 +1667,16 @@ Ipv4L3Protocol::Fragments::AddFragment (Ptr<Packet> fragment, uint16_t fragmentO
 {
   NS_LOG_FUNCTION (this << fragment << fragmentOffset << moreFragment);
 
-  std::list<std::pair<Ptr<Packet>, uint16_t> >::iterator it;
+  // Fragments usually arrive in order, hence look for the insertion
+  // point starting from the last fragment
+  std::list<std::pair<Ptr<Packet>, uint16_t> >::iterator it = m_fragments.end ();
 
-  for (it = m_fragments.begin (); it != m_fragments.end (); it++)
+  while (it != m_fragments.begin ())
     {
-      if (it->second > fragmentOffset)
+      it--;
+      if (it->second <= fragmentOffset)
         {
+          it++;
           break;
         }
     }
@@ -1611,8 +1726,12 @@ Ipv4L3Protocol::Fragments::GetPacket () const
 
   std::list<std::pair<Ptr<Packet>, uint16_t> >::const_iterator it = m_fragments.begin ();
 
-  Ptr<Packet> p = it->first->Copy ();
-  uint16_t lastEndOffset = p->GetSize ();
+  // Collect the non-overlapping parts of the fragments (copies of packets
+  // share the buffer until modified) and then concatenate them
+  std::vector<Ptr<Packet> > parts;
+  parts.reserve (m_fragments.size ());
+  parts.push_back (it->first->Copy ());
+  uint32_t lastEndOffset = it->first->GetSize ();
   it++;
 
   for ( ; it != m_fragments.end (); it++)
@@ -1627,19 +1746,19 @@ Ipv4L3Protocol::Fragments::GetPacket () const
           if ( it->first->GetSize () > newStart )
             {
               uint32_t newSize = it->first->GetSize () - newStart;
-              Ptr<Packet> tempFragment = it->first->CreateFragment (newStart, newSize);
-              p->AddAtEnd (tempFragment);
+              parts.push_back (it->first->CreateFragment (newStart, newSize));
+              lastEndOffset += newSize;
             }
         }
       else
         {
           NS_LOG_LOGIC ("Adding: " << *(it->first) );
-          p->AddAtEnd (it->first);
+          parts.push_back (it->first->Copy ());
+          lastEndOffset += it->first->GetSize ();
         }
-      lastEndOffset = p->GetSize ();
     }
 
-  return p;
+  return ConcatenateParts (parts);
 }
 
 Ptr<Packet>
@@ -1678,7 +1797,19 @@ Ipv4L3Protocol::Fragments::GetPartialPacket () const
 }
 
 void
-Ipv4L3Protocol::HandleFragmentsTimeout (std::pair<uint64_t, uint32_t> key, Ipv4Header & ipHeader, uint32_t iif)
+Ipv4L3Protocol::Fragments::SetTimeoutIter (FragmentsTimeoutsListI_t iter)
+{
+  m_timeoutIter = iter;
+}
+
+Ipv4L3Protocol::FragmentsTimeoutsListI_t
+Ipv4L3Protocol::Fragments::GetTimeoutIter (void) const
+{
+  return m_timeoutIter;
+}
+
+void
+Ipv4L3Protocol::HandleFragmentsTimeout (FragmentKey_t key, Ipv4Header & ipHeader, uint32_t iif)
 {
   NS_LOG_FUNCTION (this << &key << &ipHeader << iif);
 
@@ -1697,6 +1828,69 @@ Ipv4L3Protocol::HandleFragmentsTimeout (std::pair<uint64_t, uint32_t> key, Ipv4H
   it->second = 0;
 
   m_fragments.erase (key);
-  m_fragmentsTimers.erase (key);
+}
+
+Ipv4L3Protocol::FragmentsTimeoutsListI_t
+Ipv4L3Protocol::SetTimeout (FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif)
+{
+  NS_LOG_FUNCTION (this << ipHeader << iif);
+
+  Time expiration = Simulator::Now () + m_fragmentExpirationTimeout;
+
+  // The expiration timeout is the same for all the packets, unless the
+  // attribute is changed while fragments are pending
+  FragmentsTimeoutsListI_t pos = m_timeoutEventList.end ();
+  while (pos != m_timeoutEventList.begin ())
+    {
+      pos--;
+      if (std::get<0> (*pos) <= expiration)
+        {
+          pos++;
+          break;
+        }
+    }
+  FragmentsTimeoutsListI_t iter = m_timeoutEventList.insert (pos, std::make_tuple (expiration, key, ipHeader, iif));
+
+  if (iter == m_timeoutEventList.begin ())
+    {
+      m_timeoutEvent.Cancel ();
+      m_timeoutEvent = Simulator::Schedule (m_fragmentExpirationTimeout, &Ipv4L3Protocol::HandleTimeout, this);
+    }
+
+  return iter;
+}
+
+void
+Ipv4L3Protocol::HandleTimeout (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Time now = Simulator::Now ();
+
+  while (!m_timeoutEventList.empty () && std::get<0> (m_timeoutEventList.front ()) <= now)
+    {
+      // HandleFragmentsTimeout takes a reference to the header
+      FragmentsTimeout_t entry = m_timeoutEventList.front ();
+      m_timeoutEventList.pop_front ();
+      HandleFragmentsTimeout (std::get<1> (entry), std::get<2> (entry), std::get<3> (entry));
+    }
+
+  if (!m_timeoutEventList.empty ())
+    {
+      m_timeoutEvent = Simulator::Schedule (std::get<0> (m_timeoutEventList.front ()) - now,
+                                            &Ipv4L3Protocol::HandleTimeout, this);
+    }
+}
+
+std::size_t
+Ipv4L3Protocol::KeyHash::operator() (const std::pair<uint64_t, uint8_t> &key) const
+{
+  return std::hash<uint64_t> () (key.first ^ (uint64_t (key.second) * 0x9e3779b97f4a7c15ULL));
+}
+
+std::size_t
+Ipv4L3Protocol::KeyHash::operator() (const FragmentKey_t &key) const
+{
+  return std::hash<uint64_t> () (key.first ^ (uint64_t (key.second) * 0x9e3779b97f4a7c15ULL));
 }
 } // namespace ns3
@@ -23,7 +23,9 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
+#include <tuple>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -405,6 +407,19 @@ private:
    */
   void DoFragmentation (Ptr<Packet> packet, const Ipv4Header& ipv4Header, uint32_t outIfaceMtu, std::list<Ipv4PayloadHeaderPair>& listFragments);
 
+  /**
+   * \brief Split a segmentation-offloaded TCP packet into its segments
+   *
+   * This is the software fallback used when the output device does not
+   * support segmentation offload. Segments marked as lost in the
+   * SegmentationOffloadTag are not generated.
+   *
+   * \param packet the packet
+   * \param ipv4Header the IPv4 header
+   * \param listSegments the list of segments
+   */
+  void DoSegmentation (Ptr<Packet> packet, const Ipv4Header& ipv4Header, std::list<Ipv4PayloadHeaderPair>& listSegments);
+
   /**
    * \brief Process a packet fragment
    * \param packet the packet
@@ -414,13 +429,60 @@ private:
    */
   bool ProcessFragment (Ptr<Packet>& packet, Ipv4Header & ipHeader, uint32_t iif);
 
+  /// Key identifying a fragmented packet: (src+dst addr, identification+proto)
+  typedef std::pair<uint64_t, uint32_t> FragmentKey_t;
+
   /**
    * \brief Process the timeout for packet fragments
    * \param key representing the packet fragments
    * \param ipHeader the IP header of the original packet
    * \param iif Input Interface
    */
-  void HandleFragmentsTimeout ( std::pair<uint64_t, uint32_t> key, Ipv4Header & ipHeader, uint32_t iif);
+  void HandleFragmentsTimeout (FragmentKey_t key, Ipv4Header & ipHeader, uint32_t iif);
+
+  /// Expiration list entry: (expiration time, fragments key, IP header, input interface)
+  typedef std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t> FragmentsTimeout_t;
+  /// List of the expiration times of the fragmented packets, in increasing order
+  typedef std::list<FragmentsTimeout_t> FragmentsTimeoutsList_t;
+  /// Iterator to an entry of the expiration list
+  typedef FragmentsTimeoutsList_t::iterator FragmentsTimeoutsListI_t;
+
+  /**
+   * \brief Add a fragmented packet to the expiration list
+   *
+   * All the fragmented packets share the same timeout, hence the entry is
+   * (usually) appended to the list and a single event, scheduled for the
+   * first expiration time, serves all the entries.
+   *
+   * \param key representing the packet fragments
+   * \param ipHeader the IP header of the original packet
+   * \param iif Input Interface
+   * \return an iterator to the new entry
+   */
+  FragmentsTimeoutsListI_t SetTimeout (FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif);
+
+  /**
+   * \brief Process the expired entries of the expiration list and
+   * reschedule the timeout event for the first entry left, if any.
+   */
+  void HandleTimeout (void);
+
+  /**
+   * \brief Hash function for the identification and fragment tables
+   */
+  struct KeyHash
+  {
+    /**
+     * \param key a (src+dst addr, proto) key
+     * \return the hash of the key
+     */
+    std::size_t operator() (const std::pair<uint64_t, uint8_t> &key) const;
+    /**
+     * \param key a fragments key
+     * \return the hash of the key
+     */
+    std::size_t operator() (const FragmentKey_t &key) const;
+  };
 
   /**
    * \brief Make a copy of the packet, add the header and invoke the TX trace callback
@@ -463,7 +525,7 @@ private:
   Ipv4InterfaceList m_interfaces; //!< List of IPv4 interfaces.
   Ipv4InterfaceReverseContainer m_reverseInterfacesContainer; //!< Container of NetDevice / Interface index associations.
   uint8_t m_defaultTtl;  //!< Default TTL
-  std::map<std::pair<uint64_t, uint8_t>, uint16_t> m_identification; //!< Identification (for each {src, dst, proto} tuple)
+  std::unordered_map<std::pair<uint64_t, uint8_t>, uint16_t, KeyHash> m_identification; //!< Identification (for each {src, dst, proto} tuple)
   Ptr<Node> m_node; //!< Node attached to stack.
 
   /// Trace of sent packets
@@ -534,12 +596,29 @@ public:
      */
     Ptr<Packet> GetPartialPacket () const;
 
+    /**
+     * \brief Set the iterator to the entry of the expiration list.
+     * \param iter The iterator.
+     */
+    void SetTimeoutIter (FragmentsTimeoutsListI_t iter);
+
+    /**
+     * \brief Get the iterator to the entry of the expiration list.
+     * \return The iterator.
+     */
+    FragmentsTimeoutsListI_t GetTimeoutIter (void) const;
+
 private:
     /**
      * \brief True if other fragments will be sent.
      */
     bool m_moreFragment;
 
+    /**
+     * \brief The entry of the expiration list.
+     */
+    FragmentsTimeoutsListI_t m_timeoutIter;
+
     /**
      * \brief The current fragments.
      */
@@ -547,14 +626,13 @@ private:
 
   };
 
-  /// Container of fragments, stored as pairs(src+dst addr, src+dst port) / fragment
-  typedef std::map< std::pair<uint64_t, uint32_t>, Ptr<Fragments> > MapFragments_t;
-  /// Container of fragment timeout event, stored as pairs(src+dst addr, src+dst port) / EventId
-  typedef std::map< std::pair<uint64_t, uint32_t>, EventId > MapFragmentsTimers_t;
+  /// Container of fragments, stored as pairs(src+dst addr, identification+proto) / fragment
+  typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, KeyHash> MapFragments_t;
 
   MapFragments_t       m_fragments; //!< Fragmented packets.
   Time                 m_fragmentExpirationTimeout; //!< Expiration timeout
-  MapFragmentsTimers_t m_fragmentsTimers; //!< Expiration events.
+  FragmentsTimeoutsList_t m_timeoutEventList; //!< Expiration times of the fragmented packets.
+  EventId              m_timeoutEvent; //!< Event for the first expiration time.
 
 };
 
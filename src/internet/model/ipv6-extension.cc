@@ -19,6 +19,8 @@
  */
 
 #include <list>
+#include <vector>
+#include <functional>
 #include <ctime>
 
 #include "ns3/log.h"
@@ -44,6 +46,34 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Ipv6Extension");
 
+/**
+ * \brief Concatenate the parts of a packet being reassembled, merging
+ * adjacent parts pairwise so that each byte is copied a logarithmic
+ * (rather than linear) number of times.
+ *
+ * \param parts the parts of the packet, in order (modified)
+ * \return the reassembled packet
+ */
+static Ptr<Packet>
+ConcatenateParts (std::vector<Ptr<Packet> > &parts)
+{
+  NS_ASSERT (!parts.empty ());
+  while (parts.size () > 1)
+    {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < parts.size (); i += 2, n++)
+        {
+          parts[n] = parts[i];
+          if (i + 1 < parts.size ())
+            {
+              parts[n]->AddAtEnd (parts[i + 1]);
+            }
+        }
+      parts.resize (n);
+    }
+  return parts.front ();
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6Extension);
 
 TypeId Ipv6Extension::GetTypeId ()
@@ -339,6 +369,11 @@ void Ipv6ExtensionFragment::DoDispose ()
     }
 
   m_fragments.clear ();
+  m_timeoutEventList.clear ();
+  if (m_timeoutEvent.IsRunning ())
+    {
+      m_timeoutEvent.Cancel ();
+    }
   Ipv6Extension::DoDispose ();
 }
 
@@ -376,7 +411,7 @@ uint8_t Ipv6ExtensionFragment::Process (Ptr<Packet>& packet,
   uint32_t identification = fragmentHeader.GetIdentification ();
   Ipv6Address src = ipv6Header.GetSourceAddress ();
 
-  std::pair<Ipv6Address, uint32_t> fragmentsId = std::pair<Ipv6Address, uint32_t> (src, identification);
+  FragmentKey_t fragmentsId = FragmentKey_t (src, identification);
   Ptr<Fragments> fragments;
 
   Ipv6Header ipHeader = ipv6Header;
@@ -387,10 +422,7 @@ uint8_t Ipv6ExtensionFragment::Process (Ptr<Packet>& packet,
     {
       fragments = Create<Fragments> ();
       m_fragments.insert (std::make_pair (fragmentsId, fragments));
-      EventId timeout = Simulator::Schedule (Seconds (60),
-                                             &Ipv6ExtensionFragment::HandleFragmentsTimeout, this,
-                                             fragmentsId, ipHeader);
-      fragments->SetTimeoutEventId (timeout);
+      fragments->SetTimeoutIter (SetTimeout (fragmentsId, ipHeader));
     }
   else
     {
@@ -409,7 +441,7 @@ uint8_t Ipv6ExtensionFragment::Process (Ptr<Packet>& packet,
   if (fragments->IsEntire ())
     {
       packet = fragments->GetPacket ();
-      fragments->CancelTimeout ();
+      m_timeoutEventList.erase (fragments->GetTimeoutIter ());
       m_fragments.erase (fragmentsId);
       stopProcessing = false;
     }
@@ -594,7 +626,7 @@ void Ipv6ExtensionFragment::GetFragments (Ptr<Packet> packet, Ipv6Header ipv6Hea
 }
 
 
-void Ipv6ExtensionFragment::HandleFragmentsTimeout (std::pair<Ipv6Address, uint32_t> fragmentsId,
+void Ipv6ExtensionFragment::HandleFragmentsTimeout (FragmentKey_t fragmentsId,
                                                     Ipv6Header ipHeader)
 {
   Ptr<Fragments> fragments;
@@ -621,6 +653,46 @@ void Ipv6ExtensionFragment::HandleFragmentsTimeout (std::pair<Ipv6Address, uint3
   m_fragments.erase (fragmentsId);
 }
 
+Ipv6ExtensionFragment::FragmentsTimeoutsListI_t Ipv6ExtensionFragment::SetTimeout (FragmentKey_t key, Ipv6Header ipHeader)
+{
+  // All the fragmented packets expire after the same time, hence the new
+  // entry is the last one to expire
+  Time expiration = Simulator::Now () + Seconds (60);
+  m_timeoutEventList.push_back (std::make_tuple (expiration, key, ipHeader));
+
+  if (!m_timeoutEvent.IsRunning ())
+    {
+      m_timeoutEvent = Simulator::Schedule (Seconds (60), &Ipv6ExtensionFragment::HandleTimeout, this);
+    }
+
+  return --m_timeoutEventList.end ();
+}
+
+void Ipv6ExtensionFragment::HandleTimeout (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Time now = Simulator::Now ();
+
+  while (!m_timeoutEventList.empty () && std::get<0> (m_timeoutEventList.front ()) <= now)
+    {
+      FragmentsTimeout_t entry = m_timeoutEventList.front ();
+      m_timeoutEventList.pop_front ();
+      HandleFragmentsTimeout (std::get<1> (entry), std::get<2> (entry));
+    }
+
+  if (!m_timeoutEventList.empty ())
+    {
+      m_timeoutEvent = Simulator::Schedule (std::get<0> (m_timeoutEventList.front ()) - now,
+                                            &Ipv6ExtensionFragment::HandleTimeout, this);
+    }
+}
+
+std::size_t Ipv6ExtensionFragment::FragmentKeyHash::operator() (const FragmentKey_t &key) const
+{
+  return Ipv6AddressHash () (key.first) ^ std::hash<uint32_t> () (key.second);
+}
+
 Ipv6ExtensionFragment::Fragments::Fragments ()
   : m_moreFragment (0)
 {
@@ -632,12 +704,16 @@ Ipv6ExtensionFragment::Fragments::~Fragments ()
 
 void Ipv6ExtensionFragment::Fragments::AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset, bool moreFragment)
 {
-  std::list<std::pair<Ptr<Packet>, uint16_t> >::iterator it;
+  // Look for the insertion point starting from the last fragment, as
+  // fragments usually arrive in order
+  std::list<std::pair<Ptr<Packet>, uint16_t> >::iterator it = m_packetFragments.end ();
 
-  for (it = m_packetFragments.begin (); it != m_packetFragments.end (); it++)
+  while (it != m_packetFragments.begin ())
     {
-      if (it->second > fragmentOffset)
+      it--;
+      if (it->second <= fragmentOffset)
         {
+          it++;
           break;
         }
     }
@@ -680,14 +756,16 @@ bool Ipv6ExtensionFragment::Fragments::IsEntire () const
 
 Ptr<Packet> Ipv6ExtensionFragment::Fragments::GetPacket () const
 {
-  Ptr<Packet> p =  m_unfragmentable->Copy ();
+  std::vector<Ptr<Packet> > parts;
+  parts.reserve (m_packetFragments.size () + 1);
+  parts.push_back (m_unfragmentable->Copy ());
 
   for (std::list<std::pair<Ptr<Packet>, uint16_t> >::const_iterator it = m_packetFragments.begin (); it != m_packetFragments.end (); it++)
     {
-      p->AddAtEnd (it->first);
+      parts.push_back (it->first->Copy ());
     }
 
-  return p;
+  return ConcatenateParts (parts);
 }
 
 Ptr<Packet> Ipv6ExtensionFragment::Fragments::GetPartialPacket () const
@@ -718,16 +796,15 @@ Ptr<Packet> Ipv6ExtensionFragment::Fragments::GetPartialPacket () const
   return p;
 }
 
-void Ipv6ExtensionFragment::Fragments::SetTimeoutEventId (EventId event)
+void Ipv6ExtensionFragment::Fragments::SetTimeoutIter (FragmentsTimeoutsListI_t iter)
 {
-  m_timeoutEventId = event;
+  m_timeoutIter = iter;
   return;
 }
 
-void Ipv6ExtensionFragment::Fragments::CancelTimeout ()
+Ipv6ExtensionFragment::FragmentsTimeoutsListI_t Ipv6ExtensionFragment::Fragments::GetTimeoutIter (void) const
 {
-  m_timeoutEventId.Cancel ();
-  return;
+  return m_timeoutIter;
 }
 
 
@@ -23,6 +23,8 @@
 
 #include <map>
 #include <list>
+#include <unordered_map>
+#include <tuple>
 
 #include "ns3/object.h"
 #include "ns3/node.h"
@@ -35,6 +37,8 @@
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/traced-callback.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 
 
 namespace ns3 {
@@ -316,6 +320,16 @@ protected:
   virtual void DoDispose ();
 
 private:
+  /// Key identifying a fragmented packet: (source address, identification)
+  typedef std::pair<Ipv6Address, uint32_t> FragmentKey_t;
+
+  /// Expiration list entry: (expiration time, fragments key, IPv6 header)
+  typedef std::tuple<Time, FragmentKey_t, Ipv6Header> FragmentsTimeout_t;
+  /// List of the expiration times of the fragmented packets, in increasing order
+  typedef std::list<FragmentsTimeout_t> FragmentsTimeoutsList_t;
+  /// Iterator to an entry of the expiration list
+  typedef FragmentsTimeoutsList_t::iterator FragmentsTimeoutsListI_t;
+
   /**
    * \ingroup ipv6HeaderExt
    *
@@ -367,15 +381,16 @@ public:
     Ptr<Packet> GetPartialPacket () const;
 
     /**
-     * \brief Set the Timeout EventId.
-     * \param event The event.
+     * \brief Set the iterator to the entry of the expiration list.
+     * \param iter The iterator.
      */
-    void SetTimeoutEventId (EventId event);
+    void SetTimeoutIter (FragmentsTimeoutsListI_t iter);
 
     /**
-     * \brief Cancel the timeout event
+     * \brief Get the iterator to the entry of the expiration list.
+     * \return The iterator.
      */
-    void CancelTimeout ();
+    FragmentsTimeoutsListI_t GetTimeoutIter (void) const;
 
 private:
     /**
@@ -394,9 +409,9 @@ private:
     Ptr<Packet> m_unfragmentable;
 
     /**
-     * \brief Timeout handler event
+     * \brief The entry of the expiration list
      */
-    EventId m_timeoutEventId;
+    FragmentsTimeoutsListI_t m_timeoutIter;
   };
 
   /**
@@ -404,7 +419,34 @@ private:
    * \param key representing the packet fragments
    * \param ipHeader the IP header of the original packet
    */
-  void HandleFragmentsTimeout (std::pair<Ipv6Address, uint32_t> key, Ipv6Header ipHeader);
+  void HandleFragmentsTimeout (FragmentKey_t key, Ipv6Header ipHeader);
+
+  /**
+   * \brief Add a fragmented packet to the expiration list. A single event,
+   * scheduled for the first expiration time, serves all the entries.
+   * \param key representing the packet fragments
+   * \param ipHeader the IP header of the original packet
+   * \return an iterator to the new entry
+   */
+  FragmentsTimeoutsListI_t SetTimeout (FragmentKey_t key, Ipv6Header ipHeader);
+
+  /**
+   * \brief Process the expired entries of the expiration list and
+   * reschedule the timeout event for the first entry left, if any.
+   */
+  void HandleTimeout (void);
+
+  /**
+   * \brief Hash function for the fragments keys
+   */
+  struct FragmentKeyHash
+  {
+    /**
+     * \param key a fragments key
+     * \return the hash of the key
+     */
+    std::size_t operator() (const FragmentKey_t &key) const;
+  };
 
   /**
    * \brief Get the packet parts so far received.
@@ -426,12 +468,22 @@ private:
   /**
    * \brief Container for the packet fragments.
    */
-  typedef std::map<std::pair<Ipv6Address, uint32_t>, Ptr<Fragments> > MapFragments_t;
+  typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
   /**
    * \brief The hash of fragmented packets.
    */
   MapFragments_t m_fragments;
+
+  /**
+   * \brief Expiration times of the fragmented packets.
+   */
+  FragmentsTimeoutsList_t m_timeoutEventList;
+
+  /**
+   * \brief Event for the first expiration time.
+   */
+  EventId m_timeoutEvent;
 };
 
 /**
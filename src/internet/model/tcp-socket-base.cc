@@ -41,6 +41,7 @@
 #include "ns3/double.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "tcp-socket-base.h"
 #include "tcp-l4-protocol.h"
 #include "ipv4-end-point.h"
@@ -135,6 +136,17 @@ TcpSocketBase::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_limitedTx),
                    MakeBooleanChecker ())
+    .AddAttribute ("Tso", "Enable or disable TCP segmentation offload: new data "
+                   "is handed to IPv4 in super-segments of up to TsoMaxSegments "
+                   "segments, split only where needed",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_tsoEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TsoMaxSegments", "Maximum number of segments in a "
+                   "segmentation-offloaded packet",
+                   UintegerValue (44),
+                   MakeUintegerAccessor (&TcpSocketBase::m_tsoMaxSegments),
+                   MakeUintegerChecker<uint32_t> (1, SegmentationOffloadTag::MAX_SEGMENTS))
     .AddTraceSource ("RTO",
                      "Retransmission timeout",
                      MakeTraceSourceAccessor (&TcpSocketBase::m_rto),
@@ -346,6 +358,8 @@ TcpSocketBase::TcpSocketBase (void)
     m_recover (0),
     m_retxThresh (3),
     m_limitedTx (false),
+    m_tsoEnabled (false),
+    m_tsoMaxSegments (1),
     m_congestionControl (0),
     m_isFirstPartialAck (true),
     m_pacingTimer (Timer::REMOVE_ON_DESTROY)
@@ -426,6 +440,8 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_recover (sock.m_recover),
     m_retxThresh (sock.m_retxThresh),
     m_limitedTx (sock.m_limitedTx),
+    m_tsoEnabled (sock.m_tsoEnabled),
+    m_tsoMaxSegments (sock.m_tsoMaxSegments),
     m_isFirstPartialAck (sock.m_isFirstPartialAck),
     m_txTrace (sock.m_txTrace),
     m_rxTrace (sock.m_rxTrace),
@@ -2682,8 +2698,27 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
       isRetransmission = true;
     }
 
-  Ptr<Packet> p = m_txBuffer->CopyFromSequence (maxSize, seq);
+  Ptr<Packet> p = m_txBuffer->CopyFromSequence (std::min (maxSize, m_tcb->m_segmentSize), seq);
+
+  // A super-segment (see TsoSegmentSize) is extracted one segment at a time,
+  // so that the scoreboard of the TxBuffer keeps the granularity it would have
+  // if the segments were sent one by one
+  while (p->GetSize () < maxSize)
+    {
+      uint32_t s = std::min (maxSize - p->GetSize (), m_tcb->m_segmentSize);
+      Ptr<Packet> segment = m_txBuffer->CopyFromSequence (s, seq + SequenceNumber32 (p->GetSize ()));
+      if (segment->GetSize () == 0)
+        {
+          break;
+        }
+      p->AddAtEnd (segment);
+    }
   uint32_t sz = p->GetSize (); // Size of packet
+  if (sz > m_tcb->m_segmentSize)
+    {
+      SegmentationOffloadTag tsoTag (m_tcb->m_segmentSize, sz);
+      p->AddPacketTag (tsoTag);
+    }
   uint8_t flags = withAck ? TcpHeader::ACK : 0;
   uint32_t remainingData = m_txBuffer->SizeFromSequence (seq + SequenceNumber32 (sz));
 
@@ -2925,6 +2960,11 @@ TcpSocketBase::SendPendingData (bool withAck)
             }
 
           uint32_t s = std::min (availableWindow, m_tcb->m_segmentSize);
+          uint32_t tsoSize = TsoSegmentSize (next, availableWindow, availableData);
+          if (tsoSize > 0)
+            {
+              s = tsoSize;
+            }
 
           // (C.2) If any of the data octets sent in (C.1) are below HighData,
           //       HighRxt MUST be set to the highest sequence number of the
@@ -3112,6 +3152,36 @@ TcpSocketBase::AdvertisedWindowSize (bool scale) const
   return static_cast<uint16_t> (w);
 }
 
+uint32_t
+TcpSocketBase::TsoSegmentSize (const SequenceNumber32 &next, uint32_t availableWindow,
+                               uint32_t availableData) const
+{
+  NS_LOG_FUNCTION (this << next << availableWindow << availableData);
+
+  // Only previously unsent data over IPv4 is offloaded: retransmissions keep
+  // going out one segment at a time, and a FIN is never merged into a
+  // super-segment
+  if (!m_tsoEnabled || m_endPoint == 0 || m_closeOnEmpty
+      || next != m_tcb->m_highTxMark)
+    {
+      return 0;
+    }
+
+  // The IPv4 total length field limits the size of the super-segment
+  static const uint32_t maxTsoPayload = 65535 - 60 - 60;
+  uint32_t size = std::min (m_tsoMaxSegments * m_tcb->m_segmentSize, maxTsoPayload);
+  size = std::min (size, std::min (availableWindow, availableData));
+
+  // Only full-sized segments are offloaded; the tail is left to the usual
+  // silly window and Nagle checks
+  size -= size % m_tcb->m_segmentSize;
+  if (size < 2 * m_tcb->m_segmentSize)
+    {
+      return 0;
+    }
+  return size;
+}
+
 // Receipt of new packet, put into Rx buffer
 void
 TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
@@ -3120,6 +3190,32 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
   NS_LOG_DEBUG ("Data segment, seq=" << tcpHeader.GetSequenceNumber () <<
                 " pkt size=" << p->GetSize () );
 
+  SegmentationOffloadTag tsoTag;
+  if (p->PeekPacketTag (tsoTag) && tsoTag.GetSegmentCount () > 1)
+    {
+      // A super-segment is processed as the train of segments it stands
+      // for, so that ACKs (and delayed ACKs) are generated exactly as if the
+      // segments had been received one by one. Segments corrupted along the
+      // path are discarded here.
+      NS_LOG_LOGIC ("Splitting super-segment: " << tsoTag.GetSegmentCount () << " segments");
+      uint32_t offset = 0;
+      for (uint32_t i = 0; i < tsoTag.GetSegmentCount (); ++i)
+        {
+          uint32_t size = tsoTag.GetSegmentPayloadSize (i);
+          if (!tsoTag.IsLost (i))
+            {
+              SegmentationOffloadTag segmentTag;
+              Ptr<Packet> segment = p->CreateFragment (offset, size);
+              segment->RemovePacketTag (segmentTag);
+              TcpHeader segmentHeader = tcpHeader;
+              segmentHeader.SetSequenceNumber (tcpHeader.GetSequenceNumber () + SequenceNumber32 (offset));
+              ReceivedData (segment, segmentHeader);
+            }
+          offset += size;
+        }
+      return;
+    }
+
   // Put into Rx buffer
   SequenceNumber32 expectedSeq = m_rxBuffer->NextRxSequence ();
   if (!m_rxBuffer->Add (p, tcpHeader))
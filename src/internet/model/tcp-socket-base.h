@@ -675,6 +675,21 @@ protected:
    */
   uint32_t SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool withAck);
 
+  /**
+   * \brief Compute the size of the next segmentation-offloaded packet
+   *
+   * With TCP segmentation offload enabled, previously unsent data is handed
+   * down to IPv4 in super-segments carrying several full-sized segments.
+   *
+   * \param next the sequence number of the next byte to send
+   * \param availableWindow the available transmission window
+   * \param availableData the data available in the TxBuffer from next
+   * \returns the number of bytes of the super-segment, or 0 if the next
+   *          transmission should not be offloaded
+   */
+  uint32_t TsoSegmentSize (const SequenceNumber32 &next, uint32_t availableWindow,
+                           uint32_t availableData) const;
+
   /**
    * \brief Send a empty packet that carries a flag, e.g., ACK
    *
@@ -1170,6 +1185,10 @@ protected:
   uint32_t               m_retxThresh;   //!< Fast Retransmit threshold
   bool                   m_limitedTx;    //!< perform limited transmit
 
+  // Segmentation offload
+  bool     m_tsoEnabled;     //!< TCP segmentation offload enabled
+  uint32_t m_tsoMaxSegments; //!< Maximum number of segments in a super-segment
+
   // Transmission Control Block
   Ptr<TcpSocketState>    m_tcb;               //!< Congestion control informations
   Ptr<TcpCongestionOps>  m_congestionControl; //!< Congestion control
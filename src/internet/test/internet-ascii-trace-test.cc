@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/socket.h"
+#include "ns3/boolean.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/trace-helper.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/icmpv6-l4-protocol.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the IPv4 and IPv6 ascii traces stay text when the
+ * binary format of the device traces is enabled.
+ *
+ * Only the default trace sinks can write binary records, so the files of
+ * the internet stack, which has its own sinks, must not be binary.
+ */
+class InternetAsciiTraceBinaryFormatTest : public TestCase
+{
+public:
+  InternetAsciiTraceBinaryFormatTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Send a packet.
+   * \param socket The sending socket.
+   * \param to The destination address.
+   */
+  void SendPacket (Ptr<Socket> socket, Address to);
+  /**
+   * \brief Check that a trace file holds text events.
+   * \param filename The name of the trace file.
+   */
+  void CheckTextTrace (std::string filename);
+};
+
+InternetAsciiTraceBinaryFormatTest::InternetAsciiTraceBinaryFormatTest ()
+  : TestCase ("Check that the internet ascii traces ignore the binary format")
+{
+}
+
+void
+InternetAsciiTraceBinaryFormatTest::SendPacket (Ptr<Socket> socket, Address to)
+{
+  socket->SendTo (Create<Packet> (123), 0, to);
+}
+
+void
+InternetAsciiTraceBinaryFormatTest::CheckTextTrace (std::string filename)
+{
+  std::ifstream file (filename.c_str (), std::ios::binary);
+  std::string trace ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char> ());
+  NS_TEST_EXPECT_MSG_EQ (trace.empty (), false, "Empty trace " << filename);
+  NS_TEST_EXPECT_MSG_NE (trace.substr (0, 8), "NS3TRAC1", "Binary trace " << filename);
+  NS_TEST_EXPECT_MSG_EQ (trace.substr (0, 2), "r ", "Unexpected first event in " << filename);
+}
+
+void
+InternetAsciiTraceBinaryFormatTest::DoRun (void)
+{
+  Ptr<Node> rxNode = CreateObject<Node> ();
+  Ptr<Node> txNode = CreateObject<Node> ();
+  NodeContainer nodes (rxNode, txNode);
+
+  SimpleNetDeviceHelper helperChannel;
+  helperChannel.SetNetDevicePointToPointMode (true);
+  NetDeviceContainer devices = helperChannel.Install (nodes);
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  rxNode->GetObject<Icmpv6L4Protocol> ()->SetAttribute ("DAD", BooleanValue (false));
+  txNode->GetObject<Icmpv6L4Protocol> ()->SetAttribute ("DAD", BooleanValue (false));
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase (Ipv4Address ("10.0.0.0"), Ipv4Mask ("255.255.255.0"));
+  Ipv4InterfaceContainer ipv4Interfaces = ipv4.Assign (devices);
+  Ipv6AddressHelper ipv6;
+  ipv6.SetBase (Ipv6Address ("2001:1::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer ipv6Interfaces = ipv6.Assign (devices);
+
+  AsciiTraceHelper::SetBinaryFormat (true);
+  std::string ipv4Filename = CreateTempDirFilename ("internet-ascii-trace-ipv4.tr");
+  std::string ipv6Filename = CreateTempDirFilename ("internet-ascii-trace-ipv6.tr");
+  internet.EnableAsciiIpv4 (ipv4Filename, rxNode->GetObject<Ipv4> (), 1, true);
+  internet.EnableAsciiIpv6 (ipv6Filename, rxNode->GetObject<Ipv6> (), 1, true);
+  AsciiTraceHelper::SetBinaryFormat (false);
+
+  Ptr<Socket> ipv4Socket = Socket::CreateSocket (txNode, UdpSocketFactory::GetTypeId ());
+  Ptr<Socket> ipv6Socket = Socket::CreateSocket (txNode, UdpSocketFactory::GetTypeId ());
+  Simulator::ScheduleWithContext (txNode->GetId (), Seconds (1),
+                                  &InternetAsciiTraceBinaryFormatTest::SendPacket, this, ipv4Socket,
+                                  InetSocketAddress (ipv4Interfaces.GetAddress (0), 1234));
+  Simulator::ScheduleWithContext (txNode->GetId (), Seconds (2),
+                                  &InternetAsciiTraceBinaryFormatTest::SendPacket, this, ipv6Socket,
+                                  Inet6SocketAddress (ipv6Interfaces.GetAddress (0, 1), 1234));
+  Simulator::Run ();
+  ipv4Socket->Close ();
+  ipv6Socket->Close ();
+  Simulator::Destroy ();
+
+  // the streams are closed once the nodes holding the trace sinks are disposed
+  CheckTextTrace (ipv4Filename);
+  CheckTextTrace (ipv6Filename);
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Internet ascii trace TestSuite
+ */
+class InternetAsciiTraceTestSuite : public TestSuite
+{
+public:
+  InternetAsciiTraceTestSuite ()
+    : TestSuite ("internet-ascii-trace", UNIT)
+  {
+    AddTestCase (new InternetAsciiTraceBinaryFormatTest (), TestCase::QUICK);
+  }
+};
+
+static InternetAsciiTraceTestSuite g_internetAsciiTraceTestSuite; //!< Static variable for test initialization
@@ -49,6 +49,7 @@
 
 #include <string>
 #include <limits>
+#include <vector>
 #include <netinet/in.h>
 
 using namespace ns3;
@@ -109,6 +110,7 @@ class Ipv4FragmentationTest: public TestCase
   uint8_t *m_data;        //!< Data.
   uint32_t m_size;        //!< packet size.
   uint8_t m_icmpType;     //!< ICMP type.
+  std::vector<Time> m_icmpTimes; //!< Reception times of the ICMP packets.
 
 public:
   virtual void DoRun (void);
@@ -260,6 +262,7 @@ Ipv4FragmentationTest::HandleReadIcmpClient (Ipv4Address icmpSource,
                                              uint8_t icmpCode, uint32_t icmpInfo)
 {
   m_icmpType = icmpType;
+  m_icmpTimes.push_back (Simulator::Now ());
 }
 
 void
@@ -507,6 +510,30 @@ Ipv4FragmentationTest::DoRun (void)
       NS_TEST_EXPECT_MSG_EQ (end, m_receivedPacketServer->GetSize (), "trivial");
     }
 
+  // Fifth test: normal channel, some errors, no delays.
+  // Several packets are partially received at different times, hence their
+  // fragments are waiting for reassembly at the same time. Each of them must
+  // expire 30 seconds after its first fragment has been received.
+  serverDevErrorModel->Enable ();
+  serverDevErrorModel->Reset ();
+  SetFill (fillData, 78, 5000);
+  m_receivedPacketServer = Create<Packet> ();
+  m_icmpTimes.clear ();
+  Time start = Simulator::Now ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::ScheduleWithContext (m_socketClient->GetNode ()->GetId (), Seconds (i),
+                                      &Ipv4FragmentationTest::SendClient, this);
+    }
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_receivedPacketServer->GetSize (), 0, "Server got a packet, something wrong");
+  NS_TEST_ASSERT_MSG_EQ (m_icmpTimes.size (), 3, "Client did not receive one ICMP::TIME_EXCEEDED per packet");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_icmpTimes[i] - start, Seconds (30 + i), MilliSeconds (10), "Unexpected expiration time");
+    }
+
 
   Simulator::Destroy ();
 }
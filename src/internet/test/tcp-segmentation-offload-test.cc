@@ -0,0 +1,365 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/socket-factory.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/error-model.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv4-list-routing.h"
+#include "ns3/node.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/icmpv4-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/traffic-control-layer.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpSegmentationOffloadTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief SimpleNetDevice which can transmit segmentation-offloaded packets
+ */
+class TsoSimpleNetDevice : public SimpleNetDevice
+{
+public:
+  /**
+   * \brief Constructor
+   * \param offload whether the device supports segmentation offload
+   */
+  TsoSimpleNetDevice (bool offload)
+    : m_offload (offload)
+  {
+  }
+
+  virtual bool SupportsSegmentationOffload (void) const
+  {
+    return m_offload;
+  }
+
+private:
+  bool m_offload; //!< Whether the device supports segmentation offload
+};
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Bulk transfer with TCP segmentation offload enabled
+ *
+ * The transfer is checked for integrity, both when the super-segments cross
+ * the channel (and are split by the receiving socket) and when they are
+ * segmented in software by IPv4, optionally with some segments corrupted by
+ * a receive error model.
+ */
+class TcpSegmentationOffloadTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param deviceOffload whether the devices support segmentation offload
+   * \param lossy whether the receiving device drops some segments
+   */
+  TcpSegmentationOffloadTestCase (bool deviceOffload, bool lossy);
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * \brief Create a node with the Internet stack
+   * \returns The new node.
+   */
+  Ptr<Node> CreateInternetNode (void);
+  /**
+   * \brief Add a device to a node
+   * \param node The target node.
+   * \param ipaddr the device IPv4 address.
+   * \returns The new device.
+   */
+  Ptr<SimpleNetDevice> AddDevice (Ptr<Node> node, const char* ipaddr);
+
+  /**
+   * \brief Server: Handle connection created.
+   * \param s The socket.
+   * \param addr The other party address.
+   */
+  void ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr);
+  /**
+   * \brief Server: Receive data.
+   * \param sock The socket.
+   */
+  void ServerHandleRecv (Ptr<Socket> sock);
+  /**
+   * \brief Client: Send data.
+   * \param sock The socket.
+   * \param available Unused in the test.
+   */
+  void SourceHandleSend (Ptr<Socket> sock, uint32_t available);
+  /**
+   * \brief Client: Trace the packets handed to IP.
+   * \param p The packet.
+   * \param h The TCP header.
+   * \param socket The socket.
+   */
+  void SourceTx (Ptr<const Packet> p, const TcpHeader &h, Ptr<const TcpSocketBase> socket);
+  /**
+   * \brief Client: Count the packets handed to the devices.
+   * \param p The packet.
+   * \param ipv4 The IPv4 object.
+   * \param interface The interface.
+   */
+  void IpTx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+
+  bool m_deviceOffload;             //!< Devices support segmentation offload
+  bool m_lossy;                     //!< Drop some segments
+  uint32_t m_totalBytes;            //!< Total stream size (in bytes).
+  uint32_t m_currentSourceTxBytes;  //!< Client Tx bytes.
+  uint32_t m_currentServerRxBytes;  //!< Server Rx bytes.
+  uint32_t m_superSegments;         //!< Super-segments sent by the client
+  uint32_t m_ipTx;                  //!< Packets handed to the client device
+  uint32_t m_segmentsTx;            //!< Segments sent by the client
+  uint8_t *m_sourceTxPayload;       //!< Client Tx payload.
+  uint8_t *m_serverRxPayload;       //!< Server Rx payload.
+};
+
+TcpSegmentationOffloadTestCase::TcpSegmentationOffloadTestCase (bool deviceOffload, bool lossy)
+  : TestCase (std::string ("TCP segmentation offload, device offload=")
+              + (deviceOffload ? "yes" : "no") + ", lossy=" + (lossy ? "yes" : "no")),
+    m_deviceOffload (deviceOffload),
+    m_lossy (lossy),
+    m_totalBytes (200000)
+{
+}
+
+void
+TcpSegmentationOffloadTestCase::DoRun (void)
+{
+  m_currentSourceTxBytes = 0;
+  m_currentServerRxBytes = 0;
+  m_superSegments = 0;
+  m_ipTx = 0;
+  m_segmentsTx = 0;
+  m_sourceTxPayload = new uint8_t [m_totalBytes];
+  m_serverRxPayload = new uint8_t [m_totalBytes];
+  for (uint32_t i = 0; i < m_totalBytes; ++i)
+    {
+      m_sourceTxPayload[i] = (uint8_t)(97 + (i % 26));
+    }
+  memset (m_serverRxPayload, 0, m_totalBytes);
+
+  Ptr<Node> node0 = CreateInternetNode ();
+  Ptr<Node> node1 = CreateInternetNode ();
+  Ptr<SimpleNetDevice> dev0 = AddDevice (node0, "192.168.1.1");
+  Ptr<SimpleNetDevice> dev1 = AddDevice (node1, "192.168.1.2");
+
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  dev0->SetChannel (channel);
+  dev1->SetChannel (channel);
+
+  if (m_lossy)
+    {
+      // Each segment is accounted separately by the error model, whether
+      // it travels alone or inside a super-segment
+      Ptr<ReceiveListErrorModel> em = CreateObject<ReceiveListErrorModel> ();
+      std::list<uint32_t> sampleList;
+      sampleList.push_back (20);
+      sampleList.push_back (21);
+      sampleList.push_back (60);
+      em->SetList (sampleList);
+      dev0->SetReceiveErrorModel (em);
+    }
+
+  Ptr<Socket> server = node0->GetObject<TcpSocketFactory> ()->CreateSocket ();
+  Ptr<Socket> source = node1->GetObject<TcpSocketFactory> ()->CreateSocket ();
+  source->SetAttribute ("Tso", BooleanValue (true));
+  source->SetAttribute ("SegmentSize", UintegerValue (1000));
+  source->SetAttribute ("SndBufSize", UintegerValue (m_totalBytes));
+  source->TraceConnectWithoutContext ("Tx", MakeCallback (&TcpSegmentationOffloadTestCase::SourceTx, this));
+  node1->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx", MakeCallback (&TcpSegmentationOffloadTestCase::IpTx, this));
+
+  uint16_t port = 50000;
+  server->Bind (InetSocketAddress (Ipv4Address::GetAny (), port));
+  server->Listen ();
+  server->SetAcceptCallback (MakeNullCallback<bool, Ptr< Socket >, const Address &> (),
+                             MakeCallback (&TcpSegmentationOffloadTestCase::ServerHandleConnectionCreated, this));
+
+  source->SetSendCallback (MakeCallback (&TcpSegmentationOffloadTestCase::SourceHandleSend, this));
+  source->Connect (InetSocketAddress (Ipv4Address ("192.168.1.1"), port));
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_currentSourceTxBytes, m_totalBytes, "Source sent all bytes");
+  NS_TEST_EXPECT_MSG_EQ (m_currentServerRxBytes, m_totalBytes, "Server received all bytes");
+  NS_TEST_EXPECT_MSG_EQ (memcmp (m_sourceTxPayload, m_serverRxPayload, m_totalBytes), 0,
+                         "Server received expected data buffers");
+  NS_TEST_EXPECT_MSG_GT (m_superSegments, 0, "No super-segment has been sent");
+  if (m_deviceOffload)
+    {
+      NS_TEST_EXPECT_MSG_LT (m_ipTx, m_segmentsTx, "Super-segments should cross the channel");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_ipTx, m_segmentsTx, "Super-segments should be split by IPv4");
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::DoTeardown (void)
+{
+  delete [] m_sourceTxPayload;
+  delete [] m_serverRxPayload;
+  Simulator::Destroy ();
+}
+
+void
+TcpSegmentationOffloadTestCase::ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr)
+{
+  s->SetRecvCallback (MakeCallback (&TcpSegmentationOffloadTestCase::ServerHandleRecv, this));
+}
+
+void
+TcpSegmentationOffloadTestCase::ServerHandleRecv (Ptr<Socket> sock)
+{
+  while (sock->GetRxAvailable () > 0)
+    {
+      Ptr<Packet> p = sock->Recv (sock->GetRxAvailable (), 0);
+      NS_TEST_EXPECT_MSG_EQ ((m_currentServerRxBytes + p->GetSize () <= m_totalBytes), true,
+                             "Server received too many bytes");
+      p->CopyData (&m_serverRxPayload[m_currentServerRxBytes], p->GetSize ());
+      m_currentServerRxBytes += p->GetSize ();
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::SourceHandleSend (Ptr<Socket> sock, uint32_t available)
+{
+  while (sock->GetTxAvailable () > 0 && m_currentSourceTxBytes < m_totalBytes)
+    {
+      uint32_t left = m_totalBytes - m_currentSourceTxBytes;
+      uint32_t toSend = std::min (left, sock->GetTxAvailable ());
+      Ptr<Packet> p = Create<Packet> (&m_sourceTxPayload[m_currentSourceTxBytes], toSend);
+      int sent = sock->Send (p);
+      NS_TEST_EXPECT_MSG_EQ ((sent != -1), true, "Error during send ?");
+      m_currentSourceTxBytes += sent;
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::SourceTx (Ptr<const Packet> p, const TcpHeader &h,
+                                          Ptr<const TcpSocketBase> socket)
+{
+  SegmentationOffloadTag tag;
+  if (p->PeekPacketTag (tag))
+    {
+      NS_TEST_EXPECT_MSG_EQ (tag.GetPayloadSize (), p->GetSize (), "Wrong payload size in tag");
+      NS_TEST_EXPECT_MSG_EQ (tag.GetSegmentSize (), 1000, "Wrong segment size in tag");
+      NS_TEST_EXPECT_MSG_EQ ((h.GetFlags () & TcpHeader::FIN), 0, "FIN in a super-segment");
+      ++m_superSegments;
+      m_segmentsTx += tag.GetSegmentCount ();
+    }
+  else
+    {
+      ++m_segmentsTx;
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::IpTx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  ++m_ipTx;
+}
+
+Ptr<Node>
+TcpSegmentationOffloadTestCase::CreateInternetNode ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  //ARP
+  Ptr<ArpL3Protocol> arp = CreateObject<ArpL3Protocol> ();
+  node->AggregateObject (arp);
+  //IPV4
+  Ptr<Ipv4L3Protocol> ipv4 = CreateObject<Ipv4L3Protocol> ();
+  //Routing for Ipv4
+  Ptr<Ipv4ListRouting> ipv4Routing = CreateObject<Ipv4ListRouting> ();
+  ipv4->SetRoutingProtocol (ipv4Routing);
+  Ptr<Ipv4StaticRouting> ipv4staticRouting = CreateObject<Ipv4StaticRouting> ();
+  ipv4Routing->AddRoutingProtocol (ipv4staticRouting, 0);
+  node->AggregateObject (ipv4);
+  //ICMP
+  Ptr<Icmpv4L4Protocol> icmp = CreateObject<Icmpv4L4Protocol> ();
+  node->AggregateObject (icmp);
+  //UDP
+  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
+  node->AggregateObject (udp);
+  //TCP
+  Ptr<TcpL4Protocol> tcp = CreateObject<TcpL4Protocol> ();
+  node->AggregateObject (tcp);
+  // Traffic Control
+  Ptr<TrafficControlLayer> tc = CreateObject<TrafficControlLayer> ();
+  node->AggregateObject (tc);
+  return node;
+}
+
+Ptr<SimpleNetDevice>
+TcpSegmentationOffloadTestCase::AddDevice (Ptr<Node> node, const char* ipaddr)
+{
+  Ptr<SimpleNetDevice> dev = CreateObject<TsoSimpleNetDevice> (m_deviceOffload);
+  dev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  node->AddDevice (dev);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  uint32_t ndid = ipv4->AddInterface (dev);
+  Ipv4InterfaceAddress ipv4Addr = Ipv4InterfaceAddress (Ipv4Address (ipaddr), Ipv4Mask ("255.255.255.0"));
+  ipv4->AddAddress (ndid, ipv4Addr);
+  ipv4->SetUp (ndid);
+  return dev;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP segmentation offload TestSuite
+ */
+class TcpSegmentationOffloadTestSuite : public TestSuite
+{
+public:
+  TcpSegmentationOffloadTestSuite ()
+    : TestSuite ("tcp-segmentation-offload", UNIT)
+  {
+    AddTestCase (new TcpSegmentationOffloadTestCase (true, false), TestCase::QUICK);
+    AddTestCase (new TcpSegmentationOffloadTestCase (false, false), TestCase::QUICK);
+    AddTestCase (new TcpSegmentationOffloadTestCase (true, true), TestCase::QUICK);
+    AddTestCase (new TcpSegmentationOffloadTestCase (false, true), TestCase::QUICK);
+  }
+};
+
+static TcpSegmentationOffloadTestSuite g_tcpSegmentationOffloadTestSuite; //!< Static variable for test initialization
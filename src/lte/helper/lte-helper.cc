@@ -197,6 +197,25 @@ TypeId LteHelper::GetTypeId (void)
                    UintegerValue (1),
                    MakeUintegerAccessor (&LteHelper::m_noOfCcs),
                    MakeUintegerChecker<uint16_t> (MIN_NO_CC, MAX_NO_CC))
+    .AddAttribute ("SubframeBatching",
+                   "If true, the downlink and uplink channels deliver all the "
+                   "signals transmitted at the same time (e.g., the control "
+                   "frames of all the cells at the start of a subframe) to the "
+                   "receivers of each node by a single event, run in the context "
+                   "of that node, instead of one event per signal and receiver. "
+                   "See the BatchReceptions attribute of SpectrumChannel.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_subframeBatching),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ShareUeAntennaModel",
+                   "If true, the UE devices installed by the same call of "
+                   "InstallUeDevice share a single antenna model, instead of "
+                   "creating one each. This saves time and memory with many "
+                   "UEs, but is only correct if the attributes of the antenna "
+                   "model are not changed after the installation.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_shareUeAntennaModel),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -232,6 +251,11 @@ LteHelper::ChannelModelInitialization (void)
 
   m_downlinkChannel = m_channelFactory.Create<SpectrumChannel> ();
   m_uplinkChannel = m_channelFactory.Create<SpectrumChannel> ();
+  if (m_subframeBatching)
+    {
+      m_downlinkChannel->SetAttribute ("BatchReceptions", BooleanValue (true));
+      m_uplinkChannel->SetAttribute ("BatchReceptions", BooleanValue (true));
+    }
 
   m_downlinkPathlossModel = m_pathlossModelFactory.Create ();
   Ptr<SpectrumPropagationLossModel> dlSplm = m_downlinkPathlossModel->GetObject<SpectrumPropagationLossModel> ();
@@ -500,12 +524,18 @@ LteHelper::InstallUeDevice (NodeContainer c)
 {
   NS_LOG_FUNCTION (this);
   NetDeviceContainer devices;
+  if (m_shareUeAntennaModel)
+    {
+      m_sharedUeAntennaModel = (m_ueAntennaModelFactory.Create ())->GetObject<AntennaModel> ();
+      NS_ASSERT_MSG (m_sharedUeAntennaModel, "error in creating the AntennaModel object");
+    }
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
       Ptr<Node> node = *i;
       Ptr<NetDevice> device = InstallSingleUeDevice (node);
       devices.Add (device);
     }
+  m_sharedUeAntennaModel = 0;
   return devices;
 }
 
@@ -833,8 +863,12 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       dlPhy->SetMobility (mm);
       ulPhy->SetMobility (mm);
 
-      Ptr<AntennaModel> antenna = (m_ueAntennaModelFactory.Create ())->GetObject<AntennaModel> ();
-      NS_ASSERT_MSG (antenna, "error in creating the AntennaModel object");
+      Ptr<AntennaModel> antenna = m_sharedUeAntennaModel;
+      if (antenna == 0)
+        {
+          antenna = (m_ueAntennaModelFactory.Create ())->GetObject<AntennaModel> ();
+          NS_ASSERT_MSG (antenna, "error in creating the AntennaModel object");
+        }
       dlPhy->SetAntenna (antenna);
       ulPhy->SetAntenna (antenna);
 
@@ -1015,6 +1049,53 @@ LteHelper::Attach (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice)
     }
 }
 
+void
+LteHelper::PreAttach (NetDeviceContainer ueDevices, Ptr<NetDevice> enbDevice)
+{
+  NS_LOG_FUNCTION (this);
+  for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); ++i)
+    {
+      PreAttach (*i, enbDevice);
+    }
+}
+
+void
+LteHelper::PreAttach (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_UNLESS (m_useIdealRrc, "PreAttach requires the ideal RRC protocol");
+
+  Ptr<LteUeNetDevice> ueLteDevice = ueDevice->GetObject<LteUeNetDevice> ();
+  Ptr<LteEnbNetDevice> enbLteDevice = enbDevice->GetObject<LteEnbNetDevice> ();
+  NS_ABORT_MSG_IF (ueLteDevice == 0, "The passed UE NetDevice must be an LteUeNetDevice");
+  NS_ABORT_MSG_IF (enbLteDevice == 0, "The passed eNB NetDevice must be an LteEnbNetDevice");
+
+  // connect at time zero, so that the bearers can still be activated
+  Simulator::Schedule (Seconds (0), &LteHelper::DoPreAttach, this, ueLteDevice, enbLteDevice);
+
+  if (m_epcHelper != 0)
+    {
+      // activate default EPS bearer
+      m_epcHelper->ActivateEpsBearer (ueDevice, ueLteDevice->GetImsi (), EpcTft::Default (), EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+  else
+    {
+      ueLteDevice->SetTargetEnb (enbLteDevice);
+    }
+}
+
+void
+LteHelper::DoPreAttach (Ptr<LteUeNetDevice> ueDevice, Ptr<LteEnbNetDevice> enbDevice)
+{
+  NS_LOG_FUNCTION (this << ueDevice << enbDevice);
+  Ptr<LteEnbRrc> enbRrc = enbDevice->GetRrc ();
+  uint16_t rnti = enbRrc->AddPreAttachedUe ();
+  ueDevice->GetRrc ()->PreAttach (enbDevice->GetCellId (), enbDevice->GetDlEarfcn (), rnti,
+                                  enbRrc->GetMasterInformationBlock (0),
+                                  enbRrc->GetSystemInformationBlockType1 (0),
+                                  enbRrc->GetSystemInformation (0));
+}
+
 void
 LteHelper::AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices)
 {
@@ -1051,12 +1132,12 @@ uint8_t
 LteHelper::ActivateDedicatedEpsBearer (NetDeviceContainer ueDevices, EpsBearer bearer, Ptr<EpcTft> tft)
 {
   NS_LOG_FUNCTION (this);
+  uint8_t bearerId = 0;
   for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); ++i)
     {
-      uint8_t bearerId = ActivateDedicatedEpsBearer (*i, bearer, tft);
-      return bearerId;
+      bearerId = ActivateDedicatedEpsBearer (*i, bearer, tft);
     }
-  return 0;
+  return bearerId;
 }
 
 
@@ -1476,10 +1557,9 @@ void
 LteHelper::EnableUlPhyTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportUeSinr",
-                   MakeBoundCallback (&PhyStatsCalculator::ReportUeSinr, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportInterference",
-                   MakeBoundCallback (&PhyStatsCalculator::ReportInterference, m_phyStats));
+  Config::MatchContainer enbPhys = Config::LookupMatches ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy");
+  enbPhys.Connect ("ReportUeSinr", MakeBoundCallback (&PhyStatsCalculator::ReportUeSinr, m_phyStats));
+  enbPhys.Connect ("ReportInterference", MakeBoundCallback (&PhyStatsCalculator::ReportInterference, m_phyStats));
 
 }
 
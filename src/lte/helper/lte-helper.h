@@ -48,6 +48,9 @@ namespace ns3 {
 
 class LteUePhy;
 class LteEnbPhy;
+class LteUeNetDevice;
+class LteEnbNetDevice;
+class AntennaModel;
 class SpectrumChannel;
 class EpcHelper;
 class PropagationLossModel;
@@ -350,6 +353,9 @@ public:
   /**
    * Create a set of UE devices.
    *
+   * If the ShareUeAntennaModel attribute is true, a single antenna model is
+   * created for all the devices.
+   *
    * \param c the node container where the devices are to be installed
    * \return the NetDeviceContainer with the newly created devices
    */
@@ -422,6 +428,39 @@ public:
    */
   void Attach (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice);
 
+  /**
+   * \brief Attachment of a set of UE devices to a given eNodeB, with their
+   *        connection established at the beginning of the simulation.
+   * \param ueDevices the set of UE devices to be attached
+   * \param enbDevice the destination eNodeB device
+   *
+   * \sa LteHelper::PreAttach (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice);
+   */
+  void PreAttach (NetDeviceContainer ueDevices, Ptr<NetDevice> enbDevice);
+
+  /**
+   * \brief Attachment of a UE device to a given eNodeB, with its connection
+   *        established at the beginning of the simulation.
+   * \param ueDevice the UE device to be attached
+   * \param enbDevice the destination eNodeB device
+   *
+   * Like Attach (Ptr<NetDevice>, Ptr<NetDevice>), but the UE does not wait
+   * for the broadcast of the system information of the cell and does not
+   * perform the random access procedure: at time zero, the eNodeB allocates
+   * the C-RNTI of the UE and the UE sends its RRC CONNECTION REQUEST
+   * straight away. The rest of the connection establishment, including the
+   * setup of the EPS bearers in the EPC, is performed by the regular RRC,
+   * S1-AP and S11 procedures, so the resulting state is the one of a normal
+   * attachment. With the ideal RRC protocol, the UE is in CONNECTED mode with
+   * its bearers active before the first subframe, and the preambles of many
+   * UEs do not collide.
+   *
+   * The function requires the ideal RRC protocol (the UseIdealRrc
+   * attribute), and can be used in both LTE-only and EPC-enabled
+   * simulations.
+   */
+  void PreAttach (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice);
+
   /** 
    * \brief Manual attachment of a set of UE devices to the network via the
    *        closest eNodeB (with respect to distance) among those in the set.
@@ -460,7 +499,7 @@ public:
    * \param ueDevices the set of UE devices
    * \param bearer the characteristics of the bearer to be activated
    * \param tft the Traffic Flow Template that identifies the traffic to go on this bearer
-   * \returns bearer ID
+   * \returns bearer ID of the last UE device
    */
   uint8_t ActivateDedicatedEpsBearer (NetDeviceContainer ueDevices, EpsBearer bearer, Ptr<EpcTft> tft);
 
@@ -722,6 +761,15 @@ private:
                           Ptr<NetDevice> sourceEnbDev,
                           uint16_t targetCellId);
 
+  /**
+   * The actual function to connect a pre-attached UE.
+   * \param ueDevice the UE
+   * \param enbDevice the eNB the UE is attached to
+   *
+   * This method is scheduled by PreAttach() to run at time zero.
+   */
+  void DoPreAttach (Ptr<LteUeNetDevice> ueDevice, Ptr<LteEnbNetDevice> enbDevice);
+
 
   /**
    *  \brief The actual function to trigger a manual bearer de-activation
@@ -855,6 +903,22 @@ private:
    */
   uint16_t m_noOfCcs;
 
+  /**
+   * The `SubframeBatching` attribute. If true, the signals transmitted at
+   * the same time are delivered to the receivers of each node by a single
+   * event.
+   */
+  bool m_subframeBatching;
+
+  /**
+   * The `ShareUeAntennaModel` attribute. If true, the UE devices installed
+   * by the same call of InstallUeDevice share their antenna model.
+   */
+  bool m_shareUeAntennaModel;
+
+  /// The antenna model shared by the UE devices being installed, if any
+  Ptr<AntennaModel> m_sharedUeAntennaModel;
+
 };   // end of `class LteHelper`
 
 
@@ -22,10 +22,12 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/simulator.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-ue-net-device.h>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -43,7 +45,8 @@ LteStatsCalculator::LteStatsCalculator ()
 
 LteStatsCalculator::~LteStatsCalculator ()
 {
-  // Nothing to do here
+  // the streams themselves are closed by the destructors of the derived classes
+  m_flushEvent.Cancel ();
 }
 
 
@@ -84,6 +87,48 @@ LteStatsCalculator::GetDlOutputFilename (void)
 }
 
 
+void
+LteStatsCalculator::DoDispose ()
+{
+  FlushOutputFiles ();
+  m_flushEvent.Cancel ();
+  Object::DoDispose ();
+}
+
+bool
+LteStatsCalculator::OpenOutputFile (std::ofstream& outFile, std::string filename, std::string header)
+{
+  if (outFile.is_open ())
+    {
+      return true;
+    }
+  outFile.open (filename.c_str ());
+  if (!outFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      return false;
+    }
+  outFile << header << std::endl;
+  if (std::find (m_outputFiles.begin (), m_outputFiles.end (), &outFile) == m_outputFiles.end ())
+    {
+      m_outputFiles.push_back (&outFile);
+    }
+  if (!m_flushEvent.IsRunning ())
+    {
+      m_flushEvent = Simulator::ScheduleDestroy (&LteStatsCalculator::FlushOutputFiles, this);
+    }
+  return true;
+}
+
+void
+LteStatsCalculator::FlushOutputFiles ()
+{
+  for (std::vector<std::ofstream *>::iterator it = m_outputFiles.begin (); it != m_outputFiles.end (); ++it)
+    {
+      (*it)->flush ();
+    }
+}
+
 bool
 LteStatsCalculator::ExistsImsiPath (std::string path)
 {
@@ -23,7 +23,10 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/event-id.h"
 #include <map>
+#include <vector>
+#include <fstream>
 
 namespace ns3 {
 
@@ -32,7 +35,8 @@ namespace ns3 {
  *
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
- * Also stores names of output files.
+ * Also stores names of output files and keeps the output
+ * streams of the derived classes open for the whole simulation.
  */
 
 class LteStatsCalculator : public Object
@@ -123,6 +127,29 @@ public:
   uint16_t GetCellIdPath (std::string path);
 
 protected:
+  // inherited from Object
+  virtual void DoDispose (void);
+
+  /**
+   * Makes sure that the given output stream is open. The first time
+   * the stream is used, the file is created and the column descriptions
+   * are written to it; the stream is then kept open, so that the
+   * statistics lines are buffered instead of reopening the file in
+   * append mode for each of them. All the streams opened this way are
+   * flushed at Simulator::Destroy and when the calculator is disposed.
+   *
+   * @param outFile the output stream, owned by the derived class
+   * @param filename the name of the file to be created
+   * @param header the column descriptions, without the end of line
+   * @return true if the stream is open and can be written
+   */
+  bool OpenOutputFile (std::ofstream& outFile, std::string filename, std::string header);
+
+  /**
+   * Flushes the buffered output of all the streams opened with
+   * OpenOutputFile ()
+   */
+  void FlushOutputFiles (void);
 
   /**
    * Retrieves IMSI from Enb RLC path in the attribute system
@@ -204,6 +231,16 @@ private:
    * Name of the file where the uplink results will be saved
    */
   std::string m_ulOutputFilename;
+
+  /**
+   * Output streams opened by OpenOutputFile ()
+   */
+  std::vector<std::ofstream *> m_outputFiles;
+
+  /**
+   * Event flushing the output streams at Simulator::Destroy
+   */
+  EventId m_flushEvent;
 };
 
 } // namespace ns3
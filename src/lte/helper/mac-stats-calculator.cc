@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("MacStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (MacStatsCalculator);
 
 MacStatsCalculator::MacStatsCalculator ()
-  : m_dlFirstWrite (true),
-    m_ulFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -96,28 +94,12 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, DlSchedulingCa
 		  dlSchedulingCallbackInfo.rnti << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << dlSchedulingCallbackInfo.sizeTb1 << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << dlSchedulingCallbackInfo.sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlFirstWrite == true )
+  if (!OpenOutputFile (m_dlOutFile, GetDlOutputFilename (),
+                       "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId"))
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_dlFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_dlOutFile;
 
   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << (uint32_t) cellId << "\t";
@@ -129,8 +111,7 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, DlSchedulingCa
   outFile << dlSchedulingCallbackInfo.sizeTb1 << "\t";
   outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << "\t";
   outFile << dlSchedulingCallbackInfo.sizeTb2 << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.componentCarrierId << std::endl;
-  outFile.close ();
+  outFile << (uint32_t) dlSchedulingCallbackInfo.componentCarrierId << "\n";
 }
 
 void
@@ -140,28 +121,12 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulFirstWrite == true )
-    {
-      outFile.open (GetUlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-      m_ulFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
-      outFile << std::endl;
-    }
-  else
+  if (!OpenOutputFile (m_ulOutFile, GetUlOutputFilename (),
+                       "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId"))
     {
-      outFile.open (GetUlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_ulOutFile;
 
   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << (uint32_t) cellId << "\t";
@@ -171,8 +136,7 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   outFile << rnti << "\t";
   outFile << (uint32_t) mcsTb << "\t";
   outFile << size << "\t";
-  outFile << (uint32_t) componentCarrierId << std::endl;
-  outFile.close ();
+  outFile << (uint32_t) componentCarrierId << "\n";
 }
 
 void
@@ -151,20 +151,18 @@ public:
 
 private:
   /**
-   * When writing DL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the DL MAC statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_dlFirstWrite;
+  std::ofstream m_dlOutFile;
 
   /**
-   * When writing UL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the UL MAC statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_ulFirstWrite;
+  std::ofstream m_ulOutFile;
 
 };
 
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyRxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyRxStatsCalculator);
 
 PhyRxStatsCalculator::PhyRxStatsCalculator ()
-  : m_dlRxFirstWrite (true),
-    m_ulRxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -95,28 +93,12 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlRxFirstWrite == true )
+  if (!OpenOutputFile (m_dlRxOutFile, GetDlRxOutputFilename (),
+                       "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId"))
     {
-      outFile.open (GetDlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_dlRxOutFile;
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << params.m_timestamp << "\t";
@@ -130,8 +112,7 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   outFile << (uint32_t) params.m_rv << "\t";
   outFile << (uint32_t) params.m_ndi << "\t";
   outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId << std::endl;
-  outFile.close ();
+  outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
@@ -140,28 +121,12 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulRxFirstWrite == true )
-    {
-      outFile.open (GetUlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
+  if (!OpenOutputFile (m_ulRxOutFile, GetUlRxOutputFilename (),
+                       "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId"))
     {
-      outFile.open (GetUlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_ulRxOutFile;
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << params.m_timestamp << "\t";
@@ -174,8 +139,7 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   outFile << (uint32_t) params.m_rv << "\t";
   outFile << (uint32_t) params.m_ndi << "\t";
   outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId <<std::endl;
-  outFile.close ();
+  outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
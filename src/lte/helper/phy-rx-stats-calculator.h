@@ -127,20 +127,18 @@ public:
 private:
 
   /**
-   * When writing DL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the DL RX PHY statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_dlRxFirstWrite;
+  std::ofstream m_dlRxOutFile;
 
   /**
-   * When writing UL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the UL RX PHY statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_ulRxFirstWrite;
+  std::ofstream m_ulRxOutFile;
 
 };
 
@@ -31,9 +31,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyStatsCalculator);
 
 PhyStatsCalculator::PhyStatsCalculator ()
-  :  m_RsrpSinrFirstWrite (true),
-    m_UeSinrFirstWrite (true),
-    m_InterferenceFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -115,28 +112,12 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_RsrpSinrFirstWrite == true )
+  if (!OpenOutputFile (m_rsrpSinrOutFile, GetCurrentCellRsrpSinrFilename (),
+                       "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId"))
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
-      m_RsrpSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_rsrpSinrOutFile;
 
   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << cellId << "\t";
@@ -144,8 +125,7 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   outFile << rnti << "\t";
   outFile << rsrp << "\t";
   outFile << sinr << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  outFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -154,36 +134,19 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_UeSinrFirstWrite == true )
-    {
-      outFile.open (GetUeSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
-      m_UeSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
-      outFile << std::endl;
-    }
-  else
+  if (!OpenOutputFile (m_ueSinrOutFile, GetUeSinrFilename (),
+                       "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId"))
     {
-      outFile.open (GetUeSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_ueSinrOutFile;
 
   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << cellId << "\t";
   outFile << imsi << "\t";
   outFile << rnti << "\t";
   outFile << sinrLinear << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  outFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -192,33 +155,21 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_InterferenceFirstWrite == true )
+  if (!OpenOutputFile (m_interferenceOutFile, GetInterferenceFilename (),
+                       "% time\tcellId\tInterference"))
     {
-      outFile.open (GetInterferenceFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
-      m_InterferenceFirstWrite = false;
-      outFile << "% time\tcellId\tInterference";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetInterferenceFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
+      return;
     }
+  std::ofstream& outFile = m_interferenceOutFile;
 
   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
   outFile << cellId << "\t";
-  outFile << *interference;
-  outFile.close ();
+  // same format as operator<< of SpectrumValue, which would flush the stream with std::endl
+  for (Values::const_iterator it = interference->ConstValuesBegin (); it != interference->ConstValuesEnd (); ++it)
+    {
+      outFile << *it << " ";
+    }
+  outFile << "\n";
 }
 
 
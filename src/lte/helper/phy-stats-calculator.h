@@ -183,28 +183,25 @@ public:
 
 private:
   /**
-   * When writing RSRP SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the RSRP SINR statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_RsrpSinrFirstWrite;
+  std::ofstream m_rsrpSinrOutFile;
 
   /**
-   * When writing UE SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the UE SINR statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_UeSinrFirstWrite;
+  std::ofstream m_ueSinrOutFile;
 
   /**
-   * When writing interference statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the interference statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_InterferenceFirstWrite;
+  std::ofstream m_interferenceOutFile;
 
   /**
    * Name of the file where the RSRP/SINR statistics will be saved
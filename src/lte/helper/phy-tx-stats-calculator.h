@@ -128,20 +128,18 @@ public:
 
 private:
   /**
-   * When writing DL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the DL TX PHY statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_dlTxFirstWrite;
+  std::ofstream m_dlTxOutFile;
 
   /**
-   * When writing UL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output stream of the UL TX PHY statistics. It is opened, and the
+   * columns description is added, the first time the statistics are
+   * written; it is then kept open for the next lines.
    */
-  bool m_ulTxFirstWrite;
+  std::ofstream m_ulTxOutFile;
 
 };
 
@@ -24,7 +24,6 @@
 #include "ns3/nstime.h"
 #include <ns3/log.h>
 #include <vector>
-#include <algorithm>
 
 namespace ns3 {
 
@@ -33,16 +32,14 @@ NS_LOG_COMPONENT_DEFINE ("RadioBearerStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED ( RadioBearerStatsCalculator);
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator ()
-  : m_firstWrite (true),
-    m_pendingOutput (false), 
+  : m_pendingOutput (false),
     m_protocolType ("RLC")
 {
   NS_LOG_FUNCTION (this);
 }
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator (std::string protocolType)
-  : m_firstWrite (true),
-    m_pendingOutput (false)
+  : m_pendingOutput (false)
 {
   NS_LOG_FUNCTION (this);
   m_protocolType = protocolType;
@@ -102,6 +99,7 @@ RadioBearerStatsCalculator::DoDispose ()
     {
       ShowResults ();
     }
+  LteStatsCalculator::DoDispose ();
 }
 
 void 
@@ -130,6 +128,45 @@ RadioBearerStatsCalculator::GetEpoch () const
   return m_epochDuration;  
 }
 
+RadioBearerStatsCalculator::BearerStats::BearerStats ()
+  : dlCellId (0),
+    ulCellId (0),
+    dlTx (false),
+    ulTx (false),
+    dlTxPackets (0),
+    dlRxPackets (0),
+    dlTxData (0),
+    dlRxData (0),
+    ulTxPackets (0),
+    ulRxPackets (0),
+    ulTxData (0),
+    ulRxData (0)
+{
+}
+
+RadioBearerStatsCalculator::BearerStats&
+RadioBearerStatsCalculator::GetBearerStats (ImsiLcidPair_t p)
+{
+  std::map<ImsiLcidPair_t, uint32_t>::iterator it = m_bearerIndex.find (p);
+  if (it == m_bearerIndex.end ())
+    {
+      it = m_bearerIndex.insert (std::make_pair (p, m_bearerStats.size ())).first;
+      m_bearerStats.push_back (BearerStats ());
+    }
+  return m_bearerStats[it->second];
+}
+
+const RadioBearerStatsCalculator::BearerStats*
+RadioBearerStatsCalculator::FindBearerStats (uint64_t imsi, uint8_t lcid) const
+{
+  std::map<ImsiLcidPair_t, uint32_t>::const_iterator it = m_bearerIndex.find (ImsiLcidPair_t (imsi, lcid));
+  if (it == m_bearerIndex.end ())
+    {
+      return 0;
+    }
+  return &m_bearerStats[it->second];
+}
+
 void
 RadioBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
@@ -137,10 +174,12 @@ RadioBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rn
   ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_ulTxPackets[p]++;
-      m_ulTxData[p] += packetSize;
+      BearerStats& stats = GetBearerStats (p);
+      stats.ulCellId = cellId;
+      stats.flowId = LteFlowId_t (rnti, lcid);
+      stats.ulTx = true;
+      stats.ulTxPackets++;
+      stats.ulTxData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -152,10 +191,12 @@ RadioBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rn
   ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_dlTxPackets[p]++;
-      m_dlTxData[p] += packetSize;
+      BearerStats& stats = GetBearerStats (p);
+      stats.dlCellId = cellId;
+      stats.flowId = LteFlowId_t (rnti, lcid);
+      stats.dlTx = true;
+      stats.dlTxPackets++;
+      stats.dlTxData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -168,19 +209,19 @@ RadioBearerStatsCalculator::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rn
   ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_ulRxPackets[p]++;
-      m_ulRxData[p] += packetSize;
+      BearerStats& stats = GetBearerStats (p);
+      stats.ulCellId = cellId;
+      stats.ulRxPackets++;
+      stats.ulRxData += packetSize;
 
-      Uint64StatsMap::iterator it = m_ulDelay.find (p);
-      if (it == m_ulDelay.end ())
+      if (stats.ulDelay == 0)
         {
           NS_LOG_DEBUG (this << " Creating UL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_ulDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_ulPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+          stats.ulDelay = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
+          stats.ulPduSize = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
         }
-      m_ulDelay[p]->Update (delay);
-      m_ulPduSize[p]->Update (packetSize);
+      stats.ulDelay->Update (delay);
+      stats.ulPduSize->Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -192,19 +233,19 @@ RadioBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rn
   ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_dlRxPackets[p]++;
-      m_dlRxData[p] += packetSize;
+      BearerStats& stats = GetBearerStats (p);
+      stats.dlCellId = cellId;
+      stats.dlRxPackets++;
+      stats.dlRxData += packetSize;
 
-      Uint64StatsMap::iterator it = m_dlDelay.find (p);
-      if (it == m_dlDelay.end ())
+      if (stats.dlDelay == 0)
         {
           NS_LOG_DEBUG (this << " Creating DL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_dlDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_dlPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+          stats.dlDelay = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
+          stats.dlPduSize = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
         }
-      m_dlDelay[p]->Update (delay);
-      m_dlPduSize[p]->Update (packetSize);
+      stats.dlDelay->Update (delay);
+      stats.dlPduSize->Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -216,53 +257,17 @@ RadioBearerStatsCalculator::ShowResults (void)
   NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
   NS_LOG_INFO ("Write Rlc Stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream ulOutFile;
-  std::ofstream dlOutFile;
-
-  if (m_firstWrite == true)
-    {
-      ulOutFile.open (GetUlOutputFilename ().c_str ());
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str ());
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_firstWrite = false;
-      ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      ulOutFile << "delay\tstdDev\tmin\tmax\t";
-      ulOutFile << "PduSize\tstdDev\tmin\tmax";
-      ulOutFile << std::endl;
-      dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      dlOutFile << "delay\tstdDev\tmin\tmax\t";
-      dlOutFile << "PduSize\tstdDev\tmin\tmax";
-      dlOutFile << std::endl;
-    }
-  else
+  std::string header = "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t"
+    "delay\tstdDev\tmin\tmax\t"
+    "PduSize\tstdDev\tmin\tmax";
+  if (!OpenOutputFile (m_ulOutFile, GetUlOutputFilename (), header)
+      || !OpenOutputFile (m_dlOutFile, GetDlOutputFilename (), header))
     {
-      ulOutFile.open (GetUlOutputFilename ().c_str (), std::ios_base::app);
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str (), std::ios_base::app);
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
-  WriteUlResults (ulOutFile);
-  WriteDlResults (dlOutFile);
+  WriteUlResults (m_ulOutFile);
+  WriteDlResults (m_dlOutFile);
   m_pendingOutput = false;
 
 }
@@ -272,31 +277,26 @@ RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
 
-  // Get the unique IMSI / LCID list
-
-  std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_ulTxPackets.begin (); it != m_ulTxPackets.end (); ++it)
+  // the bearers are written in (IMSI, LCID) order
+  Time endTime = m_startTime + m_epochDuration;
+  for (std::map<ImsiLcidPair_t, uint32_t>::const_iterator it = m_bearerIndex.begin (); it != m_bearerIndex.end (); ++it)
     {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+      const BearerStats& bearer = m_bearerStats[it->second];
+      if (!bearer.ulTx)
         {
-          pairVector.push_back ((*it).first);
+          continue;
         }
-    }
-
-  Time endTime = m_startTime + m_epochDuration;
-  for (std::vector<ImsiLcidPair_t>::iterator it = pairVector.begin (); it != pairVector.end (); ++it)
-    {
-      ImsiLcidPair_t p = *it;
+      ImsiLcidPair_t p = it->first;
       outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
       outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
+      outFile << bearer.ulCellId << "\t";
       outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxData (p.m_imsi, p.m_lcId) << "\t";
+      outFile << bearer.flowId.m_rnti << "\t";
+      outFile << (uint32_t) bearer.flowId.m_lcId << "\t";
+      outFile << bearer.ulTxPackets << "\t";
+      outFile << bearer.ulTxData << "\t";
+      outFile << bearer.ulRxPackets << "\t";
+      outFile << bearer.ulRxData << "\t";
       std::vector<double> stats = GetUlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
@@ -307,10 +307,8 @@ RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
         {
           outFile << (*it) << "\t";
         }
-      outFile << std::endl;
+      outFile << "\n";
     }
-
-  outFile.close ();
 }
 
 void
@@ -318,30 +316,26 @@ RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
 
-  // Get the unique IMSI list
-  std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_dlTxPackets.begin (); it != m_dlTxPackets.end (); ++it)
+  // the bearers are written in (IMSI, LCID) order
+  Time endTime = m_startTime + m_epochDuration;
+  for (std::map<ImsiLcidPair_t, uint32_t>::const_iterator it = m_bearerIndex.begin (); it != m_bearerIndex.end (); ++it)
     {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+      const BearerStats& bearer = m_bearerStats[it->second];
+      if (!bearer.dlTx)
         {
-          pairVector.push_back ((*it).first);
+          continue;
         }
-    }
-
-  Time endTime = m_startTime + m_epochDuration;
-  for (std::vector<ImsiLcidPair_t>::iterator pair = pairVector.begin (); pair != pairVector.end (); ++pair)
-    {
-      ImsiLcidPair_t p = *pair;
+      ImsiLcidPair_t p = it->first;
       outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
       outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
+      outFile << bearer.dlCellId << "\t";
       outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxData (p.m_imsi, p.m_lcId) << "\t";
+      outFile << bearer.flowId.m_rnti << "\t";
+      outFile << (uint32_t) bearer.flowId.m_lcId << "\t";
+      outFile << bearer.dlTxPackets << "\t";
+      outFile << bearer.dlTxData << "\t";
+      outFile << bearer.dlRxPackets << "\t";
+      outFile << bearer.dlRxData << "\t";
       std::vector<double> stats = GetDlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
@@ -352,10 +346,8 @@ RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
         {
           outFile << (*it) << "\t";
         }
-      outFile << std::endl;
+      outFile << "\n";
     }
-
-  outFile.close ();
 }
 
 void
@@ -363,19 +355,32 @@ RadioBearerStatsCalculator::ResetResults (void)
 {
   NS_LOG_FUNCTION (this);
 
-  m_ulTxPackets.erase (m_ulTxPackets.begin (), m_ulTxPackets.end ());
-  m_ulRxPackets.erase (m_ulRxPackets.begin (), m_ulRxPackets.end ());
-  m_ulRxData.erase (m_ulRxData.begin (), m_ulRxData.end ());
-  m_ulTxData.erase (m_ulTxData.begin (), m_ulTxData.end ());
-  m_ulDelay.erase (m_ulDelay.begin (), m_ulDelay.end ());
-  m_ulPduSize.erase (m_ulPduSize.begin (), m_ulPduSize.end ());
+  // the cell ids and the flow ids are kept across the epochs, as well
+  // as the calculators of each bearer, which are just reset
+  for (std::vector<BearerStats>::iterator it = m_bearerStats.begin (); it != m_bearerStats.end (); ++it)
+    {
+      it->ulTx = false;
+      it->ulTxPackets = 0;
+      it->ulRxPackets = 0;
+      it->ulRxData = 0;
+      it->ulTxData = 0;
+      if (it->ulDelay != 0)
+        {
+          it->ulDelay->Reset ();
+          it->ulPduSize->Reset ();
+        }
 
-  m_dlTxPackets.erase (m_dlTxPackets.begin (), m_dlTxPackets.end ());
-  m_dlRxPackets.erase (m_dlRxPackets.begin (), m_dlRxPackets.end ());
-  m_dlRxData.erase (m_dlRxData.begin (), m_dlRxData.end ());
-  m_dlTxData.erase (m_dlTxData.begin (), m_dlTxData.end ());
-  m_dlDelay.erase (m_dlDelay.begin (), m_dlDelay.end ());
-  m_dlPduSize.erase (m_dlPduSize.begin (), m_dlPduSize.end ());
+      it->dlTx = false;
+      it->dlTxPackets = 0;
+      it->dlRxPackets = 0;
+      it->dlRxData = 0;
+      it->dlTxData = 0;
+      if (it->dlDelay != 0)
+        {
+          it->dlDelay->Reset ();
+          it->dlPduSize->Reset ();
+        }
+    }
 }
 
 void
@@ -401,57 +406,55 @@ uint32_t
 RadioBearerStatsCalculator::GetUlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxPackets[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->ulTxPackets;
 }
 
 uint32_t
 RadioBearerStatsCalculator::GetUlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxPackets[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->ulRxPackets;
 }
 
 uint64_t
 RadioBearerStatsCalculator::GetUlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxData[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->ulTxData;
 }
 
 uint64_t
 RadioBearerStatsCalculator::GetUlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxData[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->ulRxData;
 }
 
 double
 RadioBearerStatsCalculator::GetUlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  if (stats == 0 || stats->ulDelay == 0 || stats->ulDelay->getCount () == 0)
     {
       NS_LOG_ERROR ("UL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
       return 0;
 
     }
-  return m_ulDelay[p]->getMean ();
+  return stats->ulDelay->getMean ();
 }
 
 std::vector<double>
 RadioBearerStatsCalculator::GetUlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
   std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats* bearer = FindBearerStats (imsi, lcid);
+  if (bearer == 0 || bearer->ulDelay == 0 || bearer->ulDelay->getCount () == 0)
     {
       stats.push_back (0.0);
       stats.push_back (0.0);
@@ -460,10 +463,10 @@ RadioBearerStatsCalculator::GetUlDelayStats (uint64_t imsi, uint8_t lcid)
       return stats;
 
     }
-  stats.push_back (m_ulDelay[p]->getMean ());
-  stats.push_back (m_ulDelay[p]->getStddev ());
-  stats.push_back (m_ulDelay[p]->getMin ());
-  stats.push_back (m_ulDelay[p]->getMax ());
+  stats.push_back (bearer->ulDelay->getMean ());
+  stats.push_back (bearer->ulDelay->getStddev ());
+  stats.push_back (bearer->ulDelay->getMin ());
+  stats.push_back (bearer->ulDelay->getMax ());
   return stats;
 }
 
@@ -471,10 +474,9 @@ std::vector<double>
 RadioBearerStatsCalculator::GetUlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
   std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_ulPduSize.find (p);
-  if (it == m_ulPduSize.end ())
+  const BearerStats* bearer = FindBearerStats (imsi, lcid);
+  if (bearer == 0 || bearer->ulPduSize == 0 || bearer->ulPduSize->getCount () == 0)
     {
       stats.push_back (0.0);
       stats.push_back (0.0);
@@ -483,10 +485,10 @@ RadioBearerStatsCalculator::GetUlPduSizeStats (uint64_t imsi, uint8_t lcid)
       return stats;
 
     }
-  stats.push_back (m_ulPduSize[p]->getMean ());
-  stats.push_back (m_ulPduSize[p]->getStddev ());
-  stats.push_back (m_ulPduSize[p]->getMin ());
-  stats.push_back (m_ulPduSize[p]->getMax ());
+  stats.push_back (bearer->ulPduSize->getMean ());
+  stats.push_back (bearer->ulPduSize->getStddev ());
+  stats.push_back (bearer->ulPduSize->getMin ());
+  stats.push_back (bearer->ulPduSize->getMax ());
   return stats;
 }
 
@@ -494,72 +496,70 @@ uint32_t
 RadioBearerStatsCalculator::GetDlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxPackets[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->dlTxPackets;
 }
 
 uint32_t
 RadioBearerStatsCalculator::GetDlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxPackets[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->dlRxPackets;
 }
 
 uint64_t
 RadioBearerStatsCalculator::GetDlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxData[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->dlTxData;
 }
 
 uint64_t
 RadioBearerStatsCalculator::GetDlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxData[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->dlRxData;
 }
 
 uint32_t
 RadioBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulCellId[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->ulCellId;
 }
 
 uint32_t
 RadioBearerStatsCalculator::GetDlCellId (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlCellId[p];
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  return stats == 0 ? 0 : stats->dlCellId;
 }
 
 double
 RadioBearerStatsCalculator::GetDlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats* stats = FindBearerStats (imsi, lcid);
+  if (stats == 0 || stats->dlDelay == 0 || stats->dlDelay->getCount () == 0)
     {
       NS_LOG_ERROR ("DL delay for " << imsi << " not found");
       return 0;
     }
-  return m_dlDelay[p]->getMean ();
+  return stats->dlDelay->getMean ();
 }
 
 std::vector<double>
 RadioBearerStatsCalculator::GetDlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
   std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats* bearer = FindBearerStats (imsi, lcid);
+  if (bearer == 0 || bearer->dlDelay == 0 || bearer->dlDelay->getCount () == 0)
     {
       stats.push_back (0.0);
       stats.push_back (0.0);
@@ -568,10 +568,10 @@ RadioBearerStatsCalculator::GetDlDelayStats (uint64_t imsi, uint8_t lcid)
       return stats;
 
     }
-  stats.push_back (m_dlDelay[p]->getMean ());
-  stats.push_back (m_dlDelay[p]->getStddev ());
-  stats.push_back (m_dlDelay[p]->getMin ());
-  stats.push_back (m_dlDelay[p]->getMax ());
+  stats.push_back (bearer->dlDelay->getMean ());
+  stats.push_back (bearer->dlDelay->getStddev ());
+  stats.push_back (bearer->dlDelay->getMin ());
+  stats.push_back (bearer->dlDelay->getMax ());
   return stats;
 }
 
@@ -579,10 +579,9 @@ std::vector<double>
 RadioBearerStatsCalculator::GetDlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
   std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_dlPduSize.find (p);
-  if (it == m_dlPduSize.end ())
+  const BearerStats* bearer = FindBearerStats (imsi, lcid);
+  if (bearer == 0 || bearer->dlPduSize == 0 || bearer->dlPduSize->getCount () == 0)
     {
       stats.push_back (0.0);
       stats.push_back (0.0);
@@ -591,10 +590,10 @@ RadioBearerStatsCalculator::GetDlPduSizeStats (uint64_t imsi, uint8_t lcid)
       return stats;
 
     }
-  stats.push_back (m_dlPduSize[p]->getMean ());
-  stats.push_back (m_dlPduSize[p]->getStddev ());
-  stats.push_back (m_dlPduSize[p]->getMin ());
-  stats.push_back (m_dlPduSize[p]->getMax ());
+  stats.push_back (bearer->dlPduSize->getMean ());
+  stats.push_back (bearer->dlPduSize->getStddev ());
+  stats.push_back (bearer->dlPduSize->getMin ());
+  stats.push_back (bearer->dlPduSize->getMax ());
   return stats;
 }
 
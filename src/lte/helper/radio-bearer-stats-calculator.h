@@ -30,6 +30,7 @@
 #include "ns3/lte-common.h"
 #include <string>
 #include <map>
+#include <vector>
 #include <fstream>
 
 namespace ns3
@@ -353,22 +354,20 @@ private:
    * Called after each epoch to write collected
    * statistics to output files. During first call
    * it opens output files and write columns descriptions.
-   * During next calls it opens output files in append mode.
+   * The files are then kept open for the next calls.
    */
   void
   ShowResults (void);
 
   /**
-   * Writes collected statistics to UL output file and
-   * closes UL output file.
+   * Writes collected statistics to UL output file.
    * @param outFile ofstream for UL statistics
    */
   void
   WriteUlResults (std::ofstream& outFile);
 
   /**
-   * Writes collected statistics to DL output file and
-   * closes DL output file.
+   * Writes collected statistics to DL output file.
    * @param outFile ofstream for DL statistics
    */
   void
@@ -395,23 +394,59 @@ private:
 
   EventId m_endEpochEvent; //!< Event id for next end epoch event
 
-  FlowIdMap m_flowId; //!< List of FlowIds, ie. (RNTI, LCID) by (IMSI, LCID) pair
+  /**
+   * Statistics of a radio bearer collected during the on going epoch
+   */
+  struct BearerStats
+  {
+    BearerStats ();
+
+    LteFlowId_t flowId; //!< FlowId, ie. (RNTI, LCID)
+    uint32_t dlCellId; //!< DL CellId
+    uint32_t ulCellId; //!< UL CellId
+    bool dlTx; //!< true if DL PDUs have been transmitted during the epoch
+    bool ulTx; //!< true if UL PDUs have been transmitted during the epoch
+    uint32_t dlTxPackets; //!< Number of DL TX Packets
+    uint32_t dlRxPackets; //!< Number of DL RX Packets
+    uint64_t dlTxData; //!< Amount of DL TX Data
+    uint64_t dlRxData; //!< Amount of DL RX Data
+    uint32_t ulTxPackets; //!< Number of UL TX Packets
+    uint32_t ulRxPackets; //!< Number of UL RX Packets
+    uint64_t ulTxData; //!< Amount of UL TX Data
+    uint64_t ulRxData; //!< Amount of UL RX Data
+    Ptr<MinMaxAvgTotalCalculator<uint64_t> > dlDelay; //!< DL delay, created at the first DL reception
+    Ptr<MinMaxAvgTotalCalculator<uint32_t> > dlPduSize; //!< DL PDU Size, created at the first DL reception
+    Ptr<MinMaxAvgTotalCalculator<uint64_t> > ulDelay; //!< UL delay, created at the first UL reception
+    Ptr<MinMaxAvgTotalCalculator<uint32_t> > ulPduSize; //!< UL PDU Size, created at the first UL reception
+  };
+
+  /**
+   * Get the statistics of a radio bearer, adding them the first
+   * time the bearer is seen
+   * @param p (IMSI, LCID) pair of the bearer
+   * @return the statistics of the bearer
+   */
+  BearerStats& GetBearerStats (ImsiLcidPair_t p);
+
+  /**
+   * Find the statistics of a radio bearer
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @return the statistics of the bearer, or 0 if the bearer has not been seen
+   */
+  const BearerStats* FindBearerStats (uint64_t imsi, uint8_t lcid) const;
 
-  Uint32Map m_dlCellId; //!< List of DL CellIds by (IMSI, LCID) pair
-  Uint32Map m_dlTxPackets; //!< Number of DL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_dlRxPackets; //!< Number of DL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_dlTxData; //!< Amount of DL TX Data by (IMSI, LCID) pair
-  Uint64Map m_dlRxData; //!< Amount of DL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_dlDelay; //!< DL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_dlPduSize; //!< DL PDU Size by (IMSI, LCID) pair
+  /**
+   * Index in m_bearerStats by (IMSI, LCID) pair; being ordered, it
+   * also gives the order in which the bearers are written to the files
+   */
+  std::map<ImsiLcidPair_t, uint32_t> m_bearerIndex;
 
-  Uint32Map m_ulCellId; //!< List of UL CellIds by (IMSI, LCID) pair
-  Uint32Map m_ulTxPackets; //!< Number of UL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_ulRxPackets; //!< Number of UL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_ulTxData; //!< Amount of UL TX Data by (IMSI, LCID) pair
-  Uint64Map m_ulRxData; //!< Amount of UL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_ulDelay; //!< UL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_ulPduSize; //!< UL PDU Size by (IMSI, LCID) pair
+  /**
+   * Statistics of all the radio bearers seen so far, stored contiguously
+   * so that each PDU costs a single lookup in m_bearerIndex
+   */
+  std::vector<BearerStats> m_bearerStats;
 
   /**
    * Start time of the on going epoch
@@ -424,9 +459,14 @@ private:
   Time m_epochDuration;
 
   /**
-   * true if output files have not been opened yet
+   * Output stream of the UL statistics, kept open between the epochs
+   */
+  std::ofstream m_ulOutFile;
+
+  /**
+   * Output stream of the DL statistics, kept open between the epochs
    */
-  bool m_firstWrite;
+  std::ofstream m_dlOutFile;
 
   /**
    * true if any output is pending
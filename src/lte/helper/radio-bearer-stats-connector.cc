@@ -151,22 +151,26 @@ RadioBearerStatsConnector::EnsureConnected ()
   NS_LOG_FUNCTION (this);
   if (!m_connected)
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, this));
+      // each wildcard lookup walks all the devices of all the nodes, hence
+      // it is done once for all the trace sources of the matched RRCs
+      Config::MatchContainer enbRrcs = Config::LookupMatches ("/NodeList/*/DeviceList/*/LteEnbRrc");
+      enbRrcs.Connect ("NewUeContext",
+                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
+      enbRrcs.Connect ("ConnectionReconfiguration",
+                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
+      enbRrcs.Connect ("HandoverStart",
+                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, this));
+      enbRrcs.Connect ("HandoverEndOk",
+                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, this));
+      Config::MatchContainer ueRrcs = Config::LookupMatches ("/NodeList/*/DeviceList/*/LteUeRrc");
+      ueRrcs.Connect ("RandomAccessSuccessful",
+                      MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
+      ueRrcs.Connect ("ConnectionReconfiguration",
+                      MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
+      ueRrcs.Connect ("HandoverStart",
+                      MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, this));
+      ueRrcs.Connect ("HandoverEndOk",
+                      MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, this));
       m_connected = true;
     }
 }
@@ -258,31 +262,25 @@ RadioBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
 
+      Config::MatchContainer ueSrb0 = Config::LookupMatches (ueRrcPath + "/Srb0/LteRlc");
+      Config::MatchContainer enbSrb0 = Config::LookupMatches (ueManagerPath + "/Srb0/LteRlc");
+
       // diconnect eventually previously connected SRB0 both at UE and eNB
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&UlRxPduCallback, arg));
+      ueSrb0.Disconnect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      ueSrb0.Disconnect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      enbSrb0.Disconnect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      enbSrb0.Disconnect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB0 both at UE and eNB
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ueSrb0.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      ueSrb0.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      enbSrb0.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      enbSrb0.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::MatchContainer enbSrb1 = Config::LookupMatches (ueManagerPath + "/Srb1/LteRlc");
+      enbSrb1.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      enbSrb1.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -292,10 +290,9 @@ RadioBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi
       arg->stats = m_pdcpStats;
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::MatchContainer enbSrb1 = Config::LookupMatches (ueManagerPath + "/Srb1/LtePdcp");
+      enbSrb1.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
+      enbSrb1.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
     }
 }
 
@@ -309,10 +306,9 @@ RadioBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (ueRrcPath + "/Srb1/LteRlc");
+      srb1.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      srb1.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -320,10 +316,9 @@ RadioBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (ueRrcPath + "/Srb1/LtePdcp");
+      srb1.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      srb1.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
     }
 }
   
@@ -361,14 +356,12 @@ RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::MatchContainer drbs = Config::LookupMatches (basePath + "/DataRadioBearerMap/*/LteRlc");
+      drbs.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      drbs.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (basePath + "/Srb1/LteRlc");
+      srb1.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      srb1.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
 
     }
   if (m_pdcpStats)
@@ -377,14 +370,12 @@ RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::MatchContainer drbs = Config::LookupMatches (basePath + "/DataRadioBearerMap/*/LtePdcp");
+      drbs.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      drbs.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (basePath + "/Srb1/LtePdcp");
+      srb1.Connect ("RxPDU", MakeBoundCallback (&DlRxPduCallback, arg));
+      srb1.Connect ("TxPDU", MakeBoundCallback (&UlTxPduCallback, arg));
     }
 }
 
@@ -401,18 +392,15 @@ RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::MatchContainer drbs = Config::LookupMatches (basePath.str () + "/DataRadioBearerMap/*/LteRlc");
+      drbs.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
+      drbs.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::MatchContainer srb0 = Config::LookupMatches (basePath.str () + "/Srb0/LteRlc");
+      srb0.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
+      srb0.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (basePath.str () + "/Srb1/LteRlc");
+      srb1.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
+      srb1.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -420,14 +408,12 @@ RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::MatchContainer drbs = Config::LookupMatches (basePath.str () + "/DataRadioBearerMap/*/LtePdcp");
+      drbs.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      drbs.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::MatchContainer srb1 = Config::LookupMatches (basePath.str () + "/Srb1/LtePdcp");
+      srb1.Connect ("TxPDU", MakeBoundCallback (&DlTxPduCallback, arg));
+      srb1.Connect ("RxPDU", MakeBoundCallback (&UlRxPduCallback, arg));
     }
 }
 
@@ -28,6 +28,7 @@
 #include <ns3/uinteger.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
+#include <ns3/pointer.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/config.h>
 #include <ns3/rem-spectrum-phy.h>
@@ -37,9 +38,26 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/node-list.h>
+#include <ns3/building-list.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/object-factory.h>
+#include <ns3/core-config.h>
 
 #include <fstream>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#endif
 
 namespace ns3 {
 
@@ -47,6 +65,59 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
+/**
+ * Create a new propagation loss model with the attributes of another one,
+ * and copies of the models chained to it.
+ *
+ * A model with an attribute pointing to an object (such as the random
+ * variable of RandomPropagationLossModel) is not copied, since the copy
+ * would share that object with the original model.
+ *
+ * \param model the propagation loss model to copy
+ * \return the copy, or 0 if the model can not be created from its TypeId
+ *         or holds a pointer attribute
+ */
+static Ptr<PropagationLossModel>
+CopyPropagationLossModel (Ptr<PropagationLossModel> model)
+{
+  TypeId tid = model->GetInstanceTypeId ();
+  if (!tid.HasConstructor ())
+    {
+      return 0;
+    }
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  for (TypeId t = tid; t != Object::GetTypeId (); t = t.GetParent ())
+    {
+      for (uint32_t i = 0; i < t.GetAttributeN (); ++i)
+        {
+          struct TypeId::AttributeInformation info = t.GetAttribute (i);
+          if ((info.flags & TypeId::ATTR_GET) && (info.flags & TypeId::ATTR_CONSTRUCT))
+            {
+              Ptr<AttributeValue> value = info.checker->Create ();
+              model->GetAttribute (info.name, *value);
+              const PointerValue *pointer = dynamic_cast<const PointerValue *> (PeekPointer (value));
+              if (pointer != 0 && pointer->GetObject () != 0)
+                {
+                  return 0;
+                }
+              factory.Set (info.name, *value);
+            }
+        }
+    }
+  Ptr<PropagationLossModel> copy = factory.Create<PropagationLossModel> ();
+  if (model->GetNext () != 0)
+    {
+      Ptr<PropagationLossModel> next = CopyPropagationLossModel (model->GetNext ());
+      if (next == 0)
+        {
+          return 0;
+        }
+      copy->SetNext (next);
+    }
+  return copy;
+}
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
 {
 }
@@ -144,6 +215,22 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Direct",
+                   "If true, the REM is computed directly from the antenna and "
+                   "propagation loss models of the channel, assuming that every "
+                   "eNodeB transmits over its whole bandwidth, rather than by "
+                   "simulating the reception of the signals at each point",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_direct),
+                   MakeBooleanChecker ())
+    .AddAttribute ("DirectThreads",
+                   "Number of threads computing the REM in direct mode; 0 to use "
+                   "one per processor. A single thread is used when there are "
+                   "buildings, which are not safe to use from several threads, "
+                   "or when a propagation loss model has a pointer attribute",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_directThreads),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -200,6 +287,12 @@ RadioEnvironmentMapHelper::Install ()
       return;
     }
   
+  if (m_direct)
+    {
+      Simulator::ScheduleNow (&RadioEnvironmentMapHelper::RunDirect, this);
+      return;
+    }
+
   double startDelay = 0.0026;
 
   if (m_useDataChannel)
@@ -352,4 +445,215 @@ RadioEnvironmentMapHelper::Finalize ()
 }
 
 
+void
+RadioEnvironmentMapHelper::RunDirect ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<const SpectrumModel> rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  DoubleValue maxLossDb (std::numeric_limits<double>::infinity ());
+  m_channel->GetAttributeFailSafe ("MaxLossDb", maxLossDb);
+  m_maxLossDb = maxLossDb.Get ();
+
+  // the transmitters are the eNodeB component carriers using the channel
+  std::vector<Ptr<MobilityModel> > txMobility;
+  m_transmitters.clear ();
+  for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+    {
+      for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = (*nodeIt)->GetDevice (i)->GetObject<LteEnbNetDevice> ();
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          std::map<uint8_t, Ptr<ComponentCarrierEnb> > ccMap = enbDev->GetCcMap ();
+          for (std::map<uint8_t, Ptr<ComponentCarrierEnb> >::iterator ccIt = ccMap.begin ();
+               ccIt != ccMap.end (); ++ccIt)
+            {
+              Ptr<LteEnbPhy> enbPhy = ccIt->second->GetPhy ();
+              Ptr<LteSpectrumPhy> dlPhy = enbPhy->GetDownlinkSpectrumPhy ();
+              if (dlPhy->GetChannel () != m_channel || dlPhy->GetMobility () == 0)
+                {
+                  continue;
+                }
+
+              // the PSD of the control channel, over the whole bandwidth
+              std::vector<int> rbs;
+              for (uint8_t rb = 0; rb < ccIt->second->GetDlBandwidth (); ++rb)
+                {
+                  rbs.push_back (rb);
+                }
+              Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (ccIt->second->GetDlEarfcn (),
+                                                                                           ccIt->second->GetDlBandwidth (),
+                                                                                           enbPhy->GetTxPower (),
+                                                                                           rbs);
+              if (psd->GetSpectrumModelUid () != rxSpectrumModel->GetUid ())
+                {
+                  if (psd->GetSpectrumModel ()->IsOrthogonal (*rxSpectrumModel))
+                    {
+                      continue;
+                    }
+                  SpectrumConverter converter (psd->GetSpectrumModel (), rxSpectrumModel);
+                  psd = converter.Convert (psd);
+                }
+
+              DirectTransmitter tx;
+              tx.position = dlPhy->GetMobility ()->GetPosition ();
+              tx.antenna = dlPhy->GetRxAntenna ();
+              tx.power = (m_rbId >= 0) ? (*psd)[m_rbId] * 180000 : Integral (*psd);
+              m_transmitters.push_back (tx);
+              txMobility.push_back (dlPhy->GetMobility ());
+            }
+        }
+    }
+  NS_LOG_LOGIC (m_transmitters.size () << " transmitters");
+
+  // the points of the map, as placed by DelayedInstall
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+  m_xPoints.clear ();
+  m_yPoints.clear ();
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      m_xPoints.push_back (x);
+    }
+  for (double y = m_yMin; y < m_yMax + 0.5*m_yStep; y += m_yStep)
+    {
+      m_yPoints.push_back (y);
+    }
+  m_sinr.assign (m_xPoints.size () * m_yPoints.size (), 0.0);
+
+  // Ptr reference counts are not atomic: each thread uses its own copies of
+  // the mobility and propagation loss models.  The buildings are shared by
+  // the mobility models located in them, so that they are used by one thread.
+  Ptr<PropagationLossModel> loss = m_channel->GetPropagationLossModel ();
+  uint32_t nThreads = 1;
+#ifdef HAVE_PTHREAD_H
+  nThreads = m_directThreads;
+  if (nThreads == 0)
+    {
+      nThreads = std::max (std::thread::hardware_concurrency (), 1U);
+    }
+  if (BuildingList::GetNBuildings () > 0)
+    {
+      nThreads = 1;
+    }
+  nThreads = std::min<uint32_t> (nThreads, m_xPoints.size ());
+#endif
+  if (m_channel->GetSpectrumPropagationLossModel () != 0)
+    {
+      NS_LOG_WARN ("the frequency-dependent propagation loss models are ignored by the direct REM");
+    }
+
+  if (nThreads > 1 && loss != 0 && CopyPropagationLossModel (loss) == 0)
+    {
+      NS_LOG_WARN ("can not copy " << loss->GetInstanceTypeId ().GetName () << ", using one thread");
+      nThreads = 1;
+    }
+
+  std::vector<DirectWorker> workers (nThreads);
+  for (uint32_t t = 0; t < nThreads; ++t)
+    {
+      DirectWorker &worker = workers[t];
+      worker.firstColumn = t;
+      worker.columnStep = nThreads;
+      if (nThreads == 1)
+        {
+          worker.loss = loss;
+          worker.txMobility = txMobility;
+        }
+      else
+        {
+          worker.loss = (loss == 0) ? 0 : CopyPropagationLossModel (loss);
+          for (uint32_t i = 0; i < m_transmitters.size (); ++i)
+            {
+              Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+              mobility->SetPosition (m_transmitters[i].position);
+              mobility->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+              worker.txMobility.push_back (mobility);
+            }
+        }
+      worker.rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+      Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+      worker.rxMobility->AggregateObject (buildingInfo); // operation usually done by BuildingsHelper::Install
+    }
+
+#ifdef HAVE_PTHREAD_H
+  if (workers.size () > 1)
+    {
+      std::vector<std::thread> threads;
+      for (uint32_t t = 0; t < workers.size (); ++t)
+        {
+          threads.push_back (std::thread (&RadioEnvironmentMapHelper::ComputeDirectColumns, this, &workers[t]));
+        }
+      for (uint32_t t = 0; t < threads.size (); ++t)
+        {
+          threads[t].join ();
+        }
+    }
+  else
+#endif
+    {
+      ComputeDirectColumns (&workers[0]);
+    }
+
+  for (uint32_t i = 0; i < m_xPoints.size (); ++i)
+    {
+      for (uint32_t j = 0; j < m_yPoints.size (); ++j)
+        {
+          m_outFile << m_xPoints[i] << "\t"
+                    << m_yPoints[j] << "\t"
+                    << m_z << "\t"
+                    << m_sinr[i * m_yPoints.size () + j]
+                    << "\n";
+        }
+    }
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::ComputeDirectColumns (DirectWorker *worker)
+{
+  bool buildings = BuildingList::GetNBuildings () > 0;
+  for (uint32_t i = worker->firstColumn; i < m_xPoints.size (); i += worker->columnStep)
+    {
+      for (uint32_t j = 0; j < m_yPoints.size (); ++j)
+        {
+          Vector rxPosition (m_xPoints[i], m_yPoints[j], m_z);
+          worker->rxMobility->SetPosition (rxPosition);
+          if (buildings)
+            {
+              BuildingsHelper::MakeConsistent (worker->rxMobility);
+            }
+
+          // as computed by the channel and RemSpectrumPhy
+          double sumPower = 0;
+          double referenceSignalPower = 0;
+          for (uint32_t k = 0; k < m_transmitters.size (); ++k)
+            {
+              const DirectTransmitter &tx = m_transmitters[k];
+              double pathLossDb = 0;
+              if (tx.antenna != 0)
+                {
+                  pathLossDb -= tx.antenna->GetGainDb (Angles (rxPosition, tx.position));
+                }
+              if (worker->loss != 0)
+                {
+                  pathLossDb -= worker->loss->CalcRxPower (0, worker->txMobility[k], worker->rxMobility);
+                }
+              if (pathLossDb > m_maxLossDb)
+                {
+                  continue;
+                }
+              double power = tx.power * std::pow (10.0, (-pathLossDb) / 10.0);
+              sumPower += power;
+              referenceSignalPower = std::max (referenceSignalPower, power);
+            }
+          m_sinr[i * m_yPoints.size () + j] = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+        }
+    }
+}
+
+
 } // namespace ns3
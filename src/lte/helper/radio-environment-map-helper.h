@@ -24,7 +24,9 @@
 
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +37,8 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class PropagationLossModel;
 
 /** 
  * \ingroup lte
@@ -42,6 +46,14 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the map is generated by simulating the reception of the
+ * signals by a RemSpectrumPhy at each point.  When the `Direct` attribute
+ * is set, the received powers are instead computed directly from the
+ * antenna and propagation loss models of the channel, for every eNodeB
+ * transmitting on the channel over its whole bandwidth, by several worker
+ * threads.  The frequency-dependent propagation loss models (fading) are
+ * ignored in this mode.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -108,6 +120,38 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Scheduled by Install() in direct mode: compute the SINR at every point
+   * of the map, write the map and call Finalize().
+   */
+  void RunDirect ();
+
+  /// A transmitter of the downlink, for the direct computation of the map.
+  struct DirectTransmitter
+  {
+    Vector position;              ///< Position of the transmitter.
+    Ptr<AntennaModel> antenna;    ///< Antenna of the transmitter, or 0.
+    double power;                 ///< Transmitted power in W, over the RBs of the map.
+  };
+
+  /// The objects used by one of the threads computing the map.
+  struct DirectWorker
+  {
+    uint32_t firstColumn;                        ///< First column of the map computed.
+    uint32_t columnStep;                         ///< Number of columns between two computed columns.
+    Ptr<PropagationLossModel> loss;              ///< Copy of the propagation loss model of the channel.
+    std::vector<Ptr<MobilityModel> > txMobility; ///< Copies of the mobility of the transmitters.
+    Ptr<MobilityModel> rxMobility;               ///< Mobility moved to each point of the map.
+  };
+
+  /**
+   * Compute the SINR at the points of the columns of the map assigned to a
+   * worker.
+   *
+   * \param worker the worker.
+   */
+  void ComputeDirectColumns (DirectWorker *worker);
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +196,16 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_direct;             ///< The `Direct` attribute.
+  uint32_t m_directThreads;  ///< The `DirectThreads` attribute.
+
+  /// Transmitters of the downlink, in direct mode.
+  std::vector<DirectTransmitter> m_transmitters;
+  double m_maxLossDb;             ///< Loss beyond which a signal is ignored, in direct mode.
+  std::vector<double> m_xPoints;  ///< X coordinates of the map, in direct mode.
+  std::vector<double> m_yPoints;  ///< Y coordinates of the map, in direct mode.
+  std::vector<double> m_sinr;     ///< SINR at each point, column by column, in direct mode.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
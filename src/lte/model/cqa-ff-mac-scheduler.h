@@ -28,6 +28,8 @@
 #include <ns3/ff-mac-csched-sap.h>
 #include <ns3/ff-mac-sched-sap.h>
 #include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-harq.h>
+#include <ns3/lte-rnti-map.h>
 #include <vector>
 #include <map>
 #include <set>
@@ -39,25 +41,18 @@
 // is no CQI for this element
 
 #define NO_SINR -5000
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
+
 
 namespace ns3 {
 
+
 /// DL HARQ process status vector typedef
-typedef std::vector < uint8_t > DlHarqProcessesStatus_t;
 /// DL HARQ process timer vector typedef
-typedef std::vector < uint8_t > DlHarqProcessesTimer_t;
 /// DL HARQ process DCI buffer vector typedef
-typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t;
 /// vector of the LCs and layers per UE
-typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; 
 /// vector of the 8 HARQ processes per UE
-typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t;
 /// UL HARQ process DCI buffer vector 
-typedef std::vector < UlDciListElement_s > UlHarqProcessesDciBuffer_t;
 /// UL HARQ process status vector
-typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
 
 /// CGA Flow Performance structure
 struct CqasFlowPerf_t
@@ -271,28 +266,6 @@ private:
    */
   void UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size);
 
-  /**
-  * \brief Update and return a new process Id for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t UpdateHarqProcessId (uint16_t rnti);
-
-  /**
-  * \brief Return the availability of free process for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t HarqProcessAvailability (uint16_t rnti);
-
-  /**
-  * \brief Refresh HARQ processes according to the timers
-  *
-  */
-  void RefreshHarqProcesses ();
-
   Ptr<LteAmc> m_amc; ///< LTE AMC object
 
   /**
@@ -304,12 +277,12 @@ private:
   /**
   * Map of UE statistics (per RNTI basis) in downlink
   */
-  std::map <uint16_t, CqasFlowPerf_t> m_flowStatsDl;
+  LteRntiMap <CqasFlowPerf_t> m_flowStatsDl;
 
   /**
   * Map of UE statistics (per RNTI basis)
   */
-  std::map <uint16_t, CqasFlowPerf_t> m_flowStatsUl;
+  LteRntiMap <CqasFlowPerf_t> m_flowStatsUl;
 
   /**
   * Map of UE logical channel config list
@@ -319,22 +292,22 @@ private:
   /**
   * Map of UE's DL CQI P01 received
   */
-  std::map <uint16_t,uint8_t> m_p10CqiRxed;
+  LteRntiMap <uint8_t> m_p10CqiRxed;
 
   /**
   * Map of UE's timers on DL CQI P01 received
   */
-  std::map <uint16_t,uint32_t> m_p10CqiTimers;
+  LteRntiMap <uint32_t> m_p10CqiTimers;
 
   /**
   * Map of UE's DL CQI A30 received
   */
-  std::map <uint16_t,SbMeasResult_s> m_a30CqiRxed;
+  LteRntiMap <SbMeasResult_s> m_a30CqiRxed;
 
   /**
   * Map of UE's timers on DL CQI A30 received
   */
-  std::map <uint16_t,uint32_t> m_a30CqiTimers;
+  LteRntiMap <uint32_t> m_a30CqiTimers;
 
   /**
   * Map of previous allocated UE per RBG
@@ -350,12 +323,12 @@ private:
   /**
   * Map of UEs' timers on UL-CQI per RBG
   */
-  std::map <uint16_t, uint32_t> m_ueCqiTimers;
+  LteRntiMap <uint32_t> m_ueCqiTimers;
 
   /**
   * Map of UE's buffer status reports received
   */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
+  LteRntiMap <uint32_t> m_ceBsrRxed;
 
   // MAC SAPs
   FfMacCschedSapUser* m_cschedSapUser; ///< MAC Csched SAP user
@@ -377,26 +350,11 @@ private:
 
   uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
 
-  std::map <uint16_t,uint8_t> m_uesTxMode; ///< txMode of the UEs
+  LteRntiMap <uint8_t> m_uesTxMode; ///< txMode of the UEs
 
   // HARQ attributes
   bool m_harqOn; ///< m_harqOn when false inhibit the HARQ mechanisms (by default active)
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process statuses
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timers
-  std::map <uint16_t, DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-  std::map <uint16_t, DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
-  std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< DL HARQ retx buffered
-
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
-  std::map <uint16_t, UlHarqProcessesDciBuffer_t> m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer
+  FfMacSchedulerHarq m_harq; ///< HARQ processes of the UEs
 
 
   // RACH attributes
@@ -177,7 +177,7 @@ void
 EpcEnbApplication::DoUeContextRelease (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
-  std::map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
+  std::unordered_map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
   if (rntiIt != m_rbidTeidMap.end ())
     {
       for (std::map<uint8_t, uint32_t>::iterator bidIt = rntiIt->second.begin ();
@@ -203,7 +203,7 @@ EpcEnbApplication::DoInitialContextSetupRequest (uint64_t mmeUeS1Id, uint16_t en
       // request the RRC to setup a radio bearer
 
       uint64_t imsi = mmeUeS1Id;
-      std::map<uint64_t, uint16_t>::iterator imsiIt = m_imsiRntiMap.find (imsi);
+      std::unordered_map<uint64_t, uint16_t>::iterator imsiIt = m_imsiRntiMap.find (imsi);
       NS_ASSERT_MSG (imsiIt != m_imsiRntiMap.end (), "unknown IMSI");
       uint16_t rnti = imsiIt->second;
       
@@ -228,7 +228,7 @@ EpcEnbApplication::DoPathSwitchRequestAcknowledge (uint64_t enbUeS1Id, uint64_t
   NS_LOG_FUNCTION (this);
 
   uint64_t imsi = mmeUeS1Id;
-  std::map<uint64_t, uint16_t>::iterator imsiIt = m_imsiRntiMap.find (imsi);
+  std::unordered_map<uint64_t, uint16_t>::iterator imsiIt = m_imsiRntiMap.find (imsi);
   NS_ASSERT_MSG (imsiIt != m_imsiRntiMap.end (), "unknown IMSI");
   uint16_t rnti = imsiIt->second;
   EpcEnbS1SapUser::PathSwitchRequestAcknowledgeParameters params;
@@ -249,7 +249,7 @@ EpcEnbApplication::RecvFromLteSocket (Ptr<Socket> socket)
   uint16_t rnti = tag.GetRnti ();
   uint8_t bid = tag.GetBid ();
   NS_LOG_LOGIC ("received packet with RNTI=" << (uint32_t) rnti << ", BID=" << (uint32_t)  bid);
-  std::map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
+  std::unordered_map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
   if (rntiIt == m_rbidTeidMap.end ())
     {
       NS_LOG_WARN ("UE context not found, discarding packet");
@@ -272,7 +272,7 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
-  std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
+  std::unordered_map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
   NS_ASSERT (it != m_teidRbidMap.end ());
 
   SendToLteSocket (packet, it->second.m_rnti, it->second.m_bid);
@@ -35,6 +35,7 @@
 #include <ns3/epc-enb-s1-sap.h>
 #include <ns3/epc-s1ap-sap.h>
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 class EpcEnbS1SapUser;
@@ -264,13 +265,13 @@ private:
    * map of maps telling for each RNTI and BID the corresponding  S1-U TEID
    * 
    */
-  std::map<uint16_t, std::map<uint8_t, uint32_t> > m_rbidTeidMap;  
+  std::unordered_map<uint16_t, std::map<uint8_t, uint32_t> > m_rbidTeidMap;  
 
   /**
    * map telling for each S1-U TEID the corresponding RNTI,BID
    * 
    */
-  std::map<uint32_t, EpsFlowId_t> m_teidRbidMap;
+  std::unordered_map<uint32_t, EpsFlowId_t> m_teidRbidMap;
  
   /**
    * UDP port to be used for GTP
@@ -303,7 +304,7 @@ private:
    * UE context info
    * 
    */
-  std::map<uint64_t, uint16_t> m_imsiRntiMap;
+  std::unordered_map<uint64_t, uint16_t> m_imsiRntiMap;
 
   uint16_t m_cellId; ///< cell ID
 
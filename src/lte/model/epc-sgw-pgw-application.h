@@ -37,6 +37,7 @@
 #include <ns3/epc-s1ap-sap.h>
 #include <ns3/epc-s11-sap.h>
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -261,12 +262,12 @@ public:
   /**
    * Map telling for each UE address the corresponding UE info 
    */
-  std::map<Ipv4Address, Ptr<UeInfo> > m_ueInfoByAddrMap;
+  std::unordered_map<Ipv4Address, Ptr<UeInfo>, Ipv4AddressHash> m_ueInfoByAddrMap;
 
   /**
    * Map telling for each IMSI the corresponding UE info 
    */
-  std::map<uint64_t, Ptr<UeInfo> > m_ueInfoByImsiMap;
+  std::unordered_map<uint64_t, Ptr<UeInfo> > m_ueInfoByImsiMap;
 
   /**
    * UDP port to be used for GTP
@@ -41,6 +41,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
 EpcTftClassifier::EpcTftClassifier ()
+  : m_compiled (false),
+    m_numCompiledFilters (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -51,6 +53,7 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
   NS_LOG_FUNCTION (this << tft);
   
   m_tftMap[id] = tft;  
+  m_compiled = false;
   
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -61,18 +64,71 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_compiled = false;
 }
 
+uint32_t
+EpcTftClassifier::GetNumPacketFilters () const
+{
+  uint32_t n = 0;
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_iterator it = m_tftMap.begin (); it != m_tftMap.end (); ++it)
+    {
+      n += it->second->GetPacketFilters ().size ();
+    }
+  return n;
+}
+
+void
+EpcTftClassifier::Compile ()
+{
+  NS_LOG_FUNCTION (this);
+  m_uplinkFilters.clear ();
+  m_downlinkFilters.clear ();
+  m_numCompiledFilters = 0;
+
+  // we use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
+  for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+    {
+      const std::list<EpcTft::PacketFilter> &filters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator fit = filters.begin (); fit != filters.end (); ++fit)
+        {
+          ++m_numCompiledFilters;
+          CompiledFilter f;
+          f.id = it->first;
+          f.remoteMask = fit->remoteMask.Get ();
+          f.remoteAddress = fit->remoteAddress.Get () & f.remoteMask;
+          f.localMask = fit->localMask.Get ();
+          f.localAddress = fit->localAddress.Get () & f.localMask;
+          f.remotePortStart = fit->remotePortStart;
+          f.remotePortEnd = fit->remotePortEnd;
+          f.localPortStart = fit->localPortStart;
+          f.localPortEnd = fit->localPortEnd;
+          f.anyPort = f.remotePortStart == 0 && f.remotePortEnd == 65535
+            && f.localPortStart == 0 && f.localPortEnd == 65535;
+          f.typeOfServiceMask = fit->typeOfServiceMask;
+          f.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          if (fit->direction & EpcTft::UPLINK)
+            {
+              m_uplinkFilters.push_back (f);
+            }
+          if (fit->direction & EpcTft::DOWNLINK)
+            {
+              m_downlinkFilters.push_back (f);
+            }
+        }
+    }
+  m_compiled = true;
+}
  
 uint32_t 
 EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
   Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  p->PeekHeader (ipv4Header);
 
   Ipv4Address localAddress;
   Ipv4Address remoteAddress;
@@ -94,68 +150,70 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 
   uint8_t tos = ipv4Header.GetTos ();
 
-  uint16_t localPort = 0;
-  uint16_t remotePort = 0;
-
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
+  if (protocol != UdpL4Protocol::PROT_NUMBER && protocol != TcpL4Protocol::PROT_NUMBER)
     {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
-
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
+      NS_LOG_INFO ("Unknown protocol: " << protocol);
+      return 0;  // no match
     }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
+
+  // both the UDP and the TCP headers start with the source and
+  // destination ports: read them without copying the packet. The
+  // non-first fragments, and the packets too short to hold the ports,
+  // only match the filters that accept any port.
+  uint16_t localPort = 0;
+  uint16_t remotePort = 0;
+  uint32_t headerSize = ipv4Header.GetSerializedSize ();
+  bool hasPorts = ipv4Header.GetFragmentOffset () == 0 && p->GetSize () >= headerSize + 4;
+  if (hasPorts)
     {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
+      uint8_t buffer[64];
+      NS_ASSERT (headerSize + 4 <= sizeof (buffer));
+      p->CopyData (buffer, headerSize + 4);
+      uint16_t sourcePort = (buffer[headerSize] << 8) | buffer[headerSize + 1];
+      uint16_t destinationPort = (buffer[headerSize + 2] << 8) | buffer[headerSize + 3];
       if (direction ==  EpcTft::UPLINK)
 	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
+	  localPort = sourcePort;
+	  remotePort = destinationPort;
 	}
       else
 	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
+	  remotePort = sourcePort;
+	  localPort = destinationPort;
 	}
     }
-  else
-    {
-      NS_LOG_INFO ("Unknown protocol: " << protocol);
-      return 0;  // no match
-    }
 
   NS_LOG_INFO ("Classifing packet:"
 	       << " localAddr="  << localAddress 
 	       << " remoteAddr=" << remoteAddress 
 	       << " localPort="  << localPort 
 	       << " remotePort=" << remotePort 
+	       << " hasPorts=" << hasPorts
 	       << " tos=0x" << (uint16_t) tos );
 
   // now it is possible to classify the packet!
-  // we use a reverse iterator since filter priority is not implemented properly.
-  // This way, since the default bearer is expected to be added first, it will be evaluated last.
-  std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+  // Packet filters can only be added to a TFT, so the filter tables are
+  // out of date if the TFTs hold more filters than when they were compiled
+  if (!m_compiled || GetNumPacketFilters () != m_numCompiledFilters)
+    {
+      Compile ();
+    }
+  const std::vector<CompiledFilter> &filters = (direction == EpcTft::UPLINK) ? m_uplinkFilters : m_downlinkFilters;
+  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size () << ", filters: " << filters.size ());
 
-  for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+  uint32_t ra = remoteAddress.Get ();
+  uint32_t la = localAddress.Get ();
+  for (std::vector<CompiledFilter>::const_iterator it = filters.begin (); it != filters.end (); ++it)
     {
-      NS_LOG_LOGIC ("TFT id: " << it->first );
-      NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-      Ptr<EpcTft> tft = it->second;         
-      if (tft->Matches (direction, remoteAddress, localAddress, remotePort, localPort, tos))
+      if ((ra & it->remoteMask) == it->remoteAddress
+          && (la & it->localMask) == it->localAddress
+          && (hasPorts ? (remotePort >= it->remotePortStart && remotePort <= it->remotePortEnd
+                          && localPort >= it->localPortStart && localPort <= it->localPortEnd)
+                       : it->anyPort)
+          && (tos & it->typeOfServiceMask) == it->typeOfService)
         {
-	  NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-	  return it->first; // the id of the matching TFT
+	  NS_LOG_LOGIC ("matches with TFT ID = " << it->id);
+	  return it->id; // the id of the matching TFT
         }
     }
   NS_LOG_LOGIC ("no match");
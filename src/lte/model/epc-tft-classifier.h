@@ -28,6 +28,7 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -48,6 +49,10 @@ public:
   
   /** 
    * add a TFT to the Classifier
+   *
+   * The packet filters of the TFT are compiled when the next packet is
+   * classified.  They are compiled again if filters are added to the TFT
+   * afterwards.
    * 
    * \param tft the TFT to be added
    * \param id the ID of the bearer which will be classified by specified TFT classifier
@@ -66,6 +71,10 @@ public:
   /** 
    * classify an IP packet
    * 
+   * The packets which do not hold the ports, such as the non-first IPv4
+   * fragments, only match the packet filters whose port ranges are both
+   * 0-65535.
+   *
    * \param p the IP packet. It is assumed that the outmost header is an IPv4 header.
    * \param direction the EPC TFT direction (can be downlink, uplink or bi-directional)
    * 
@@ -76,7 +85,42 @@ public:
 protected:
   
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
-  
+
+private:
+
+  /// A packet filter with its addresses masked, for a direction
+  struct CompiledFilter
+  {
+    uint32_t id; ///< the ID of the TFT of the filter
+    uint32_t remoteAddress; ///< the masked address of the remote host
+    uint32_t remoteMask; ///< the address mask of the remote host
+    uint32_t localAddress; ///< the masked address of the UE
+    uint32_t localMask; ///< the address mask of the UE
+    uint16_t remotePortStart; ///< start of the port number range of the remote host
+    uint16_t remotePortEnd; ///< end of the port number range of the remote host
+    uint16_t localPortStart; ///< start of the port number range of the UE
+    uint16_t localPortEnd; ///< end of the port number range of the UE
+    bool anyPort; ///< whether both port number ranges are 0-65535
+    uint8_t typeOfService; ///< the masked type of service
+    uint8_t typeOfServiceMask; ///< type of service field mask
+  };
+
+  /**
+   * Rebuild the filter tables of both directions from the TFTs
+   */
+  void Compile ();
+
+  /**
+   * \return the number of packet filters of all the TFTs
+   */
+  uint32_t GetNumPacketFilters () const;
+
+  /// the filters applying to uplink packets, in the order of evaluation
+  std::vector<CompiledFilter> m_uplinkFilters;
+  /// the filters applying to downlink packets, in the order of evaluation
+  std::vector<CompiledFilter> m_downlinkFilters;
+  bool m_compiled; ///< whether the filter tables match the TFT map
+  uint32_t m_numCompiledFilters; ///< the number of packet filters of the TFTs when compiled
 };
 
 
@@ -205,5 +205,11 @@ EpcTft::Matches (Direction direction,
   return false;
 }
 
+const std::list<EpcTft::PacketFilter>&
+EpcTft::GetPacketFilters () const
+{
+  return m_filters;
+}
+
 
 } // namespace ns3
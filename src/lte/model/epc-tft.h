@@ -150,6 +150,11 @@ public:
 		  uint16_t localPort,
 		  uint8_t typeOfService);
 
+  /**
+   * \return the packet filters, in the order in which they are evaluated
+   */
+  const std::list<PacketFilter>& GetPacketFilters () const;
+
 
 private:
 
@@ -336,6 +336,8 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
   
   if (m_amcModel == PiroEW2010)
     {
+      // the SINR gap of the BER does not depend on the RB
+      double gap = (-std::log (5.0 * m_ber )) / 1.5;
 
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
@@ -354,7 +356,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               * NB: SINR must be expressed in linear units
               */
 
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
+              double s = log2 ( 1 + ( sinr_ / gap ));
 
               int cqi_ = GetCqiFromSpectralEfficiency (s);
 
@@ -379,26 +381,32 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
         rbgMap.push_back (rbId++);
         if ((rbId % rbgSize == 0)||((it+1)==sinr.ConstValuesEnd ()))
          {
+            // the mmib of the RBG only depends on the modulation, hence
+            // it is computed once for the QPSK, 16QAM and 64QAM MCSs
+            // instead of once for each MCS
             uint8_t mcs = 0;
-            TbStats_t tbStats;
+            double mib = 0.0;
+            double tbler = 0.0;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
-                if (tbStats.tbler > 0.1)
+                if ((mcs == 0) || (mcs == MI_QPSK_MAX_ID + 1) || (mcs == MI_16QAM_MAX_ID + 1))
+                  {
+                    mib = LteMiErrorModel::Mib (sinr, rbgMap, mcs);
+                  }
+                tbler = LteMiErrorModel::GetTbBler (mib, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs);
+                if (tbler > 0.1)
                   {
                     break;
                   }
                 mcs++;
-                
               }
             if (mcs > 0)
               {
                 mcs--;
               }
-            NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
+            NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbler);
             int rbgCqi = 0;
-            if ((tbStats.tbler > 0.1)&&(mcs==0))
+            if ((tbler > 0.1)&&(mcs==0))
               {
                 rbgCqi = 0; // any MCS can guarantee the 10 % of BER
               }
@@ -408,12 +416,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               }
             else
               {
-                double s = SpectralEfficiencyForMcs[mcs];
-                rbgCqi = 0;
-                while ((rbgCqi < 15) && (SpectralEfficiencyForCqi[rbgCqi + 1] < s))
-                {
-                  ++rbgCqi;
-                }
+                rbgCqi = GetCqiFromSpectralEfficiency (SpectralEfficiencyForMcs[mcs]);
               }
             NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << rbgCqi);
             // fill the cqi vector (per RB basis)
@@ -23,7 +23,7 @@
 
 #include <stdio.h>
 #include <sstream>
-#include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -79,94 +79,99 @@ void Asn1Header::Serialize (Buffer::Iterator bIterator) const
 
 void Asn1Header::WriteOctet (uint8_t octet) const
 {
-  m_serializationResult.AddAtEnd (1);
-  Buffer::Iterator bIterator = m_serializationResult.End ();
-  bIterator.Prev ();
-  bIterator.WriteU8 (octet);
+  m_serializationOctets.push_back (octet);
 }
 
-template <int N>
-void Asn1Header::SerializeBitset (std::bitset<N> data) const
+void Asn1Header::SerializeBits (uint32_t value, uint8_t numBits) const
 {
-
-  size_t dataSize = data.size ();
-  uint8_t pendingBits = dataSize;
-  uint8_t mask = 1;
-  int j;
-
-  // No extension marker (Clause 16.7 ITU-T X.691),
-  // as 3GPP TS 36.331 does not use it in its IE's.
-
-  // Clause 16.8 ITU-T X.691
-  if (dataSize == 0)
+  NS_ASSERT (numBits <= 32);
+  if (numBits == 0)
     {
       return;
     }
+  if (numBits < 32)
+    {
+      value &= (1u << numBits) - 1;
+    }
 
-  // Clause 16.9 ITU-T X.691
-  // Clause 16.10 ITU-T X.691
-  if (dataSize <= 65536)
+  // If there are bits pending to be processed,
+  // append first bits of the value to complete an octet.
+  if (m_numSerializationPendingBits > 0)
     {
-      // If there are bits pending to be processed,
-      // append first bits in data to complete an octet.
-      if (m_numSerializationPendingBits > 0)
+      uint8_t n = std::min<uint8_t> (numBits, 8 - m_numSerializationPendingBits);
+      m_serializationPendingBits |= (value >> (numBits - n)) << (8 - m_numSerializationPendingBits - n);
+      m_numSerializationPendingBits += n;
+      numBits -= n;
+      if (m_numSerializationPendingBits == 8)
         {
-          mask = 0x80 >> m_numSerializationPendingBits;
-          while (pendingBits > 0 && m_numSerializationPendingBits < 8)
-            {
-              m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-              pendingBits--;
-              m_numSerializationPendingBits++;
-              mask = (mask >> 1) & (~mask);
-            }
-
-          if (m_numSerializationPendingBits >= 8)
-            {
-              WriteOctet (m_serializationPendingBits);
-              m_numSerializationPendingBits = 0;
-              m_serializationPendingBits = 0;
-            }
+          WriteOctet (m_serializationPendingBits);
+          m_numSerializationPendingBits = 0;
+          m_serializationPendingBits = 0;
         }
+    }
 
-      while (pendingBits > 0)
-        {
-          mask = 1;
-          j = 8;
-
-          // If there are less than 8 remaining bits,
-          // store it to m_serializationPendingBits.
-          if (pendingBits < 8)
-            {
-              mask = 0x80;
-              m_numSerializationPendingBits = pendingBits;
-              while (pendingBits > 0)
-                {
-                  m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-                  mask = (mask >> 1) & (~mask);
-                  pendingBits--;
-                }
-            }
-
-          // Write the data to buffer
-          else
-            {
-              uint8_t octetToWrite = 0;
-              for (; j > 0; j--)
-                {
-                  octetToWrite |= (data[pendingBits - j]) ? mask : 0;
-                  mask = (mask << 1) & (~mask);
-                }
-              WriteOctet (octetToWrite);
-              pendingBits -= 8;
-            }
-        }
+  // Write the complete octets to buffer
+  while (numBits >= 8)
+    {
+      numBits -= 8;
+      WriteOctet ((value >> numBits) & 0xff);
+    }
+
+  // Store the remaining bits to m_serializationPendingBits.
+  if (numBits > 0)
+    {
+      m_numSerializationPendingBits = numBits;
+      m_serializationPendingBits |= (value << (8 - numBits)) & 0xff;
     }
+}
+
+void Asn1Header::StartEncoding (Asn1Encoding *outer) const
+{
+  outer->octets.clear ();
+  outer->octets.swap (m_serializationOctets);
+  outer->pendingBits = m_serializationPendingBits;
+  outer->numPendingBits = m_numSerializationPendingBits;
+  m_serializationPendingBits = 0;
+  m_numSerializationPendingBits = 0;
+}
+
+void Asn1Header::StopEncoding (Asn1Encoding *outer, Asn1Encoding *encoding) const
+{
+  encoding->octets.clear ();
+  encoding->octets.swap (m_serializationOctets);
+  encoding->pendingBits = m_serializationPendingBits;
+  encoding->numPendingBits = m_numSerializationPendingBits;
+  m_serializationOctets.swap (outer->octets);
+  m_serializationPendingBits = outer->pendingBits;
+  m_numSerializationPendingBits = outer->numPendingBits;
+}
 
-  // Clause 16.11 ITU-T X.691
+void Asn1Header::SerializeEncoding (const Asn1Encoding &encoding) const
+{
+  if (m_numSerializationPendingBits == 0)
+    {
+      m_serializationOctets.insert (m_serializationOctets.end (), encoding.octets.begin (), encoding.octets.end ());
+    }
   else
     {
-      printf ("FRAGMENTATION NEEDED!\n");
+      for (std::vector<uint8_t>::const_iterator it = encoding.octets.begin (); it != encoding.octets.end (); ++it)
+        {
+          SerializeBits (*it, 8);
+        }
     }
+  SerializeBits (encoding.pendingBits >> (8 - encoding.numPendingBits), encoding.numPendingBits);
+}
+
+template <int N>
+void Asn1Header::SerializeBitset (std::bitset<N> data) const
+{
+  // No extension marker (Clause 16.7 ITU-T X.691),
+  // as 3GPP TS 36.331 does not use it in its IE's.
+
+  // Clause 16.8 ITU-T X.691
+  // Clause 16.9 ITU-T X.691
+  // Clause 16.10 ITU-T X.691
+  SerializeBits (data.to_ulong (), N);
 }
 
 template <int N>
@@ -219,9 +224,7 @@ void Asn1Header::SerializeBitstring (std::bitset<32> data) const
 void Asn1Header::SerializeBoolean (bool value) const
 {
   // Clause 12 ITU-T X.691
-  std::bitset<1> val;
-  (value) ? val.set () : val.reset ();
-  SerializeBitset<1> (val);
+  SerializeBits (value ? 1 : 0, 1);
 }
 
 template <int N>
@@ -341,76 +344,18 @@ void Asn1Header::SerializeInteger (int n, int nmin, int nmax) const
     }
 
   // Clause 11.5.6 ITU-T X.691
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
+  int requiredBits = 0;
+  while ((1 << requiredBits) < range)
+    {
+      requiredBits++;
+    }
 
-  switch (requiredBits)
+  if (requiredBits > 20)
     {
-    case 1:
-      SerializeBitset<1> (std::bitset<1> (n));
-      break;
-    case 2:
-      SerializeBitset<2> (std::bitset<2> (n));
-      break;
-    case 3:
-      SerializeBitset<3> (std::bitset<3> (n));
-      break;
-    case 4:
-      SerializeBitset<4> (std::bitset<4> (n));
-      break;
-    case 5:
-      SerializeBitset<5> (std::bitset<5> (n));
-      break;
-    case 6:
-      SerializeBitset<6> (std::bitset<6> (n));
-      break;
-    case 7:
-      SerializeBitset<7> (std::bitset<7> (n));
-      break;
-    case 8:
-      SerializeBitset<8> (std::bitset<8> (n));
-      break;
-    case 9:
-      SerializeBitset<9> (std::bitset<9> (n));
-      break;
-    case 10:
-      SerializeBitset<10> (std::bitset<10> (n));
-      break;
-    case 11:
-      SerializeBitset<11> (std::bitset<11> (n));
-      break;
-    case 12:
-      SerializeBitset<12> (std::bitset<12> (n));
-      break;
-    case 13:
-      SerializeBitset<13> (std::bitset<13> (n));
-      break;
-    case 14:
-      SerializeBitset<14> (std::bitset<14> (n));
-      break;
-    case 15:
-      SerializeBitset<15> (std::bitset<15> (n));
-      break;
-    case 16:
-      SerializeBitset<16> (std::bitset<16> (n));
-      break;
-    case 17:
-      SerializeBitset<17> (std::bitset<17> (n));
-      break;
-    case 18:
-      SerializeBitset<18> (std::bitset<18> (n));
-      break;
-    case 19:
-      SerializeBitset<19> (std::bitset<19> (n));
-      break;
-    case 20:
-      SerializeBitset<20> (std::bitset<20> (n));
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger " << requiredBits << " Out of range!!" << std::endl;
-        exit (1);
-      }
+      std::cout << "SerializeInteger " << requiredBits << " Out of range!!" << std::endl;
+      exit (1);
     }
+  SerializeBits (n, requiredBits);
 }
 
 void Asn1Header::SerializeNull () const
@@ -423,62 +368,63 @@ void Asn1Header::FinalizeSerialization () const
 {
   if (m_numSerializationPendingBits > 0)
     {
+      WriteOctet (m_serializationPendingBits);
       m_numSerializationPendingBits = 0;
-      SerializeBitset<8> (std::bitset<8> (m_serializationPendingBits));
+      m_serializationPendingBits = 0;
+    }
+  uint32_t size = m_serializationOctets.size ();
+  if (size > 0)
+    {
+      m_serializationResult.AddAtEnd (size);
+      Buffer::Iterator bIterator = m_serializationResult.End ();
+      bIterator.Prev (size);
+      bIterator.Write (&m_serializationOctets[0], size);
+      m_serializationOctets.clear ();
     }
   m_isDataSerialized = true;
 }
 
-template <int N>
-Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
+Buffer::Iterator Asn1Header::DeserializeBits (uint32_t *value, uint8_t numBits, Buffer::Iterator bIterator)
 {
-
-  int bitsToRead = N;
-  uint8_t mask;
+  NS_ASSERT (numBits <= 32);
+  uint32_t result = 0;
 
   // Read bits from pending bits
-  if (m_numSerializationPendingBits > 0)
+  if (m_numSerializationPendingBits > 0 && numBits > 0)
     {
-      while (bitsToRead > 0 && m_numSerializationPendingBits > 0)
-        {
-          data->set (bitsToRead - 1,(m_serializationPendingBits & 0x80) ? 1 : 0);
-          bitsToRead--;
-          m_numSerializationPendingBits--;
-          m_serializationPendingBits = m_serializationPendingBits << 1;
-        }
+      uint8_t n = std::min (numBits, m_numSerializationPendingBits);
+      result = m_serializationPendingBits >> (8 - n);
+      m_serializationPendingBits = m_serializationPendingBits << n;
+      m_numSerializationPendingBits -= n;
+      numBits -= n;
     }
 
   // Read bits from buffer
-  while (bitsToRead > 0)
+  while (numBits >= 8)
     {
-      uint8_t octet = bIterator.ReadU8 ();
-      // If 8 bits can be allocated to the bitset, set the bits
-      if (bitsToRead >= 8)
-        {
-          mask = 0x80;
-          for (int j = 0; j < 8; j++)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
+      result = (result << 8) | bIterator.ReadU8 ();
+      numBits -= 8;
+    }
 
-      // Otherwise, we'll have to save the remaining bits
-      else
-        {
-          mask = 0x80;
-          m_numSerializationPendingBits = 8 - bitsToRead;
-          m_serializationPendingBits = octet << bitsToRead;
-          while (bitsToRead > 0)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
+  // Otherwise, we'll have to save the remaining bits
+  if (numBits > 0)
+    {
+      uint8_t octet = bIterator.ReadU8 ();
+      result = (result << numBits) | (octet >> (8 - numBits));
+      m_numSerializationPendingBits = 8 - numBits;
+      m_serializationPendingBits = octet << numBits;
     }
 
+  *value = result;
+  return bIterator;
+}
+
+template <int N>
+Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
+{
+  uint32_t value;
+  bIterator = DeserializeBits (&value, N, bIterator);
+  *data = std::bitset<N> (value);
   return bIterator;
 }
 
@@ -553,117 +499,20 @@ Buffer::Iterator Asn1Header::DeserializeInteger (int *n, int nmin, int nmax, Buf
       return bIterator;
     }
 
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  std::bitset<1> bitsRead1;
-  std::bitset<2> bitsRead2;
-  std::bitset<3> bitsRead3;
-  std::bitset<4> bitsRead4;
-  std::bitset<5> bitsRead5;
-  std::bitset<6> bitsRead6;
-  std::bitset<7> bitsRead7;
-  std::bitset<8> bitsRead8;
-  std::bitset<9> bitsRead9;
-  std::bitset<10> bitsRead10;
-  std::bitset<11> bitsRead11;
-  std::bitset<12> bitsRead12;
-  std::bitset<13> bitsRead13;
-  std::bitset<14> bitsRead14;
-  std::bitset<15> bitsRead15;
-  std::bitset<16> bitsRead16;
-  std::bitset<17> bitsRead17;
-  std::bitset<18> bitsRead18;
-  std::bitset<19> bitsRead19;
-  std::bitset<20> bitsRead20;
-
-  switch (requiredBits)
+  int requiredBits = 0;
+  while ((1 << requiredBits) < range)
+    {
+      requiredBits++;
+    }
+
+  if (requiredBits > 20)
     {
-    case 1:
-      bIterator = DeserializeBitset<1> (&bitsRead1,bIterator);
-      *n = (int)bitsRead1.to_ulong ();
-      break;
-    case 2: 
-      bIterator = DeserializeBitset<2> (&bitsRead2,bIterator);
-      *n = (int)bitsRead2.to_ulong ();
-      break;
-    case 3: 
-      bIterator = DeserializeBitset<3> (&bitsRead3,bIterator);
-      *n = (int)bitsRead3.to_ulong ();
-      break;
-    case 4: 
-      bIterator = DeserializeBitset<4> (&bitsRead4,bIterator);
-      *n = (int)bitsRead4.to_ulong ();
-      break;
-    case 5:
-      bIterator = DeserializeBitset<5> (&bitsRead5,bIterator);
-      *n = (int)bitsRead5.to_ulong ();
-      break;
-    case 6:
-      bIterator = DeserializeBitset<6> (&bitsRead6,bIterator);
-      *n = (int)bitsRead6.to_ulong ();
-      break;
-    case 7:
-      bIterator = DeserializeBitset<7> (&bitsRead7,bIterator);
-      *n = (int)bitsRead7.to_ulong ();
-      break;
-    case 8:
-      bIterator = DeserializeBitset<8> (&bitsRead8,bIterator);
-      *n = (int)bitsRead8.to_ulong ();
-      break;
-    case 9:
-      bIterator = DeserializeBitset<9> (&bitsRead9,bIterator);
-      *n = (int)bitsRead9.to_ulong ();
-      break;
-    case 10:
-      bIterator = DeserializeBitset<10> (&bitsRead10,bIterator);
-      *n = (int)bitsRead10.to_ulong ();
-      break;
-    case 11:
-      bIterator = DeserializeBitset<11> (&bitsRead11,bIterator);
-      *n = (int)bitsRead11.to_ulong ();
-      break;
-    case 12:
-      bIterator = DeserializeBitset<12> (&bitsRead12,bIterator);
-      *n = (int)bitsRead12.to_ulong ();
-      break;
-    case 13:
-      bIterator = DeserializeBitset<13> (&bitsRead13,bIterator);
-      *n = (int)bitsRead13.to_ulong ();
-      break;
-    case 14:
-      bIterator = DeserializeBitset<14> (&bitsRead14,bIterator);
-      *n = (int)bitsRead14.to_ulong ();
-      break;
-    case 15:
-      bIterator = DeserializeBitset<15> (&bitsRead15,bIterator);
-      *n = (int)bitsRead15.to_ulong ();
-      break;
-    case 16:
-      bIterator = DeserializeBitset<16> (&bitsRead16,bIterator);
-      *n = (int)bitsRead16.to_ulong ();
-      break;
-    case 17:
-      bIterator = DeserializeBitset<17> (&bitsRead17,bIterator);
-      *n = (int)bitsRead17.to_ulong ();
-      break;
-    case 18:
-      bIterator = DeserializeBitset<18> (&bitsRead18,bIterator);
-      *n = (int)bitsRead18.to_ulong ();
-      break;
-    case 19:
-      bIterator = DeserializeBitset<19> (&bitsRead19,bIterator);
-      *n = (int)bitsRead19.to_ulong ();
-      break;
-    case 20:
-      bIterator = DeserializeBitset<20> (&bitsRead20,bIterator);
-      *n = (int)bitsRead20.to_ulong ();
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger Out of range!!" << std::endl;
-        exit (1);
-      }
+      std::cout << "SerializeInteger Out of range!!" << std::endl;
+      exit (1);
     }
+  uint32_t bitsRead;
+  bIterator = DeserializeBits (&bitsRead, requiredBits, bIterator);
+  *n = (int) bitsRead;
 
   *n += nmin;
 
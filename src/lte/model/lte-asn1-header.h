@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -64,18 +65,58 @@ public:
    */
   virtual void PreSerialize (void) const = 0;
 
+  /**
+   * The bits of an information element serialized on their own, which
+   * can be stored and then appended to any message with SerializeEncoding
+   */
+  struct Asn1Encoding
+  {
+    std::vector<uint8_t> octets; ///< the complete octets
+    uint8_t pendingBits; ///< the last bits, from the most significant one
+    uint8_t numPendingBits; ///< the number of last bits
+  };
+
 protected:
   mutable uint8_t m_serializationPendingBits; //!< pending bits
   mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  mutable std::vector<uint8_t> m_serializationOctets; //!< octets written until the serialization is finalized
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write in m_serializationOctets, which is copied to
+   * m_serializationResult when the serialization is finalized
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
 
+  /**
+   * Serialize the least significant bits of a value, from the most
+   * significant one
+   * \param value value to serialize
+   * \param numBits number of bits to serialize, at most 32
+   */
+  void SerializeBits (uint32_t value, uint8_t numBits) const;
+
+  /**
+   * Serialize the next information elements apart from the message,
+   * until StopEncoding is called
+   * \param outer to store the state of the message
+   */
+  void StartEncoding (Asn1Encoding *outer) const;
+  /**
+   * Get the bits serialized since StartEncoding and resume the
+   * serialization of the message
+   * \param outer the state of the message stored by StartEncoding
+   * \param encoding to store the bits serialized since StartEncoding
+   */
+  void StopEncoding (Asn1Encoding *outer, Asn1Encoding *encoding) const;
+  /**
+   * Append bits serialized apart from the message
+   * \param encoding the bits
+   */
+  void SerializeEncoding (const Asn1Encoding &encoding) const;
+
   // Serialization functions
 
   /**
@@ -263,6 +304,15 @@ protected:
 
   // Deserialization functions
 
+  /**
+   * Deserialize bits, the first one being the most significant
+   * \param value to store the result
+   * \param numBits number of bits to deserialize, at most 32
+   * \param bIterator buffer iterator
+   * \returns the modified buffer iterator
+   */
+  Buffer::Iterator DeserializeBits (uint32_t *value, uint8_t numBits,
+                                    Buffer::Iterator bIterator);
   /**
    * Deserialize a bitset
    * \param data buffer to store the result
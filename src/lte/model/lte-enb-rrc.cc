@@ -2207,7 +2207,52 @@ LteEnbRrc::SendHandoverRequest (uint16_t rnti, uint16_t cellId)
 
   Ptr<UeManager> ueManager = GetUeManager (rnti);
   ueManager->PrepareHandover (cellId);
- 
+
+}
+
+uint16_t
+LteEnbRrc::AddPreAttachedUe ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_configured);
+  // same as upon the reception of a preamble on the primary carrier
+  return AddUe (UeManager::INITIAL_RANDOM_ACCESS, 0);
+}
+
+LteRrcSap::MasterInformationBlock
+LteEnbRrc::GetMasterInformationBlock (uint8_t componentCarrierId)
+{
+  LteRrcSap::MasterInformationBlock mib;
+  mib.dlBandwidth = m_componentCarrierPhyConf.at (componentCarrierId)->GetDlBandwidth ();
+  mib.systemFrameNumber = 0;
+  return mib;
+}
+
+LteRrcSap::SystemInformationBlockType1
+LteEnbRrc::GetSystemInformationBlockType1 (uint8_t componentCarrierId)
+{
+  return m_sib1.at (componentCarrierId);
+}
+
+LteRrcSap::SystemInformation
+LteEnbRrc::GetSystemInformation (uint8_t componentCarrierId)
+{
+  Ptr<ComponentCarrierEnb> cc = m_componentCarrierPhyConf.at (componentCarrierId);
+
+  LteRrcSap::SystemInformation si;
+  si.haveSib2 = true;
+  si.sib2.freqInfo.ulCarrierFreq = cc->GetUlEarfcn ();
+  si.sib2.freqInfo.ulBandwidth = cc->GetUlBandwidth ();
+  si.sib2.radioResourceConfigCommon.pdschConfigCommon.referenceSignalPower = m_cphySapProvider.at (componentCarrierId)->GetReferenceSignalPower ();
+  si.sib2.radioResourceConfigCommon.pdschConfigCommon.pb = 0;
+
+  LteEnbCmacSapProvider::RachConfig rc = m_cmacSapProvider.at (componentCarrierId)->GetRachConfig ();
+  LteRrcSap::RachConfigCommon rachConfigCommon;
+  rachConfigCommon.preambleInfo.numberOfRaPreambles = rc.numberOfRaPreambles;
+  rachConfigCommon.raSupervisionInfo.preambleTransMax = rc.preambleTransMax;
+  rachConfigCommon.raSupervisionInfo.raResponseWindowSize = rc.raResponseWindowSize;
+  si.sib2.radioResourceConfigCommon.rachConfigCommon = rachConfigCommon;
+  return si;
 }
 
 void 
@@ -2848,22 +2893,7 @@ LteEnbRrc::SendSystemInformation ()
 
   for (auto &it: m_componentCarrierPhyConf)
     {
-      uint8_t ccId = it.first;
-
-      LteRrcSap::SystemInformation si;
-      si.haveSib2 = true;
-      si.sib2.freqInfo.ulCarrierFreq = it.second->GetUlEarfcn ();
-      si.sib2.freqInfo.ulBandwidth = it.second->GetUlBandwidth ();
-      si.sib2.radioResourceConfigCommon.pdschConfigCommon.referenceSignalPower = m_cphySapProvider.at (ccId)->GetReferenceSignalPower ();
-      si.sib2.radioResourceConfigCommon.pdschConfigCommon.pb = 0;
-
-      LteEnbCmacSapProvider::RachConfig rc = m_cmacSapProvider.at (ccId)->GetRachConfig ();
-      LteRrcSap::RachConfigCommon rachConfigCommon;
-      rachConfigCommon.preambleInfo.numberOfRaPreambles = rc.numberOfRaPreambles;
-      rachConfigCommon.raSupervisionInfo.preambleTransMax = rc.preambleTransMax;
-      rachConfigCommon.raSupervisionInfo.raResponseWindowSize = rc.raResponseWindowSize;
-      si.sib2.radioResourceConfigCommon.rachConfigCommon = rachConfigCommon;
-
+      LteRrcSap::SystemInformation si = GetSystemInformation (it.first);
       m_rrcSapUser->SendSystemInformation (it.second->GetCellId (), si);
     }
 
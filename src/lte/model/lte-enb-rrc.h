@@ -969,6 +969,36 @@ public:
    */
   void SendHandoverRequest (uint16_t rnti, uint16_t cellId);
 
+  /**
+   * \brief Create the context of a UE that connects to the primary carrier
+   * without the random access procedure
+   *
+   * The context is left in the state that the reception of the random
+   * access preamble of the UE would produce. This is used by
+   * LteHelper::PreAttach.
+   *
+   * \return the C-RNTI allocated to the UE
+   */
+  uint16_t AddPreAttachedUe ();
+
+  /**
+   * \param componentCarrierId the component carrier
+   * \return the Master Information Block broadcast on the carrier
+   */
+  LteRrcSap::MasterInformationBlock GetMasterInformationBlock (uint8_t componentCarrierId);
+
+  /**
+   * \param componentCarrierId the component carrier
+   * \return the System Information Block Type 1 broadcast on the carrier
+   */
+  LteRrcSap::SystemInformationBlockType1 GetSystemInformationBlockType1 (uint8_t componentCarrierId);
+
+  /**
+   * \param componentCarrierId the component carrier
+   * \return the System Information periodically broadcast on the carrier
+   */
+  LteRrcSap::SystemInformation GetSystemInformation (uint8_t componentCarrierId);
+
   /**
    *  \brief This function acts as an interface to trigger Release indication messages towards eNB and EPC
    *  \param imsi the IMSI
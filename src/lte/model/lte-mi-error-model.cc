@@ -335,87 +335,257 @@ static const double cEcrTable [9][38] = {
 };
 
 
-double 
-LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// A map from the SINR to the mutual information of a modulation
+struct MiMap
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  const double *mi;      ///< the MI values
+  const double *axis;    ///< the uniformly spaced linear SINRs of the MI values
+  uint16_t size;         ///< the number of values
+  double scalingCoeff;   ///< the inverse of the spacing of the SINRs
+};
+
+/**
+ * Get the MI map of the modulation of an MCS.  The maps are built on the
+ * first call.
+ *
+ * \param mcs the MCS
+ * \return the MI map
+ */
+static const MiMap &
+GetMiMap (uint8_t mcs)
+{
+  // since the values of the axes are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  // and the scaling coefficient is computed once for each modulation
+  static const MiMap miMaps[3] = {
+    { MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE,
+      (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]) },
+    { MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE,
+      (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]) },
+    { MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE,
+      (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]) }
+  };
+  if (mcs <= MI_QPSK_MAX_ID)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
+      return miMaps[0];
+    }
+  else if (mcs <= MI_16QAM_MAX_ID)
+    {
+      return miMaps[1];
+    }
+  return miMaps[2];
+}
+
+/**
+ * Map a linear SINR to its mutual information.
+ *
+ * \param miMap the MI map of the modulation
+ * \param sinrLin the linear SINR
+ * \return the MI
+ */
+static inline double
+MapSinrToMi (const MiMap &miMap, double sinrLin)
+{
+  if (sinrLin > miMap.axis[miMap.size - 1])
+    {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - miMap.axis[0]) * miMap.scalingCoeff + 1;
+  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+  NS_ASSERT_MSG (sinrIndex < miMap.size, "MI map out of data");
+  return miMap.mi[sinrIndex];
+}
+
+/// The parameters of a BLER curve, see MappingMiBler
+struct BlerCurve
+{
+  double b;             ///< the mean of the curve
+  double cSqrt2;        ///< the standard deviation of the curve, times sqrt (2)
+};
+
+/**
+ * Get the parameters of a BLER curve.  The curves of all the CB sizes of
+ * cbMiSizeTable and ECRs of BlerCurvesEcrMap are built on the first call;
+ * their undefined parameters are then replaced, once for all, by those of
+ * the lowest larger CB size defining them.
+ *
+ * \param cbIndex the index of the CB size in cbMiSizeTable
+ * \param ecrId the index of the ECR in BlerCurvesEcrMap
+ * \return the parameters of the BLER curve
+ */
+static const BlerCurve &
+GetBlerCurve (int cbIndex, uint8_t ecrId)
+{
+  static BlerCurve curves[9][38];
+  static bool initialized = false;
+  if (!initialized)
+    {
+      for (int cb = 0; cb < 9; cb++)
         {
+          for (int ecr = 0; ecr < 38; ecr++)
+            {
+              //take the lowest CB size including this CB for removing CB size
+              //quatization errors
+              double b = bEcrTable[cb][ecr];
+              int i = cb;
+              while ((i<9)&&(b<0))
+                {
+                  b = bEcrTable[i++][ecr];
+                }
+              double c = cEcrTable[cb][ecr];
+              i = cb;
+              while ((i<9)&&(c<0))
+                {
+                  c = cEcrTable[i++][ecr];
+                }
+              curves[cb][ecr].b = b;
+              curves[cb][ecr].cSqrt2 = sqrt (2) * c;
+            }
+        }
+      initialized = true;
+    }
+  return curves[cbIndex][ecrId];
+}
 
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
+/// The code block segmentation of a TB (see sec 5.1.2 of TS 36.212)
+struct CbSegmentation
+{
+  uint32_t B1;          ///< the number of bits, including the CRCs
+  uint32_t C;           ///< the number of codeblocks
+  uint32_t Cplus;       ///< the number of codeblocks of size K+
+  uint32_t Kplus;       ///< the size K+
+  uint32_t Cminus;      ///< the number of codeblocks of size K-
+  uint32_t Kminus;      ///< the size K-
+};
+
+/**
+ * Compute the code block segmentation of a TB.
+ *
+ * \param size the size in bytes of the TB
+ * \return the segmentation
+ */
+static CbSegmentation
+ComputeCbSegmentation (uint16_t size)
+{
+  CbSegmentation seg;
+  uint16_t Z = 6144; // max size of a codeblock (including CRC)
+  uint32_t B = size * 8;
+  uint32_t C = 0; // no. of codeblocks
+  uint32_t B1 = 0;
+  if (B <= Z)
+    {
+      // only one codeblock
+      //L = 0;
+      C = 1;
+      B1 = B;
+    }
+  else
+    {
+      uint32_t L = 24;
+      C = ceil ((double)B / ((double)(Z-L)));
+      B1 = B + C * L;
+    }
+  // first segmentation: K+ = minimum K in table such that C * K >= B1
+  // implement a modified binary search
+  int min = 0;
+  int max = 187;
+  int mid = 0;
+  do
+    {
+      mid = (min+max) / 2;
+      if (B1 > cbSizeTable[mid]*C)
+        {
+          if (B1 < cbSizeTable[mid+1]*C)
             {
-              MI = 1;
+              break;
             }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
+          else
+            {
+              min = mid + 1;
             }
         }
       else
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
+          if (B1 > cbSizeTable[mid-1]*C)
             {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
+              break;
             }
-          else // 64-QAM
+          else
             {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
+              max = mid - 1;
             }
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
+  } while ((cbSizeTable[mid]*C != B1) && (min < max));
+  // adjust binary search to the largest integer value of K containing B1
+  if (B1 > cbSizeTable[mid]*C)
+    {
+      mid ++;
+    }
+
+  uint16_t KplusId = mid;
+  seg.B1 = B1;
+  seg.C = C;
+  seg.Kplus = cbSizeTable[mid];
+  if (C==1)
+    {
+      seg.Cplus = 1;
+      seg.Cminus = 0;
+      seg.Kminus = 0;
+    }
+  else
+    {
+      // second segmentation size: K- = maximum K in table such that K < K+
+      // -fstrict-overflow sensitive, see bug 1868
+      seg.Kminus = cbSizeTable[ KplusId > 1 ? KplusId - 1 : 0];
+      uint32_t deltaK = seg.Kplus - seg.Kminus;
+      seg.Cminus = floor ((((double) C * seg.Kplus) - (double)B1) / (double)deltaK);
+      seg.Cplus = C - seg.Cminus;
+    }
+  return seg;
+}
+
+/**
+ * Get the code block segmentation of a TB.  The segmentation only depends
+ * on the size of the TB, and is computed once for each size.
+ *
+ * \param size the size in bytes of the TB
+ * \return the segmentation
+ */
+static const CbSegmentation &
+GetCbSegmentation (uint16_t size)
+{
+  static std::vector<CbSegmentation> segmentations;
+  static std::vector<bool> computed;
+  if (size >= segmentations.size ())
+    {
+      segmentations.resize (size + 1);
+      computed.resize (size + 1, false);
+    }
+  if (!computed[size])
+    {
+      segmentations[size] = ComputeCbSegmentation (size);
+      computed[size] = true;
     }
-  MI = MIsum / map.size ();
-  NS_LOG_LOGIC (" MI = " << MI);
+  return segmentations[size];
+}
+
+
+double 
+LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+
+  // the modulation is the same on all the RBs: select its map once and
+  // run a tight loop over the allocated RBs
+  const MiMap &miMap = GetMiMap (mcs);
+  Values::const_iterator sinrValues = sinr.ConstValuesBegin ();
+  double MIsum = 0.0;
+  for (std::vector<int>::const_iterator it = map.begin (); it != map.end (); ++it)
+    {
+      MIsum += MapSinrToMi (miMap, sinrValues[*it]);
+    }
+  double MI = MIsum / map.size ();
+  NS_LOG_LOGIC (" MCS = " << (uint16_t)mcs << ", MI = " << MI);
   return MI;
 }
 
@@ -424,8 +594,6 @@ double
 LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
 
   NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
@@ -436,31 +604,10 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  const BlerCurve &curve = GetBlerCurve (cbIndex, ecrId);
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+  double bler = 0.5*( 1 - erf((mib-curve.b)/curve.cSqrt2) );
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << curve.b << " c:" << curve.cSqrt2 / sqrt (2));
   return bler;
 }
 
@@ -472,32 +619,12 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  const MiMap &miMap = GetMiMap (0); // QPSK
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinr.ConstValuesBegin () != sinr.ConstValuesEnd ());
+  for (Values::const_iterator sinrIt = sinr.ConstValuesBegin (); sinrIt != sinr.ConstValuesEnd (); ++sinrIt)
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
-      sinrIt++;
+      MIsum += MapSinrToMi (miMap, *sinrIt);
       rb++;
     }
   MI = MIsum / rb;
@@ -557,8 +684,55 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 
+/**
+ * Compute the error rate of a TB from the MI of its RBs, combining the
+ * error rates of its code blocks.
+ *
+ * \param MI the effective mutual information of the TB
+ * \param ecrId the Effective Code Rate ID
+ * \param size the size in bytes of the TB
+ * \return the TB error rate
+ */
+static double
+MappingMiTbBler (double MI, uint8_t ecrId, uint16_t size)
+{
+  // estimate CB size (according to sec 5.1.2 of TS 36.212)
+  const CbSegmentation &seg = GetCbSegmentation (size);
+  uint32_t B = size * 8;
+  uint32_t C = seg.C; // no. of codeblocks
+  uint32_t Cplus = seg.Cplus; // no. of codeblocks with size K+
+  uint32_t Kplus = seg.Kplus; // size K+
+  uint32_t Cminus = seg.Cminus; // no. of codeblocks with size K-
+  uint32_t Kminus = seg.Kminus; // size K-
+  uint32_t B1 = seg.B1;
+  NS_LOG_INFO ("--------------------LteMiErrorModel: TB size of " << B << " needs of " << B1 << " bits reparted in " << C << " CBs as "<< Cplus << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
+
+  double errorRate = 1.0;
+  if (C!=1)
+    {
+      double cbler = LteMiErrorModel::MappingMiBler (MI, ecrId, Kplus);
+      errorRate *= pow (1.0 - cbler, Cplus);
+      cbler = LteMiErrorModel::MappingMiBler (MI, ecrId, Kminus);
+      errorRate *= pow (1.0 - cbler, Cminus);
+      errorRate = 1.0 - errorRate;
+    }
+  else
+    {
+      errorRate = LteMiErrorModel::MappingMiBler (MI, ecrId, Kplus);
+    }
+  return errorRate;
+}
+
+double
+LteMiErrorModel::GetTbBler (double mib, uint16_t size, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (mib << (uint32_t) size << (uint32_t) mcs);
+  NS_ASSERT (mcs < 29);
+  return MappingMiTbBler (mib, McsEcrBlerTableMapping[mcs], size);
+}
+
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
@@ -587,98 +761,6 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
       MI = tbMi;
     }
   NS_LOG_DEBUG (" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size ());
-  // estimate CB size (according to sec 5.1.2 of TS 36.212)
-  uint16_t Z = 6144; // max size of a codeblock (including CRC)
-  uint32_t B = size * 8;
-//   B = 1234;
-  uint32_t C = 0; // no. of codeblocks
-  uint32_t Cplus = 0; // no. of codeblocks with size K+
-  uint32_t Kplus = 0; // no. of codeblocks with size K+
-  uint32_t Cminus = 0; // no. of codeblocks with size K+
-  uint32_t Kminus = 0; // no. of codeblocks with size K+
-  uint32_t B1 = 0;
-  uint32_t deltaK = 0;
-  if (B <= Z)
-    {
-      // only one codeblock
-      //L = 0;
-      C = 1;
-      B1 = B;
-    }
-  else
-    {
-      uint32_t L = 24;
-      C = ceil ((double)B / ((double)(Z-L)));
-      B1 = B + C * L;
-    }
-  // first segmentation: K+ = minimum K in table such that C * K >= B1
-//   uint i = 0;
-//   while (B1 > cbSizeTable[i] * C)
-//     {
-// //       NS_LOG_INFO (" K+ " << cbSizeTable[i] << " means " << cbSizeTable[i] * C);
-//       i++;
-//     }
-//   uint16_t KplusId = i;
-//   Kplus = cbSizeTable[i];
-
-  // implement a modified binary search
-  int min = 0;
-  int max = 187;
-  int mid = 0;
-  do
-    {
-      mid = (min+max) / 2;
-      if (B1 > cbSizeTable[mid]*C)
-        {
-          if (B1 < cbSizeTable[mid+1]*C)
-            {
-              break;
-            }
-          else
-            {
-              min = mid + 1;
-            }
-        }
-      else
-        {
-          if (B1 > cbSizeTable[mid-1]*C)
-            {
-              break;
-            }
-          else
-            {
-              max = mid - 1;
-            }
-        }
-  } while ((cbSizeTable[mid]*C != B1) && (min < max));
-  // adjust binary search to the largest integer value of K containing B1
-  if (B1 > cbSizeTable[mid]*C)
-    {
-      mid ++;
-    }
-
-  uint16_t KplusId = mid;
-  Kplus = cbSizeTable[mid];
-
-
-  if (C==1)
-    {
-      Cplus = 1;
-      Cminus = 0;
-      Kminus = 0;
-    }
-  else
-    {
-      // second segmentation size: K- = maximum K in table such that K < K+
-      // -fstrict-overflow sensitive, see bug 1868
-      Kminus = cbSizeTable[ KplusId > 1 ? KplusId - 1 : 0];
-      deltaK = Kplus - Kminus;
-      Cminus = floor ((((double) C * Kplus) - (double)B1) / (double)deltaK);
-      Cplus = C - Cminus;
-    }
-  NS_LOG_INFO ("--------------------LteMiErrorModel: TB size of " << B << " needs of " << B1 << " bits reparted in " << C << " CBs as "<< Cplus << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
-
-  double errorRate = 1.0;
   uint8_t ecrId = 0;
   if (miHistory.size ()==0)
     {
@@ -723,19 +805,7 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
       NS_LOG_DEBUG ("HARQ ECR " << (uint16_t)ecrId);
     }
 
-  if (C!=1)
-    {
-      double cbler = MappingMiBler (MI, ecrId, Kplus);
-      errorRate *= pow (1.0 - cbler, Cplus);
-      cbler = MappingMiBler (MI, ecrId, Kminus);
-      errorRate *= pow (1.0 - cbler, Cminus);
-      errorRate = 1.0 - errorRate;
-    }
-  else
-    {
-      errorRate = MappingMiBler (MI, ecrId, Kplus);
-    }
-
+  double errorRate = MappingMiTbBler (MI, ecrId, size);
   NS_LOG_LOGIC (" Error rate " << errorRate);
   TbStats_t ret;
   ret.tbler = errorRate;
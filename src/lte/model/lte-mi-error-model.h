@@ -109,7 +109,19 @@ public:
    * \param miHistory  MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
+
+  /**
+   * \brief get the error rate of the first transmission of a TB whose mmib is
+   * already known, i.e., the TB error rate returned by GetTbDecodificationStats
+   * without HARQ history. Since the mmib only depends on the modulation, it can
+   * be computed once with Mib () and shared by all the MCSs of a modulation.
+   * \param mib the mmib of the TB, as returned by Mib ()
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \return the TB error rate
+   */
+  static double GetTbBler (double mib, uint16_t size, uint8_t mcs);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -26,6 +26,7 @@
 #include <ns3/lte-rlc.h>
 
 #include <vector>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -112,7 +113,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer (SDUs are taken from and segments given back to the front)
 
     /// RetxPdu structure
     struct RetxPdu
@@ -123,8 +124,10 @@ private:
 
   std::vector <RetxPdu> m_txedBuffer;  ///< Buffer for transmitted and retransmitted PDUs 
                                        ///< that have not been acked but are not considered 
-                                       ///< for retransmission 
-  std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission
+                                       ///< for retransmission, indexed by SN
+  std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission, indexed by SN.
+                                       ///< A PDU is in at most one of the two buffers, and is moved
+                                       ///< between them without copying it
 
     uint32_t m_txonBufferSize; ///< transmit on buffer size
     uint32_t m_retxBufferSize; ///< retransmit buffer size
@@ -26,6 +26,8 @@
 
 #include <stdio.h>
 #include <sstream>
+#include <map>
+#include <vector>
 
 #define MAX_DRB 11 // According to section 6.4 3GPP TS 36.331
 #define MAX_EARFCN 262143
@@ -45,6 +47,11 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("RrcHeader");
 
+/// Encodings of the SystemInformationBlockType1 IEs, indexed by the fields they encode
+static std::map<std::vector<uint32_t>, Asn1Header::Asn1Encoding> g_sib1Encodings;
+/// Encodings of the SystemInformationBlockType2 IEs, indexed by the fields they encode
+static std::map<std::vector<uint32_t>, Asn1Header::Asn1Encoding> g_sib2Encodings;
+
 //////////////////// RrcAsn1Header class ///////////////////////////////
 RrcAsn1Header::RrcAsn1Header ()
 {
@@ -411,6 +418,22 @@ RrcAsn1Header::SerializeRadioResourceConfigDedicated (LteRrcSap::RadioResourceCo
 void
 RrcAsn1Header::SerializeSystemInformationBlockType1 (LteRrcSap::SystemInformationBlockType1 systemInformationBlockType1) const
 {
+  // The IE only depends on the configuration of the cell,
+  // so its encoding is reused by all the messages of the cell
+  std::vector<uint32_t> key;
+  key.push_back (systemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity);
+  key.push_back (systemInformationBlockType1.cellAccessRelatedInfo.cellIdentity);
+  key.push_back (systemInformationBlockType1.cellAccessRelatedInfo.csgIndication);
+  key.push_back (systemInformationBlockType1.cellAccessRelatedInfo.csgIdentity);
+  std::map<std::vector<uint32_t>, Asn1Encoding>::iterator it = g_sib1Encodings.find (key);
+  if (it != g_sib1Encodings.end ())
+    {
+      SerializeEncoding (it->second);
+      return;
+    }
+  Asn1Encoding outer;
+  StartEncoding (&outer);
+
   // 3 optional fields, no extension marker.
   std::bitset<3> sysInfoBlk1Opts;
   sysInfoBlk1Opts.set (2,0); // p-Max absent
@@ -465,6 +488,10 @@ RrcAsn1Header::SerializeSystemInformationBlockType1 (LteRrcSap::SystemInformatio
 
   // Serialize systemInfoValueTag
   SerializeInteger (0,0,31);
+
+  Asn1Encoding &encoding = g_sib1Encodings[key];
+  StopEncoding (&outer, &encoding);
+  SerializeEncoding (encoding);
 }
 
 void
@@ -580,6 +607,22 @@ RrcAsn1Header::SerializeRadioResourceConfigCommonSib (LteRrcSap::RadioResourceCo
 void
 RrcAsn1Header::SerializeSystemInformationBlockType2 (LteRrcSap::SystemInformationBlockType2 systemInformationBlockType2) const
 {
+  // As for SystemInformationBlockType1, reuse the encoding of the cell
+  std::vector<uint32_t> key;
+  key.push_back (systemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles);
+  key.push_back (systemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax);
+  key.push_back (systemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize);
+  key.push_back (systemInformationBlockType2.freqInfo.ulCarrierFreq);
+  key.push_back (systemInformationBlockType2.freqInfo.ulBandwidth);
+  std::map<std::vector<uint32_t>, Asn1Encoding>::iterator it = g_sib2Encodings.find (key);
+  if (it != g_sib2Encodings.end ())
+    {
+      SerializeEncoding (it->second);
+      return;
+    }
+  Asn1Encoding outer;
+  StartEncoding (&outer);
+
   SerializeSequence (std::bitset<2> (0),true);
 
   // RadioResourceConfigCommonSib
@@ -624,6 +667,10 @@ RrcAsn1Header::SerializeSystemInformationBlockType2 (LteRrcSap::SystemInformatio
   SerializeInteger (29,1,32); // additionalSpectrumEmission
   // timeAlignmentTimerCommon
   SerializeEnum (8,0);
+
+  Asn1Encoding &encoding = g_sib2Encodings[key];
+  StopEncoding (&outer, &encoding);
+  SerializeEncoding (encoding);
 }
 
 void
@@ -43,6 +43,29 @@ NS_LOG_COMPONENT_DEFINE ("LteRrcProtocolIdeal");
 /// RRC ideal message delay
 static const Time RRC_IDEAL_MSG_DELAY = MilliSeconds (0);
 
+/**
+ * The eNB RRC protocol of each cell, so that a UE finds the eNB it
+ * connects to without walking the list of all nodes
+ */
+static std::map<uint16_t, LteEnbRrcProtocolIdeal*> g_enbRrcProtocolByCellId;
+
+/**
+ * Remove the eNB RRC protocol of a cell from g_enbRrcProtocolByCellId,
+ * unless another protocol was registered for the cell since
+ *
+ * \param cellId the cell ID
+ * \param protocol the eNB RRC protocol
+ */
+static void
+UnregisterEnbRrcProtocol (uint16_t cellId, const LteEnbRrcProtocolIdeal *protocol)
+{
+  std::map<uint16_t, LteEnbRrcProtocolIdeal*>::iterator it = g_enbRrcProtocolByCellId.find (cellId);
+  if (it != g_enbRrcProtocolByCellId.end () && it->second == protocol)
+    {
+      g_enbRrcProtocolByCellId.erase (it);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED (LteUeRrcProtocolIdeal);
 
 LteUeRrcProtocolIdeal::LteUeRrcProtocolIdeal ()
@@ -174,39 +197,49 @@ void
 LteUeRrcProtocolIdeal::SetEnbRrcSapProvider ()
 {
   uint16_t cellId = m_rrc->GetCellId ();  
+  Ptr<LteEnbRrc> enbRrc;
 
-  // walk list of all nodes to get the peer eNB
-  Ptr<LteEnbNetDevice> enbDev;
-  NodeList::Iterator listEnd = NodeList::End ();
-  bool found = false;
-  for (NodeList::Iterator i = NodeList::Begin (); 
-       (i != listEnd) && (!found); 
-       ++i)
+  std::map<uint16_t, LteEnbRrcProtocolIdeal*>::const_iterator it = g_enbRrcProtocolByCellId.find (cellId);
+  if (it != g_enbRrcProtocolByCellId.end ())
     {
-      Ptr<Node> node = *i;
-      int nDevs = node->GetNDevices ();
-      for (int j = 0; 
-           (j < nDevs) && (!found);
-           j++)
+      enbRrc = it->second->GetObject<LteEnbRrc> ();
+    }
+  else
+    {
+      // walk list of all nodes to get the peer eNB
+      Ptr<LteEnbNetDevice> enbDev;
+      NodeList::Iterator listEnd = NodeList::End ();
+      bool found = false;
+      for (NodeList::Iterator i = NodeList::Begin (); 
+           (i != listEnd) && (!found); 
+           ++i)
         {
-          enbDev = node->GetDevice (j)->GetObject <LteEnbNetDevice> ();
-          if (enbDev == 0)
+          Ptr<Node> node = *i;
+          int nDevs = node->GetNDevices ();
+          for (int j = 0; 
+               (j < nDevs) && (!found);
+               j++)
             {
-              continue;
-            }
-          else
-            {
-              if (enbDev->HasCellId (cellId))
+              enbDev = node->GetDevice (j)->GetObject <LteEnbNetDevice> ();
+              if (enbDev == 0)
                 {
-                  found = true;          
-                  break;
+                  continue;
+                }
+              else
+                {
+                  if (enbDev->HasCellId (cellId))
+                    {
+                      found = true;          
+                      break;
+                    }
                 }
             }
         }
+      NS_ASSERT_MSG (found, " Unable to find eNB with CellId =" << cellId);
+      enbRrc = enbDev->GetRrc ();
     }
-  NS_ASSERT_MSG (found, " Unable to find eNB with CellId =" << cellId);
-  m_enbRrcSapProvider = enbDev->GetRrc ()->GetLteEnbRrcSapProvider ();  
-  Ptr<LteEnbRrcProtocolIdeal> enbRrcProtocolIdeal = enbDev->GetRrc ()->GetObject<LteEnbRrcProtocolIdeal> ();
+  m_enbRrcSapProvider = enbRrc->GetLteEnbRrcSapProvider ();  
+  Ptr<LteEnbRrcProtocolIdeal> enbRrcProtocolIdeal = enbRrc->GetObject<LteEnbRrcProtocolIdeal> ();
   enbRrcProtocolIdeal->SetUeRrcSapProvider (m_rnti, m_ueRrcSapProvider);
 }
 
@@ -214,7 +247,8 @@ LteUeRrcProtocolIdeal::SetEnbRrcSapProvider ()
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrcProtocolIdeal);
 
 LteEnbRrcProtocolIdeal::LteEnbRrcProtocolIdeal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_cellId (0),
+     m_enbRrcSapProvider (0)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<LteEnbRrcProtocolIdeal> (this);
@@ -223,6 +257,8 @@ LteEnbRrcProtocolIdeal::LteEnbRrcProtocolIdeal ()
 LteEnbRrcProtocolIdeal::~LteEnbRrcProtocolIdeal ()
 {
   NS_LOG_FUNCTION (this);
+  // the protocol may be deleted without being disposed
+  UnregisterEnbRrcProtocol (m_cellId, this);
 }
 
 void
@@ -230,6 +266,7 @@ LteEnbRrcProtocolIdeal::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   delete m_enbRrcSapUser;  
+  UnregisterEnbRrcProtocol (m_cellId, this);
 }
 
 TypeId
@@ -258,7 +295,9 @@ LteEnbRrcProtocolIdeal::GetLteEnbRrcSapUser ()
 void 
 LteEnbRrcProtocolIdeal::SetCellId (uint16_t cellId)
 {
+  UnregisterEnbRrcProtocol (m_cellId, this);
   m_cellId = cellId;
+  g_enbRrcProtocolByCellId[cellId] = this;
 }
 
 LteUeRrcSapProvider* 
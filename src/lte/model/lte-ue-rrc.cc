@@ -454,6 +454,28 @@ LteUeRrc::SetUseRlcSm (bool val)
   m_useRlcSm = val;
 }
 
+void
+LteUeRrc::PreAttach (uint16_t cellId, uint32_t dlEarfcn, uint16_t rnti,
+                     LteRrcSap::MasterInformationBlock mib,
+                     LteRrcSap::SystemInformationBlockType1 sib1,
+                     LteRrcSap::SystemInformation si)
+{
+  NS_LOG_FUNCTION (this << m_imsi << cellId << rnti);
+  NS_ASSERT_MSG (m_state == IDLE_START,
+                 "cannot pre-attach from state " << ToString (m_state));
+  DoForceCampedOnEnb (cellId, dlEarfcn);
+  DoRecvMasterInformationBlock (cellId, mib);
+  DoRecvSystemInformationBlockType1 (cellId, sib1);
+  DoRecvSystemInformation (si);
+  NS_ASSERT (m_state == IDLE_CAMPED_NORMALLY);
+
+  // proceed as upon the reception of the random access response
+  SwitchToState (IDLE_RANDOM_ACCESS);
+  m_cmacSapProvider.at (0)->SetRnti (rnti);
+  DoSetTemporaryCellRnti (rnti);
+  DoNotifyRandomAccessSuccessful ();
+}
+
 
 void
 LteUeRrc::DoInitialize (void)
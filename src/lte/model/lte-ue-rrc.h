@@ -308,6 +308,27 @@ public:
    */
   void SetUseRlcSm (bool val);
 
+  /**
+   * \brief Connect to a cell without waiting for its system information
+   * and without the random access procedure
+   *
+   * The UE camps on the cell, applies the given system information as if
+   * it had been received, and sends the RRC CONNECTION REQUEST as upon a
+   * successful random access. The eNB must have allocated the C-RNTI with
+   * LteEnbRrc::AddPreAttachedUe. This is used by LteHelper::PreAttach.
+   *
+   * \param cellId the cell ID of the eNB
+   * \param dlEarfcn the downlink carrier frequency (EARFCN) of the eNB
+   * \param rnti the C-RNTI allocated by the eNB
+   * \param mib the Master Information Block of the cell
+   * \param sib1 the System Information Block Type 1 of the cell
+   * \param si the System Information of the cell
+   */
+  void PreAttach (uint16_t cellId, uint32_t dlEarfcn, uint16_t rnti,
+                  LteRrcSap::MasterInformationBlock mib,
+                  LteRrcSap::SystemInformationBlockType1 sib1,
+                  LteRrcSap::SystemInformation si);
+
   /**
    * TracedCallback signature for imsi, cellId and rnti events.
    *
@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/point-to-point-epc-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-rrc.h"
+#include "ns3/lte-enb-rrc.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that LteHelper::ActivateDedicatedEpsBearer, given a
+ * container of UE devices, activates the bearer on each of them.
+ */
+class LteDedicatedBearerContainerTestCase : public TestCase
+{
+public:
+  LteDedicatedBearerContainerTestCase ();
+  virtual ~LteDedicatedBearerContainerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteDedicatedBearerContainerTestCase::LteDedicatedBearerContainerTestCase ()
+  : TestCase ("Dedicated bearer activated on every device of a container")
+{
+}
+
+LteDedicatedBearerContainerTestCase::~LteDedicatedBearerContainerTestCase ()
+{
+}
+
+void
+LteDedicatedBearerContainerTestCase::DoRun (void)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (3);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevs);
+
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  lteHelper->ActivateDedicatedEpsBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_OPERATOR), EpcTft::Default ());
+
+  Simulator::Stop (MilliSeconds (300));
+  Simulator::Run ();
+
+  Ptr<LteEnbRrc> enbRrc = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetRrc ();
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      uint16_t rnti = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ()->GetRnti ();
+      NS_TEST_ASSERT_MSG_EQ (enbRrc->HasUeManager (rnti), true, "no context for UE " << i);
+      // the default and the dedicated bearers
+      NS_TEST_EXPECT_MSG_EQ (enbRrc->GetUeManager (rnti)->GetErabList ().size (), 2,
+                             "wrong number of bearers for UE " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Dedicated bearer test suite
+ */
+class LteDedicatedBearerTestSuite : public TestSuite
+{
+public:
+  LteDedicatedBearerTestSuite ();
+};
+
+LteDedicatedBearerTestSuite::LteDedicatedBearerTestSuite ()
+  : TestSuite ("lte-dedicated-bearer", SYSTEM)
+{
+  AddTestCase (new LteDedicatedBearerContainerTestCase (), TestCase::QUICK);
+}
+
+static LteDedicatedBearerTestSuite g_lteDedicatedBearerTestSuite; ///< the test suite
@@ -0,0 +1,132 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-enb-phy.h"
+#include "ns3/lte-enb-cphy-sap.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the eNB PHY accepts a UE whose SRS is configured
+ * before the end of the first frame, as when its RRC connection is set
+ * up within that frame.
+ *
+ * The frames are numbered from 1, so the SRS offset of the subframes of
+ * the first frame is valid; the test fails on the SRS assertion of
+ * LteEnbPhy::StartSubFrame otherwise.
+ */
+class LteEnbPhySrsFirstFrameTestCase : public TestCase
+{
+public:
+  LteEnbPhySrsFirstFrameTestCase ();
+  virtual ~LteEnbPhySrsFirstFrameTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Configure the SRS of a UE at the eNB PHY
+   *
+   * \param enbPhy the eNB PHY
+   */
+  void ConfigureSrs (Ptr<LteEnbPhy> enbPhy);
+
+  /// Count the subframes run with the SRS configured
+  void CountSubframe (void);
+
+  uint32_t m_numSubframes; ///< the number of subframes run with the SRS configured
+};
+
+LteEnbPhySrsFirstFrameTestCase::LteEnbPhySrsFirstFrameTestCase ()
+  : TestCase ("SRS configured in the first frame"),
+    m_numSubframes (0)
+{
+}
+
+LteEnbPhySrsFirstFrameTestCase::~LteEnbPhySrsFirstFrameTestCase ()
+{
+}
+
+void
+LteEnbPhySrsFirstFrameTestCase::ConfigureSrs (Ptr<LteEnbPhy> enbPhy)
+{
+  // SRS configuration index 0: periodicity of 2 ms
+  uint16_t rnti = 1;
+  enbPhy->GetLteEnbCphySapProvider ()->AddUe (rnti);
+  enbPhy->GetLteEnbCphySapProvider ()->SetSrsConfigurationIndex (rnti, 0);
+}
+
+void
+LteEnbPhySrsFirstFrameTestCase::CountSubframe (void)
+{
+  ++m_numSubframes;
+}
+
+void
+LteEnbPhySrsFirstFrameTestCase::DoRun (void)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  Ptr<LteEnbPhy> enbPhy = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetPhy ();
+
+  // before the first subframe
+  Simulator::Schedule (Seconds (0), &LteEnbPhySrsFirstFrameTestCase::ConfigureSrs, this, enbPhy);
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (500 + 1000 * i), &LteEnbPhySrsFirstFrameTestCase::CountSubframe, this);
+    }
+  Simulator::Stop (MilliSeconds (20));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_numSubframes, 20, "the subframes of the first two frames did not run");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief eNB PHY SRS test suite
+ */
+class LteEnbPhySrsTestSuite : public TestSuite
+{
+public:
+  LteEnbPhySrsTestSuite ();
+};
+
+LteEnbPhySrsTestSuite::LteEnbPhySrsTestSuite ()
+  : TestSuite ("lte-enb-phy-srs", SYSTEM)
+{
+  AddTestCase (new LteEnbPhySrsFirstFrameTestCase (), TestCase::QUICK);
+}
+
+static LteEnbPhySrsTestSuite g_lteEnbPhySrsTestSuite; ///< the test suite
@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/lte-helper.h"
+#include "ns3/point-to-point-epc-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-rrc.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/lte-spectrum-phy.h"
+#include "ns3/antenna-model.h"
+#include "ns3/epc-ue-nas.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestPreAttach");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the UEs attached with LteHelper::PreAttach are connected
+ * with their bearers set up before the first subframe, and that their
+ * traffic flows.
+ */
+class LtePreAttachTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param useEpc whether the EPC is used
+   */
+  LtePreAttachTestCase (bool useEpc);
+  virtual ~LtePreAttachTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the RRC and NAS state of the UEs and of their eNB
+   *
+   * \param ueDevs the UE devices
+   * \param enbDevs the eNB devices
+   */
+  void CheckConnected (NetDeviceContainer ueDevs, NetDeviceContainer enbDevs);
+
+  bool m_useEpc; ///< whether the EPC is used
+  uint32_t m_numChecked; ///< the number of UEs found connected
+};
+
+LtePreAttachTestCase::LtePreAttachTestCase (bool useEpc)
+  : TestCase (useEpc ? "Pre-attached UEs with EPC" : "Pre-attached UEs without EPC"),
+    m_useEpc (useEpc),
+    m_numChecked (0)
+{
+}
+
+LtePreAttachTestCase::~LtePreAttachTestCase ()
+{
+}
+
+void
+LtePreAttachTestCase::CheckConnected (NetDeviceContainer ueDevs, NetDeviceContainer enbDevs)
+{
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<LteUeNetDevice> ueDev = ueDevs.Get (i)->GetObject<LteUeNetDevice> ();
+      Ptr<LteEnbNetDevice> enbDev = enbDevs.Get (i % enbDevs.GetN ())->GetObject<LteEnbNetDevice> ();
+      Ptr<LteUeRrc> ueRrc = ueDev->GetRrc ();
+      NS_TEST_ASSERT_MSG_EQ (ueRrc->GetState (), LteUeRrc::CONNECTED_NORMALLY, "UE " << i << " not connected");
+      NS_TEST_ASSERT_MSG_EQ (ueRrc->GetCellId (), enbDev->GetCellId (), "UE " << i << " in the wrong cell");
+      NS_TEST_ASSERT_MSG_EQ (ueRrc->GetUlBandwidth (), enbDev->GetUlBandwidth (), "SIB2 of UE " << i << " not applied");
+
+      Ptr<LteEnbRrc> enbRrc = enbDev->GetRrc ();
+      NS_TEST_ASSERT_MSG_EQ (enbRrc->HasUeManager (ueRrc->GetRnti ()), true, "no context for UE " << i);
+      Ptr<UeManager> ueManager = enbRrc->GetUeManager (ueRrc->GetRnti ());
+      NS_TEST_ASSERT_MSG_EQ (ueManager->GetState (), UeManager::CONNECTED_NORMALLY, "UE " << i << " not connected at the eNB");
+      NS_TEST_ASSERT_MSG_EQ (ueManager->GetImsi (), ueDev->GetImsi (), "wrong IMSI for UE " << i);
+      if (m_useEpc)
+        {
+          NS_TEST_ASSERT_MSG_EQ (ueDev->GetNas ()->GetState (), EpcUeNas::ACTIVE, "NAS of UE " << i << " not active");
+          // the default and the dedicated bearers
+          NS_TEST_ASSERT_MSG_EQ (ueManager->GetErabList ().size (), 2, "wrong number of bearers for UE " << i);
+        }
+      ++m_numChecked;
+    }
+}
+
+void
+LtePreAttachTestCase::DoRun (void)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DataErrorModelEnabled", BooleanValue (false));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("ShareUeAntennaModel", BooleanValue (true));
+  Ptr<PointToPointEpcHelper> epcHelper;
+  if (m_useEpc)
+    {
+      epcHelper = CreateObject<PointToPointEpcHelper> ();
+      lteHelper->SetEpcHelper (epcHelper);
+    }
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (2);
+  ueNodes.Create (6);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (1000.0, 0.0, 30.0));
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (1000.0 * (i % 2) + 20.0 * (i + 1), 10.0, 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  Ptr<LteUeNetDevice> ueDev0 = ueDevs.Get (0)->GetObject<LteUeNetDevice> ();
+  Ptr<LteUeNetDevice> ueDev1 = ueDevs.Get (1)->GetObject<LteUeNetDevice> ();
+  NS_TEST_ASSERT_MSG_EQ (ueDev0->GetPhy ()->GetDlSpectrumPhy ()->GetRxAntenna (),
+                         ueDev1->GetPhy ()->GetDlSpectrumPhy ()->GetRxAntenna (),
+                         "antenna model not shared");
+
+  std::vector<Ptr<PacketSink> > sinks;
+  if (m_useEpc)
+    {
+      Ptr<Node> pgw = epcHelper->GetPgwNode ();
+      NodeContainer remoteHostContainer;
+      remoteHostContainer.Create (1);
+      Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+      InternetStackHelper internet;
+      internet.Install (remoteHostContainer);
+      PointToPointHelper p2ph;
+      p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+      p2ph.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (1)));
+      NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+      Ipv4AddressHelper ipv4h;
+      ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+      ipv4h.Assign (internetDevices);
+      Ipv4StaticRoutingHelper ipv4RoutingHelper;
+      Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+      remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+      internet.Install (ueNodes);
+      Ipv4InterfaceContainer ueIpIfaces = epcHelper->AssignUeIpv4Address (ueDevs);
+      for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+        {
+          Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (i)->GetObject<Ipv4> ());
+          ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+
+          // the downlink traffic goes over the dedicated bearer
+          uint16_t dlPort = 1234;
+          PacketSinkHelper packetSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), dlPort));
+          ApplicationContainer apps = packetSinkHelper.Install (ueNodes.Get (i));
+          sinks.push_back (apps.Get (0)->GetObject<PacketSink> ());
+          UdpClientHelper client (ueIpIfaces.GetAddress (i), dlPort);
+          client.SetAttribute ("MaxPackets", UintegerValue (10));
+          client.SetAttribute ("Interval", TimeValue (MilliSeconds (10)));
+          client.SetAttribute ("PacketSize", UintegerValue (100));
+          apps = client.Install (remoteHost);
+          apps.Start (MilliSeconds (10));
+        }
+    }
+
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      lteHelper->PreAttach (ueDevs.Get (i), enbDevs.Get (i % 2));
+    }
+  if (m_useEpc)
+    {
+      Ptr<EpcTft> tft = Create<EpcTft> ();
+      EpcTft::PacketFilter dlpf;
+      dlpf.localPortStart = 1234;
+      dlpf.localPortEnd = 1234;
+      tft->Add (dlpf);
+      lteHelper->ActivateDedicatedEpsBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_OPERATOR), tft);
+    }
+  else
+    {
+      lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+
+  // before the first subframe
+  Simulator::Schedule (MicroSeconds (500), &LtePreAttachTestCase::CheckConnected, this, ueDevs, enbDevs);
+  Simulator::Stop (MilliSeconds (300));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_numChecked, ueDevs.GetN (), "the UEs have not been checked");
+  for (uint32_t i = 0; i < sinks.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (sinks.at (i)->GetTotalRx (), 10 * 100, "wrong downlink traffic for UE " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Pre-attach test suite
+ */
+class LtePreAttachTestSuite : public TestSuite
+{
+public:
+  LtePreAttachTestSuite ();
+};
+
+LtePreAttachTestSuite::LtePreAttachTestSuite ()
+  : TestSuite ("lte-pre-attach", SYSTEM)
+{
+  AddTestCase (new LtePreAttachTestCase (false), TestCase::QUICK);
+  AddTestCase (new LtePreAttachTestCase (true), TestCase::QUICK);
+}
+
+static LtePreAttachTestSuite g_ltePreAttachTestSuite; ///< the test suite
@@ -0,0 +1,181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/lte-helper.h"
+#include "ns3/radio-environment-map-helper.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the map computed directly from the propagation models
+ * is the one obtained by simulating the reception of the control channel.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param threads the number of threads of the direct computation
+   */
+  LteRadioEnvironmentMapTestCase (uint32_t threads);
+  virtual ~LteRadioEnvironmentMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Generate a map with two sectored eNodeBs
+   *
+   * \param direct whether to compute the map directly
+   * \param fileName the name of the map file
+   */
+  void GenerateMap (bool direct, std::string fileName);
+
+  /**
+   * Read the lines of a map
+   *
+   * \param fileName the name of the map file
+   * \return the values of the map
+   */
+  std::vector<double> ReadMap (std::string fileName);
+
+  uint32_t m_threads; ///< the number of threads of the direct computation
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase (uint32_t threads)
+  : TestCase ("Direct REM computed with " + std::string (threads == 1 ? "one thread" : "several threads")),
+    m_threads (threads)
+{
+}
+
+LteRadioEnvironmentMapTestCase::~LteRadioEnvironmentMapTestCase ()
+{
+}
+
+void
+LteRadioEnvironmentMapTestCase::GenerateMap (bool direct, std::string fileName)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::LogDistancePropagationLossModel"));
+  lteHelper->SetPathlossModelAttribute ("Exponent", DoubleValue (3.5));
+  lteHelper->SetEnbAntennaModelType ("ns3::CosineAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (90));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  enbNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0, 0, 30));
+  enbNodes.Get (1)->GetObject<MobilityModel> ()->SetPosition (Vector (600, 100, 30));
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (fileName));
+  remHelper->SetAttribute ("XMin", DoubleValue (-100.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (700.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (9));
+  remHelper->SetAttribute ("YMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (200.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (5));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("Direct", BooleanValue (direct));
+  remHelper->SetAttribute ("DirectThreads", UintegerValue (m_threads));
+  remHelper->Install ();
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+std::vector<double>
+LteRadioEnvironmentMapTestCase::ReadMap (std::string fileName)
+{
+  std::vector<double> values;
+  std::ifstream file (fileName.c_str ());
+  double value;
+  while (file >> value)
+    {
+      values.push_back (value);
+    }
+  return values;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  std::string simulatedFile = CreateTempDirFilename ("rem-simulated.out");
+  std::string directFile = CreateTempDirFilename ("rem-direct.out");
+  GenerateMap (false, simulatedFile);
+  GenerateMap (true, directFile);
+
+  std::vector<double> simulated = ReadMap (simulatedFile);
+  std::vector<double> direct = ReadMap (directFile);
+  NS_TEST_ASSERT_MSG_EQ (simulated.size (), 9 * 5 * 4, "Wrong number of values in the simulated map");
+  NS_TEST_ASSERT_MSG_EQ (direct.size (), simulated.size (), "Wrong number of values in the direct map");
+  for (uint32_t i = 0; i < simulated.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (direct[i], simulated[i], std::fabs (simulated[i]) * 1e-4,
+                                 "Wrong value " << i % 4 << " of point " << i / 4);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Radio environment map test suite
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase (1), TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapTestCase (3), TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; ///< the test suite
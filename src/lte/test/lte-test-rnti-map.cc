@@ -0,0 +1,125 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+
+#include "ns3/test.h"
+#include "ns3/lte-rnti-map.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that LteRntiMap behaves like the std::map it replaces in
+ * the schedulers, including when elements are erased while iterating.
+ */
+class LteRntiMapTestCase : public TestCase
+{
+public:
+  LteRntiMapTestCase ();
+  virtual ~LteRntiMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRntiMapTestCase::LteRntiMapTestCase ()
+  : TestCase ("Compare LteRntiMap with std::map")
+{
+}
+
+LteRntiMapTestCase::~LteRntiMapTestCase ()
+{
+}
+
+void
+LteRntiMapTestCase::DoRun (void)
+{
+  LteRntiMap<uint32_t> map;
+  std::map<uint16_t, uint32_t> reference;
+  uint16_t rntis[] = { 7, 3, 12, 1, 9, 4 };
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (map.insert (std::make_pair (rntis[i], i * 10)).second, true, "RNTI not inserted");
+      reference.insert (std::make_pair (rntis[i], i * 10));
+    }
+  NS_TEST_ASSERT_MSG_EQ (map.insert (std::make_pair (rntis[0], 99)).second, false, "RNTI inserted twice");
+  NS_TEST_ASSERT_MSG_EQ (map.size (), reference.size (), "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ ((map.find (5) == map.end ()), true, "Missing RNTI found");
+  NS_TEST_ASSERT_MSG_EQ (map.find (12)->second, 20, "Wrong value");
+  map[5] = 50;
+  reference[5] = 50;
+
+  // erase the elements with an odd value while iterating, as the schedulers do
+  LteRntiMap<uint32_t>::iterator it = map.begin ();
+  while (it != map.end ())
+    {
+      if ((*it).second % 20 != 0)
+        {
+          LteRntiMap<uint32_t>::iterator temp = it;
+          it++;
+          map.erase (temp);
+        }
+      else
+        {
+          it++;
+        }
+    }
+  std::map<uint16_t, uint32_t>::iterator itRef = reference.begin ();
+  while (itRef != reference.end ())
+    {
+      if ((*itRef).second % 20 != 0)
+        {
+          reference.erase (itRef++);
+        }
+      else
+        {
+          itRef++;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (map.size (), reference.size (), "Wrong size after the erasures");
+  for (it = map.begin (), itRef = reference.begin (); it != map.end (); it++, itRef++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*it).first, (*itRef).first, "Wrong order of the RNTIs");
+      NS_TEST_ASSERT_MSG_EQ ((*it).second, (*itRef).second, "Wrong value");
+    }
+  NS_TEST_ASSERT_MSG_EQ (map.erase (3), 0, "Erased RNTI found");
+  map.clear ();
+  NS_TEST_ASSERT_MSG_EQ (map.empty (), true, "Map not empty");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteRntiMap test suite
+ */
+class LteRntiMapTestSuite : public TestSuite
+{
+public:
+  LteRntiMapTestSuite ();
+};
+
+LteRntiMapTestSuite::LteRntiMapTestSuite ()
+  : TestSuite ("lte-rnti-map", UNIT)
+{
+  AddTestCase (new LteRntiMapTestCase, TestCase::QUICK);
+}
+
+static LteRntiMapTestSuite g_lteRntiMapTestSuite; ///< the test suite
@@ -0,0 +1,217 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-common.h"
+#include "ns3/eps-bearer.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestSubframeBatching");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that batching the receptions of the LTE channels does not
+ * change the outcome of a multi-cell simulation, nor the node context in
+ * which the receptions run.
+ */
+class LteSubframeBatchingTestCase : public TestCase
+{
+public:
+  LteSubframeBatchingTestCase ();
+  virtual ~LteSubframeBatchingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the simulation
+   *
+   * \param batching the value of the SubframeBatching attribute
+   * \return the log of the receptions, sorted since the order of the
+   * receptions of a PHY at the same time depends on the addresses of the
+   * objects
+   */
+  std::string RunSimulation (bool batching);
+
+  /**
+   * DL reception trace sink
+   *
+   * \param params the reception parameters
+   */
+  void DlPhyReception (PhyReceptionStatParameters params);
+
+  /**
+   * UL reception trace sink
+   *
+   * \param params the reception parameters
+   */
+  void UlPhyReception (PhyReceptionStatParameters params);
+
+  /**
+   * RSRP and SINR trace sink
+   *
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param rsrp the RSRP
+   * \param sinr the SINR
+   * \param ccId the component carrier ID
+   */
+  void ReportSinr (uint16_t cellId, uint16_t rnti, double rsrp, double sinr, uint8_t ccId);
+
+  std::vector<std::string> m_log; ///< the log of the receptions
+};
+
+LteSubframeBatchingTestCase::LteSubframeBatchingTestCase ()
+  : TestCase ("Receptions with and without subframe batching")
+{
+}
+
+LteSubframeBatchingTestCase::~LteSubframeBatchingTestCase ()
+{
+}
+
+void
+LteSubframeBatchingTestCase::DlPhyReception (PhyReceptionStatParameters params)
+{
+  std::ostringstream line;
+  line << "DL " << params.m_timestamp << " " << Simulator::GetContext () << " " << params.m_cellId << " " << params.m_rnti
+       << " " << params.m_size << " " << (uint16_t) params.m_correctness << "\n";
+  m_log.push_back (line.str ());
+}
+
+void
+LteSubframeBatchingTestCase::UlPhyReception (PhyReceptionStatParameters params)
+{
+  std::ostringstream line;
+  line << "UL " << params.m_timestamp << " " << Simulator::GetContext () << " " << params.m_cellId << " " << params.m_rnti
+       << " " << params.m_size << " " << (uint16_t) params.m_correctness << "\n";
+  m_log.push_back (line.str ());
+}
+
+void
+LteSubframeBatchingTestCase::ReportSinr (uint16_t cellId, uint16_t rnti, double rsrp, double sinr, uint8_t ccId)
+{
+  std::ostringstream line;
+  line << "SINR " << Simulator::Now ().GetMilliSeconds () << " " << Simulator::GetContext ()
+       << " " << cellId << " " << rnti
+       << " " << rsrp << " " << sinr << "\n";
+  m_log.push_back (line.str ());
+}
+
+std::string
+LteSubframeBatchingTestCase::RunSimulation (bool batching)
+{
+  m_log.clear ();
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("SubframeBatching", BooleanValue (batching));
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (3);
+  ueNodes.Create (9);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (1000.0 * i, 0.0, 30.0));
+    }
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (1000.0 * (i % 3) + 150.0 * (i / 3 + 1), 100.0 * (i / 3), 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      lteHelper->Attach (ueDevs.Get (i), enbDevs.Get (i % 3));
+    }
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+  // the two simulations run in the same process: fix the random streams
+  lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1000);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/DlSpectrumPhy/DlPhyReception",
+                                 MakeCallback (&LteSubframeBatchingTestCase::DlPhyReception, this));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/UlSpectrumPhy/UlPhyReception",
+                                 MakeCallback (&LteSubframeBatchingTestCase::UlPhyReception, this));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/ReportCurrentCellRsrpSinr",
+                                 MakeCallback (&LteSubframeBatchingTestCase::ReportSinr, this));
+
+  Simulator::Stop (Seconds (0.3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::sort (m_log.begin (), m_log.end ());
+  std::string log;
+  for (std::vector<std::string>::const_iterator it = m_log.begin (); it != m_log.end (); ++it)
+    {
+      log += *it;
+    }
+  return log;
+}
+
+void
+LteSubframeBatchingTestCase::DoRun (void)
+{
+  std::string reference = RunSimulation (false);
+  std::string batched = RunSimulation (true);
+  NS_TEST_ASSERT_MSG_GT (reference.size (), 0, "No reception");
+  NS_TEST_ASSERT_MSG_EQ (batched, reference, "Batching the receptions changed the simulation");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Subframe batching test suite
+ */
+class LteSubframeBatchingTestSuite : public TestSuite
+{
+public:
+  LteSubframeBatchingTestSuite ();
+};
+
+LteSubframeBatchingTestSuite::LteSubframeBatchingTestSuite ()
+  : TestSuite ("lte-subframe-batching", SYSTEM)
+{
+  AddTestCase (new LteSubframeBatchingTestCase, TestCase::QUICK);
+}
+
+static LteSubframeBatchingTestSuite g_lteSubframeBatchingTestSuite; ///< the test suite
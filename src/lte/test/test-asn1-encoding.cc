@@ -789,6 +789,76 @@ HandoverPreparationInfoTestCase::DoRun (void)
   packet = 0;
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the reuse of the encodings of the system information
+ * blocks by messages where they start at different bit offsets
+ */
+class SystemInformationEncodingTestCase : public RrcHeaderTestCase
+{
+public:
+  SystemInformationEncodingTestCase ();
+  virtual void DoRun (void);
+};
+
+SystemInformationEncodingTestCase::SystemInformationEncodingTestCase () : RrcHeaderTestCase ("Testing SystemInformationEncodingTestCase")
+{
+}
+
+void
+SystemInformationEncodingTestCase::DoRun (void)
+{
+  NS_LOG_DEBUG ("============= SystemInformationEncodingTestCase ===========");
+
+  LteRrcSap::HandoverPreparationInfo msg;
+  msg.asConfig.sourceDlCarrierFreq = 3;
+  msg.asConfig.sourceUeIdentity = 11;
+  msg.asConfig.sourceRadioResourceConfig = CreateRadioResourceConfigDedicated ();
+  msg.asConfig.sourceMasterInformationBlock.dlBandwidth = 3;
+  msg.asConfig.sourceMasterInformationBlock.systemFrameNumber = 1;
+  msg.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIndication = false;
+  msg.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIdentity = 0;
+  msg.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity = 123;
+  msg.asConfig.sourceSystemInformationBlockType2.freqInfo.ulBandwidth = 25;
+  msg.asConfig.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq = 18100;
+  msg.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  msg.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  msg.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  msg.asConfig.sourceMeasConfig.haveQuantityConfig = false;
+  msg.asConfig.sourceMeasConfig.haveMeasGapConfig = false;
+  msg.asConfig.sourceMeasConfig.haveSpeedStatePars = false;
+  msg.asConfig.sourceMeasConfig.sMeasure = 33;
+
+  // two cells, and messages where the blocks start at two bit offsets
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      msg.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity = 1 + i / 2;
+      msg.asConfig.sourceMeasConfig.haveSmeasure = (i % 2 == 1);
+
+      HandoverPreparationInfoHeader source;
+      source.SetMessage (msg);
+      packet = Create<Packet> ();
+      packet->AddHeader (source);
+      TestUtils::LogPacketContents (packet);
+      HandoverPreparationInfoHeader destination;
+      packet->RemoveHeader (destination);
+
+      LteRrcSap::AsConfig src = source.GetAsConfig ();
+      LteRrcSap::AsConfig dst = destination.GetAsConfig ();
+      NS_TEST_ASSERT_MSG_EQ (src.sourceMeasConfig.haveSmeasure, dst.sourceMeasConfig.haveSmeasure, "haveSmeasure");
+      NS_TEST_ASSERT_MSG_EQ (src.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity, dst.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity, "cellIdentity");
+      NS_TEST_ASSERT_MSG_EQ (src.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity, dst.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity, "plmnIdentity");
+      NS_TEST_ASSERT_MSG_EQ (src.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq, dst.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq, "ulCarrierFreq");
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) src.sourceSystemInformationBlockType2.freqInfo.ulBandwidth, (uint16_t) dst.sourceSystemInformationBlockType2.freqInfo.ulBandwidth, "ulBandwidth");
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) src.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax, (uint16_t) dst.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax, "preambleTransMax");
+      NS_TEST_ASSERT_MSG_EQ (src.sourceDlCarrierFreq, dst.sourceDlCarrierFreq, "sourceDlCarrierFreq");
+    }
+
+  packet = 0;
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -1137,6 +1207,7 @@ Asn1EncodingSuite::Asn1EncodingSuite ()
   AddTestCase (new RrcConnectionReconfigurationCompleteTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReconfigurationTestCase (), TestCase::QUICK);
   AddTestCase (new HandoverPreparationInfoTestCase (), TestCase::QUICK);
+  AddTestCase (new SystemInformationEncodingTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReestablishmentRequestTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReestablishmentTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReestablishmentCompleteTestCase (), TestCase::QUICK);
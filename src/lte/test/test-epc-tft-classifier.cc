@@ -43,8 +43,8 @@ NS_LOG_COMPONENT_DEFINE ("TestEpcTftClassifier");
  *
  * \brief Test case to check the functionality of the Tft Classifier. Test 
  * consist of defining different TFT configurations, i.e. direction, ports, 
- * address, and it is checking if the clasiffication of UDP packets is
- * done correctly.
+ * address, and it is checking if the clasiffication of UDP and TCP packets
+ * is done correctly.
  */
 class EpcTftClassifierTestCase : public TestCase
 {
@@ -124,6 +124,9 @@ EpcTftClassifierTestCase::EpcTftClassifierTestCase (Ptr<EpcTftClassifier> c,
 
   m_udpHeader.SetSourcePort (sp);
   m_udpHeader.SetDestinationPort (dp);  
+
+  m_tcpHeader.SetSourcePort (sp);
+  m_tcpHeader.SetDestinationPort (dp);
 }
 
 EpcTftClassifierTestCase::~EpcTftClassifierTestCase ()
@@ -164,10 +167,132 @@ EpcTftClassifierTestCase::DoRun (void)
   NS_LOG_LOGIC (this << *udpPacket);
   uint32_t obtainedTftId = m_c ->Classify (udpPacket, m_d);
   NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad classification of UDP packet");
+
+  Ptr<Packet> tcpPacket = Create<Packet> ();
+  m_ipHeader.SetProtocol (TcpL4Protocol::PROT_NUMBER);
+  tcpPacket->AddHeader (m_tcpHeader);
+  tcpPacket->AddHeader (m_ipHeader);
+  NS_LOG_LOGIC (this << *tcpPacket);
+  obtainedTftId = m_c ->Classify (tcpPacket, m_d);
+  NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad classification of TCP packet");
+}
+
+
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case to check that the Tft Classifier matches the packets
+ * which do not hold the transport ports (non-first fragments, truncated
+ * packets) only with the packet filters accepting any port, and that it
+ * takes into account the packet filters added to a TFT after a packet was
+ * classified.
+ */
+class EpcTftClassifierPortlessTestCase : public TestCase
+{
+public:
+  EpcTftClassifierPortlessTestCase ();
+  virtual ~EpcTftClassifierPortlessTestCase ();
+
+private:
+  /**
+   * Build an uplink IPv4 packet
+   *
+   * \param da the destination address
+   * \param protocol the transport protocol number
+   * \param fragmentOffset the fragment offset, in bytes
+   * \param payloadSize the size of the IPv4 payload, in bytes
+   * \param dp the destination port, written if the payload can hold it
+   * \return the packet
+   */
+  static Ptr<Packet> BuildPacket (Ipv4Address da, uint8_t protocol, uint16_t fragmentOffset,
+                                  uint32_t payloadSize, uint16_t dp);
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierPortlessTestCase::EpcTftClassifierPortlessTestCase ()
+  : TestCase ("packets without transport ports and TFTs changed after classification")
+{
 }
 
+EpcTftClassifierPortlessTestCase::~EpcTftClassifierPortlessTestCase ()
+{
+}
 
+Ptr<Packet>
+EpcTftClassifierPortlessTestCase::BuildPacket (Ipv4Address da, uint8_t protocol, uint16_t fragmentOffset,
+                                               uint32_t payloadSize, uint16_t dp)
+{
+  Ptr<Packet> p;
+  if (payloadSize >= 8)
+    {
+      p = Create<Packet> (payloadSize - 8);
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (4);
+      udpHeader.SetDestinationPort (dp);
+      p->AddHeader (udpHeader);
+    }
+  else
+    {
+      p = Create<Packet> (payloadSize);
+    }
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("8.1.1.1"));
+  ipHeader.SetDestination (da);
+  ipHeader.SetProtocol (protocol);
+  ipHeader.SetFragmentOffset (fragmentOffset);
+  ipHeader.SetPayloadSize (payloadSize);
+  p->AddHeader (ipHeader);
+  return p;
+}
 
+void
+EpcTftClassifierPortlessTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.direction = EpcTft::UPLINK;
+  pf.remoteAddress.Set ("9.0.0.0");
+  pf.remoteMask.Set (0xFF000000);
+  pf.remotePortStart = 5000;
+  pf.remotePortEnd = 5000;
+  tft->Add (pf);
+  c->Add (tft, 2);
+  Ptr<EpcTft> anyPortTft = Create<EpcTft> ();
+  EpcTft::PacketFilter anyPortPf;
+  anyPortPf.direction = EpcTft::UPLINK;
+  anyPortPf.remoteAddress.Set ("6.0.0.0");
+  anyPortPf.remoteMask.Set (0xFF000000);
+  anyPortTft->Add (anyPortPf);
+  c->Add (anyPortTft, 3);
+
+  uint32_t id = c->Classify (BuildPacket (Ipv4Address ("9.1.1.1"), UdpL4Protocol::PROT_NUMBER, 0, 100, 5000), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 2, "bad classification of the first fragment");
+  id = c->Classify (BuildPacket (Ipv4Address ("9.1.1.1"), UdpL4Protocol::PROT_NUMBER, 0, 100, 6000), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 1, "bad classification of a packet to another port");
+  id = c->Classify (BuildPacket (Ipv4Address ("9.1.1.1"), UdpL4Protocol::PROT_NUMBER, 1480, 2, 0), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 1, "a non-first fragment matched a filter restricted to a port");
+  id = c->Classify (BuildPacket (Ipv4Address ("7.1.1.1"), UdpL4Protocol::PROT_NUMBER, 1480, 2, 0), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 1, "bad classification of a non-first fragment to another host");
+  id = c->Classify (BuildPacket (Ipv4Address ("9.1.1.1"), TcpL4Protocol::PROT_NUMBER, 0, 2, 0), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 1, "a truncated packet matched a filter restricted to a port");
+  id = c->Classify (BuildPacket (Ipv4Address ("6.1.1.1"), UdpL4Protocol::PROT_NUMBER, 1480, 2, 0), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 3, "bad classification of a non-first fragment by a filter accepting any port");
+  id = c->Classify (BuildPacket (Ipv4Address ("6.1.1.1"), TcpL4Protocol::PROT_NUMBER, 0, 2, 0), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 3, "bad classification of a truncated packet by a filter accepting any port");
+
+  // a filter added to the TFT after the classification of packets
+  id = c->Classify (BuildPacket (Ipv4Address ("7.1.1.1"), UdpL4Protocol::PROT_NUMBER, 0, 100, 5000), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 1, "bad classification before the addition of a filter");
+  pf.remoteAddress.Set ("7.0.0.0");
+  tft->Add (pf);
+  id = c->Classify (BuildPacket (Ipv4Address ("7.1.1.1"), UdpL4Protocol::PROT_NUMBER, 0, 100, 5000), EpcTft::UPLINK);
+  NS_TEST_EXPECT_MSG_EQ (id, 2, "filter added to the TFT not taken into account");
+}
 
 /**
  * \ingroup lte-test
@@ -367,4 +492,10 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),     9,     5897,     0,    2), TestCase::QUICK);
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),  5897,       10,     0,    2), TestCase::QUICK);
 
+
+  ///////////////////////////////////////////
+  // check packets without transport ports
+  ///////////////////////////////////////////
+
+  AddTestCase (new EpcTftClassifierPortlessTestCase (), TestCase::QUICK);
 }
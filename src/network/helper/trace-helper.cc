@@ -28,6 +28,7 @@
 #include "ns3/names.h"
 #include "ns3/net-device.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/binary-trace-writer.h"
 
 #include "trace-helper.h"
 
@@ -35,6 +36,23 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceHelper");
 
+/// The name of the pcapng file receiving the packets of the pcap files
+static std::string g_pcapNgFilename;
+/// The pcapng file receiving the packets of the pcap files, once created
+static Ptr<PcapNgFile> g_pcapNgFile;
+
+/// Whether the device helpers create binary traces
+static bool g_binaryTrace = false;
+/// Whether the binary traces record the headers of the packets
+static bool g_binaryTraceHeaderDigest = true;
+
+/// Release the pcapng file, which is closed with its last interface
+static void
+ReleasePcapNgFile (void)
+{
+  g_pcapNgFile = 0;
+}
+
 PcapHelper::PcapHelper ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -56,7 +74,27 @@ PcapHelper::CreateFile (
   NS_LOG_FUNCTION (filename << filemode << dataLinkType << snapLen << tzCorrection);
 
   Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
-  file->Open (filename, filemode);
+  if (!g_pcapNgFilename.empty () && !(filemode & (std::ios::in | std::ios::app)))
+    {
+      if (g_pcapNgFile == 0)
+        {
+          g_pcapNgFile = Create<PcapNgFile> ();
+          g_pcapNgFile->Open (g_pcapNgFilename);
+          NS_ABORT_MSG_IF (g_pcapNgFile->Fail (), "Unable to Open " << g_pcapNgFilename);
+          Simulator::ScheduleDestroy (&ReleasePcapNgFile);
+        }
+      // name the interface after the pcap file, without directory nor extension
+      std::string name = filename.substr (filename.find_last_of ('/') + 1);
+      if (name.size () > 5 && name.compare (name.size () - 5, 5, ".pcap") == 0)
+        {
+          name.resize (name.size () - 5);
+        }
+      file->Open (g_pcapNgFile, name);
+    }
+  else
+    {
+      file->Open (filename, filemode);
+    }
   NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename << " for mode " << filemode);
 
   file->Init (dataLinkType, snapLen, tzCorrection);
@@ -76,6 +114,14 @@ PcapHelper::CreateFile (
   return file;
 }
 
+void
+PcapHelper::SetPcapNgFile (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+  g_pcapNgFilename = filename;
+  g_pcapNgFile = 0;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -208,6 +254,30 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   return StreamWrapper;
 }
 
+Ptr<OutputStreamWrapper>
+AsciiTraceHelper::CreateBinaryFileStream (std::string filename, std::ios::openmode filemode)
+{
+  NS_LOG_FUNCTION (filename << filemode);
+
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (filename, filemode | std::ios::binary);
+  stream->EnableBinaryTrace (g_binaryTraceHeaderDigest);
+  return stream;
+}
+
+void
+AsciiTraceHelper::SetBinaryFormat (bool enable, bool headerDigest)
+{
+  NS_LOG_FUNCTION (enable << headerDigest);
+  g_binaryTrace = enable;
+  g_binaryTraceHeaderDigest = headerDigest;
+}
+
+bool
+AsciiTraceHelper::IsBinaryFormat (void)
+{
+  return g_binaryTrace;
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -310,6 +380,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::ENQUEUE, p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -317,6 +393,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::ENQUEUE, context, p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -336,6 +418,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::DROP, p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -343,6 +431,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::DROP, context, p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -363,6 +457,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::DEQUEUE, p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -370,6 +470,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::DEQUEUE, context, p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -387,6 +493,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::RECEIVE, p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -394,6 +506,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  BinaryTraceWriter *writer = stream->GetBinaryTraceWriter ();
+  if (writer != 0)
+    {
+      writer->Write (BinaryTraceWriter::RECEIVE, context, p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -109,6 +109,24 @@ public:
                                    DataLinkType dataLinkType,
                                    uint32_t snapLen = std::numeric_limits<uint32_t>::max (),
                                    int32_t tzCorrection = 0);
+
+  /**
+   * @brief Write the packets of the pcap files created afterwards to a
+   * single pcapng file.
+   *
+   * Each pcap file that CreateFile is asked to create for writing becomes
+   * an interface of the pcapng file, named after the pcap file without its
+   * directory and extension (e.g. "prefix-0-1"), so that a
+   * simulation tracing many devices opens a single file.  The pcapng file
+   * is created with the first of these interfaces, written by a background
+   * thread, and closed when its last interface is released; it is not
+   * used anymore by the pcap files created after Simulator::Destroy.
+   *
+   * @param filename name of the pcapng file, or an empty string to create
+   * separate pcap files again
+   */
+  static void SetPcapNgFile (std::string filename);
+
   /**
    * @brief Hook a trace source to the default trace sink
    * 
@@ -222,6 +240,45 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Create and initialize an output stream object holding binary
+   * trace records rather than text.
+   *
+   * Only the default trace sinks know how to write to such a stream: they
+   * write a fixed-size record per event (see BinaryTraceWriter) instead of
+   * printing the packet.  The stream must therefore not be handed to any
+   * other trace sink.  The print-binary-trace utility program converts the
+   * file back to text.
+   *
+   * @param filename file name
+   * @param filemode file mode
+   * @returns a smart pointer to the binary output stream
+   */
+  Ptr<OutputStreamWrapper> CreateBinaryFileStream (std::string filename,
+                                                   std::ios::openmode filemode = std::ios::out);
+
+  /**
+   * @brief Let the device helpers write binary trace records rather than
+   * text.
+   *
+   * The EnableAscii and EnableAsciiAll methods of the device helpers which
+   * only hook the default trace sinks then create their files with
+   * CreateBinaryFileStream.  The files created by CreateFileStream, and so
+   * the traces of the other helpers, are still text.
+   *
+   * @param enable whether to write binary traces
+   * @param headerDigest whether to record the headers of the packets, which
+   * is needed to print the packets when converting the trace to text
+   */
+  static void SetBinaryFormat (bool enable, bool headerDigest = true);
+
+  /**
+   * @brief Check whether the device helpers write binary trace records.
+   *
+   * @returns true if SetBinaryFormat enabled the binary traces
+   */
+  static bool IsBinaryFormat (void);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
@@ -20,6 +20,8 @@
 
 #include "ns3/log.h"
 #include "net-device.h"
+#include "ns3/queue-item.h"
+#include "ns3/net-device-queue-interface.h"
 
 namespace ns3 {
 
@@ -41,4 +43,29 @@ NetDevice::~NetDevice ()
   NS_LOG_FUNCTION (this);
 }
 
+uint32_t
+NetDevice::SendBatch (const std::vector<Ptr<QueueDiscItem> > &items)
+{
+  NS_LOG_FUNCTION (this << items.size ());
+  Ptr<NetDeviceQueueInterface> ndqi = GetObject<NetDeviceQueueInterface> ();
+  uint32_t sent = 0;
+  for (auto& item : items)
+    {
+      if (ndqi && ndqi->GetTxQueue (item->GetTxQueueIndex ())->IsStopped ())
+        {
+          break;
+        }
+      Send (item->GetPacket (), item->GetAddress (), item->GetProtocol ());
+      sent++;
+    }
+  return sent;
+}
+
+bool
+NetDevice::SupportsSegmentationOffload (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
 } // namespace ns3
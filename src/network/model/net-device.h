@@ -22,6 +22,7 @@
 #define NET_DEVICE_H
 
 #include <stdint.h>
+#include <vector>
 #include "ns3/callback.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -34,6 +35,7 @@ namespace ns3 {
 
 class Node;
 class Channel;
+class QueueDiscItem;
 
 /**
  * \ingroup network
@@ -260,6 +262,22 @@ public:
    * \return whether the Send operation succeeded 
    */
   virtual bool SendFrom (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber) = 0;
+  /**
+   * \param items the packets sent from above down to Network Device, each
+   *        along with its destination address and protocol number
+   *
+   *  Called from higher layers (i.e., queue discs performing bulk dequeue)
+   *  to send a batch of packets into Network Device. Packets are processed
+   *  in order and processing stops as soon as the transmission queue of the
+   *  device the next packet is destined to is stopped. Packets that are
+   *  processed are consumed by the device, even if their transmission fails.
+   *
+   *  The default implementation calls Send for every packet. Devices may
+   *  override it to process the whole batch before starting a transmission.
+   *
+   * \return the number of packets consumed by the device
+   */
+  virtual uint32_t SendBatch (const std::vector<Ptr<QueueDiscItem> > &items);
   /**
    * \returns the node base class which contains this network
    *          interface.
@@ -359,6 +377,20 @@ public:
    */
   virtual bool SupportsSendFrom (void) const = 0;
 
+  /**
+   * \brief Check whether this device can transmit segmentation-offloaded packets
+   *
+   * A device supporting segmentation offload accepts packets carrying a
+   * SegmentationOffloadTag whose size exceeds the MTU, and transmits them
+   * with the timing of the train of segments they stand for. Packets sent
+   * to devices not supporting the offload are segmented by the IP layer.
+   *
+   * The default implementation returns false.
+   *
+   * \return true if this device supports segmentation offload, false otherwise.
+   */
+  virtual bool SupportsSegmentationOffload (void) const;
+
 };
 
 } // namespace ns3
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/trace-helper.h"
+#include "ns3/binary-trace-writer.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/ethernet-trailer.h"
+#include <sstream>
+#include <cstring>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that a binary trace converted to text is identical to the text
+ * trace of the same events.
+ */
+class BinaryTraceAsciiTestCase : public TestCase
+{
+public:
+  BinaryTraceAsciiTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Trace a packet to the text and binary streams, with and without context
+   * \param p the packet
+   */
+  void TracePacket (Ptr<const Packet> p);
+
+  std::ostringstream m_text;    //!< The text trace
+  std::ostringstream m_binary;  //!< The binary trace
+  Ptr<OutputStreamWrapper> m_textStream;   //!< The text trace stream
+  Ptr<OutputStreamWrapper> m_binaryStream; //!< The binary trace stream
+};
+
+BinaryTraceAsciiTestCase::BinaryTraceAsciiTestCase ()
+  : TestCase ("Check that a binary trace is converted to the text trace")
+{
+}
+
+void
+BinaryTraceAsciiTestCase::TracePacket (Ptr<const Packet> p)
+{
+  AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (m_textStream, p);
+  AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (m_binaryStream, p);
+  std::string context = "/NodeList/3/DeviceList/1/$ns3::CsmaNetDevice/TxQueue/Dequeue";
+  AsciiTraceHelper::DefaultDequeueSinkWithContext (m_textStream, context, p);
+  AsciiTraceHelper::DefaultDequeueSinkWithContext (m_binaryStream, context, p);
+  context = "/NodeList/12/DeviceList/0/$ns3::CsmaNetDevice/MacRx";
+  AsciiTraceHelper::DefaultReceiveSinkWithContext (m_textStream, context, p);
+  AsciiTraceHelper::DefaultReceiveSinkWithContext (m_binaryStream, context, p);
+  AsciiTraceHelper::DefaultDropSinkWithoutContext (m_textStream, p);
+  AsciiTraceHelper::DefaultDropSinkWithoutContext (m_binaryStream, p);
+}
+
+void
+BinaryTraceAsciiTestCase::DoRun (void)
+{
+  Packet::EnablePrinting ();
+  m_textStream = Create<OutputStreamWrapper> (&m_text);
+  m_binaryStream = Create<OutputStreamWrapper> (&m_binary);
+  m_binaryStream->EnableBinaryTrace ();
+
+  Ptr<Packet> p = Create<Packet> (100);
+  Simulator::Schedule (MilliSeconds (1500), &BinaryTraceAsciiTestCase::TracePacket, this, p->Copy ());
+
+  LlcSnapHeader llc;
+  llc.SetType (0x0800);
+  p->AddHeader (llc);
+  EthernetHeader ethernet;
+  ethernet.SetSource (Mac48Address ("00:00:00:00:00:01"));
+  ethernet.SetDestination (Mac48Address ("00:00:00:00:00:02"));
+  ethernet.SetLengthType (p->GetSize ());
+  p->AddHeader (ethernet);
+  EthernetTrailer trailer;
+  trailer.CalcFcs (p);
+  p->AddTrailer (trailer);
+  Simulator::Schedule (Seconds (2.25), &BinaryTraceAsciiTestCase::TracePacket, this, p);
+  Simulator::Schedule (NanoSeconds (3000000001LL), &BinaryTraceAsciiTestCase::TracePacket, this,
+                       p->CreateFragment (10, 50));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::istringstream is (m_binary.str ());
+  std::ostringstream converted;
+  bool ok = BinaryTraceWriter::PrintAscii (is, converted);
+  NS_TEST_EXPECT_MSG_EQ (ok, true, "Invalid binary trace");
+  NS_TEST_EXPECT_MSG_EQ (converted.str (), m_text.str (), "The converted trace differs from the text trace");
+
+  // without the packet headers, a record has a fixed size
+  std::ostringstream noDigest;
+  BinaryTraceWriter writer (&noDigest, false);
+  writer.Write (BinaryTraceWriter::DROP, p);
+  NS_TEST_EXPECT_MSG_EQ (noDigest.str ().size (), 8 + 36, "Unexpected size of a record without digest");
+
+  // the node and device identifiers end the record
+  uint32_t ids[2];
+  std::memcpy (ids, noDigest.str ().data () + 8 + 28, sizeof (ids));
+  NS_TEST_EXPECT_MSG_EQ (ids[0], 0xffffffff, "Node identifier of an event without context");
+  NS_TEST_EXPECT_MSG_EQ (ids[1], 0xffffffff, "Device identifier of an event without context");
+  std::ostringstream boundDevice;
+  BinaryTraceWriter boundWriter (&boundDevice, false);
+  boundWriter.SetDevice (3, 1);
+  boundWriter.Write (BinaryTraceWriter::DROP, p);
+  std::memcpy (ids, boundDevice.str ().data () + 8 + 28, sizeof (ids));
+  NS_TEST_EXPECT_MSG_EQ (ids[0], 3, "Node identifier not recorded");
+  NS_TEST_EXPECT_MSG_EQ (ids[1], 1, "Device identifier not recorded");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+public:
+  BinaryTraceTestSuite ()
+    : TestSuite ("binary-trace", UNIT)
+  {
+    AddTestCase (new BinaryTraceAsciiTestCase (), TestCase::QUICK);
+  }
+};
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -35,6 +35,8 @@
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/error-model.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/llc-snap-header.h"
 #include "ns3/pointer.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
@@ -262,6 +264,100 @@ BurstErrorModelSimple::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_drops, 260 , "Wrong number of drops.");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * ErrorModel recording the packets it evaluates, and corrupting those
+ * without an LLC/SNAP header.
+ */
+class HeaderCheckErrorModel : public ErrorModel
+{
+public:
+  std::vector<uint32_t> m_sizes; //!< The sizes of the packets evaluated
+  std::vector<uint64_t> m_uids; //!< The UIDs of the packets evaluated
+
+private:
+  virtual bool DoCorrupt (Ptr<Packet> p)
+  {
+    m_sizes.push_back (p->GetSize ());
+    m_uids.push_back (p->GetUid ());
+    LlcSnapHeader llc;
+    return p->PeekHeader (llc) != llc.GetSerializedSize () || llc.GetType () != 0x800;
+  }
+  virtual void DoReset (void)
+  {
+  }
+};
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that ErrorModel::IsCorruptSegmented evaluates each segment of a
+ * super-segment with the UID and the headers of the super-segment.
+ */
+class SegmentedErrorModelTest : public TestCase
+{
+public:
+  SegmentedErrorModelTest ();
+  virtual ~SegmentedErrorModelTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Build a super-segment of 4 segments of 100 bytes, with an LLC/SNAP header
+   * \return the super-segment
+   */
+  static Ptr<Packet> BuildSuperSegment (void);
+};
+
+SegmentedErrorModelTest::SegmentedErrorModelTest ()
+  : TestCase ("ErrorModel applied to the segments of a super-segment")
+{
+}
+
+SegmentedErrorModelTest::~SegmentedErrorModelTest ()
+{
+}
+
+Ptr<Packet>
+SegmentedErrorModelTest::BuildSuperSegment (void)
+{
+  Ptr<Packet> p = Create<Packet> (350);
+  LlcSnapHeader llc;
+  llc.SetType (0x800);
+  p->AddHeader (llc);
+  p->AddPacketTag (SegmentationOffloadTag (100, 350));
+  return p;
+}
+
+void
+SegmentedErrorModelTest::DoRun (void)
+{
+  Ptr<HeaderCheckErrorModel> headerEm = CreateObject<HeaderCheckErrorModel> ();
+  Ptr<Packet> p = BuildSuperSegment ();
+  NS_TEST_EXPECT_MSG_EQ (headerEm->IsCorruptSegmented (p), false, "Segments without the headers of the packet");
+  NS_TEST_ASSERT_MSG_EQ (headerEm->m_sizes.size (), 4, "Wrong number of segments evaluated");
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (headerEm->m_sizes[i], 8 + (i < 3 ? 100 : 50), "Wrong size of segment " << i);
+      NS_TEST_EXPECT_MSG_EQ (headerEm->m_uids[i], p->GetUid (), "Wrong UID of segment " << i);
+    }
+  SegmentationOffloadTag tag;
+  p->PeekPacketTag (tag);
+  NS_TEST_EXPECT_MSG_EQ (tag.IsAllLost () || tag.IsLost (0), false, "Segments marked as lost");
+
+  // a ListErrorModel matching the UID of the super-segment corrupts all its segments
+  Ptr<ListErrorModel> listEm = CreateObject<ListErrorModel> ();
+  std::list<uint32_t> uids;
+  uids.push_back (p->GetUid ());
+  listEm->SetList (uids);
+  NS_TEST_EXPECT_MSG_EQ (listEm->IsCorruptSegmented (p), true, "Segments of a listed packet not corrupted");
+  Ptr<Packet> other = BuildSuperSegment ();
+  NS_TEST_EXPECT_MSG_EQ (listEm->IsCorruptSegmented (other), false, "Segments of an unlisted packet corrupted");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -283,6 +379,7 @@ ErrorModelTestSuite::ErrorModelTestSuite ()
 {
   AddTestCase (new ErrorModelSimple, TestCase::QUICK);
   AddTestCase (new BurstErrorModelSimple, TestCase::QUICK);
+  AddTestCase (new SegmentedErrorModelTest, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
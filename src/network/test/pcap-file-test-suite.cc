@@ -25,6 +25,10 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/packet.h"
+#include <fstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -1144,6 +1148,146 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that a pcap file written by the background
+ * thread is identical to the same pcap file written synchronously.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+public:
+  AsyncWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Write the test packets to a pcap file
+   * \param f the pcap file, open for writing
+   */
+  void WritePackets (PcapFile &f);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase ()
+  : TestCase ("Check that a pcap file is written correctly by the background thread")
+{
+}
+
+void
+AsyncWriteTestCase::WritePackets (PcapFile &f)
+{
+  f.Init (1, 400);
+  uint8_t data[500];
+  // enough packets to fill several buffers of the background thread
+  for (uint32_t i = 0; i < 10000; ++i)
+    {
+      std::memset (data, i & 0xff, sizeof (data));
+      if (i % 2)
+        {
+          f.Write (i / 1000, i % 1000, data, sizeof (data));
+        }
+      else
+        {
+          f.Write (i / 1000, i % 1000, Create<Packet> (data, i % 500));
+        }
+    }
+}
+
+void
+AsyncWriteTestCase::DoRun (void)
+{
+  std::string syncFilename = CreateTempDirFilename ("sync.pcap");
+  std::string asyncFilename = CreateTempDirFilename ("async.pcap");
+
+  PcapFile syncFile;
+  syncFile.Open (syncFilename, std::ios::out);
+  WritePackets (syncFile);
+  syncFile.Close ();
+
+  // a single buffer waiting for the writer thread forces the simulation
+  // thread to wait for it
+  AsyncOutputFile::SetMaxPendingBuffers (1);
+  PcapFile asyncFile;
+  asyncFile.OpenForAsyncWrite (asyncFilename);
+  NS_TEST_ASSERT_MSG_EQ (asyncFile.Fail (), false, "OpenForAsyncWrite (" << asyncFilename << ") returns error");
+  WritePackets (asyncFile);
+  NS_TEST_EXPECT_MSG_EQ (asyncFile.Fail (), false, "Write must not fail");
+  asyncFile.Close ();
+  AsyncOutputFile::SetMaxPendingBuffers (16);
+
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (syncFilename, asyncFilename, sec, usec, packets, 400);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "The files differ at packet " << packets);
+  NS_TEST_EXPECT_MSG_EQ (packets, 10000, "Unexpected number of packets");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that a pcapng file is made of the expected
+ * blocks.
+ */
+class PcapNgFileTestCase : public TestCase
+{
+public:
+  PcapNgFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapNgFileTestCase::PcapNgFileTestCase ()
+  : TestCase ("Check the blocks of a pcapng file")
+{
+}
+
+void
+PcapNgFileTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("interfaces.pcapng");
+  PcapNgFile f;
+  f.Open (filename);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ") returns error");
+  uint8_t data[100];
+  std::memset (data, 0xab, sizeof (data));
+  uint32_t csma = f.AddInterface ("csma-0-1", 1, 65535);
+  f.Write (csma, NanoSeconds (5000000123ULL), data, 61);
+  uint32_t ppp = f.AddInterface ("ppp-1-1", 9, 64);
+  f.Write (ppp, Seconds (7), Create<Packet> (data, 100));
+  f.Close ();
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Close returns error");
+
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  std::vector<char> content ((std::istreambuf_iterator<char> (is)), std::istreambuf_iterator<char> ());
+  const uint32_t expectedTypes[5] = { 0x0a0d0d0a, 1, 6, 1, 6 };
+  const uint32_t expectedLengths[5] = { 28, 44, 96, 44, 96 };
+  uint32_t offset = 0;
+  for (uint32_t block = 0; block < 5; ++block)
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (content.size (), offset + 12, "File too short for block " << block);
+      uint32_t word[7];
+      std::memcpy (word, &content[offset], std::min<uint32_t> (28, content.size () - offset));
+      NS_TEST_EXPECT_MSG_EQ (word[0], expectedTypes[block], "Unexpected type of block " << block);
+      NS_TEST_ASSERT_MSG_EQ (word[1], expectedLengths[block], "Unexpected length of block " << block);
+      uint32_t trailer;
+      std::memcpy (&trailer, &content[offset + word[1] - 4], 4);
+      NS_TEST_EXPECT_MSG_EQ (trailer, word[1], "The length of block " << block << " must be repeated at its end");
+      if (word[0] == 6)
+        {
+          NS_TEST_EXPECT_MSG_EQ (word[2], (block == 2 ? csma : ppp), "Unexpected interface");
+          uint64_t ns = (static_cast<uint64_t> (word[3]) << 32) | word[4];
+          NS_TEST_EXPECT_MSG_EQ (ns, (block == 2 ? 5000000123ULL : 7000000000ULL), "Unexpected timestamp");
+          NS_TEST_EXPECT_MSG_EQ (word[5], (block == 2 ? 61 : 64), "Unexpected captured length");
+          NS_TEST_EXPECT_MSG_EQ (word[6], (block == 2 ? 61 : 100), "Unexpected original length");
+          NS_TEST_EXPECT_MSG_EQ (std::memcmp (&content[offset + 28], data, word[5]), 0, "Unexpected packet data");
+        }
+      offset += word[1];
+    }
+  NS_TEST_EXPECT_MSG_EQ (content.size (), offset, "Unexpected data at the end of the file");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1311,8 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new AsyncWriteTestCase, TestCase::QUICK);
+  AddTestCase (new PcapNgFileTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
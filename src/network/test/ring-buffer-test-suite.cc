@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/packet.h"
+#include <list>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that elements are returned in FIFO order while the buffer wraps
+ * around and grows.
+ */
+class RingBufferFifoTestCase : public TestCase
+{
+public:
+  RingBufferFifoTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+RingBufferFifoTestCase::RingBufferFifoTestCase ()
+  : TestCase ("Check FIFO order across wrap-around and growth of the ring buffer")
+{
+}
+
+void
+RingBufferFifoTestCase::DoRun (void)
+{
+  RingBuffer<uint32_t> buffer;
+  NS_TEST_EXPECT_MSG_EQ (buffer.empty (), true, "The buffer should be empty");
+  NS_TEST_EXPECT_MSG_EQ (buffer.capacity (), 0, "No memory should be allocated yet");
+
+  uint32_t in = 0;
+  uint32_t out = 0;
+  // Keep a varying number of elements in the buffer, so that the head
+  // moves across the whole array and the buffer has to grow a few times
+  for (uint32_t round = 1; round <= 100; round++)
+    {
+      for (uint32_t i = 0; i < round; i++)
+        {
+          buffer.push_back (in++);
+        }
+      for (uint32_t i = 0; i < round / 2; i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (buffer.front (), out, "Unexpected element at the head");
+          buffer.pop_front ();
+          out++;
+        }
+      NS_TEST_EXPECT_MSG_EQ (buffer.size (), in - out, "Unexpected number of elements");
+      NS_TEST_EXPECT_MSG_EQ (buffer.back (), in - 1, "Unexpected element at the tail");
+    }
+
+  uint32_t capacity = buffer.capacity ();
+  NS_TEST_EXPECT_MSG_EQ ((capacity & (capacity - 1)), 0, "The capacity should be a power of two");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (capacity, buffer.size (), "The capacity should be at least the size");
+
+  uint32_t expected = out;
+  for (RingBuffer<uint32_t>::ConstIterator it = buffer.cbegin (); it != buffer.cend (); it++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (*it, expected++, "Unexpected element while browsing the buffer");
+    }
+  NS_TEST_EXPECT_MSG_EQ (expected, in, "Not all the elements have been browsed");
+
+  for (uint32_t i = 0; i < buffer.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (buffer[i], out + i, "Unexpected element at position " << i);
+    }
+  buffer[0] = 0;
+  NS_TEST_EXPECT_MSG_EQ (buffer.front (), 0, "The element at the head should have been replaced");
+
+  buffer.clear ();
+  NS_TEST_EXPECT_MSG_EQ (buffer.empty (), true, "The buffer should be empty");
+  NS_TEST_EXPECT_MSG_EQ (buffer.capacity (), capacity, "Clear should not release memory");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check insertions and removals at arbitrary positions against a std::list,
+ * including the browse-and-remove pattern used by Queue subclasses.
+ */
+class RingBufferInsertEraseTestCase : public TestCase
+{
+public:
+  RingBufferInsertEraseTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Check that the ring buffer and the list have the same content
+   * \param buffer the ring buffer
+   * \param list the list
+   */
+  void CheckEqual (const RingBuffer<uint32_t> &buffer, const std::list<uint32_t> &list);
+};
+
+RingBufferInsertEraseTestCase::RingBufferInsertEraseTestCase ()
+  : TestCase ("Check insert and erase at arbitrary positions of the ring buffer")
+{
+}
+
+void
+RingBufferInsertEraseTestCase::CheckEqual (const RingBuffer<uint32_t> &buffer, const std::list<uint32_t> &list)
+{
+  NS_TEST_ASSERT_MSG_EQ (buffer.size (), list.size (), "Unexpected number of elements");
+  std::list<uint32_t>::const_iterator l = list.cbegin ();
+  for (RingBuffer<uint32_t>::ConstIterator it = buffer.cbegin (); it != buffer.cend (); it++, l++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (*it, *l, "Unexpected element");
+    }
+}
+
+void
+RingBufferInsertEraseTestCase::DoRun (void)
+{
+  RingBuffer<uint32_t> buffer;
+  std::list<uint32_t> list;
+
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      buffer.push_back (i);
+      list.push_back (i);
+    }
+
+  // Insert an element before every third element, at the head and at the tail
+  RingBuffer<uint32_t>::ConstIterator bIt = buffer.cbegin ();
+  std::list<uint32_t>::const_iterator lIt = list.cbegin ();
+  for (uint32_t i = 0; bIt != buffer.cend (); i++, bIt++, lIt++)
+    {
+      if (i % 3 == 0)
+        {
+          // bIt must keep referring to the same element after the insertion
+          RingBuffer<uint32_t>::ConstIterator ret = buffer.insert (bIt, 100 + i);
+          NS_TEST_EXPECT_MSG_EQ (*ret, 100 + i, "Insert should return the inserted element");
+          NS_TEST_EXPECT_MSG_EQ (*bIt, *lIt, "Insert invalidated the iterator to pos");
+          list.insert (lIt, 100 + i);
+        }
+    }
+  buffer.insert (buffer.cbegin (), 1000);
+  list.insert (list.cbegin (), 1000);
+  buffer.insert (buffer.cend (), 1001);
+  list.insert (list.cend (), 1001);
+  CheckEqual (buffer, list);
+
+  // Browse the buffer and remove the odd elements through a copy of the
+  // iterator, as WifiMacQueue::TtlExceeded does
+  for (RingBuffer<uint32_t>::ConstIterator it = buffer.cbegin (); it != buffer.cend (); )
+    {
+      if (*it % 2 == 1)
+        {
+          RingBuffer<uint32_t>::ConstIterator curr = it++;
+          buffer.erase (curr);
+        }
+      else
+        {
+          it++;
+        }
+    }
+  for (std::list<uint32_t>::iterator l = list.begin (); l != list.end (); )
+    {
+      l = (*l % 2 == 1 ? list.erase (l) : ++l);
+    }
+  CheckEqual (buffer, list);
+
+  // Remove every element through the iterator returned by erase
+  RingBuffer<uint32_t>::ConstIterator it = buffer.cbegin ();
+  while (it != buffer.cend ())
+    {
+      it = buffer.erase (it);
+    }
+  NS_TEST_EXPECT_MSG_EQ (buffer.empty (), true, "The buffer should be empty");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that the buffer releases the references to the removed objects.
+ */
+class RingBufferReleaseTestCase : public TestCase
+{
+public:
+  RingBufferReleaseTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+RingBufferReleaseTestCase::RingBufferReleaseTestCase ()
+  : TestCase ("Check that the ring buffer releases the removed objects")
+{
+}
+
+void
+RingBufferReleaseTestCase::DoRun (void)
+{
+  RingBuffer<Ptr<Packet> > buffer;
+  Ptr<Packet> p = Create<Packet> (100);
+
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      buffer.push_back (p);
+    }
+  NS_TEST_EXPECT_MSG_EQ (p->GetReferenceCount (), 51, "Unexpected reference count");
+
+  buffer.pop_front ();
+  buffer.pop_back ();
+  buffer.erase (++buffer.cbegin ());
+  NS_TEST_EXPECT_MSG_EQ (p->GetReferenceCount (), 48, "Unexpected reference count");
+
+  buffer.clear ();
+  NS_TEST_EXPECT_MSG_EQ (p->GetReferenceCount (), 1, "Unexpected reference count");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief RingBuffer TestSuite
+ */
+class RingBufferTestSuite : public TestSuite
+{
+public:
+  RingBufferTestSuite ()
+    : TestSuite ("ring-buffer", UNIT)
+  {
+    AddTestCase (new RingBufferFifoTestCase (), TestCase::QUICK);
+    AddTestCase (new RingBufferInsertEraseTestCase (), TestCase::QUICK);
+    AddTestCase (new RingBufferReleaseTestCase (), TestCase::QUICK);
+  }
+};
+
+static RingBufferTestSuite g_ringBufferTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,402 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "async-output-file.h"
+#include "ns3/core-config.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <deque>
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AsyncOutputFile");
+
+/**
+ * \ingroup network
+ *
+ * \brief The thread writing the buffers of all the AsyncOutputFile objects
+ *
+ * The writer object is created when first used, and never destroyed, so
+ * that files closed by static destructors are still written.  The writer
+ * thread is started when a file is opened while no other file is open,
+ * and joined when the last open file is closed.  The files must therefore
+ * be opened and closed by a single thread, the simulation thread.
+ * std::mutex is used rather than SystemMutex since the writer thread must
+ * not log.
+ */
+class AsyncFileWriter
+{
+public:
+  /**
+   * \return the writer
+   */
+  static AsyncFileWriter *Get (void);
+
+  /**
+   * Open a file, starting the writer thread if needed
+   * \param file the file
+   * \param filename the name of the file
+   * \return true if the file could be opened
+   */
+  bool Open (AsyncOutputFile *file, std::string const &filename);
+
+  /**
+   * \param file the file
+   * \return true if the file is open
+   */
+  bool IsOpen (const AsyncOutputFile *file);
+
+  /**
+   * Queue a buffer of a file, waiting if too many buffers are queued
+   * \param file the file
+   * \param data the buffer, swapped with an empty string
+   */
+  void Submit (AsyncOutputFile *file, std::string &data);
+
+  /**
+   * Wait until all the buffers of a file are written and close it,
+   * joining the writer thread if no other file is open
+   * \param file the file
+   * \return true if a write failed
+   */
+  bool Close (AsyncOutputFile *file);
+
+  /**
+   * \param file the file
+   * \return true if a write failed
+   */
+  bool Fail (const AsyncOutputFile *file);
+
+  /**
+   * Set the maximum number of queued buffers
+   * \param maxPending the maximum number of buffers
+   */
+  void SetMaxPending (uint32_t maxPending);
+
+private:
+  AsyncFileWriter ();
+
+  /// A buffer waiting to be written
+  struct Job
+  {
+    AsyncOutputFile *file; //!< The file
+    std::string data;      //!< The buffer
+  };
+
+  /**
+   * Write a buffer to its file
+   * \param file the file
+   * \param data the buffer
+   * \return true if the write succeeded
+   */
+  static bool WriteBuffer (AsyncOutputFile *file, const std::string &data);
+
+  uint32_t m_maxPending;                 //!< The maximum number of queued buffers
+  uint32_t m_nOpen;                      //!< The number of open files
+  std::deque<Job> m_jobs;                //!< The queued buffers
+#ifdef HAVE_PTHREAD_H
+  /// The loop of the writer thread
+  void Run (void);
+
+  std::mutex m_mutex;                    //!< Protects all the members and the files state
+  std::condition_variable m_jobQueued;   //!< Signaled when a buffer is queued or the thread must stop
+  std::condition_variable m_jobDone;     //!< Signaled when a buffer is written
+  std::thread m_thread;                  //!< The writer thread
+  bool m_stop;                           //!< The writer thread must stop once the queue is empty
+#endif /* HAVE_PTHREAD_H */
+};
+
+AsyncFileWriter *
+AsyncFileWriter::Get (void)
+{
+  static AsyncFileWriter *writer = new AsyncFileWriter ();
+  return writer;
+}
+
+AsyncFileWriter::AsyncFileWriter ()
+  : m_maxPending (16),
+    m_nOpen (0)
+#ifdef HAVE_PTHREAD_H
+    ,
+    m_stop (false)
+#endif /* HAVE_PTHREAD_H */
+{
+}
+
+bool
+AsyncFileWriter::WriteBuffer (AsyncOutputFile *file, const std::string &data)
+{
+  file->m_file.write (data.data (), data.size ());
+  file->m_file.flush ();
+  return file->m_file.good ();
+}
+
+#ifdef HAVE_PTHREAD_H
+
+void
+AsyncFileWriter::Run (void)
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      while (m_jobs.empty () && !m_stop)
+        {
+          m_jobQueued.wait (lock);
+        }
+      if (m_jobs.empty ())
+        {
+          return;
+        }
+      // the job stays in the queue while it is written, so that the bound
+      // on the number of queued buffers includes it
+      Job &job = m_jobs.front ();
+      lock.unlock ();
+      bool ok = WriteBuffer (job.file, job.data);
+      lock.lock ();
+      job.file->m_fail |= !ok;
+      job.file->m_pending--;
+      m_jobs.pop_front ();
+      m_jobDone.notify_all ();
+    }
+}
+
+bool
+AsyncFileWriter::Open (AsyncOutputFile *file, std::string const &filename)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  file->m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  file->m_open = file->m_file.is_open ();
+  file->m_fail = !file->m_open;
+  if (file->m_fail)
+    {
+      return false;
+    }
+  if (m_nOpen++ == 0)
+    {
+      m_stop = false;
+      m_thread = std::thread (&AsyncFileWriter::Run, this);
+    }
+  return true;
+}
+
+bool
+AsyncFileWriter::IsOpen (const AsyncOutputFile *file)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  return file->m_open;
+}
+
+void
+AsyncFileWriter::Submit (AsyncOutputFile *file, std::string &data)
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (m_jobs.size () >= m_maxPending)
+    {
+      m_jobDone.wait (lock);
+    }
+  m_jobs.push_back (Job ());
+  m_jobs.back ().file = file;
+  m_jobs.back ().data.swap (data);
+  file->m_pending++;
+  m_jobQueued.notify_one ();
+}
+
+bool
+AsyncFileWriter::Close (AsyncOutputFile *file)
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (file->m_pending > 0)
+    {
+      m_jobDone.wait (lock);
+    }
+  file->m_file.close ();
+  file->m_open = false;
+  if (--m_nOpen > 0)
+    {
+      return file->m_fail;
+    }
+  bool fail = file->m_fail;
+  m_stop = true;
+  m_jobQueued.notify_one ();
+  std::thread thread;
+  thread.swap (m_thread);
+  lock.unlock ();
+  thread.join ();
+  return fail;
+}
+
+bool
+AsyncFileWriter::Fail (const AsyncOutputFile *file)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  return file->m_fail;
+}
+
+void
+AsyncFileWriter::SetMaxPending (uint32_t maxPending)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  m_maxPending = maxPending;
+  // let the threads waiting for room see the new bound
+  m_jobDone.notify_all ();
+}
+
+#else /* HAVE_PTHREAD_H */
+
+bool
+AsyncFileWriter::Open (AsyncOutputFile *file, std::string const &filename)
+{
+  file->m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  file->m_open = file->m_file.is_open ();
+  file->m_fail = !file->m_open;
+  return !file->m_fail;
+}
+
+bool
+AsyncFileWriter::IsOpen (const AsyncOutputFile *file)
+{
+  return file->m_open;
+}
+
+void
+AsyncFileWriter::Submit (AsyncOutputFile *file, std::string &data)
+{
+  file->m_fail |= !WriteBuffer (file, data);
+  data.clear ();
+}
+
+bool
+AsyncFileWriter::Close (AsyncOutputFile *file)
+{
+  file->m_file.close ();
+  file->m_open = false;
+  return file->m_fail;
+}
+
+bool
+AsyncFileWriter::Fail (const AsyncOutputFile *file)
+{
+  return file->m_fail;
+}
+
+void
+AsyncFileWriter::SetMaxPending (uint32_t maxPending)
+{
+  m_maxPending = maxPending;
+}
+
+#endif /* HAVE_PTHREAD_H */
+
+
+AsyncOutputFile::AsyncOutputFile ()
+  : m_bufferSize (0),
+    m_open (false),
+    m_pending (0),
+    m_fail (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AsyncOutputFile::~AsyncOutputFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+AsyncOutputFile::Open (std::string const &filename, uint32_t bufferSize)
+{
+  NS_LOG_FUNCTION (this << filename << bufferSize);
+  NS_ASSERT_MSG (!IsOpen (), "File already open");
+  m_bufferSize = bufferSize;
+  m_buffer.reserve (bufferSize);
+  return AsyncFileWriter::Get ()->Open (this, filename);
+}
+
+bool
+AsyncOutputFile::IsOpen (void) const
+{
+  return AsyncFileWriter::Get ()->IsOpen (this);
+}
+
+bool
+AsyncOutputFile::Fail (void) const
+{
+  return AsyncFileWriter::Get ()->Fail (this);
+}
+
+void
+AsyncOutputFile::Write (const void *data, uint32_t size)
+{
+  m_buffer.append (static_cast<const char *> (data), size);
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+}
+
+uint8_t *
+AsyncOutputFile::Append (uint32_t size)
+{
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+  std::string::size_type offset = m_buffer.size ();
+  m_buffer.resize (offset + size);
+  return reinterpret_cast<uint8_t *> (&m_buffer[offset]);
+}
+
+void
+AsyncOutputFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_buffer.size ());
+  NS_ASSERT_MSG (IsOpen (), "File not open");
+  if (m_buffer.empty ())
+    {
+      return;
+    }
+  AsyncFileWriter::Get ()->Submit (this, m_buffer);
+  m_buffer.reserve (m_bufferSize);
+}
+
+void
+AsyncOutputFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!IsOpen ())
+    {
+      return;
+    }
+  Flush ();
+  AsyncFileWriter::Get ()->Close (this);
+  std::string ().swap (m_buffer);
+}
+
+void
+AsyncOutputFile::SetMaxPendingBuffers (uint32_t maxPendingBuffers)
+{
+  NS_LOG_FUNCTION (maxPendingBuffers);
+  NS_ASSERT (maxPendingBuffers > 0);
+  AsyncFileWriter::Get ()->SetMaxPending (maxPendingBuffers);
+}
+
+} // namespace ns3
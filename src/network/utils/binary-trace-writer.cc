@@ -0,0 +1,388 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/chunk.h"
+#include "binary-trace-writer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceWriter");
+
+namespace {
+
+/// The magic string at the start of a binary trace
+const char MAGIC[8] = { 'N', 'S', '3', 'T', 'R', 'A', 'C', '1' };
+
+/// The types of the records of a binary trace
+enum RecordType
+{
+  CONTEXT_RECORD = 'C', //!< id, node, device, length, context
+  TYPEID_RECORD = 'T',  //!< uid, length, name
+  EVENT_RECORD = 'E'    //!< event, items, context, time, uid, size, node, device
+};
+
+/// The size of an event record, without its items
+const uint32_t EVENT_RECORD_SIZE = 36;
+
+/// The node or device identifier of an event without known node or device
+const uint32_t NO_ID = 0xffffffff;
+
+/**
+ * Append a value to a record
+ * \param record the record
+ * \param value the value
+ */
+template <typename T>
+inline void
+Append (std::string &record, T value)
+{
+  record.append (reinterpret_cast<const char *> (&value), sizeof (value));
+}
+
+/**
+ * Read a value from a binary trace
+ * \param is the binary trace
+ * \param value [out] the value
+ * \return true if the value could be read
+ */
+template <typename T>
+inline bool
+Read (std::istream &is, T *value)
+{
+  is.read (reinterpret_cast<char *> (value), sizeof (*value));
+  return is.good ();
+}
+
+/**
+ * Read a string from a binary trace
+ * \param is the binary trace
+ * \param value [out] the string
+ * \return true if the string could be read
+ */
+bool
+ReadString (std::istream &is, std::string *value)
+{
+  uint32_t length;
+  if (!Read (is, &length))
+    {
+      return false;
+    }
+  value->resize (length);
+  if (length > 0)
+    {
+      is.read (&(*value)[0], length);
+    }
+  return is.good ();
+}
+
+/**
+ * Parse an unsigned integer followed by a slash or the end of a string
+ * \param context the string
+ * \param pos [in,out] the position of the integer, then of its end
+ * \param value [out] the integer
+ * \return true if an integer was found
+ */
+bool
+ParseId (std::string const &context, std::string::size_type *pos, uint32_t *value)
+{
+  std::string::size_type end = context.find ('/', *pos);
+  if (end == std::string::npos)
+    {
+      end = context.size ();
+    }
+  if (end == *pos || context.find_first_not_of ("0123456789", *pos) < end)
+    {
+      return false;
+    }
+  *value = std::strtoul (context.c_str () + *pos, 0, 10);
+  *pos = end;
+  return true;
+}
+
+} // unnamed namespace
+
+BinaryTraceWriter::BinaryTraceWriter (std::ostream *os, bool headerDigest)
+  : m_os (os),
+    m_headerDigest (headerDigest),
+    m_node (NO_ID),
+    m_device (NO_ID)
+{
+  NS_LOG_FUNCTION (this << os << headerDigest);
+  m_os->write (MAGIC, sizeof (MAGIC));
+}
+
+void
+BinaryTraceWriter::SetDevice (uint32_t node, uint32_t device)
+{
+  NS_LOG_FUNCTION (this << node << device);
+  m_node = node;
+  m_device = device;
+}
+
+void
+BinaryTraceWriter::Write (Event event, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << event << p);
+  m_record.clear ();
+  WriteEvent (event, 0, p);
+}
+
+void
+BinaryTraceWriter::Write (Event event, std::string const &context, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << event << context << p);
+  m_record.clear ();
+  std::unordered_map<std::string, Context>::iterator it = m_contexts.find (context);
+  if (it == m_contexts.end ())
+    {
+      Context info;
+      info.id = m_contexts.size () + 1;
+      info.node = NO_ID;
+      info.device = NO_ID;
+      std::string::size_type pos = 0;
+      if (context.compare (0, 10, "/NodeList/") == 0)
+        {
+          pos = 10;
+          if (ParseId (context, &pos, &info.node)
+              && context.compare (pos, 12, "/DeviceList/") == 0)
+            {
+              pos += 12;
+              ParseId (context, &pos, &info.device);
+            }
+        }
+      it = m_contexts.insert (std::make_pair (context, info)).first;
+
+      Append<uint8_t> (m_record, CONTEXT_RECORD);
+      Append (m_record, info.id);
+      Append (m_record, info.node);
+      Append (m_record, info.device);
+      Append<uint32_t> (m_record, context.size ());
+      m_record.append (context);
+    }
+  WriteEvent (event, &it->second, p);
+}
+
+void
+BinaryTraceWriter::WriteTypeId (TypeId tid)
+{
+  uint16_t uid = tid.GetUid ();
+  if (uid < m_typeIds.size () && m_typeIds[uid])
+    {
+      return;
+    }
+  if (uid >= m_typeIds.size ())
+    {
+      m_typeIds.resize (uid + 1, false);
+    }
+  m_typeIds[uid] = true;
+  std::string name = tid.GetName ();
+  Append<uint8_t> (m_record, TYPEID_RECORD);
+  Append (m_record, uid);
+  Append<uint32_t> (m_record, name.size ());
+  m_record.append (name);
+}
+
+void
+BinaryTraceWriter::WriteEvent (Event event, const Context *context, Ptr<const Packet> p)
+{
+  // The TypeId records have to be written before the event, so the items
+  // are collected in a separate string
+  std::string items;
+  uint16_t nItems = 0;
+  if (m_headerDigest)
+    {
+      PacketMetadata::ItemIterator i = p->BeginItem ();
+      while (i.HasNext ())
+        {
+          PacketMetadata::Item item = i.Next ();
+          uint16_t tid = 0;
+          if (item.type != PacketMetadata::Item::PAYLOAD)
+            {
+              WriteTypeId (item.tid);
+              tid = item.tid.GetUid ();
+            }
+          Append<uint8_t> (items, item.type);
+          Append<uint8_t> (items, item.isFragment);
+          Append (items, tid);
+          Append (items, item.currentSize);
+          Append (items, item.currentTrimedFromStart);
+          if (item.type != PacketMetadata::Item::PAYLOAD && !item.isFragment)
+            {
+              Buffer::Iterator start = item.current;
+              if (item.type == PacketMetadata::Item::TRAILER)
+                {
+                  start.Prev (item.currentSize);
+                }
+              std::string::size_type offset = items.size ();
+              items.resize (offset + item.currentSize);
+              start.Read (reinterpret_cast<uint8_t *> (&items[offset]), item.currentSize);
+            }
+          nItems++;
+        }
+    }
+
+  Append<uint8_t> (m_record, EVENT_RECORD);
+  Append<uint8_t> (m_record, event);
+  Append (m_record, nItems);
+  Append<uint32_t> (m_record, context == 0 ? 0 : context->id);
+  Append<int64_t> (m_record, Simulator::Now ().GetNanoSeconds ());
+  Append<uint64_t> (m_record, p->GetUid ());
+  Append<uint32_t> (m_record, p->GetSize ());
+  Append<uint32_t> (m_record, context == 0 ? m_node : context->node);
+  Append<uint32_t> (m_record, context == 0 ? m_device : context->device);
+  m_record.append (items);
+  m_os->write (m_record.data (), m_record.size ());
+}
+
+bool
+BinaryTraceWriter::PrintAscii (std::istream &is, std::ostream &os)
+{
+  NS_LOG_FUNCTION (&is << &os);
+  char magic[sizeof (MAGIC)];
+  is.read (magic, sizeof (magic));
+  if (!is.good () || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0)
+    {
+      return false;
+    }
+
+  std::map<uint32_t, std::string> contexts;
+  std::map<uint16_t, std::string> typeNames;
+  std::vector<uint8_t> data;
+  uint8_t recordType;
+  while (Read (is, &recordType))
+    {
+      if (recordType == CONTEXT_RECORD)
+        {
+          uint32_t id;
+          uint32_t node;
+          uint32_t device;
+          std::string context;
+          if (!Read (is, &id) || !Read (is, &node) || !Read (is, &device) || !ReadString (is, &context))
+            {
+              return false;
+            }
+          contexts[id] = context;
+          continue;
+        }
+      if (recordType == TYPEID_RECORD)
+        {
+          uint16_t uid;
+          std::string name;
+          if (!Read (is, &uid) || !ReadString (is, &name))
+            {
+              return false;
+            }
+          typeNames[uid] = name;
+          continue;
+        }
+      if (recordType != EVENT_RECORD)
+        {
+          return false;
+        }
+
+      char header[EVENT_RECORD_SIZE - 1];
+      is.read (header, sizeof (header));
+      if (!is.good ())
+        {
+          return false;
+        }
+      uint8_t event;
+      uint16_t nItems;
+      uint32_t context;
+      int64_t time;
+      std::memcpy (&event, header, 1);
+      std::memcpy (&nItems, header + 1, 2);
+      std::memcpy (&context, header + 3, 4);
+      std::memcpy (&time, header + 7, 8);
+
+      os << event << " " << NanoSeconds (time).GetSeconds () << " ";
+      if (context != 0)
+        {
+          os << contexts[context] << " ";
+        }
+      // print the items as Packet::Print does
+      for (uint16_t i = 0; i < nItems; i++)
+        {
+          uint8_t type;
+          uint8_t isFragment;
+          uint16_t tid;
+          uint32_t size;
+          uint32_t trimmedFromStart;
+          if (!Read (is, &type) || !Read (is, &isFragment) || !Read (is, &tid)
+              || !Read (is, &size) || !Read (is, &trimmedFromStart))
+            {
+              return false;
+            }
+          if (isFragment)
+            {
+              if (type == PacketMetadata::Item::PAYLOAD)
+                {
+                  os << "Payload";
+                }
+              else
+                {
+                  os << typeNames[tid];
+                }
+              os << " Fragment [" << trimmedFromStart << ":" << (trimmedFromStart + size) << "]";
+            }
+          else if (type == PacketMetadata::Item::PAYLOAD)
+            {
+              os << "Payload (size=" << size << ")";
+            }
+          else
+            {
+              data.resize (size);
+              if (size > 0)
+                {
+                  is.read (reinterpret_cast<char *> (&data[0]), size);
+                }
+              if (!is.good ())
+                {
+                  return false;
+                }
+              os << typeNames[tid] << " (";
+              TypeId typeId;
+              if (TypeId::LookupByNameFailSafe (typeNames[tid], &typeId) && typeId.HasConstructor ())
+                {
+                  Buffer buffer;
+                  buffer.AddAtStart (size);
+                  buffer.Begin ().Write (data.data (), size);
+                  Callback<ObjectBase *> constructor = typeId.GetConstructor ();
+                  Chunk *chunk = dynamic_cast<Chunk *> (constructor ());
+                  NS_ASSERT (chunk != 0);
+                  chunk->Deserialize (buffer.Begin (), buffer.End ());
+                  chunk->Print (os);
+                  delete chunk;
+                }
+              os << ")";
+            }
+          if (i + 1 < nItems)
+            {
+              os << " ";
+            }
+        }
+      os << std::endl;
+    }
+  return is.eof ();
+}
+
+} // namespace ns3
@@ -63,6 +63,7 @@
 #include <cmath>
 
 #include "error-model.h"
+#include "segmentation-offload-tag.h"
 
 #include "ns3/packet.h"
 #include "ns3/assert.h"
@@ -114,6 +115,46 @@ ErrorModel::IsCorrupt (Ptr<Packet> p)
   return result;
 }
 
+bool
+ErrorModel::IsCorruptSegmented (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  SegmentationOffloadTag tag;
+  if (!p->PeekPacketTag (tag) || tag.GetSegmentCount () < 2)
+    {
+      return IsCorrupt (p);
+    }
+
+  // Evaluate the model on a copy of the super-segment for each segment,
+  // trimmed to the size the segment would have if the super-segment were
+  // split, so that the models relying on the packet UID, on the headers or
+  // on the size see the segment as they would see the real one
+  uint32_t overhead = p->GetSize () - tag.GetPayloadSize ();
+  bool modified = false;
+  for (uint32_t i = 0; i < tag.GetSegmentCount (); ++i)
+    {
+      if (tag.IsLost (i))
+        {
+          continue;
+        }
+      Ptr<Packet> segment = p->Copy ();
+      SegmentationOffloadTag segmentTag;
+      segment->RemovePacketTag (segmentTag);
+      segment->RemoveAtEnd (p->GetSize () - overhead - tag.GetSegmentPayloadSize (i));
+      if (DoCorrupt (segment))
+        {
+          NS_LOG_LOGIC ("Segment " << i << " of " << tag.GetSegmentCount () << " is corrupted");
+          tag.SetLost (i);
+          modified = true;
+        }
+    }
+  if (modified)
+    {
+      p->ReplacePacketTag (tag);
+    }
+  return tag.IsAllLost ();
+}
+
 void
 ErrorModel::Reset (void)
 {
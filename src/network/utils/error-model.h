@@ -132,6 +132,19 @@ public:
    * \param pkt Packet to apply error model to
    */
   bool IsCorrupt (Ptr<Packet> pkt);
+  /**
+   * Same as IsCorrupt, but the packets carrying a SegmentationOffloadTag
+   * are evaluated as the train of segments they stand for: the model is
+   * applied once per segment, and the corrupted segments are marked as
+   * lost in the tag.  Each segment is evaluated as a copy of the packet
+   * trimmed to the size of the segment, so it has the UID and the headers
+   * of the packet; the header fields that differ between the segments
+   * (e.g., the TCP sequence number) are those of the first segment.
+   *
+   * \returns true if the whole Packet is to be considered as errored/corrupted
+   * \param pkt Packet to apply error model to
+   */
+  bool IsCorruptSegmented (Ptr<Packet> pkt);
   /**
    * Reset any state associated with the error model
    */
@@ -17,6 +17,7 @@
  */
 
 #include "output-stream-wrapper.h"
+#include "binary-trace-writer.h"
 #include "ns3/log.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/abort.h"
@@ -27,7 +28,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("OutputStreamWrapper");
 
 OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmode filemode)
-  : m_destroyable (true)
+  : m_destroyable (true),
+    m_binaryTraceWriter (0)
 {
   NS_LOG_FUNCTION (this << filename << filemode);
   std::ofstream* os = new std::ofstream ();
@@ -39,7 +41,7 @@ OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmo
 }
 
 OutputStreamWrapper::OutputStreamWrapper (std::ostream* os)
-  : m_ostream (os), m_destroyable (false)
+  : m_ostream (os), m_destroyable (false), m_binaryTraceWriter (0)
 {
   NS_LOG_FUNCTION (this << os);
   FatalImpl::RegisterStream (m_ostream);
@@ -50,6 +52,7 @@ OutputStreamWrapper::~OutputStreamWrapper ()
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::UnregisterStream (m_ostream);
+  delete m_binaryTraceWriter;
   if (m_destroyable) delete m_ostream;
   m_ostream = 0;
 }
@@ -61,4 +64,18 @@ OutputStreamWrapper::GetStream (void)
   return m_ostream;
 }
 
+void
+OutputStreamWrapper::EnableBinaryTrace (bool headerDigest)
+{
+  NS_LOG_FUNCTION (this << headerDigest);
+  NS_ABORT_MSG_IF (m_binaryTraceWriter != 0, "Binary trace already enabled");
+  m_binaryTraceWriter = new BinaryTraceWriter (m_ostream, headerDigest);
+}
+
+BinaryTraceWriter *
+OutputStreamWrapper::GetBinaryTraceWriter (void)
+{
+  return m_binaryTraceWriter;
+}
+
 } // namespace ns3
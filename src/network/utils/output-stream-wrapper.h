@@ -26,6 +26,8 @@
 
 namespace ns3 {
 
+class BinaryTraceWriter;
+
 /**
  * @brief A class encapsulating an output stream.
  *
@@ -92,9 +94,25 @@ public:
    */
   std::ostream *GetStream (void);
 
+  /**
+   * Have the default trace sinks of AsciiTraceHelper write binary records
+   * to the stream rather than text (see BinaryTraceWriter).  The stream
+   * must have been opened in binary mode.
+   *
+   * \param headerDigest whether to write the headers of the packets
+   */
+  void EnableBinaryTrace (bool headerDigest = true);
+
+  /**
+   * \returns the writer of binary trace records, or 0 if the stream is
+   * a text stream
+   */
+  BinaryTraceWriter *GetBinaryTraceWriter (void);
+
 private:
   std::ostream *m_ostream; //!< The output stream
   bool m_destroyable; //!< Can be destroyed
+  BinaryTraceWriter *m_binaryTraceWriter; //!< The binary trace writer, if any
 };
 
 } // namespace ns3
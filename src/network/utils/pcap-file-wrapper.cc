@@ -46,12 +46,20 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("AsyncWrite",
+                   "Whether the packets of a file opened for writing are serialized into large "
+                   "buffers written to the file by a background thread, rather than written "
+                   "to the file by the simulation thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_asyncWrite),
+                   MakeBooleanChecker())
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_ngInterface (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,6 +74,10 @@ bool
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->Fail ();
+    }
   return m_file.Fail ();
 }
 
@@ -86,6 +98,7 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  m_ngFile = 0;
   m_file.Close ();
 }
 
@@ -93,7 +106,22 @@ void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
-  m_file.Open (filename, mode);
+  if (m_asyncWrite && (mode & std::ios::out) && !(mode & (std::ios::in | std::ios::app)))
+    {
+      m_file.OpenForAsyncWrite (filename);
+    }
+  else
+    {
+      m_file.Open (filename, mode);
+    }
+}
+
+void
+PcapFileWrapper::Open (Ptr<PcapNgFile> file, std::string const &interfaceName)
+{
+  NS_LOG_FUNCTION (this << file << interfaceName);
+  m_ngFile = file;
+  m_ngInterfaceName = interfaceName;
 }
 
 void
@@ -105,6 +133,15 @@ PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrec
   // a snaplen, we use the one provided.
   //
   NS_LOG_FUNCTION (this << dataLinkType << snapLen << tzCorrection);
+  if (m_ngFile)
+    {
+      if (snapLen == std::numeric_limits<uint32_t>::max ())
+        {
+          snapLen = m_snapLen;
+        }
+      m_ngInterface = m_ngFile->AddInterface (m_ngInterfaceName, dataLinkType, snapLen);
+      return;
+    }
   if (snapLen != std::numeric_limits<uint32_t>::max ())
     {
       m_file.Init (dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
@@ -119,6 +156,11 @@ void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t, p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -139,6 +181,11 @@ void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t, header, p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -159,6 +206,11 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t, buffer, length);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 namespace ns3 {
 
@@ -77,6 +78,19 @@ public:
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * Write the packets to an interface of a pcapng file shared with other
+   * wrappers, rather than to a pcap file.  The interface is added to the
+   * pcapng file by Init.
+   *
+   * Only the Fail, Init, Write and Close methods can be used on a wrapper
+   * opened this way.
+   *
+   * \param file the pcapng file
+   * \param interfaceName the name of the interface in the pcapng file
+   */
+  void Open (Ptr<PcapNgFile> file, std::string const &interfaceName);
+
   /**
    * Close the underlying pcap file.
    */
@@ -224,6 +238,10 @@ private:
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+  bool     m_asyncWrite; //!< Write the pcap file from a background thread
+  Ptr<PcapNgFile> m_ngFile; //!< The pcapng file, if the packets are written to a pcapng file
+  std::string m_ngInterfaceName; //!< The name of the interface in the pcapng file
+  uint32_t m_ngInterface; //!< The identifier of the interface in the pcapng file
 };
 
 } // namespace ns3
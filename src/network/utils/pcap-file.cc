@@ -68,6 +68,10 @@ bool
 PcapFile::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_asyncFile.IsOpen ())
+    {
+      return m_asyncFile.Fail ();
+    }
   return m_file.fail ();
 }
 bool 
@@ -88,6 +92,7 @@ void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  m_asyncFile.Close ();
   m_file.close ();
 }
 
@@ -206,8 +211,11 @@ PcapFile::WriteFileHeader (void)
   // If we're initializing the file, we need to write the pcap file header
   // at the start of the file.
   //
-  m_file.seekp (0, std::ios::beg);
- 
+  if (!m_asyncFile.IsOpen ())
+    {
+      m_file.seekp (0, std::ios::beg);
+    }
+
   //
   // We have the ability to write out the pcap file header in a foreign endian
   // format, so we need a temp place to swap on the way out.
@@ -234,13 +242,13 @@ PcapFile::WriteFileHeader (void)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
-  m_file.write ((const char *)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-  m_file.write ((const char *)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-  m_file.write ((const char *)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-  m_file.write ((const char *)&headerOut->m_zone, sizeof(headerOut->m_zone));
-  m_file.write ((const char *)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-  m_file.write ((const char *)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-  m_file.write ((const char *)&headerOut->m_type, sizeof(headerOut->m_type));
+  WriteOut (&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
+  WriteOut (&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
+  WriteOut (&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
+  WriteOut (&headerOut->m_zone, sizeof(headerOut->m_zone));
+  WriteOut (&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
+  WriteOut (&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
+  WriteOut (&headerOut->m_type, sizeof(headerOut->m_type));
 }
 
 void
@@ -341,6 +349,18 @@ PcapFile::Open (std::string const &filename, std::ios::openmode mode)
     }
 }
 
+void
+PcapFile::OpenForAsyncWrite (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  NS_ASSERT (!m_file.fail ());
+  m_filename = filename;
+  if (!m_asyncFile.Open (filename))
+    {
+      m_file.setstate (std::ios::failbit);
+    }
+}
+
 void
 PcapFile::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t timeZoneCorrection, bool swapMode, bool nanosecMode)
 {
@@ -403,7 +423,7 @@ uint32_t
 PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen);
-  NS_ASSERT (m_file.good ());
+  NS_ASSERT (m_asyncFile.IsOpen () || m_file.good ());
 
   uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -422,19 +442,36 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
-  m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
-  m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
-  m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
-  m_file.write ((const char *)&header.m_origLen, sizeof(header.m_origLen));
-  NS_BUILD_DEBUG(m_file.flush());
+  WriteOut (&header.m_tsSec, sizeof(header.m_tsSec));
+  WriteOut (&header.m_tsUsec, sizeof(header.m_tsUsec));
+  WriteOut (&header.m_inclLen, sizeof(header.m_inclLen));
+  WriteOut (&header.m_origLen, sizeof(header.m_origLen));
   return inclLen;
 }
 
+void
+PcapFile::WriteOut (const void *data, uint32_t size)
+{
+  if (m_asyncFile.IsOpen ())
+    {
+      m_asyncFile.Write (data, size);
+    }
+  else
+    {
+      m_file.write (static_cast<const char *> (data), size);
+    }
+}
+
 void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
+  if (m_asyncFile.IsOpen ())
+    {
+      m_asyncFile.Write (data, inclLen);
+      return;
+    }
   m_file.write ((const char *)data, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -444,6 +481,11 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
+  if (m_asyncFile.IsOpen ())
+    {
+      p->CopyData (m_asyncFile.Append (inclLen), inclLen);
+      return;
+    }
   p->CopyData (&m_file, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -460,8 +502,14 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<cons
   headerBuffer.AddAtStart (headerSize);
   header.Serialize (headerBuffer.Begin ());
   uint32_t toCopy = std::min (headerSize, inclLen);
-  headerBuffer.CopyData (&m_file, toCopy);
   inclLen -= toCopy;
+  if (m_asyncFile.IsOpen ())
+    {
+      headerBuffer.CopyData (m_asyncFile.Append (toCopy), toCopy);
+      p->CopyData (m_asyncFile.Append (inclLen), inclLen);
+      return;
+    }
+  headerBuffer.CopyData (&m_file, toCopy);
   p->CopyData (&m_file, inclLen);
 }
 
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <stdint.h>
 #include "ns3/ptr.h"
+#include "async-output-file.h"
 
 namespace ns3 {
 
@@ -80,6 +81,18 @@ public:
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * Create a new pcap file, written by a background thread.
+   *
+   * The packets are serialized into large buffers, which are written to the
+   * file by a thread shared by all the files opened this way (see
+   * AsyncOutputFile).  The file can only be written, and the data is
+   * written to the disk at the latest when the file is closed.
+   *
+   * \param filename String containing the name of the file.
+   */
+  void OpenForAsyncWrite (std::string const &filename);
+
   /**
    * Close the underlying file.
    */
@@ -361,6 +374,13 @@ private:
    */
   uint32_t WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
 
+  /**
+   * \brief Write data to the file, or to the asynchronous file if open
+   * \param data the data
+   * \param size the size of the data
+   */
+  void WriteOut (const void *data, uint32_t size);
+
   /**
    * \brief Read and verify a Pcap file header
    */
@@ -368,6 +388,7 @@ private:
 
   std::string    m_filename;    //!< file name
   std::fstream   m_file;        //!< file stream
+  AsyncOutputFile m_asyncFile;  //!< file written by a background thread
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
   bool m_nanosecMode;           //!< nanosecond timestamp mode
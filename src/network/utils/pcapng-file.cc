@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/header.h"
+#include "ns3/buffer.h"
+#include "pcapng-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapNgFile");
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;  /**< Section Header Block type */
+const uint32_t INTERFACE_BLOCK = 0x00000001;       /**< Interface Description Block type */
+const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006; /**< Enhanced Packet Block type */
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;      /**< Byte order magic number */
+
+const uint16_t OPT_ENDOFOPT = 0;                   /**< End of the options of a block */
+const uint16_t IF_NAME = 2;                        /**< Interface name option */
+const uint16_t IF_TSRESOL = 9;                     /**< Interface timestamp resolution option */
+
+/**
+ * \param length a length
+ * \return the length rounded up to a multiple of 4
+ */
+static inline uint32_t
+Pad32 (uint32_t length)
+{
+  return (length + 3) & ~3U;
+}
+
+PcapNgFile::PcapNgFile ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapNgFile::~PcapNgFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+PcapNgFile::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  if (!m_file.Open (filename))
+    {
+      return;
+    }
+
+  // block type, block length, byte order magic, version 1.0, unknown
+  // section length, block length
+  uint32_t header[3] = { SECTION_HEADER_BLOCK, 28, BYTE_ORDER_MAGIC };
+  uint16_t version[2] = { 1, 0 };
+  uint32_t trailer[3] = { 0xffffffff, 0xffffffff, 28 };
+  m_file.Write (header, sizeof (header));
+  m_file.Write (version, sizeof (version));
+  m_file.Write (trailer, sizeof (trailer));
+}
+
+bool
+PcapNgFile::Fail (void) const
+{
+  return m_file.Fail ();
+}
+
+void
+PcapNgFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Close ();
+}
+
+void
+PcapNgFile::WriteOption (uint16_t code, const void *value, uint16_t length)
+{
+  uint16_t option[2] = { code, length };
+  m_file.Write (option, sizeof (option));
+  if (length > 0)
+    {
+      uint8_t *room = m_file.Append (Pad32 (length));
+      std::memcpy (room, value, length);
+      std::memset (room + length, 0, Pad32 (length) - length);
+    }
+}
+
+uint32_t
+PcapNgFile::AddInterface (std::string const &name, uint32_t dataLinkType, uint32_t snapLen)
+{
+  NS_LOG_FUNCTION (this << name << dataLinkType << snapLen);
+  NS_ASSERT_MSG (name.size () < 0xffff, "Interface name too long");
+
+  // header, name and resolution options, end of options, trailer
+  uint32_t blockLength = 16 + 4 + Pad32 (name.size ()) + 4 + 4 + 4 + 4;
+  uint32_t header[2] = { INTERFACE_BLOCK, blockLength };
+  uint16_t linkType[2] = { static_cast<uint16_t> (dataLinkType), 0 };
+  m_file.Write (header, sizeof (header));
+  m_file.Write (linkType, sizeof (linkType));
+  m_file.Write (&snapLen, sizeof (snapLen));
+
+  WriteOption (IF_NAME, name.data (), name.size ());
+  uint8_t nanoseconds = 9;
+  WriteOption (IF_TSRESOL, &nanoseconds, 1);
+  WriteOption (OPT_ENDOFOPT, 0, 0);
+  m_file.Write (&blockLength, sizeof (blockLength));
+
+  m_snapLens.push_back (snapLen);
+  return m_snapLens.size () - 1;
+}
+
+uint8_t *
+PcapNgFile::StartPacketBlock (uint32_t interface, Time t, uint32_t totalLen, uint32_t *inclLen)
+{
+  NS_ASSERT_MSG (interface < m_snapLens.size (), "Unknown interface " << interface);
+  *inclLen = std::min (totalLen, m_snapLens[interface]);
+  uint32_t padded = Pad32 (*inclLen);
+  uint32_t blockLength = 28 + padded + 4;
+  uint64_t ns = t.GetNanoSeconds ();
+
+  // the header, data and trailer of the block are written in place
+  uint8_t *block = m_file.Append (blockLength);
+  uint32_t header[7] = { ENHANCED_PACKET_BLOCK, blockLength, interface,
+                         static_cast<uint32_t> (ns >> 32), static_cast<uint32_t> (ns),
+                         *inclLen, totalLen };
+  std::memcpy (block, header, sizeof (header));
+  std::memset (block + 28 + *inclLen, 0, padded - *inclLen);
+  std::memcpy (block + 28 + padded, &blockLength, sizeof (blockLength));
+  return block + 28;
+}
+
+void
+PcapNgFile::Write (uint32_t interface, Time t, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << t << p);
+  uint32_t inclLen;
+  uint8_t *data = StartPacketBlock (interface, t, p->GetSize (), &inclLen);
+  p->CopyData (data, inclLen);
+}
+
+void
+PcapNgFile::Write (uint32_t interface, Time t, const Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << t << &header << p);
+  uint32_t headerSize = header.GetSerializedSize ();
+  uint32_t inclLen;
+  uint8_t *data = StartPacketBlock (interface, t, headerSize + p->GetSize (), &inclLen);
+
+  Buffer headerBuffer;
+  headerBuffer.AddAtStart (headerSize);
+  header.Serialize (headerBuffer.Begin ());
+  uint32_t toCopy = std::min (headerSize, inclLen);
+  headerBuffer.CopyData (data, toCopy);
+  p->CopyData (data + toCopy, inclLen - toCopy);
+}
+
+void
+PcapNgFile::Write (uint32_t interface, Time t, uint8_t const *buffer, uint32_t length)
+{
+  NS_LOG_FUNCTION (this << interface << t << &buffer << length);
+  uint32_t inclLen;
+  uint8_t *data = StartPacketBlock (interface, t, length, &inclLen);
+  std::memcpy (data, buffer, inclLen);
+}
+
+} // namespace ns3
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "async-output-file.h"
+
+namespace ns3 {
+
+class Packet;
+class Header;
+
+/**
+ * \ingroup network
+ *
+ * \brief A pcapng file, holding the packets of several interfaces
+ *
+ * The file is made of a single section.  Each interface is described by
+ * an Interface Description Block, holding its data link type, its snap
+ * length and its name, and each packet is written in an Enhanced Packet
+ * Block, with a nanosecond timestamp.  The blocks are written in the byte
+ * order of the host, as allowed by the format.
+ *
+ * The file is written by a background thread (see AsyncOutputFile).  It
+ * can not be read by this class; it can be opened by Wireshark and the
+ * other tools based on libpcap 1.1 or later.
+ *
+ * See http://www.tcpdump.org/pcap/pcap.html
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+public:
+  PcapNgFile ();
+  ~PcapNgFile ();
+
+  /**
+   * Create a new pcapng file, and write its section header.
+   *
+   * \param filename the name of the file
+   */
+  void Open (std::string const &filename);
+
+  /**
+   * \return true if the file could not be opened or written
+   */
+  bool Fail (void) const;
+
+  /**
+   * Write all the data and close the file.
+   */
+  void Close (void);
+
+  /**
+   * Describe a new interface.
+   *
+   * \param name the name of the interface
+   * \param dataLinkType the data link type of the packets of the interface
+   * \param snapLen the maximum number of bytes saved per packet
+   * \return the identifier of the interface
+   */
+  uint32_t AddInterface (std::string const &name, uint32_t dataLinkType, uint32_t snapLen);
+
+  /**
+   * \brief Write a packet received or sent on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param t the packet timestamp
+   * \param p the packet
+   */
+  void Write (uint32_t interface, Time t, Ptr<const Packet> p);
+
+  /**
+   * \brief Write a packet received or sent on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param t the packet timestamp
+   * \param header the header to prepend to the packet
+   * \param p the packet
+   */
+  void Write (uint32_t interface, Time t, const Header &header, Ptr<const Packet> p);
+
+  /**
+   * \brief Write a packet received or sent on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param t the packet timestamp
+   * \param buffer the packet data
+   * \param length the size of the packet data
+   */
+  void Write (uint32_t interface, Time t, uint8_t const *buffer, uint32_t length);
+
+private:
+  /**
+   * \brief Start an Enhanced Packet Block
+   *
+   * \param interface the identifier of the interface
+   * \param t the packet timestamp
+   * \param totalLen the size of the packet
+   * \param inclLen [out] the number of bytes of the packet to save
+   * \return a pointer to the room of the packet data in the block
+   */
+  uint8_t *StartPacketBlock (uint32_t interface, Time t, uint32_t totalLen, uint32_t *inclLen);
+
+  /**
+   * \brief Write an option of a block
+   *
+   * \param code the code of the option
+   * \param value the value of the option
+   * \param length the size of the value
+   */
+  void WriteOption (uint16_t code, const void *value, uint16_t length);
+
+  AsyncOutputFile m_file;           //!< The file
+  std::vector<uint32_t> m_snapLens; //!< The snap length of each interface
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -29,6 +29,7 @@
 #include "ns3/traced-value.h"
 #include "ns3/unused.h"
 #include "ns3/log.h"
+#include "ns3/ring-buffer.h"
 #include <string>
 #include <sstream>
 #include <list>
@@ -251,6 +252,35 @@ private:
 };
 
 
+/**
+ * \ingroup queue
+ * \brief Storage policy of the Queue template class
+ *
+ * Defines the container used by Queue<Item> to store the items. The container
+ * must provide the cbegin, cend, insert and erase methods of std::list. By
+ * default, items are stored in a RingBuffer, which does not allocate memory
+ * when items are enqueued and dequeued. Queues requiring the iterators to all
+ * the other items to remain valid after an item is removed from the middle of
+ * the queue can store their items in a std::list by specializing this template:
+ *
+ * \code
+ *   template <>
+ *   struct QueueStorage<MyItem>
+ *   {
+ *     typedef std::list<Ptr<MyItem> > Container;
+ *   };
+ * \endcode
+ *
+ * The specialization must be visible wherever Queue<MyItem> is instantiated.
+ */
+template <typename Item>
+struct QueueStorage
+{
+  /// Container storing the items
+  typedef RingBuffer<Ptr<Item> > Container;
+};
+
+
 /**
  * \ingroup queue
  * \brief Template class for packet Queues
@@ -273,6 +303,9 @@ private:
  * \endcode
  *
  * Then, include queue.h in the corresponding .cc file.
+ *
+ * The items are stored in the container defined by QueueStorage<Item>, which
+ * is a RingBuffer by default.
  */
 template <typename Item>
 class Queue : public QueueBase
@@ -322,8 +355,10 @@ public:
 
 protected:
 
+  /// Container storing the items.
+  typedef typename QueueStorage<Item>::Container Container;
   /// Const iterator.
-  typedef typename std::list<Ptr<Item> >::const_iterator ConstIterator;
+  typedef typename Container::const_iterator ConstIterator;
 
   /**
    * \brief Get a const iterator which refers to the first item in the queue.
@@ -407,7 +442,7 @@ protected:
   void DropAfterDequeue (Ptr<Item> item);
 
 private:
-  std::list<Ptr<Item> > m_packets;          //!< the items in the queue
+  Container m_packets;                      //!< the items in the queue
   NS_LOG_TEMPLATE_DECLARE;                  //!< the log component
 
   /// Traced callback: fired when a packet is enqueued
@@ -0,0 +1,595 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <utility>
+
+namespace ns3 {
+
+/**
+ * \ingroup queue
+ *
+ * \brief A growable circular buffer of objects of type T
+ *
+ * Elements are stored in a contiguous array whose size is a power of two,
+ * which is doubled when the buffer is full. Adding or removing an element
+ * at either end does not allocate memory (unless the buffer has to grow),
+ * which makes this container a good fit for FIFO queues.
+ *
+ * The container offers a subset of the std::list interface (cbegin, cend,
+ * insert, erase, ...), so that it can be used as a drop-in replacement for
+ * std::list in the Queue class. Each element is identified by a sequence
+ * number, which is not affected by the insertion or the removal of other
+ * elements at the ends of the buffer nor by the growth of the buffer. As a
+ * consequence:
+ *
+ * - push_back, push_front, pop_back and pop_front do not invalidate the
+ *   iterators to the other elements;
+ * - insert (pos, value) does not invalidate the iterators to the elements
+ *   at or after pos; the elements preceding pos are moved and the iterators
+ *   to them are invalidated. If pos is the end of the buffer, the element is
+ *   appended and the past-the-end iterator refers to the new element;
+ * - erase (pos) does not invalidate the iterators to the elements after
+ *   pos nor the past-the-end iterator; the elements preceding pos are moved
+ *   and the iterators to them are invalidated.
+ *
+ * Hence, a loop that browses the buffer from the head and removes some of the
+ * elements (a common pattern in Queue subclasses) keeps working as with a
+ * std::list. Insertions (except at the ends of the buffer) and removals
+ * (except at the head of the buffer) take a time proportional to the distance
+ * from the head of the buffer.
+ *
+ * T must be default constructible. Slots that do not hold an element are
+ * reset to T (), so that, e.g., smart pointers release the referenced objects
+ * as soon as they are removed from the buffer.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+  /**
+   * \brief Const iterator over the elements of a RingBuffer
+   */
+  class ConstIterator
+  {
+public:
+    /// Iterator category
+    typedef std::bidirectional_iterator_tag iterator_category;
+    /// Type of the elements
+    typedef T value_type;
+    /// Difference type
+    typedef std::ptrdiff_t difference_type;
+    /// Pointer type
+    typedef const T* pointer;
+    /// Reference type
+    typedef const T& reference;
+
+    ConstIterator ();
+    /**
+     * \return a reference to the element
+     */
+    const T & operator* (void) const;
+    /**
+     * \return a pointer to the element
+     */
+    const T * operator-> (void) const;
+    /**
+     * Prefix increment operator
+     * \return a reference to this iterator
+     */
+    ConstIterator & operator++ (void);
+    /**
+     * Postfix increment operator
+     * \return the iterator before the increment
+     */
+    ConstIterator operator++ (int);
+    /**
+     * Prefix decrement operator
+     * \return a reference to this iterator
+     */
+    ConstIterator & operator-- (void);
+    /**
+     * Postfix decrement operator
+     * \return the iterator before the decrement
+     */
+    ConstIterator operator-- (int);
+    /**
+     * \param o the other iterator
+     * \return true if both iterators refer to the same position
+     */
+    bool operator== (const ConstIterator &o) const;
+    /**
+     * \param o the other iterator
+     * \return true if the iterators refer to different positions
+     */
+    bool operator!= (const ConstIterator &o) const;
+
+private:
+    friend class RingBuffer<T>;
+    /**
+     * Constructor
+     * \param buffer the buffer
+     * \param seq the sequence number of the element
+     */
+    ConstIterator (const RingBuffer<T> *buffer, std::size_t seq);
+
+    const RingBuffer<T> *m_buffer;   //!< the buffer
+    std::size_t m_seq;               //!< the sequence number of the element
+  };
+
+  /// Const iterator (std naming)
+  typedef ConstIterator const_iterator;
+  /// Type of the elements
+  typedef T value_type;
+  /// Size type
+  typedef std::size_t size_type;
+
+  RingBuffer ();
+
+  /**
+   * \return the number of elements in the buffer
+   */
+  std::size_t size (void) const;
+  /**
+   * \return true if the buffer contains no element
+   */
+  bool empty (void) const;
+  /**
+   * \return the number of elements the buffer can hold before growing
+   */
+  std::size_t capacity (void) const;
+  /**
+   * Make sure that the buffer can hold at least n elements without growing
+   * \param n the number of elements
+   */
+  void reserve (std::size_t n);
+
+  /**
+   * \return an iterator to the first element
+   */
+  ConstIterator cbegin (void) const;
+  /**
+   * \return an iterator past the last element
+   */
+  ConstIterator cend (void) const;
+  /**
+   * \return an iterator to the first element
+   */
+  ConstIterator begin (void) const;
+  /**
+   * \return an iterator past the last element
+   */
+  ConstIterator end (void) const;
+
+  /**
+   * \param i the position of the element, from the beginning of the buffer
+   * \return a reference to the element
+   */
+  T & operator[] (std::size_t i);
+  /**
+   * \param i the position of the element, from the beginning of the buffer
+   * \return a reference to the element
+   */
+  const T & operator[] (std::size_t i) const;
+  /**
+   * \return a reference to the first element
+   */
+  const T & front (void) const;
+  /**
+   * \return a reference to the last element
+   */
+  const T & back (void) const;
+
+  /**
+   * Add an element at the end of the buffer
+   * \param value the element
+   */
+  void push_back (const T &value);
+  /**
+   * Add an element at the beginning of the buffer
+   * \param value the element
+   */
+  void push_front (const T &value);
+  /**
+   * Remove the last element
+   */
+  void pop_back (void);
+  /**
+   * Remove the first element
+   */
+  void pop_front (void);
+
+  /**
+   * Insert an element before the given position
+   * \param pos the position
+   * \param value the element
+   * \return an iterator to the inserted element
+   */
+  ConstIterator insert (ConstIterator pos, const T &value);
+  /**
+   * Remove the element at the given position
+   * \param pos the position
+   * \return an iterator to the element following the removed one
+   */
+  ConstIterator erase (ConstIterator pos);
+  /**
+   * Remove all the elements. The memory is not released.
+   */
+  void clear (void);
+
+private:
+  /**
+   * \param seq a sequence number
+   * \return the slot storing the element having the given sequence number
+   */
+  T & Slot (std::size_t seq);
+  /**
+   * \param seq a sequence number
+   * \return the slot storing the element having the given sequence number
+   */
+  const T & Slot (std::size_t seq) const;
+  /**
+   * Double the capacity of the buffer (or allocate the initial slots)
+   */
+  void Grow (void);
+  /**
+   * Move the elements in the slots to a new array of the given size
+   * \param capacity the new capacity (a power of two)
+   */
+  void Relocate (std::size_t capacity);
+
+  /// Initial number of slots
+  static const std::size_t INITIAL_CAPACITY = 16;
+
+  std::vector<T> m_slots;  //!< the slots (the size is a power of two)
+  std::size_t m_mask;      //!< the number of slots minus one
+  std::size_t m_head;      //!< the sequence number of the first element
+  std::size_t m_size;      //!< the number of elements
+};
+
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <typename T>
+const std::size_t RingBuffer<T>::INITIAL_CAPACITY;
+
+template <typename T>
+RingBuffer<T>::ConstIterator::ConstIterator ()
+  : m_buffer (0),
+    m_seq (0)
+{
+}
+
+template <typename T>
+RingBuffer<T>::ConstIterator::ConstIterator (const RingBuffer<T> *buffer, std::size_t seq)
+  : m_buffer (buffer),
+    m_seq (seq)
+{
+}
+
+template <typename T>
+const T &
+RingBuffer<T>::ConstIterator::operator* (void) const
+{
+  NS_ASSERT (m_seq - m_buffer->m_head < m_buffer->m_size);
+  return m_buffer->Slot (m_seq);
+}
+
+template <typename T>
+const T *
+RingBuffer<T>::ConstIterator::operator-> (void) const
+{
+  return &(operator* ());
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator &
+RingBuffer<T>::ConstIterator::operator++ (void)
+{
+  m_seq++;
+  return *this;
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::ConstIterator::operator++ (int)
+{
+  ConstIterator tmp = *this;
+  m_seq++;
+  return tmp;
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator &
+RingBuffer<T>::ConstIterator::operator-- (void)
+{
+  m_seq--;
+  return *this;
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::ConstIterator::operator-- (int)
+{
+  ConstIterator tmp = *this;
+  m_seq--;
+  return tmp;
+}
+
+template <typename T>
+bool
+RingBuffer<T>::ConstIterator::operator== (const ConstIterator &o) const
+{
+  return m_buffer == o.m_buffer && m_seq == o.m_seq;
+}
+
+template <typename T>
+bool
+RingBuffer<T>::ConstIterator::operator!= (const ConstIterator &o) const
+{
+  return !(*this == o);
+}
+
+template <typename T>
+RingBuffer<T>::RingBuffer ()
+  : m_mask (0),
+    m_head (0),
+    m_size (0)
+{
+}
+
+template <typename T>
+std::size_t
+RingBuffer<T>::size (void) const
+{
+  return m_size;
+}
+
+template <typename T>
+bool
+RingBuffer<T>::empty (void) const
+{
+  return m_size == 0;
+}
+
+template <typename T>
+std::size_t
+RingBuffer<T>::capacity (void) const
+{
+  return m_slots.size ();
+}
+
+template <typename T>
+void
+RingBuffer<T>::reserve (std::size_t n)
+{
+  std::size_t capacity = (m_slots.empty () ? INITIAL_CAPACITY : m_slots.size ());
+  while (capacity < n)
+    {
+      capacity <<= 1;
+    }
+  if (capacity > m_slots.size ())
+    {
+      Relocate (capacity);
+    }
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::cbegin (void) const
+{
+  return ConstIterator (this, m_head);
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::cend (void) const
+{
+  return ConstIterator (this, m_head + m_size);
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::begin (void) const
+{
+  return cbegin ();
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::end (void) const
+{
+  return cend ();
+}
+
+template <typename T>
+T &
+RingBuffer<T>::operator[] (std::size_t i)
+{
+  NS_ASSERT (i < m_size);
+  return Slot (m_head + i);
+}
+
+template <typename T>
+const T &
+RingBuffer<T>::operator[] (std::size_t i) const
+{
+  NS_ASSERT (i < m_size);
+  return Slot (m_head + i);
+}
+
+template <typename T>
+const T &
+RingBuffer<T>::front (void) const
+{
+  NS_ASSERT (m_size > 0);
+  return Slot (m_head);
+}
+
+template <typename T>
+const T &
+RingBuffer<T>::back (void) const
+{
+  NS_ASSERT (m_size > 0);
+  return Slot (m_head + m_size - 1);
+}
+
+template <typename T>
+void
+RingBuffer<T>::push_back (const T &value)
+{
+  if (m_size == m_slots.size ())
+    {
+      Grow ();
+    }
+  Slot (m_head + m_size) = value;
+  m_size++;
+}
+
+template <typename T>
+void
+RingBuffer<T>::push_front (const T &value)
+{
+  if (m_size == m_slots.size ())
+    {
+      Grow ();
+    }
+  m_head--;
+  Slot (m_head) = value;
+  m_size++;
+}
+
+template <typename T>
+void
+RingBuffer<T>::pop_back (void)
+{
+  NS_ASSERT (m_size > 0);
+  m_size--;
+  Slot (m_head + m_size) = T ();
+}
+
+template <typename T>
+void
+RingBuffer<T>::pop_front (void)
+{
+  NS_ASSERT (m_size > 0);
+  Slot (m_head) = T ();
+  m_head++;
+  m_size--;
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::insert (ConstIterator pos, const T &value)
+{
+  NS_ASSERT (pos.m_buffer == this);
+  std::size_t offset = pos.m_seq - m_head;
+  NS_ASSERT (offset <= m_size);
+
+  if (offset == m_size)
+    {
+      push_back (value);
+      return ConstIterator (this, m_head + offset);
+    }
+
+  // make room by moving the elements preceding pos one slot towards the head
+  push_front (value);
+  for (std::size_t i = 0; i < offset; i++)
+    {
+      std::swap (Slot (m_head + i), Slot (m_head + i + 1));
+    }
+  return ConstIterator (this, m_head + offset);
+}
+
+template <typename T>
+typename RingBuffer<T>::ConstIterator
+RingBuffer<T>::erase (ConstIterator pos)
+{
+  NS_ASSERT (pos.m_buffer == this);
+  std::size_t offset = pos.m_seq - m_head;
+  NS_ASSERT (offset < m_size);
+
+  // fill the hole by moving the elements preceding pos one slot towards the
+  // tail, so that the elements following pos (and the end of the buffer)
+  // keep their sequence number
+  for (std::size_t i = offset; i > 0; i--)
+    {
+      std::swap (Slot (m_head + i), Slot (m_head + i - 1));
+    }
+  pop_front ();
+  return ConstIterator (this, pos.m_seq + 1);
+}
+
+template <typename T>
+void
+RingBuffer<T>::clear (void)
+{
+  while (m_size > 0)
+    {
+      pop_front ();
+    }
+  m_head = 0;
+}
+
+template <typename T>
+T &
+RingBuffer<T>::Slot (std::size_t seq)
+{
+  return m_slots[seq & m_mask];
+}
+
+template <typename T>
+const T &
+RingBuffer<T>::Slot (std::size_t seq) const
+{
+  return m_slots[seq & m_mask];
+}
+
+template <typename T>
+void
+RingBuffer<T>::Grow (void)
+{
+  Relocate (m_slots.empty () ? INITIAL_CAPACITY : m_slots.size () << 1);
+}
+
+template <typename T>
+void
+RingBuffer<T>::Relocate (std::size_t capacity)
+{
+  NS_ASSERT ((capacity & (capacity - 1)) == 0 && capacity >= m_size);
+
+  // Elements keep their sequence number, hence iterators stay valid
+  std::vector<T> slots (capacity);
+  std::size_t mask = capacity - 1;
+  for (std::size_t seq = m_head; seq != m_head + m_size; seq++)
+    {
+      std::swap (slots[seq & mask], Slot (seq));
+    }
+  m_slots.swap (slots);
+  m_mask = mask;
+}
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
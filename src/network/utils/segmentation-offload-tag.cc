@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "segmentation-offload-tag.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SegmentationOffloadTag");
+
+NS_OBJECT_ENSURE_REGISTERED (SegmentationOffloadTag);
+
+TypeId
+SegmentationOffloadTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SegmentationOffloadTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("Network")
+    .AddConstructor<SegmentationOffloadTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+SegmentationOffloadTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+SegmentationOffloadTag::GetSerializedSize (void) const
+{
+  return 2 + 4 + 8;
+}
+
+void
+SegmentationOffloadTag::Serialize (TagBuffer buf) const
+{
+  buf.WriteU16 (m_segmentSize);
+  buf.WriteU32 (m_payloadSize);
+  buf.WriteU64 (m_lostSegments);
+}
+
+void
+SegmentationOffloadTag::Deserialize (TagBuffer buf)
+{
+  m_segmentSize = buf.ReadU16 ();
+  m_payloadSize = buf.ReadU32 ();
+  m_lostSegments = buf.ReadU64 ();
+}
+
+void
+SegmentationOffloadTag::Print (std::ostream &os) const
+{
+  os << "SegmentSize=" << m_segmentSize << " PayloadSize=" << m_payloadSize
+     << " Segments=" << GetSegmentCount ();
+  if (IsAnyLost ())
+    {
+      os << " LostMask=0x" << std::hex << m_lostSegments << std::dec;
+    }
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag ()
+  : Tag (),
+    m_segmentSize (0),
+    m_payloadSize (0),
+    m_lostSegments (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag (uint16_t segmentSize, uint32_t payloadSize)
+  : Tag (),
+    m_segmentSize (segmentSize),
+    m_payloadSize (payloadSize),
+    m_lostSegments (0)
+{
+  NS_LOG_FUNCTION (this << segmentSize << payloadSize);
+  NS_ASSERT (GetSegmentCount () <= MAX_SEGMENTS);
+}
+
+void
+SegmentationOffloadTag::SetSegmentSize (uint16_t segmentSize)
+{
+  NS_LOG_FUNCTION (this << segmentSize);
+  m_segmentSize = segmentSize;
+}
+
+uint16_t
+SegmentationOffloadTag::GetSegmentSize (void) const
+{
+  return m_segmentSize;
+}
+
+void
+SegmentationOffloadTag::SetPayloadSize (uint32_t payloadSize)
+{
+  NS_LOG_FUNCTION (this << payloadSize);
+  m_payloadSize = payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetPayloadSize (void) const
+{
+  return m_payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentCount (void) const
+{
+  if (m_segmentSize == 0)
+    {
+      return 1;
+    }
+  return (m_payloadSize + m_segmentSize - 1) / m_segmentSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentPayloadSize (uint32_t index) const
+{
+  NS_ASSERT (index < GetSegmentCount ());
+  uint32_t offset = index * m_segmentSize;
+  return std::min<uint32_t> (m_segmentSize, m_payloadSize - offset);
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentedSize (uint32_t packetSize) const
+{
+  NS_ASSERT (packetSize >= m_payloadSize);
+  uint32_t overhead = packetSize - m_payloadSize;
+  return m_payloadSize + GetSegmentCount () * overhead;
+}
+
+void
+SegmentationOffloadTag::SetLost (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT (index < GetSegmentCount ());
+  m_lostSegments |= (uint64_t (1) << index);
+}
+
+bool
+SegmentationOffloadTag::IsLost (uint32_t index) const
+{
+  NS_ASSERT (index < GetSegmentCount ());
+  return (m_lostSegments & (uint64_t (1) << index)) != 0;
+}
+
+bool
+SegmentationOffloadTag::IsAnyLost (void) const
+{
+  return m_lostSegments != 0;
+}
+
+bool
+SegmentationOffloadTag::IsAllLost (void) const
+{
+  uint32_t count = GetSegmentCount ();
+  uint64_t all = (count >= 64) ? ~uint64_t (0) : ((uint64_t (1) << count) - 1);
+  return (m_lostSegments & all) == all;
+}
+
+} // namespace ns3
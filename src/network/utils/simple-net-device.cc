@@ -270,7 +270,7 @@ SimpleNetDevice::Receive (Ptr<Packet> packet, uint16_t protocol,
   NS_LOG_FUNCTION (this << packet << protocol << to << from);
   NetDevice::PacketType packetType;
 
-  if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (packet) )
+  if (m_receiveErrorModel && m_receiveErrorModel->IsCorruptSegmented (packet) )
     {
       m_phyRxDropTrace (packet);
       return;
@@ -32,6 +32,8 @@
 #include "ns3/mpi-receiver.h"
 
 #include "ns3/trace-helper.h"
+#include "ns3/binary-trace-writer.h"
+#include "ns3/node.h"
 #include "point-to-point-helper.h"
 
 namespace ns3 {
@@ -158,7 +160,20 @@ PointToPointHelper::EnableAsciiInternal (
           filename = asciiTraceHelper.GetFilenameFromDevice (prefix, device);
         }
 
-      Ptr<OutputStreamWrapper> theStream = asciiTraceHelper.CreateFileStream (filename);
+      //
+      // Only the default trace sinks are hooked below, so the file may hold
+      // binary records rather than text.
+      //
+      Ptr<OutputStreamWrapper> theStream;
+      if (AsciiTraceHelper::IsBinaryFormat ())
+        {
+          theStream = asciiTraceHelper.CreateBinaryFileStream (filename);
+          theStream->GetBinaryTraceWriter ()->SetDevice (device->GetNode ()->GetId (), device->GetIfIndex ());
+        }
+      else
+        {
+          theStream = asciiTraceHelper.CreateFileStream (filename);
+        }
 
       //
       // The MacRx trace source provides our "r" event.
@@ -26,6 +26,8 @@
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/queue-item.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
@@ -284,7 +286,21 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
 
-  Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+  Time txTime;
+  SegmentationOffloadTag tso;
+  if (p->PeekPacketTag (tso))
+    {
+      //
+      // A segmentation-offloaded packet takes the time needed to transmit
+      // the train of segments it stands for, back to back.
+      //
+      txTime = m_bps.CalculateBytesTxTime (tso.GetSegmentedSize (p->GetSize ()))
+        + m_tInterframeGap * (tso.GetSegmentCount () - 1);
+    }
+  else
+    {
+      txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+    }
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
@@ -370,7 +386,7 @@ PointToPointNetDevice::Receive (Ptr<Packet> packet)
   NS_LOG_FUNCTION (this << packet);
   uint16_t protocol = 0;
 
-  if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (packet) ) 
+  if (m_receiveErrorModel && m_receiveErrorModel->IsCorruptSegmented (packet) ) 
     {
       // 
       // If we have an error model and it indicates that it is time to lose a
@@ -592,6 +608,52 @@ PointToPointNetDevice::Send (
   return false;
 }
 
+uint32_t
+PointToPointNetDevice::SendBatch (const std::vector<Ptr<QueueDiscItem> > &items)
+{
+  NS_LOG_FUNCTION (this << items.size ());
+
+  uint32_t sent = 0;
+  for (auto& item : items)
+    {
+      if (m_queueInterface && m_queueInterface->GetTxQueue (0)->IsStopped ())
+        {
+          break;
+        }
+      sent++;
+
+      Ptr<Packet> packet = item->GetPacket ();
+      if (IsLinkUp () == false)
+        {
+          m_macTxDropTrace (packet);
+          continue;
+        }
+
+      AddHeader (packet, item->GetProtocol ());
+
+      m_macTxTrace (packet);
+
+      if (!m_queue->Enqueue (packet))
+        {
+          m_macTxDropTrace (packet);
+        }
+    }
+
+  //
+  // Start the transmission of the first packet if the channel is ready,
+  // the others will follow when the transmission completes.
+  //
+  if (m_txMachineState == READY && !m_queue->IsEmpty ())
+    {
+      Ptr<Packet> packet = m_queue->Dequeue ();
+      m_snifferTrace (packet);
+      m_promiscSnifferTrace (packet);
+      TransmitStart (packet);
+    }
+
+  return sent;
+}
+
 bool
 PointToPointNetDevice::SendFrom (Ptr<Packet> packet, 
                                  const Address &source, 
@@ -641,6 +703,13 @@ PointToPointNetDevice::SupportsSendFrom (void) const
   return false;
 }
 
+bool
+PointToPointNetDevice::SupportsSegmentationOffload (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
 void
 PointToPointNetDevice::DoMpiReceive (Ptr<Packet> p)
 {
@@ -179,6 +179,19 @@ public:
   virtual bool Send (Ptr<Packet> packet, const Address &dest, uint16_t protocolNumber);
   virtual bool SendFrom (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber);
 
+  /**
+   * \brief Send a batch of packets
+   *
+   * All the packets of the batch are enqueued in the transmit queue (as long
+   * as the transmission queue is not stopped) before starting a transmission,
+   * if the device is idle.
+   *
+   * \param items the packets to send
+   * \return the number of packets consumed by the device
+   */
+  virtual uint32_t SendBatch (const std::vector<Ptr<QueueDiscItem> > &items);
+
+
   virtual Ptr<Node> GetNode (void) const;
   virtual void SetNode (Ptr<Node> node);
 
@@ -190,6 +203,7 @@ public:
 
   virtual void SetPromiscReceiveCallback (PromiscReceiveCallback cb);
   virtual bool SupportsSendFrom (void) const;
+  virtual bool SupportsSegmentationOffload (void) const;
 
 protected:
   /**
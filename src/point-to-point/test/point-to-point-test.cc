@@ -24,6 +24,17 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/error-model.h"
+#include "ns3/data-rate.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/trace-helper.h"
+
+#include <fstream>
+#include <iterator>
+#include <cstring>
 
 using namespace ns3;
 
@@ -101,6 +112,182 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test the transmission of segmentation-offloaded packets
+ *
+ * A packet carrying a SegmentationOffloadTag must be received after the time
+ * needed to transmit all the segments it stands for, and the receive error
+ * model must be applied to each of those segments.
+ */
+class PointToPointSegmentationOffloadTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointSegmentationOffloadTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send a super-segment to the device specified
+   *
+   * \param device NetDevice to send to
+   */
+  void SendSuperSegment (Ptr<PointToPointNetDevice> device);
+
+  /**
+   * \brief Receive callback
+   *
+   * \param device the receiving device
+   * \param p the packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+
+  Time m_rxTime;                       //!< Reception time
+  SegmentationOffloadTag m_rxTag;      //!< Tag of the received packet
+};
+
+PointToPointSegmentationOffloadTest::PointToPointSegmentationOffloadTest ()
+  : TestCase ("PointToPoint segmentation offload")
+{
+}
+
+void
+PointToPointSegmentationOffloadTest::SendSuperSegment (Ptr<PointToPointNetDevice> device)
+{
+  // 10 segments of 1000 bytes, with 40 bytes of headers
+  Ptr<Packet> p = Create<Packet> (10040);
+  p->AddPacketTag (SegmentationOffloadTag (1000, 10000));
+  device->Send (p, device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointSegmentationOffloadTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p,
+                                              uint16_t protocol, const Address &from)
+{
+  m_rxTime = Simulator::Now ();
+  p->PeekPacketTag (m_rxTag);
+  return true;
+}
+
+void
+PointToPointSegmentationOffloadTest::DoRun (void)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+  devA->SetDataRate (DataRate ("8Mbps"));
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+
+  // corrupt the third and the fifth segments
+  Ptr<ReceiveListErrorModel> em = CreateObject<ReceiveListErrorModel> ();
+  std::list<uint32_t> sampleList;
+  sampleList.push_back (2);
+  sampleList.push_back (4);
+  em->SetList (sampleList);
+  devB->SetReceiveErrorModel (em);
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  // Node::AddDevice overrides the receive callback
+  devB->SetReceiveCallback (MakeCallback (&PointToPointSegmentationOffloadTest::Receive, this));
+
+  NS_TEST_ASSERT_MSG_EQ (devA->SupportsSegmentationOffload (), true, "Offload not supported");
+
+  Simulator::Schedule (Seconds (1.0), &PointToPointSegmentationOffloadTest::SendSuperSegment, this, devA);
+
+  Simulator::Run ();
+
+  // 10 segments of 1000 + 40 + 2 (PPP header) bytes at 1 byte/us
+  NS_TEST_ASSERT_MSG_EQ (m_rxTime, Seconds (1.0) + MicroSeconds (10420), "Wrong transmission time");
+  NS_TEST_ASSERT_MSG_EQ (m_rxTag.GetSegmentCount (), 10, "Wrong number of segments");
+  for (uint32_t i = 0; i < m_rxTag.GetSegmentCount (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_rxTag.IsLost (i), (i == 2 || i == 4), "Wrong lost state for segment " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief Test the binary ascii trace of a PointToPointNetDevice
+ *
+ * The events of the binary trace file of a device must record the node and
+ * device identifiers of the device.
+ */
+class PointToPointBinaryTraceTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointBinaryTraceTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+};
+
+PointToPointBinaryTraceTest::PointToPointBinaryTraceTest ()
+  : TestCase ("PointToPoint binary ascii trace")
+{
+}
+
+void
+PointToPointBinaryTraceTest::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("point-to-point-binary.tr");
+  uint32_t nodeId;
+  uint32_t deviceId;
+  {
+    NodeContainer nodes;
+    nodes.Create (2);
+    PointToPointHelper p2p;
+    NetDeviceContainer devices = p2p.Install (nodes);
+    nodeId = devices.Get (1)->GetNode ()->GetId ();
+    deviceId = devices.Get (1)->GetIfIndex ();
+
+    // without the packet headers, the records have a fixed size
+    AsciiTraceHelper::SetBinaryFormat (true, false);
+    p2p.EnableAscii (filename, devices.Get (1), true);
+    AsciiTraceHelper::SetBinaryFormat (false);
+
+    Simulator::Schedule (Seconds (1.0), &NetDevice::Send, devices.Get (0), Create<Packet> (100),
+                         devices.Get (1)->GetAddress (), 0x800);
+    Simulator::Run ();
+  }
+  // the devices, and so the trace file, are released
+  Simulator::Destroy ();
+
+  std::ifstream file (filename.c_str (), std::ios::binary);
+  std::string trace ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char> ());
+  NS_TEST_ASSERT_MSG_EQ (trace.size (), 8 + 36, "Expected a single reception record");
+  NS_TEST_EXPECT_MSG_EQ (trace[8 + 1], 'r', "Expected a reception record");
+  // the node and device identifiers end the record
+  uint32_t ids[2];
+  std::memcpy (ids, trace.data () + 8 + 28, sizeof (ids));
+  NS_TEST_EXPECT_MSG_EQ (ids[0], nodeId, "Wrong node identifier");
+  NS_TEST_EXPECT_MSG_EQ (ids[1], deviceId, "Wrong device identifier");
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -116,7 +303,11 @@ public:
 PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
+  // the ascii trace enables the packet metadata, which must be done before
+  // any packet is created
+  AddTestCase (new PointToPointBinaryTraceTest, TestCase::QUICK);
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointSegmentationOffloadTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
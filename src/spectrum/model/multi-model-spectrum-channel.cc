@@ -369,6 +369,12 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+              if (m_batchReceptions && delay.IsZero ())
+                {
+                  QueueRx (rxParams, *rxPhyIterator);
+                  continue;
+                }
+
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
                 {
@@ -463,6 +469,13 @@ MultiModelSpectrumChannel::AddSpectrumPropagationLossModel (Ptr<SpectrumPropagat
   m_spectrumPropagationLoss = loss;
 }
 
+Ptr<PropagationLossModel>
+MultiModelSpectrumChannel::GetPropagationLossModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_propagationLoss;
+}
+
 void
 MultiModelSpectrumChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
 {
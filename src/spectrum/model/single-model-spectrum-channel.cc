@@ -192,6 +192,12 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
             }
 
 
+          if (m_batchReceptions && delay.IsZero ())
+            {
+              QueueRx (rxParams, *rxPhyIterator);
+              continue;
+            }
+
           Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
           if (netDev)
             {
@@ -258,6 +264,13 @@ SingleModelSpectrumChannel::AddSpectrumPropagationLossModel (Ptr<SpectrumPropaga
   m_spectrumPropagationLoss = loss;
 }
 
+Ptr<PropagationLossModel>
+SingleModelSpectrumChannel::GetPropagationLossModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_propagationLoss;
+}
+
 void
 SingleModelSpectrumChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
 {
@@ -53,6 +53,7 @@ public:
   virtual void AddPropagationLossModel (Ptr<PropagationLossModel> loss);
   virtual void AddSpectrumPropagationLossModel (Ptr<SpectrumPropagationLossModel> loss);
   virtual void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
+  virtual Ptr<PropagationLossModel> GetPropagationLossModel (void);
   virtual void AddRx (Ptr<SpectrumPhy> phy);
   virtual void StartTx (Ptr<SpectrumSignalParameters> params);
 
@@ -18,6 +18,11 @@
  * Author: Nicola Baldo <nbaldo@cttc.es>
  */
 
+#include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
 #include "spectrum-channel.h"
 
 
@@ -32,12 +37,64 @@ SpectrumChannel::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SpectrumChannel")
     .SetParent<Channel> ()
     .SetGroupName ("Spectrum")
+    .AddAttribute ("BatchReceptions",
+                   "If true, the signals transmitted at the same time that reach "
+                   "their receivers without propagation delay are delivered by a "
+                   "single event per receiving node, instead of one event per "
+                   "signal and receiver.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SpectrumChannel::m_batchReceptions),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
+SpectrumChannel::SpectrumChannel ()
+  : m_batchReceptions (false)
+{
+}
+
 SpectrumChannel::~SpectrumChannel ()
 {
 }
 
+void
+SpectrumChannel::DoDispose (void)
+{
+  m_queuedRx.clear ();
+  Channel::DoDispose ();
+}
+
+void
+SpectrumChannel::QueueRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
+{
+  // the receptions run in the context of the receiving node, as with one
+  // event per signal; a receiver without NetDevice keeps the current context
+  uint32_t context = Simulator::GetContext ();
+  Ptr<NetDevice> netDev = receiver->GetDevice ();
+  if (netDev)
+    {
+      context = netDev->GetNode ()->GetId ();
+    }
+  QueuedRxList_t &signals = m_queuedRx[context];
+  if (signals.empty ())
+    {
+      Simulator::ScheduleWithContext (context, Seconds (0), &SpectrumChannel::DeliverQueuedRx, this, context);
+    }
+  signals.push_back (std::make_pair (params, receiver));
+}
+
+void
+SpectrumChannel::DeliverQueuedRx (uint32_t context)
+{
+  // the receivers may cause new signals to be queued: they are delivered
+  // by the next event
+  QueuedRxList_t signals;
+  m_queuedRx[context].swap (signals);
+  for (QueuedRxList_t::const_iterator it = signals.begin (); it != signals.end (); ++it)
+    {
+      it->second->StartRx (it->first);
+    }
+}
+
 } // namespace
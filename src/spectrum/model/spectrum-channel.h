@@ -26,6 +26,9 @@
 #include <ns3/nstime.h>
 #include <ns3/channel.h>
 #include <ns3/spectrum-signal-parameters.h>
+#include <vector>
+#include <map>
+#include <utility>
 
 namespace ns3 {
 
@@ -46,6 +49,7 @@ class PropagationDelayModel;
 class SpectrumChannel : public Channel
 {
 public:
+  SpectrumChannel ();
   virtual ~SpectrumChannel ();
 
   /**
@@ -74,6 +78,20 @@ public:
    */
   virtual void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay) = 0;
 
+  /**
+   * Get the single-frequency propagation loss model, which is the first
+   * of the chain of models added to the channel.
+   * \return the propagation loss model, or 0 if none was added.
+   */
+  virtual Ptr<PropagationLossModel> GetPropagationLossModel (void) = 0;
+
+  /**
+   * Get the frequency-dependent propagation loss model, which is the
+   * first of the chain of models added to the channel.
+   * \return the propagation loss model, or 0 if none was added.
+   */
+  virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void) = 0;
+
 
   /**
    * Used by attached PHY instances to transmit signals on the channel
@@ -112,7 +130,37 @@ public:
   typedef void (* LossTracedCallback)
     (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy,
      double lossDb);
-  
+
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Queue a signal reaching a receiver without propagation delay.  The
+   * signals queued at the same time for the receivers of a node are all
+   * delivered, in the order they were queued, by a single event scheduled
+   * in the context of that node when the first of them is queued.  Used by
+   * the subclasses, when the BatchReceptions attribute is true, instead of
+   * scheduling one reception event per signal and receiver.
+   *
+   * \param params the parameters of the received signal
+   * \param receiver the receiver
+   */
+  void QueueRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+  bool m_batchReceptions; //!< The `BatchReceptions` attribute.
+
+private:
+  /**
+   * Deliver the queued signals to the receivers of a node.
+   *
+   * \param context the context of the node
+   */
+  void DeliverQueuedRx (uint32_t context);
+
+  /// The signals queued for delivery, with their receivers
+  typedef std::vector<std::pair<Ptr<SpectrumSignalParameters>, Ptr<SpectrumPhy> > > QueuedRxList_t;
+  /// The signals waiting to be delivered, by context of the receiving node
+  std::map<uint32_t, QueuedRxList_t> m_queuedRx;
 };
 
 
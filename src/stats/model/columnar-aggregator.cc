@@ -0,0 +1,478 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "columnar-aggregator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ColumnarAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED (ColumnarAggregator);
+
+/// The magic string at the start of a file
+static const char COLUMNAR_MAGIC[8] = { 'N', 'S', '3', 'C', 'O', 'L', 'A', '1' };
+/// The type of a series record
+static const uint8_t SERIES_RECORD = 'S';
+/// The type of a chunk record
+static const uint8_t CHUNK_RECORD = 'K';
+/// The byte written for a value equal to the previous one
+static const uint8_t SAME_VALUE = 0xff;
+
+/**
+ * \param data the data to append to.
+ * \param value the value.
+ *
+ * Appends a value in the byte order of the host.
+ */
+template <typename T>
+static inline void
+AppendRaw (std::string &data, T value)
+{
+  data.append (reinterpret_cast<const char *> (&value), sizeof (value));
+}
+
+/**
+ * \param data the data to append to.
+ * \param value the value.
+ *
+ * Appends a value as a variable length integer, 7 bits per byte.
+ */
+static void
+AppendVarint (std::string &data, uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      data.push_back (static_cast<char> ((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+  data.push_back (static_cast<char> (value));
+}
+
+/**
+ * \param data the data to append to.
+ * \param column the column.
+ *
+ * Appends a column of doubles, each XORed with the previous one.
+ */
+static void
+AppendColumn (std::string &data, const std::vector<double> &column)
+{
+  uint64_t previous = 0;
+  for (std::vector<double>::const_iterator i = column.begin (); i != column.end (); i++)
+    {
+      uint64_t bits;
+      std::memcpy (&bits, &*i, sizeof (bits));
+      uint64_t x = bits ^ previous;
+      previous = bits;
+      if (x == 0)
+        {
+          data.push_back (static_cast<char> (SAME_VALUE));
+          continue;
+        }
+      uint8_t zeroBytes = 0;
+      while ((x & 0xff) == 0)
+        {
+          x >>= 8;
+          zeroBytes++;
+        }
+      data.push_back (static_cast<char> (zeroBytes));
+      AppendVarint (data, x);
+    }
+}
+
+/**
+ * \param is the stream.
+ * \param value [out] the value.
+ * \return true if the value could be read.
+ *
+ * Reads a value in the byte order of the host.
+ */
+template <typename T>
+static inline bool
+ReadRaw (std::istream &is, T *value)
+{
+  is.read (reinterpret_cast<char *> (value), sizeof (*value));
+  return is.good ();
+}
+
+/**
+ * \param is the stream.
+ * \param value [out] the value.
+ * \return true if the value could be read.
+ *
+ * Reads a variable length integer.
+ */
+static bool
+ReadVarint (std::istream &is, uint64_t *value)
+{
+  *value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int byte = is.get ();
+      if (byte == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      *value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \param is the stream.
+ * \param rows the number of values.
+ * \param column [out] the column.
+ * \return true if the column could be read.
+ *
+ * Reads a column of doubles written by AppendColumn.
+ */
+static bool
+ReadColumn (std::istream &is, uint32_t rows, std::vector<double> *column)
+{
+  column->resize (rows);
+  uint64_t previous = 0;
+  for (uint32_t i = 0; i < rows; i++)
+    {
+      int zeroBytes = is.get ();
+      uint64_t x = 0;
+      if (zeroBytes == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      if (zeroBytes != SAME_VALUE)
+        {
+          if (zeroBytes > 7 || !ReadVarint (is, &x))
+            {
+              return false;
+            }
+          x <<= 8 * zeroBytes;
+        }
+      previous ^= x;
+      std::memcpy (&(*column)[i], &previous, sizeof (previous));
+    }
+  return true;
+}
+
+ColumnarAggregator::Series::Series ()
+  : nameWritten (false),
+    binOpen (false),
+    bin (0),
+    binSum (0),
+    binMin (0),
+    binMax (0),
+    binCount (0)
+{
+}
+
+TypeId
+ColumnarAggregator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ColumnarAggregator")
+    .SetParent<DataCollectionObject> ()
+    .SetGroupName ("Stats")
+  ;
+
+  return tid;
+}
+
+ColumnarAggregator::ColumnarAggregator (const std::string &outputFileName)
+  : m_outputFileName (outputFileName),
+    m_headerWritten (false),
+    m_binWidth (0),
+    m_chunkSize (4096)
+{
+  NS_LOG_FUNCTION (this << outputFileName);
+
+  m_file.open (m_outputFileName.c_str (), std::ios::out | std::ios::binary);
+}
+
+ColumnarAggregator::~ColumnarAggregator ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_file.close ();
+}
+
+void
+ColumnarAggregator::SetBinWidth (double width)
+{
+  NS_LOG_FUNCTION (this << width);
+  NS_ASSERT_MSG (!m_headerWritten, "The bin width must be set before the first chunk is written");
+  m_binWidth = width;
+}
+
+void
+ColumnarAggregator::SetChunkSize (uint32_t rows)
+{
+  NS_LOG_FUNCTION (this << rows);
+  m_chunkSize = std::max (rows, 1U);
+}
+
+uint32_t
+ColumnarAggregator::GetSeries (const std::string &context)
+{
+  NS_LOG_FUNCTION (this << context);
+  std::unordered_map<std::string, uint32_t>::const_iterator it = m_seriesIds.find (context);
+  if (it != m_seriesIds.end ())
+    {
+      return it->second;
+    }
+  uint32_t id = m_series.size ();
+  m_series.push_back (Series ());
+  m_series.back ().name = context;
+  m_seriesIds[context] = id;
+  return id;
+}
+
+Callback<void, double, double>
+ColumnarAggregator::GetSink (const std::string &context)
+{
+  NS_LOG_FUNCTION (this << context);
+  return MakeBoundCallback (&ColumnarAggregator::AddToSeries, this, GetSeries (context));
+}
+
+void
+ColumnarAggregator::AddToSeries (ColumnarAggregator *aggregator, uint32_t series, double time, double value)
+{
+  aggregator->Add (series, time, value);
+}
+
+void
+ColumnarAggregator::Add (uint32_t series, double time, double value)
+{
+  NS_LOG_FUNCTION (this << series << time << value);
+  NS_ASSERT (series < m_series.size ());
+
+  if (!m_enabled)
+    {
+      return;
+    }
+
+  Series &s = m_series[series];
+  if (m_binWidth > 0)
+    {
+      int64_t bin = static_cast<int64_t> (std::floor (time / m_binWidth));
+      if (s.binOpen && bin != s.bin)
+        {
+          CloseBin (s);
+        }
+      if (!s.binOpen)
+        {
+          s.binOpen = true;
+          s.bin = bin;
+          s.binSum = 0;
+          s.binMin = value;
+          s.binMax = value;
+          s.binCount = 0;
+        }
+      s.binSum += value;
+      s.binMin = std::min (s.binMin, value);
+      s.binMax = std::max (s.binMax, value);
+      s.binCount++;
+    }
+  else
+    {
+      s.time.push_back (time);
+      s.value.push_back (value);
+    }
+
+  if (s.time.size () >= m_chunkSize)
+    {
+      WriteChunk (series);
+    }
+}
+
+void
+ColumnarAggregator::Write1d (std::string context, double v1)
+{
+  NS_LOG_FUNCTION (this << context << v1);
+  Add (GetSeries (context), Simulator::Now ().GetSeconds (), v1);
+}
+
+void
+ColumnarAggregator::Write2d (std::string context, double v1, double v2)
+{
+  NS_LOG_FUNCTION (this << context << v1 << v2);
+  Add (GetSeries (context), v1, v2);
+}
+
+void
+ColumnarAggregator::CloseBin (Series &series)
+{
+  series.time.push_back (series.bin * m_binWidth);
+  series.value.push_back (series.binSum / series.binCount);
+  series.min.push_back (series.binMin);
+  series.max.push_back (series.binMax);
+  series.count.push_back (series.binCount);
+  series.binOpen = false;
+}
+
+void
+ColumnarAggregator::WriteHeader (void)
+{
+  if (!m_headerWritten)
+    {
+      m_file.write (COLUMNAR_MAGIC, sizeof (COLUMNAR_MAGIC));
+      m_file.write (reinterpret_cast<const char *> (&m_binWidth), sizeof (m_binWidth));
+      m_headerWritten = true;
+    }
+}
+
+void
+ColumnarAggregator::WriteChunk (uint32_t id)
+{
+  NS_LOG_FUNCTION (this << id);
+  Series &s = m_series[id];
+  if (s.time.empty ())
+    {
+      return;
+    }
+  WriteHeader ();
+
+  m_chunk.clear ();
+  if (!s.nameWritten)
+    {
+      AppendRaw (m_chunk, SERIES_RECORD);
+      AppendRaw (m_chunk, id);
+      AppendRaw<uint32_t> (m_chunk, s.name.size ());
+      m_chunk.append (s.name);
+      s.nameWritten = true;
+    }
+  AppendRaw (m_chunk, CHUNK_RECORD);
+  AppendRaw (m_chunk, id);
+  AppendRaw<uint32_t> (m_chunk, s.time.size ());
+  AppendColumn (m_chunk, s.time);
+  AppendColumn (m_chunk, s.value);
+  if (m_binWidth > 0)
+    {
+      AppendColumn (m_chunk, s.min);
+      AppendColumn (m_chunk, s.max);
+      for (std::vector<uint32_t>::const_iterator i = s.count.begin (); i != s.count.end (); i++)
+        {
+          AppendVarint (m_chunk, *i);
+        }
+    }
+  m_file.write (m_chunk.data (), m_chunk.size ());
+
+  s.time.clear ();
+  s.value.clear ();
+  s.min.clear ();
+  s.max.clear ();
+  s.count.clear ();
+}
+
+void
+ColumnarAggregator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  WriteHeader ();
+  for (uint32_t id = 0; id < m_series.size (); id++)
+    {
+      if (m_series[id].binOpen)
+        {
+          CloseBin (m_series[id]);
+        }
+      WriteChunk (id);
+    }
+  m_file.flush ();
+}
+
+bool
+ColumnarAggregator::PrintText (std::istream &is, std::ostream &os)
+{
+  NS_LOG_FUNCTION (&is << &os);
+  char magic[sizeof (COLUMNAR_MAGIC)];
+  double binWidth;
+  is.read (magic, sizeof (magic));
+  if (!is.good () || std::memcmp (magic, COLUMNAR_MAGIC, sizeof (magic)) != 0
+      || !ReadRaw (is, &binWidth))
+    {
+      return false;
+    }
+
+  std::vector<std::string> names;
+  std::vector<double> time;
+  std::vector<double> value;
+  std::vector<double> min;
+  std::vector<double> max;
+  std::vector<uint64_t> count;
+  uint8_t recordType;
+  while (ReadRaw (is, &recordType))
+    {
+      uint32_t id;
+      uint32_t size;
+      if (!ReadRaw (is, &id) || !ReadRaw (is, &size))
+        {
+          return false;
+        }
+      if (recordType == SERIES_RECORD)
+        {
+          if (id >= names.size ())
+            {
+              names.resize (id + 1);
+            }
+          names[id].resize (size);
+          if (size > 0)
+            {
+              is.read (&names[id][0], size);
+            }
+          continue;
+        }
+      if (recordType != CHUNK_RECORD || id >= names.size ()
+          || !ReadColumn (is, size, &time) || !ReadColumn (is, size, &value))
+        {
+          return false;
+        }
+      if (binWidth > 0)
+        {
+          if (!ReadColumn (is, size, &min) || !ReadColumn (is, size, &max))
+            {
+              return false;
+            }
+          count.resize (size);
+          for (uint32_t i = 0; i < size; i++)
+            {
+              if (!ReadVarint (is, &count[i]))
+                {
+                  return false;
+                }
+            }
+        }
+      for (uint32_t i = 0; i < size; i++)
+        {
+          os << names[id] << " " << time[i] << " " << value[i];
+          if (binWidth > 0)
+            {
+              os << " " << min[i] << " " << max[i] << " " << count[i];
+            }
+          os << std::endl;
+        }
+    }
+  return is.eof ();
+}
+
+} // namespace ns3
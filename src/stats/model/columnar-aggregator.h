@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COLUMNAR_AGGREGATOR_H
+#define COLUMNAR_AGGREGATOR_H
+
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "ns3/callback.h"
+#include "ns3/data-collection-object.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup aggregator
+ *
+ * This aggregator stores the time series it receives in a compact
+ * binary file.
+ *
+ * Each context is interned once as a series identifier, and the samples
+ * of a series are buffered in column arrays (one for the times, one for
+ * the values) rather than formatted as text.  When a series has buffered
+ * ChunkSize rows, its columns are compressed and written to the file as
+ * one chunk.  The series which still have rows are written when the
+ * aggregator is destroyed, or by Flush.
+ *
+ * When a bin width is set, the samples are downsampled on the fly: the
+ * samples of a series which fall in the same bin of time are reduced to
+ * a single row holding the start of the bin, the mean, the minimum and
+ * the maximum of the values, and the number of samples.
+ *
+ * The Write1d and Write2d trace sinks have the signature of those of
+ * FileAggregator, so that the aggregator can be connected to the same
+ * probes and adaptors.  They look the context up for every sample; the
+ * sinks returned by GetSink are bound to their series and avoid it.
+ *
+ * PrintText converts a file back to text, with one line per row.
+ *
+ * The file starts with the "NS3COLA1" magic string and the bin width, as
+ * a double.  It is followed by series records ('S', identifier, name
+ * length, name) and chunk records ('K', identifier, number of rows, then
+ * each column).  A column of doubles is compressed by XORing the bits of
+ * each value with those of the previous one and writing the number of
+ * trailing zero bytes of the result (0xff if the result is zero) followed
+ * by the remaining bytes as a variable length integer; the counts of
+ * samples are written as variable length integers.  All the values are
+ * written in the byte order of the host.
+ */
+class ColumnarAggregator : public DataCollectionObject
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \param outputFileName name of the file to write.
+   *
+   * Constructs a columnar aggregator that will create a file named
+   * outputFileName.
+   */
+  ColumnarAggregator (const std::string &outputFileName);
+
+  virtual ~ColumnarAggregator ();
+
+  /**
+   * \param width the width of the bins, in the unit of the times; 0 to
+   * disable downsampling.
+   *
+   * \brief Sets the width of the bins over which the samples are
+   * downsampled.  It must be set before the first sample is received.
+   */
+  void SetBinWidth (double width);
+
+  /**
+   * \param rows the number of rows of a chunk.
+   *
+   * \brief Sets the number of rows a series buffers before they are
+   * written to the file.
+   */
+  void SetChunkSize (uint32_t rows);
+
+  /**
+   * \param context the name of a series.
+   * \return the identifier of the series.
+   *
+   * \brief Gets the identifier of a series, which is created the first
+   * time its name is used.
+   */
+  uint32_t GetSeries (const std::string &context);
+
+  /**
+   * \param context the name of a series.
+   * \return a trace sink adding its (time, value) arguments to the series.
+   *
+   * \brief Gets a trace sink bound to a series, for the output of a
+   * TimeSeriesAdaptor for example.
+   */
+  Callback<void, double, double> GetSink (const std::string &context);
+
+  /**
+   * \param series the identifier of a series.
+   * \param time the time of the sample.
+   * \param value the value of the sample.
+   *
+   * \brief Adds a sample to a series.
+   */
+  void Add (uint32_t series, double time, double value);
+
+  /**
+   * \param context specifies the series.
+   * \param v1 the value of the sample.
+   *
+   * \brief Adds a sample, at the current simulation time in seconds, to
+   * the series named after the context.
+   */
+  void Write1d (std::string context, double v1);
+
+  /**
+   * \param context specifies the series.
+   * \param v1 the time of the sample.
+   * \param v2 the value of the sample.
+   *
+   * \brief Adds a sample to the series named after the context.
+   */
+  void Write2d (std::string context, double v1, double v2);
+
+  /**
+   * \brief Writes the buffered rows of all the series, including those of
+   * the current bins, to the file.
+   */
+  void Flush (void);
+
+  /**
+   * \param is the file written by a columnar aggregator.
+   * \param os the stream to print to.
+   * \return false if the input is not a valid file.
+   *
+   * \brief Prints the rows of a file as text.  Each line holds the name of
+   * the series, the time and the value, followed by the minimum, the
+   * maximum and the number of samples when the series is downsampled.
+   */
+  static bool PrintText (std::istream &is, std::ostream &os);
+
+private:
+  /// The columns of a series
+  struct Series
+  {
+    Series ();
+
+    std::string name;              //!< The name of the series
+    bool nameWritten;              //!< Whether the series record was written
+    std::vector<double> time;      //!< The times, or the start of the bins
+    std::vector<double> value;     //!< The values, or their mean over the bins
+    std::vector<double> min;       //!< The minimum of the values over the bins
+    std::vector<double> max;       //!< The maximum of the values over the bins
+    std::vector<uint32_t> count;   //!< The number of samples in the bins
+    bool binOpen;                  //!< Whether the current bin has samples
+    int64_t bin;                   //!< The index of the current bin
+    double binSum;                 //!< The sum of the values of the current bin
+    double binMin;                 //!< The minimum value of the current bin
+    double binMax;                 //!< The maximum value of the current bin
+    uint32_t binCount;             //!< The number of samples of the current bin
+  };
+
+  /**
+   * \param aggregator the aggregator.
+   * \param series the identifier of a series.
+   * \param time the time of the sample.
+   * \param value the value of the sample.
+   *
+   * \brief Trace sink bound to a series by GetSink.
+   */
+  static void AddToSeries (ColumnarAggregator *aggregator, uint32_t series, double time, double value);
+
+  /**
+   * \param series the series.
+   *
+   * \brief Closes the current bin of a series.
+   */
+  void CloseBin (Series &series);
+
+  /**
+   * \brief Writes the header of the file, if not done yet.
+   */
+  void WriteHeader (void);
+
+  /**
+   * \param id the identifier of the series.
+   *
+   * \brief Writes the buffered rows of a series and clears them.
+   */
+  void WriteChunk (uint32_t id);
+
+  std::string m_outputFileName;    //!< The output file name
+  std::ofstream m_file;            //!< The output file
+  bool m_headerWritten;            //!< Whether the file header was written
+  double m_binWidth;               //!< The width of the bins, or 0
+  uint32_t m_chunkSize;            //!< The number of rows of a chunk
+  std::vector<Series> m_series;    //!< The series, by identifier
+  /// The identifiers of the series, by name
+  std::unordered_map<std::string, uint32_t> m_seriesIds;
+  std::string m_chunk;             //!< The chunk being written
+
+}; // class ColumnarAggregator
+
+
+} // namespace ns3
+
+#endif // COLUMNAR_AGGREGATOR_H
@@ -36,6 +36,9 @@ NS_LOG_COMPONENT_DEFINE ("SqliteDataOutput");
 //--------------------------------------------------------------
 //----------------------------------------------
 SqliteDataOutput::SqliteDataOutput()
+  : m_db (0),
+    m_insertTimeSeriesStatement (0),
+    m_firstTimeSeriesRow (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -61,6 +64,8 @@ SqliteDataOutput::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  // the time series values not followed by a run are discarded
+  Close (false);
   DataOutputInterface::DoDispose ();
   // end SqliteDataOutput::DoDispose
 }
@@ -116,12 +121,8 @@ SqliteDataOutput::Output (DataCollector &dc)
 {
   NS_LOG_FUNCTION (this << &dc);
 
-  std::string m_dbFile = m_filePrefix + ".db";
-
-  if (sqlite3_open (m_dbFile.c_str (), &m_db)) {
-      NS_LOG_ERROR ("Could not open sqlite3 database \"" << m_dbFile << "\"");
-      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
-      sqlite3_close (m_db);
+  if (!Open ())
+    {
       /// \todo Better error reporting, management!
       return;
     }
@@ -172,17 +173,130 @@ SqliteDataOutput::Output (DataCollector &dc)
     }
   sqlite3_finalize (stmt);
 
-  Exec ("BEGIN");
-  SqliteOutputCallback callback (this, run);
-  for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
-       i != dc.DataCalculatorEnd (); i++) {
-      (*i)->Output (callback);
+  {
+    // the statement of the callback is finalized before closing the database
+    SqliteOutputCallback callback (this, run);
+    for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
+         i != dc.DataCalculatorEnd (); i++) {
+        (*i)->Output (callback);
+      }
+  }
+  OutputTimeSeries (run);
+  Close (true);
+
+  // end SqliteDataOutput::Output
+}
+
+bool
+SqliteDataOutput::Open (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_db != 0)
+    {
+      return true;
+    }
+
+  std::string dbFile = m_filePrefix + ".db";
+  if (sqlite3_open (dbFile.c_str (), &m_db)) {
+      NS_LOG_ERROR ("Could not open sqlite3 database \"" << dbFile << "\"");
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
+      sqlite3_close (m_db);
+      m_db = 0;
+      return false;
     }
-  Exec ("COMMIT");
 
+  // The whole run is written in a single transaction; in write-ahead log
+  // mode, the commit only has to sync the log.
+  Exec ("PRAGMA journal_mode=WAL");
+  Exec ("PRAGMA synchronous=NORMAL");
+  Exec ("BEGIN");
+  return true;
+}
+
+void
+SqliteDataOutput::Close (bool commit)
+{
+  NS_LOG_FUNCTION (this << commit);
+
+  if (m_db == 0)
+    {
+      return;
+    }
+  if (m_insertTimeSeriesStatement != 0)
+    {
+      sqlite3_finalize (m_insertTimeSeriesStatement);
+      m_insertTimeSeriesStatement = 0;
+    }
+  m_firstTimeSeriesRow = 0;
+  Exec (commit ? "COMMIT" : "ROLLBACK");
   sqlite3_close (m_db);
+  m_db = 0;
+}
 
-  // end SqliteDataOutput::Output
+void
+SqliteDataOutput::Write2d (std::string context, double time, double value)
+{
+  NS_LOG_FUNCTION (this << context << time << value);
+
+  if (!Open ())
+    {
+      return;
+    }
+  if (m_insertTimeSeriesStatement == 0)
+    {
+      Exec ("create table if not exists TimeSeries (run text, name text, time real, value real)");
+      sqlite3_prepare_v2 (m_db,
+        "insert into TimeSeries (name, time, value) values (?, ?, ?)",
+        -1,
+        &m_insertTimeSeriesStatement,
+        NULL
+      );
+    }
+
+  // the run is only known when it is written: the rows are labelled then
+  sqlite3_reset (m_insertTimeSeriesStatement);
+  sqlite3_bind_text (m_insertTimeSeriesStatement, 1, context.c_str (), context.length (), SQLITE_TRANSIENT);
+  sqlite3_bind_double (m_insertTimeSeriesStatement, 2, time);
+  sqlite3_bind_double (m_insertTimeSeriesStatement, 3, value);
+  if (sqlite3_step (m_insertTimeSeriesStatement) != SQLITE_DONE)
+    {
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
+      return;
+    }
+  if (m_firstTimeSeriesRow == 0)
+    {
+      m_firstTimeSeriesRow = sqlite3_last_insert_rowid (m_db);
+    }
+}
+
+void
+SqliteDataOutput::OutputTimeSeries (std::string run)
+{
+  NS_LOG_FUNCTION (this << run);
+
+  if (m_firstTimeSeriesRow == 0)
+    {
+      return;
+    }
+
+  // the row IDs of the values inserted since the last run follow the
+  // first one, so the update does not scan the older runs
+  sqlite3_stmt *stmt;
+  sqlite3_prepare_v2 (m_db,
+    "update TimeSeries set run = ? where rowid >= ?",
+    -1,
+    &stmt,
+    NULL
+  );
+  sqlite3_bind_text (stmt, 1, run.c_str (), run.length (), SQLITE_TRANSIENT);
+  sqlite3_bind_int64 (stmt, 2, m_firstTimeSeriesRow);
+  if (sqlite3_step (stmt) != SQLITE_DONE)
+    {
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
+    }
+  sqlite3_finalize (stmt);
+  m_firstTimeSeriesRow = 0;
 }
 
 SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
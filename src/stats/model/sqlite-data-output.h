@@ -37,6 +37,24 @@ namespace ns3 {
  * \ingroup dataoutput
  * \class SqliteDataOutput
  * \brief Outputs data in a format compatible with SQLite
+ *
+ * All the rows of a run are written in a single transaction, with
+ * prepared statements reused for every row, to a database in write-ahead
+ * log mode.
+ *
+ * Besides the DataCollector output, time series can be stored directly
+ * in the database: the values received by the Write2d trace sink, which
+ * matches the output of a TimeSeriesAdaptor, are inserted in the
+ * TimeSeries table as they are received, in the transaction of the next
+ * run written by Output, which labels them with that run.  The database
+ * is opened, and the transaction started, by the first value; the values
+ * are discarded if the object is disposed before the run is written.
+ *
+ * \code
+ *   Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+ *   adaptor->TraceConnect ("Output", "PacketBytes",
+ *                          MakeCallback (&SqliteDataOutput::Write2d, output));
+ * \endcode
  */
 class SqliteDataOutput : public DataOutputInterface {
 public:
@@ -51,6 +69,19 @@ public:
   
   virtual void Output (DataCollector &dc);
 
+  /**
+   * \brief Insert a value of a time series in the TimeSeries table, to be
+   * committed with the next run.
+   * \param context the name of the time series
+   * \param time the time, in seconds
+   * \param value the value
+   *
+   * The signature of this trace sink matches the output of a
+   * TimeSeriesAdaptor, when connected with a context, and the Write2d
+   * method of the FileAggregator.
+   */
+  void Write2d (std::string context, double time, double value);
+
 protected:
   virtual void DoDispose ();
 
@@ -143,7 +174,27 @@ private:
   };
 
 
-  sqlite3 *m_db; //!< pointer to the SQL database
+  sqlite3 *m_db; //!< pointer to the SQL database, or 0 if closed
+  sqlite3_stmt *m_insertTimeSeriesStatement; //!< Prepared time series insert statement
+  sqlite3_int64 m_firstTimeSeriesRow; //!< Row ID of the first time series value without run, or 0
+
+  /**
+   * \brief Open the database and start a transaction, unless already done.
+   * \return false if the database could not be opened
+   */
+  bool Open (void);
+
+  /**
+   * \brief End the transaction and close the database, if open.
+   * \param commit whether to commit the transaction rather than roll it back
+   */
+  void Close (bool commit);
+
+  /**
+   * \brief Label the time series values inserted since the last run.
+   * \param run the run label
+   */
+  void OutputTimeSeries (std::string run);
 
   /**
    * \brief Execute a sqlite3 query
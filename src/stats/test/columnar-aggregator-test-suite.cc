@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/columnar-aggregator.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for samples written in several chunks.
+// ===========================================================================
+
+class ColumnarAggregatorChunksTestCase : public TestCase
+{
+public:
+  ColumnarAggregatorChunksTestCase ();
+  virtual ~ColumnarAggregatorChunksTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ColumnarAggregatorChunksTestCase::ColumnarAggregatorChunksTestCase ()
+  : TestCase ("Write two series in several chunks")
+{
+}
+
+ColumnarAggregatorChunksTestCase::~ColumnarAggregatorChunksTestCase ()
+{
+}
+
+void
+ColumnarAggregatorChunksTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("columnar-chunks.dat");
+  std::ostringstream expected;
+
+  Ptr<ColumnarAggregator> aggregator = CreateObject<ColumnarAggregator> (fileName);
+  aggregator->SetChunkSize (3);
+  Callback<void, double, double> sink = aggregator->GetSink ("/Names/B");
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      aggregator->Write2d ("/Names/A", i * 0.5, 10 - i);
+      sink (i * 0.25, 1000);
+    }
+  // the first chunks of both series, then what was left at the
+  // destruction, in the order the series were created
+  expected << "/Names/A 0 10\n/Names/A 0.5 9\n/Names/A 1 8\n";
+  expected << "/Names/B 0 1000\n/Names/B 0.25 1000\n/Names/B 0.5 1000\n";
+  expected << "/Names/B 0.75 1000\n/Names/B 1 1000\n";
+  expected << "/Names/A 1.5 7\n/Names/A 2 6\n";
+  aggregator = 0;
+
+  std::ifstream is (fileName.c_str (), std::ios::binary);
+  std::ostringstream text;
+  NS_TEST_ASSERT_MSG_EQ (ColumnarAggregator::PrintText (is, text), true, "Invalid file");
+  NS_TEST_EXPECT_MSG_EQ (text.str (), expected.str (), "Unexpected rows");
+}
+
+// ===========================================================================
+// Test case for downsampled samples.
+// ===========================================================================
+
+class ColumnarAggregatorBinsTestCase : public TestCase
+{
+public:
+  ColumnarAggregatorBinsTestCase ();
+  virtual ~ColumnarAggregatorBinsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ColumnarAggregatorBinsTestCase::ColumnarAggregatorBinsTestCase ()
+  : TestCase ("Downsample a series over bins")
+{
+}
+
+ColumnarAggregatorBinsTestCase::~ColumnarAggregatorBinsTestCase ()
+{
+}
+
+void
+ColumnarAggregatorBinsTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("columnar-bins.dat");
+
+  Ptr<ColumnarAggregator> aggregator = CreateObject<ColumnarAggregator> (fileName);
+  aggregator->SetBinWidth (1.0);
+  uint32_t series = aggregator->GetSeries ("Delay");
+  aggregator->Add (series, 0.1, 1);
+  aggregator->Add (series, 0.5, 3);
+  aggregator->Add (series, 1.2, 5);
+  aggregator->Add (series, 2.5, 2);
+  aggregator->Add (series, 2.75, 4);
+  aggregator->Flush ();
+
+  std::ifstream is (fileName.c_str (), std::ios::binary);
+  std::ostringstream text;
+  NS_TEST_ASSERT_MSG_EQ (ColumnarAggregator::PrintText (is, text), true, "Invalid file");
+  NS_TEST_EXPECT_MSG_EQ (text.str (), "Delay 0 2 1 3 2\nDelay 1 5 5 5 1\nDelay 2 3 2 4 2\n",
+                         "Unexpected bins");
+}
+
+
+class ColumnarAggregatorTestSuite : public TestSuite
+{
+public:
+  ColumnarAggregatorTestSuite ();
+};
+
+ColumnarAggregatorTestSuite::ColumnarAggregatorTestSuite ()
+  : TestSuite ("columnar-aggregator", UNIT)
+{
+  AddTestCase (new ColumnarAggregatorChunksTestCase, TestCase::QUICK);
+  AddTestCase (new ColumnarAggregatorBinsTestCase, TestCase::QUICK);
+}
+
+static ColumnarAggregatorTestSuite columnarAggregatorTestSuite;
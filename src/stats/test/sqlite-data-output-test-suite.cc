@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sqlite3.h>
+
+#include "ns3/test.h"
+#include "ns3/data-collector.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/sqlite-data-output.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for the rows written by two runs.
+// ===========================================================================
+
+class SqliteDataOutputTestCase : public TestCase
+{
+public:
+  SqliteDataOutputTestCase ();
+  virtual ~SqliteDataOutputTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run a query returning a single number.
+   * \param db the database
+   * \param query the query
+   * \return the number
+   */
+  double Query (sqlite3 *db, std::string query);
+};
+
+SqliteDataOutputTestCase::SqliteDataOutputTestCase ()
+  : TestCase ("Write two runs with singletons and time series")
+{
+}
+
+SqliteDataOutputTestCase::~SqliteDataOutputTestCase ()
+{
+}
+
+double
+SqliteDataOutputTestCase::Query (sqlite3 *db, std::string query)
+{
+  sqlite3_stmt *stmt;
+  double value = -1;
+  if (sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, NULL) == SQLITE_OK)
+    {
+      if (sqlite3_step (stmt) == SQLITE_ROW)
+        {
+          value = sqlite3_column_double (stmt, 0);
+        }
+      sqlite3_finalize (stmt);
+    }
+  return value;
+}
+
+void
+SqliteDataOutputTestCase::DoRun (void)
+{
+  std::string prefix = CreateTempDirFilename ("sqlite-data-output");
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetFilePrefix (prefix);
+
+  for (uint32_t run = 0; run < 2; run++)
+    {
+      DataCollector data;
+      data.DescribeRun ("experiment", "strategy", "input", run == 0 ? "run-0" : "run-1");
+      data.AddMetadata ("author", "tester");
+
+      Ptr<CounterCalculator<uint32_t> > counter = CreateObject<CounterCalculator<uint32_t> > ();
+      counter->SetKey ("packets");
+      counter->SetContext ("node[0]");
+      counter->Update (10 + run);
+      data.AddDataCalculator (counter);
+
+      for (uint32_t i = 0; i < 100; i++)
+        {
+          output->Write2d ("Throughput", i * 0.1, i + run);
+        }
+      output->Write2d ("Delay", 1.0, 0.5);
+      output->Output (data);
+    }
+
+  sqlite3 *db;
+  NS_TEST_ASSERT_MSG_EQ (sqlite3_open ((prefix + ".db").c_str (), &db), SQLITE_OK, "Could not open the database");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from Experiments"), 2, "Wrong number of runs");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from Metadata"), 2, "Wrong number of metadata");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select value from Singletons where run = 'run-1' and name = 'node[0]' and variable = 'packets'"), 11,
+                         "Wrong singleton value");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from TimeSeries"), 202, "Wrong number of time series values");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from TimeSeries where run is null"), 0,
+                         "Time series values without run");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from TimeSeries where run = 'run-1' and name = 'Throughput'"), 5050,
+                         "Wrong time series values");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select time from TimeSeries where run = 'run-0' and name = 'Delay'"), 1.0,
+                         "Wrong time series time");
+  sqlite3_close (db);
+}
+
+class SqliteDataOutputTestSuite : public TestSuite
+{
+public:
+  SqliteDataOutputTestSuite ();
+};
+
+SqliteDataOutputTestSuite::SqliteDataOutputTestSuite ()
+  : TestSuite ("sqlite-data-output", UNIT)
+{
+  AddTestCase (new SqliteDataOutputTestCase, TestCase::QUICK);
+}
+
+static SqliteDataOutputTestSuite sqliteDataOutputTestSuite;
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/*
+ * Benchmark of the FqCoDel queue disc with many concurrent flows.
+ *
+ * Packets belonging to a configurable number of flows (i.e., IPv4 packets
+ * having distinct destination addresses) are enqueued in a FqCoDel queue
+ * disc in a round robin fashion and then dequeued, for a number of rounds.
+ * Every round is performed at a different simulation time, so that CoDel
+ * operates as usual. The benchmark is run twice, first with flows stored in
+ * classes having a CoDel child queue disc (the default) and then with flows
+ * stored in the flow table (UseFlowTable attribute set to true). The wall
+ * clock time taken by each run is printed.
+ *
+ * Usage:
+ *
+ *   ./waf --run "fq-codel-flows-benchmark --flows=4096 --packetsPerFlow=4 --rounds=50"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/traffic-control-module.h"
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("FqCoDelFlowsBenchmark");
+
+/**
+ * Run the benchmark
+ * \param useFlowTable whether flows are stored in the flow table
+ * \param flows the number of flows
+ * \param packetsPerFlow the number of packets per flow enqueued at each round
+ * \param rounds the number of rounds
+ * \return the number of packets dequeued
+ */
+static uint64_t
+RunBenchmark (bool useFlowTable, uint32_t flows, uint32_t packetsPerFlow, uint32_t rounds)
+{
+  Ptr<FqCoDelQueueDisc> queueDisc = CreateObjectWithAttributes<FqCoDelQueueDisc> ("Flows", UintegerValue (flows),
+                                                                                    "PacketLimit", UintegerValue (flows * packetsPerFlow + 1),
+                                                                                    "UseFlowTable", BooleanValue (useFlowTable));
+  queueDisc->AddPacketFilter (CreateObject<FqCoDelIpv4PacketFilter> ());
+  queueDisc->SetQuantum (1500);
+  queueDisc->Initialize ();
+
+  Ipv4Header hdr;
+  hdr.SetPayloadSize (1000);
+  hdr.SetSource (Ipv4Address ("10.0.0.1"));
+  hdr.SetProtocol (17);
+  Address dest;
+
+  uint64_t dequeued = 0;
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      Simulator::Stop (MilliSeconds (1));
+      Simulator::Run ();
+
+      for (uint32_t p = 0; p < packetsPerFlow; p++)
+        {
+          for (uint32_t f = 0; f < flows; f++)
+            {
+              hdr.SetDestination (Ipv4Address (0x0b000000 + f));
+              queueDisc->Enqueue (Create<Ipv4QueueDiscItem> (Create<Packet> (1000), dest, 0, hdr));
+            }
+        }
+      while (queueDisc->Dequeue ())
+        {
+          dequeued++;
+        }
+    }
+
+  Simulator::Destroy ();
+  return dequeued;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t flows = 1024;
+  uint32_t packetsPerFlow = 4;
+  uint32_t rounds = 50;
+
+  CommandLine cmd;
+  cmd.AddValue ("flows", "Number of concurrent flows", flows);
+  cmd.AddValue ("packetsPerFlow", "Number of packets per flow enqueued at each round", packetsPerFlow);
+  cmd.AddValue ("rounds", "Number of rounds", rounds);
+  cmd.Parse (argc, argv);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      bool useFlowTable = (i == 1);
+      SystemWallClockMs clock;
+      clock.Start ();
+      uint64_t dequeued = RunBenchmark (useFlowTable, flows, packetsPerFlow, rounds);
+      int64_t elapsed = clock.End ();
+      std::cout << (useFlowTable ? "flow table: " : "classes:    ")
+                << flows << " flows, " << dequeued << " packets dequeued in "
+                << elapsed << " ms" << std::endl;
+    }
+
+  return 0;
+}
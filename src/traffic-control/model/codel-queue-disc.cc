@@ -39,32 +39,88 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("CoDelQueueDisc");
 
 /**
- * Performs a reciprocal divide, similar to the
- * Linux kernel reciprocal_divide function
- * \param A numerator
- * \param R reciprocal of the denominator B
- * \return the value of A/B
+ * \brief The internal queue of a CoDelQueueDisc, as used by CoDelDequeue
  */
-/* borrowed from the linux kernel */
-static inline uint32_t ReciprocalDivide (uint32_t A, uint32_t R)
+class CoDelQueueDisc::InternalQueueOps
 {
-  return (uint32_t)(((uint64_t)A * R) >> 32);
-}
-
-/* end kernel borrowings */
+public:
+  /**
+   * \brief Constructor
+   * \param qd the CoDel queue disc
+   */
+  InternalQueueOps (CoDelQueueDisc *qd)
+    : m_qd (qd)
+  {
+  }
+  /**
+   * \brief Remove the packet at the head of the internal queue
+   * \return the removed packet, or 0 if the queue is empty
+   */
+  Ptr<QueueDiscItem> Pop (void)
+  {
+    Ptr<QueueDiscItem> item = m_qd->GetInternalQueue (0)->Dequeue ();
+    if (item)
+      {
+        NS_LOG_LOGIC ("Popped " << item);
+        NS_LOG_LOGIC ("Number packets remaining " << m_qd->GetInternalQueue (0)->GetNPackets ());
+        NS_LOG_LOGIC ("Number bytes remaining " << m_qd->GetInternalQueue (0)->GetNBytes ());
+      }
+    else
+      {
+        NS_LOG_LOGIC ("Queue empty");
+      }
+    return item;
+  }
+  /**
+   * \return the number of bytes in the internal queue
+   */
+  uint32_t GetNBytes (void)
+  {
+    return m_qd->GetInternalQueue (0)->GetNBytes ();
+  }
+  /**
+   * \brief Drop a packet whose sojourn time exceeded the target
+   * \param item the packet
+   */
+  void Drop (Ptr<QueueDiscItem> item)
+  {
+    NS_LOG_LOGIC ("Sojourn time is above target; dropping " << item);
+    m_qd->DropAfterDequeue (item, TARGET_EXCEEDED_DROP);
+  }
+
+private:
+  CoDelQueueDisc *m_qd;  //!< the CoDel queue disc
+};
 
 /**
- * Returns the current time translated in CoDel time representation
- * \return the current time
+ * \brief The CoDel state of a CoDelQueueDisc, as used by CoDelDequeue
+ *
+ * The members refer to those of the queue disc, so that the traced values
+ * fire their trace sources when CoDelDequeue updates them.
  */
-static uint32_t CoDelGetTime (void)
+struct CoDelQueueDisc::TracedState
 {
-  Time time = Simulator::Now ();
-  uint64_t ns = time.GetNanoSeconds ();
-
-  return ns >> CODEL_SHIFT;
-}
-
+  /**
+   * \brief Constructor
+   * \param qd the CoDel queue disc
+   */
+  TracedState (CoDelQueueDisc *qd)
+    : count (qd->m_count),
+      lastCount (qd->m_lastCount),
+      dropping (qd->m_dropping),
+      recInvSqrt (qd->m_recInvSqrt),
+      firstAboveTime (qd->m_firstAboveTime),
+      dropNext (qd->m_dropNext)
+  {
+  }
+
+  TracedValue<uint32_t> &count;      //!< Number of packets dropped since entering drop state
+  TracedValue<uint32_t> &lastCount;  //!< Last number of packets dropped since entering drop state
+  TracedValue<bool> &dropping;       //!< True if in dropping state
+  uint16_t &recInvSqrt;              //!< Reciprocal inverse square root
+  uint32_t &firstAboveTime;          //!< Time to declare sojourn time above target
+  TracedValue<uint32_t> &dropNext;   //!< Time to drop next packet
+};
 
 NS_OBJECT_ENSURE_REGISTERED (CoDelQueueDisc);
 
@@ -134,11 +190,7 @@ CoDelQueueDisc::CoDelQueueDisc ()
     m_dropping (false),
     m_recInvSqrt (~0U >> REC_INV_SQRT_SHIFT),
     m_firstAboveTime (0),
-    m_dropNext (0),
-    m_state1 (0),
-    m_state2 (0),
-    m_state3 (0),
-    m_states (0)
+    m_dropNext (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -152,20 +204,14 @@ void
 CoDelQueueDisc::NewtonStep (void)
 {
   NS_LOG_FUNCTION (this);
-  uint32_t invsqrt = ((uint32_t) m_recInvSqrt) << REC_INV_SQRT_SHIFT;
-  uint32_t invsqrt2 = ((uint64_t) invsqrt * invsqrt) >> 32;
-  uint64_t val = (3ll << 32) - ((uint64_t) m_count * invsqrt2);
-
-  val >>= 2; /* avoid overflow */
-  val = (val * invsqrt) >> (32 - 2 + 1);
-  m_recInvSqrt = val >> REC_INV_SQRT_SHIFT;
+  m_recInvSqrt = CoDelNewtonStep (m_count, m_recInvSqrt);
 }
 
 uint32_t
 CoDelQueueDisc::ControlLaw (uint32_t t)
 {
   NS_LOG_FUNCTION (this);
-  return t + ReciprocalDivide (Time2CoDel (m_interval), m_recInvSqrt << REC_INV_SQRT_SHIFT);
+  return CoDelControlLaw (t, Time2CoDel (m_interval), m_recInvSqrt);
 }
 
 void
@@ -212,168 +258,19 @@ CoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
   return retval;
 }
 
-bool
-CoDelQueueDisc::OkToDrop (Ptr<QueueDiscItem> item, uint32_t now)
-{
-  NS_LOG_FUNCTION (this);
-  bool okToDrop;
-
-  if (!item)
-    {
-      m_firstAboveTime = 0;
-      return false;
-    }
-
-  Time delta = Simulator::Now () - item->GetTimeStamp ();
-  NS_LOG_INFO ("Sojourn time " << delta.ToDouble (Time::MS) << "ms");
-  uint32_t sojournTime = Time2CoDel (delta);
-
-  if (CoDelTimeBefore (sojournTime, Time2CoDel (m_target))
-      || GetInternalQueue (0)->GetNBytes () < m_minBytes)
-    {
-      // went below so we'll stay below for at least q->interval
-      NS_LOG_LOGIC ("Sojourn time is below target or number of bytes in queue is less than minBytes; packet should not be dropped");
-      m_firstAboveTime = 0;
-      return false;
-    }
-  okToDrop = false;
-  if (m_firstAboveTime == 0)
-    {
-      /* just went above from below. If we stay above
-       * for at least q->interval we'll say it's ok to drop
-       */
-      NS_LOG_LOGIC ("Sojourn time has just gone above target from below, need to stay above for at least q->interval before packet can be dropped. ");
-      m_firstAboveTime = now + Time2CoDel (m_interval);
-    }
-  else if (CoDelTimeAfter (now, m_firstAboveTime))
-    {
-      NS_LOG_LOGIC ("Sojourn time has been above target for at least q->interval; it's OK to (possibly) drop packet.");
-      okToDrop = true;
-      ++m_state1;
-    }
-  return okToDrop;
-}
-
 Ptr<QueueDiscItem>
 CoDelQueueDisc::DoDequeue (void)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<QueueDiscItem> item = GetInternalQueue (0)->Dequeue ();
-  if (!item)
-    {
-      // Leave dropping state when queue is empty
-      m_dropping = false;
-      NS_LOG_LOGIC ("Queue empty");
-      return 0;
-    }
-  uint32_t now = CoDelGetTime ();
-
-  NS_LOG_LOGIC ("Popped " << item);
-  NS_LOG_LOGIC ("Number packets remaining " << GetInternalQueue (0)->GetNPackets ());
-  NS_LOG_LOGIC ("Number bytes remaining " << GetInternalQueue (0)->GetNBytes ());
-
-  // Determine if item should be dropped
-  bool okToDrop = OkToDrop (item, now);
+  CoDelParameters params;
+  params.target = Time2CoDel (m_target);
+  params.interval = Time2CoDel (m_interval);
+  params.minBytes = m_minBytes;
 
-  if (m_dropping)
-    { // In the dropping state (sojourn time has gone above target and hasn't come down yet)
-      // Check if we can leave the dropping state or next drop should occur
-      NS_LOG_LOGIC ("In dropping state, check if it's OK to leave or next drop should occur");
-      if (!okToDrop)
-        {
-          /* sojourn time fell below target - leave dropping state */
-          NS_LOG_LOGIC ("Sojourn time goes below target, it's OK to leave dropping state.");
-          m_dropping = false;
-        }
-      else if (CoDelTimeAfterEq (now, m_dropNext))
-        {
-          m_state2++;
-          while (m_dropping && CoDelTimeAfterEq (now, m_dropNext))
-            {
-              // It's time for the next drop. Drop the current packet and
-              // dequeue the next. The dequeue might take us out of dropping
-              // state. If not, schedule the next drop.
-              // A large amount of packets in queue might result in drop
-              // rates so high that the next drop should happen now,
-              // hence the while loop.
-              NS_LOG_LOGIC ("Sojourn time is still above target and it's time for next drop; dropping " << item);
-              DropAfterDequeue (item, TARGET_EXCEEDED_DROP);
-
-              ++m_count;
-              NewtonStep ();
-              item = GetInternalQueue (0)->Dequeue ();
-
-              if (item)
-                {
-                  NS_LOG_LOGIC ("Popped " << item);
-                  NS_LOG_LOGIC ("Number packets remaining " << GetInternalQueue (0)->GetNPackets ());
-                  NS_LOG_LOGIC ("Number bytes remaining " << GetInternalQueue (0)->GetNBytes ());
-                }
-
-              if (!OkToDrop (item, now))
-                {
-                  /* leave dropping state */
-                  NS_LOG_LOGIC ("Leaving dropping state");
-                  m_dropping = false;
-                }
-              else
-                {
-                  /* schedule the next drop */
-                  NS_LOG_LOGIC ("Running ControlLaw for input m_dropNext: " << (double)m_dropNext / 1000000);
-                  m_dropNext = ControlLaw (m_dropNext);
-                  NS_LOG_LOGIC ("Scheduled next drop at " << (double)m_dropNext / 1000000);
-                }
-            }
-        }
-    }
-  else
-    {
-      // Not in the dropping state
-      // Decide if we have to enter the dropping state and drop the first packet
-      NS_LOG_LOGIC ("Not in dropping state; decide if we have to enter the state and drop the first packet");
-      if (okToDrop)
-        {
-          // Drop the first packet and enter dropping state unless the queue is empty
-          NS_LOG_LOGIC ("Sojourn time goes above target, dropping the first packet " << item << " and entering the dropping state");
-          DropAfterDequeue (item, TARGET_EXCEEDED_DROP);
-
-          item = GetInternalQueue (0)->Dequeue ();
-
-          if (item)
-            {
-              NS_LOG_LOGIC ("Popped " << item);
-              NS_LOG_LOGIC ("Number packets remaining " << GetInternalQueue (0)->GetNPackets ());
-              NS_LOG_LOGIC ("Number bytes remaining " << GetInternalQueue (0)->GetNBytes ());
-            }
-
-          OkToDrop (item, now);
-          m_dropping = true;
-          ++m_state3;
-          /*
-           * if min went above target close to when we last went below it
-           * assume that the drop rate that controlled the queue on the
-           * last cycle is a good starting point to control it now.
-           */
-          int delta = m_count - m_lastCount;
-          if (delta > 1 && CoDelTimeBefore (now - m_dropNext, 16 * Time2CoDel (m_interval)))
-            {
-              m_count = delta;
-              NewtonStep ();
-            }
-          else
-            {
-              m_count = 1;
-              m_recInvSqrt = ~0U >> REC_INV_SQRT_SHIFT;
-            }
-          m_lastCount = m_count;
-          NS_LOG_LOGIC ("Running ControlLaw for input now: " << (double)now);
-          m_dropNext = ControlLaw (now);
-          NS_LOG_LOGIC ("Scheduled next drop at " << (double)m_dropNext / 1000000 << " now " << (double)now / 1000000);
-        }
-    }
-  ++m_states;
-  return item;
+  TracedState state (this);
+  InternalQueueOps queue (this);
+  return CoDelDequeue (state, params, queue);
 }
 
 uint32_t
@@ -431,34 +328,10 @@ CoDelQueueDisc::DoPeek (void) const
   return item;
 }
 
-bool
-CoDelQueueDisc::CoDelTimeAfter (uint32_t a, uint32_t b)
-{
-  return  ((int)(a) - (int)(b) > 0);
-}
-
-bool
-CoDelQueueDisc::CoDelTimeAfterEq (uint32_t a, uint32_t b)
-{
-  return ((int)(a) - (int)(b) >= 0);
-}
-
-bool
-CoDelQueueDisc::CoDelTimeBefore (uint32_t a, uint32_t b)
-{
-  return  ((int)(a) - (int)(b) < 0);
-}
-
-bool
-CoDelQueueDisc::CoDelTimeBeforeEq (uint32_t a, uint32_t b)
-{
-  return ((int)(a) - (int)(b) <= 0);
-}
-
 uint32_t
 CoDelQueueDisc::Time2CoDel (Time t)
 {
-  return (t.GetNanoSeconds () >> CODEL_SHIFT);
+  return CoDelTime (t);
 }
 
 bool
@@ -34,21 +34,14 @@
 #include "ns3/string.h"
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
+#include "codel-algorithm.h"
 
 class CoDelQueueDiscNewtonStepTest;  // Forward declaration for unit test
 class CoDelQueueDiscControlLawTest;  // Forward declaration for unit test
 
 namespace ns3 {
 
-/**
- * Number of bits discarded from the time representation.
- * The time is assumed to be in nanoseconds.
- */
-static const int  CODEL_SHIFT = 10;
-
 #define DEFAULT_CODEL_LIMIT 1000
-#define REC_INV_SQRT_BITS (8 * sizeof(uint16_t))
-#define REC_INV_SQRT_SHIFT (32 - REC_INV_SQRT_BITS)
 
 class TraceContainer;
 
@@ -176,45 +169,6 @@ private:
    */
   uint32_t ControlLaw (uint32_t t);
 
-  /**
-   * \brief Determine whether a packet is OK to be dropped. The packet
-   * may not be actually dropped (depending on the drop state)
-   *
-   * \param item The packet that is considered
-   * \param now The current time represented as 32-bit unsigned integer (us)
-   * \returns True if it is OK to drop the packet (sojourn time above target for at least interval)
-   */
-  bool OkToDrop (Ptr<QueueDiscItem> item, uint32_t now);
-
-  /**
-   * Check if CoDel time a is successive to b
-   * @param a left operand
-   * @param b right operand
-   * @return true if a is greater than b
-   */
-  bool CoDelTimeAfter (uint32_t a, uint32_t b);
-  /**
-   * Check if CoDel time a is successive or equal to b
-   * @param a left operand
-   * @param b right operand
-   * @return true if a is greater than or equal to b
-   */
-  bool CoDelTimeAfterEq (uint32_t a, uint32_t b);
-  /**
-   * Check if CoDel time a is preceding b
-   * @param a left operand
-   * @param b right operand
-   * @return true if a is less than to b
-   */
-  bool CoDelTimeBefore (uint32_t a, uint32_t b);
-  /**
-   * Check if CoDel time a is preceding or equal to b
-   * @param a left operand
-   * @param b right operand
-   * @return true if a is less than or equal to b
-   */
-  bool CoDelTimeBeforeEq (uint32_t a, uint32_t b);
-
   /**
    * Return the unsigned 32-bit integer representation of the input Time
    * object. Units are microseconds
@@ -225,6 +179,9 @@ private:
 
   virtual void InitializeParams (void);
 
+  class InternalQueueOps;  //!< The internal queue, as seen by CoDelDequeue
+  struct TracedState;      //!< The traced CoDel state, as seen by CoDelDequeue
+
   uint32_t m_maxPackets;                  //!< Max # of packets accepted by the queue
   uint32_t m_maxBytes;                    //!< Max # of bytes accepted by the queue
   uint32_t m_minBytes;                    //!< Minimum bytes in queue to allow a packet drop
@@ -236,10 +193,6 @@ private:
   uint16_t m_recInvSqrt;                  //!< Reciprocal inverse square root
   uint32_t m_firstAboveTime;              //!< Time to declare sojourn time above target
   TracedValue<uint32_t> m_dropNext;       //!< Time to drop next packet
-  uint32_t m_state1;                      //!< Number of times packet sojourn goes above target for interval
-  uint32_t m_state2;                      //!< Number of times we perform next drop while in dropping state
-  uint32_t m_state3;                      //!< Number of times we enter drop state and drop the fist packet
-  uint32_t m_states;                      //!< Total number of times we are in state 1, state 2, or state 3
   QueueDiscMode m_mode;                   //!< The operating mode (Bytes or packets)
 };
 
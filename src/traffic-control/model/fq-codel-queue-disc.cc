@@ -25,11 +25,62 @@
 #include "fq-codel-queue-disc.h"
 #include "codel-queue-disc.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/unused.h"
+#include <algorithm>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("FqCoDelQueueDisc");
 
+/**
+ * \brief A flow slot of the flow table, as used by CoDelDequeue
+ */
+class FqCoDelQueueDisc::FlowSlotOps
+{
+public:
+  /**
+   * \brief Constructor
+   * \param qd the FqCoDel queue disc
+   * \param slot the flow slot
+   */
+  FlowSlotOps (FqCoDelQueueDisc *qd, FlowSlot &slot)
+    : m_qd (qd),
+      m_slot (slot)
+  {
+  }
+  /**
+   * \brief Remove the packet at the head of the flow
+   * \return the removed packet, or 0 if the flow is empty
+   */
+  Ptr<QueueDiscItem> Pop (void)
+  {
+    return m_qd->FlowTablePop (m_slot);
+  }
+  /**
+   * \return the number of bytes of the flow
+   */
+  uint32_t GetNBytes (void)
+  {
+    return m_slot.bytes;
+  }
+  /**
+   * \brief Drop a packet whose sojourn time exceeded the target
+   * \param item the packet
+   */
+  void Drop (Ptr<QueueDiscItem> item)
+  {
+    NS_LOG_LOGIC ("Sojourn time is above target; dropping " << item);
+    m_qd->DropAfterDequeue (item, TARGET_EXCEEDED_DROP);
+  }
+
+private:
+  FqCoDelQueueDisc *m_qd;  //!< the FqCoDel queue disc
+  FlowSlot &m_slot;        //!< the flow slot
+};
+
 NS_OBJECT_ENSURE_REGISTERED (FqCoDelFlow);
 
 TypeId FqCoDelFlow::GetTypeId (void)
@@ -123,12 +174,19 @@ TypeId FqCoDelQueueDisc::GetTypeId (void)
                    UintegerValue (64),
                    MakeUintegerAccessor (&FqCoDelQueueDisc::m_dropBatchSize),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("UseFlowTable",
+                   "True to store the flows in a flat table rather than in classes "
+                   "having a CoDel child queue disc",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FqCoDelQueueDisc::m_useFlowTable),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 FqCoDelQueueDisc::FqCoDelQueueDisc ()
-  : m_quantum (0)
+  : m_quantum (0),
+    m_freeEntry (-1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -167,6 +225,18 @@ FqCoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
 
   uint32_t h = ret % m_flows;
 
+  if (m_useFlowTable)
+    {
+      FlowTableEnqueue (item, h);
+
+      if (GetNPackets () > m_limit)
+        {
+          FlowTableDrop ();
+        }
+
+      return true;
+    }
+
   Ptr<FqCoDelFlow> flow;
   if (m_flowsIndices.find (h) == m_flowsIndices.end ())
     {
@@ -208,6 +278,11 @@ FqCoDelQueueDisc::DoDequeue (void)
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_useFlowTable)
+    {
+      return FlowTableDequeue ();
+    }
+
   Ptr<FqCoDelFlow> flow;
   Ptr<QueueDiscItem> item;
 
@@ -289,6 +364,11 @@ FqCoDelQueueDisc::DoPeek (void) const
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_useFlowTable)
+    {
+      return FlowTablePeek ();
+    }
+
   Ptr<FqCoDelFlow> flow;
 
   if (!m_newFlows.empty ())
@@ -357,6 +437,35 @@ FqCoDelQueueDisc::InitializeParams (void)
   m_queueDiscFactory.Set ("MaxPackets", UintegerValue (m_limit + 1));
   m_queueDiscFactory.Set ("Interval", StringValue (m_interval));
   m_queueDiscFactory.Set ("Target", StringValue (m_target));
+
+  if (m_useFlowTable)
+    {
+      FlowSlot empty;
+      empty.head = -1;
+      empty.tail = -1;
+      empty.next = -1;
+      empty.packets = 0;
+      empty.bytes = 0;
+      empty.deficit = 0;
+      empty.status = FqCoDelFlow::INACTIVE;
+      m_flowSlots.assign (m_flows, empty);
+
+      m_entries.clear ();
+      m_entries.reserve (std::min<uint32_t> (m_limit + 1, 4096));
+      m_freeEntry = -1;
+      m_newFlowSlots.head = m_newFlowSlots.tail = -1;
+      m_oldFlowSlots.head = m_oldFlowSlots.tail = -1;
+
+      m_codelParams.target = CoDelTime (Time (m_target));
+      m_codelParams.interval = CoDelTime (Time (m_interval));
+
+      // use the same minbytes value as the CoDel queue discs used as flow queues
+      struct TypeId::AttributeInformation info;
+      bool found = CoDelQueueDisc::GetTypeId ().LookupAttributeByName ("MinBytes", &info);
+      NS_ASSERT (found);
+      NS_UNUSED (found);
+      m_codelParams.minBytes = DynamicCast<const UintegerValue> (info.initialValue)->Get ();
+    }
 }
 
 uint32_t
@@ -394,4 +503,238 @@ FqCoDelQueueDisc::FqCoDelDrop (void)
   return index;
 }
 
+void
+FqCoDelQueueDisc::FlowListPushBack (FlowList &list, int32_t index)
+{
+  m_flowSlots[index].next = -1;
+  if (list.tail == -1)
+    {
+      list.head = index;
+    }
+  else
+    {
+      m_flowSlots[list.tail].next = index;
+    }
+  list.tail = index;
+}
+
+void
+FqCoDelQueueDisc::FlowListPopFront (FlowList &list)
+{
+  NS_ASSERT (list.head != -1);
+  int32_t index = list.head;
+  list.head = m_flowSlots[index].next;
+  if (list.head == -1)
+    {
+      list.tail = -1;
+    }
+  m_flowSlots[index].next = -1;
+}
+
+void
+FqCoDelQueueDisc::FlowTableEnqueue (Ptr<QueueDiscItem> item, uint32_t h)
+{
+  NS_LOG_FUNCTION (this << item << h);
+
+  int32_t entry;
+  if (m_freeEntry != -1)
+    {
+      entry = m_freeEntry;
+      m_freeEntry = m_entries[entry].next;
+    }
+  else
+    {
+      entry = m_entries.size ();
+      m_entries.push_back (FlowTableEntry ());
+    }
+  m_entries[entry].item = item;
+  m_entries[entry].next = -1;
+
+  FlowSlot &slot = m_flowSlots[h];
+  if (slot.tail == -1)
+    {
+      slot.head = entry;
+    }
+  else
+    {
+      m_entries[slot.tail].next = entry;
+    }
+  slot.tail = entry;
+  slot.packets++;
+  slot.bytes += item->GetSize ();
+
+  // the CoDel queue disc used as flow queue sets the timestamp upon enqueue
+  item->SetTimeStamp (Simulator::Now ());
+  PacketEnqueued (item);
+
+  if (slot.status == FqCoDelFlow::INACTIVE)
+    {
+      slot.status = FqCoDelFlow::NEW_FLOW;
+      slot.deficit = m_quantum;
+      FlowListPushBack (m_newFlowSlots, h);
+    }
+
+  NS_LOG_DEBUG ("Packet enqueued into flow " << h);
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::FlowTablePop (FlowSlot &slot)
+{
+  if (slot.head == -1)
+    {
+      return 0;
+    }
+
+  int32_t entry = slot.head;
+  Ptr<QueueDiscItem> item = m_entries[entry].item;
+  slot.head = m_entries[entry].next;
+  if (slot.head == -1)
+    {
+      slot.tail = -1;
+    }
+  slot.packets--;
+  slot.bytes -= item->GetSize ();
+
+  m_entries[entry].item = 0;
+  m_entries[entry].next = m_freeEntry;
+  m_freeEntry = entry;
+
+  PacketDequeued (item);
+  return item;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::FlowTableDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  int32_t index;
+  Ptr<QueueDiscItem> item;
+
+  do
+    {
+      bool found = false;
+
+      while (!found && m_newFlowSlots.head != -1)
+        {
+          index = m_newFlowSlots.head;
+          FlowSlot &slot = m_flowSlots[index];
+
+          if (slot.deficit <= 0)
+            {
+              slot.deficit += m_quantum;
+              slot.status = FqCoDelFlow::OLD_FLOW;
+              FlowListPopFront (m_newFlowSlots);
+              FlowListPushBack (m_oldFlowSlots, index);
+            }
+          else
+            {
+              NS_LOG_DEBUG ("Found a new flow with positive deficit");
+              found = true;
+            }
+        }
+
+      while (!found && m_oldFlowSlots.head != -1)
+        {
+          index = m_oldFlowSlots.head;
+          FlowSlot &slot = m_flowSlots[index];
+
+          if (slot.deficit <= 0)
+            {
+              slot.deficit += m_quantum;
+              FlowListPopFront (m_oldFlowSlots);
+              FlowListPushBack (m_oldFlowSlots, index);
+            }
+          else
+            {
+              NS_LOG_DEBUG ("Found an old flow with positive deficit");
+              found = true;
+            }
+        }
+
+      if (!found)
+        {
+          NS_LOG_DEBUG ("No flow found to dequeue a packet");
+          return 0;
+        }
+
+      FlowSlot &slot = m_flowSlots[index];
+      FlowSlotOps queue (this, slot);
+      item = CoDelDequeue (slot.codel, m_codelParams, queue);
+
+      if (!item)
+        {
+          NS_LOG_DEBUG ("Could not get a packet from the selected flow queue");
+          if (m_newFlowSlots.head != -1)
+            {
+              slot.status = FqCoDelFlow::OLD_FLOW;
+              FlowListPopFront (m_newFlowSlots);
+              FlowListPushBack (m_oldFlowSlots, index);
+            }
+          else
+            {
+              slot.status = FqCoDelFlow::INACTIVE;
+              FlowListPopFront (m_oldFlowSlots);
+            }
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Dequeued packet " << item->GetPacket ());
+        }
+    } while (item == 0);
+
+  m_flowSlots[index].deficit -= item->GetSize ();
+
+  return item;
+}
+
+Ptr<const QueueDiscItem>
+FqCoDelQueueDisc::FlowTablePeek (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  int32_t index = m_newFlowSlots.head;
+  if (index == -1)
+    {
+      index = m_oldFlowSlots.head;
+    }
+  if (index == -1 || m_flowSlots[index].head == -1)
+    {
+      return 0;
+    }
+  return m_entries[m_flowSlots[index].head].item;
+}
+
+uint32_t
+FqCoDelQueueDisc::FlowTableDrop (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t maxBacklog = 0, index = 0;
+
+  /* Queue is full! Find the fat flow and drop packet(s) from it */
+  for (uint32_t i = 0; i < m_flowSlots.size (); i++)
+    {
+      if (m_flowSlots[i].bytes > maxBacklog)
+        {
+          maxBacklog = m_flowSlots[i].bytes;
+          index = i;
+        }
+    }
+
+  /* Our goal is to drop half of this fat flow backlog */
+  uint32_t len = 0, count = 0, threshold = maxBacklog >> 1;
+  FlowSlot &slot = m_flowSlots[index];
+  Ptr<QueueDiscItem> item;
+
+  do
+    {
+      item = FlowTablePop (slot);
+      DropAfterDequeue (item, OVERLIMIT_DROP);
+      len += item->GetSize ();
+    } while (++count < m_dropBatchSize && len < threshold);
+
+  return index;
+}
+
 } // namespace ns3
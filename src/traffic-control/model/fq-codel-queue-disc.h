@@ -24,8 +24,10 @@
 
 #include "ns3/queue-disc.h"
 #include "ns3/object-factory.h"
+#include "codel-algorithm.h"
 #include <list>
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -96,6 +98,18 @@ private:
  * \ingroup traffic-control
  *
  * \brief A FqCoDel packet queue disc
+ *
+ * By default, every flow queue is a FqCoDelFlow class having a CoDelQueueDisc
+ * as child queue disc, which are created when the first packet of the flow is
+ * received. If the UseFlowTable attribute is set to true, flows are instead
+ * stored in a flat table, allocated at initialization time, of Flows slots.
+ * Each slot stores the packets of a flow (in a packet pool shared by all the
+ * flows), the scheduling state and the CoDel state of the flow, and the links
+ * of the (intrusive) lists of new and old flows. The flow table allows to
+ * handle a large number of flows without allocating objects for each flow,
+ * and provides the same behavior, except that no class is created (hence
+ * flows cannot be inspected through the classes of the queue disc) and
+ * packets dropped by CoDel are accounted with the TARGET_EXCEEDED_DROP reason.
  */
 
 class FqCoDelQueueDisc : public QueueDisc {
@@ -129,6 +143,7 @@ public:
   // Reasons for dropping packets
   static constexpr const char* UNCLASSIFIED_DROP = "Unclassified drop";  //!< No packet filter able to classify packet
   static constexpr const char* OVERLIMIT_DROP = "Overlimit drop";        //!< Overlimit dropped packets
+  static constexpr const char* TARGET_EXCEEDED_DROP = "Target exceeded drop";  //!< Sojourn time above target (flow table only)
 
 private:
   virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
@@ -143,12 +158,87 @@ private:
    */
   uint32_t FqCoDelDrop (void);
 
+  /**
+   * \brief A packet stored in the flow table
+   */
+  struct FlowTableEntry
+  {
+    Ptr<QueueDiscItem> item;  //!< the packet
+    int32_t next;             //!< index of the next entry of the flow (or of the free list)
+  };
+
+  /**
+   * \brief A slot of the flow table, storing a flow queue and its CoDel state
+   */
+  struct FlowSlot
+  {
+    int32_t head;                    //!< index of the first packet of the flow (-1 if none)
+    int32_t tail;                    //!< index of the last packet of the flow (-1 if none)
+    int32_t next;                    //!< index of the next slot in the list of new or old flows
+    uint32_t packets;                //!< number of packets of the flow
+    uint32_t bytes;                  //!< number of bytes of the flow
+    int32_t deficit;                 //!< the deficit of the flow
+    FqCoDelFlow::FlowStatus status;  //!< the status of the flow
+    CoDelState codel;                //!< the CoDel state of the flow
+  };
+
+  /**
+   * \brief An intrusive list of flow slots
+   */
+  struct FlowList
+  {
+    int32_t head;  //!< index of the first slot (-1 if the list is empty)
+    int32_t tail;  //!< index of the last slot (-1 if the list is empty)
+  };
+
+  /**
+   * \brief Enqueue a packet in the flow table
+   * \param item the packet
+   * \param h the index of the flow slot
+   */
+  void FlowTableEnqueue (Ptr<QueueDiscItem> item, uint32_t h);
+  /**
+   * \brief Dequeue a packet from the flow table
+   * \return the dequeued packet, or 0 if no packet is available
+   */
+  Ptr<QueueDiscItem> FlowTableDequeue (void);
+  /**
+   * \brief Peek the next packet to dequeue from the flow table
+   * \return the next packet, or 0 if no packet is available
+   */
+  Ptr<const QueueDiscItem> FlowTablePeek (void) const;
+  /**
+   * \brief Drop packets from the head of the fat flow of the flow table
+   * \return the index of the slot of the fat flow
+   */
+  uint32_t FlowTableDrop (void);
+  /**
+   * \brief Remove the packet at the head of the given flow slot
+   * \param slot the flow slot
+   * \return the removed packet, or 0 if the flow is empty
+   */
+  Ptr<QueueDiscItem> FlowTablePop (FlowSlot &slot);
+  /**
+   * \brief Append a slot to a list of flows
+   * \param list the list
+   * \param index the index of the slot
+   */
+  void FlowListPushBack (FlowList &list, int32_t index);
+  /**
+   * \brief Remove the first slot of a list of flows
+   * \param list the list
+   */
+  void FlowListPopFront (FlowList &list);
+
+  class FlowSlotOps;  //!< A flow slot, as seen by CoDelDequeue
+
   std::string m_interval;    //!< CoDel interval attribute
   std::string m_target;      //!< CoDel target attribute
   uint32_t m_limit;          //!< Maximum number of packets in the queue disc
   uint32_t m_quantum;        //!< Deficit assigned to flows at each round
   uint32_t m_flows;          //!< Number of flow queues
   uint32_t m_dropBatchSize;  //!< Max number of packets dropped from the fat flow
+  bool m_useFlowTable;       //!< True to store flows in the flow table
 
   std::list<Ptr<FqCoDelFlow> > m_newFlows;    //!< The list of new flows
   std::list<Ptr<FqCoDelFlow> > m_oldFlows;    //!< The list of old flows
@@ -157,6 +247,13 @@ private:
 
   ObjectFactory m_flowFactory;         //!< Factory to create a new flow
   ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
+
+  std::vector<FlowSlot> m_flowSlots;        //!< The flow table
+  std::vector<FlowTableEntry> m_entries;    //!< The pool of packets stored in the flow table
+  int32_t m_freeEntry;                      //!< Index of the first free entry of the pool (-1 if none)
+  FlowList m_newFlowSlots;                  //!< The list of new flows of the flow table
+  FlowList m_oldFlowSlots;                  //!< The list of old flows of the flow table
+  CoDelParameters m_codelParams;            //!< CoDel parameters of the flows of the flow table
 };
 
 } // namespace ns3
@@ -29,6 +29,8 @@
 #include "queue-disc.h"
 #include <ns3/drop-tail-queue.h>
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/queue-limits.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -273,6 +275,12 @@ TypeId QueueDisc::GetTypeId (void)
                    MakeUintegerAccessor (&QueueDisc::SetQuota,
                                          &QueueDisc::GetQuota),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MaxBulkBytes",
+                   "The maximum number of bytes dequeued in bulk and passed to the device "
+                   "in a single batch (0 disables bulk dequeue)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&QueueDisc::m_maxBulkBytes),
+                   MakeUintegerChecker<uint32_t> ())
     .AddAttribute ("InternalQueueList", "The list of internal queues.",
                    ObjectVectorValue (),
                    MakeObjectVectorAccessor (&QueueDisc::m_queues),
@@ -376,7 +384,8 @@ QueueDisc::DoDispose (void)
   m_classes.clear ();
   m_device = 0;
   m_devQueueIface = 0;
-  m_requeued = 0;
+  m_requeued.clear ();
+  m_bulk.clear ();
   Object::DoDispose ();
 }
 
@@ -418,9 +427,14 @@ QueueDisc::GetStats (void)
   // the total number of sent packets is only updated here to avoid to increase it
   // after a dequeue and then having to decrease it if the packet is dropped after
   // dequeue or requeued
-  m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - (m_requeued ? 1 : 0)
+  uint64_t requeuedBytes = 0;
+  for (auto& item : m_requeued)
+    {
+      requeuedBytes += item->GetSize ();
+    }
+  m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - m_requeued.size ()
                               - m_stats.nTotalDroppedPacketsAfterDequeue;
-  m_stats.nTotalSentBytes = m_stats.nTotalDequeuedBytes - (m_requeued ? m_requeued->GetSize () : 0)
+  m_stats.nTotalSentBytes = m_stats.nTotalDequeuedBytes - requeuedBytes
                             - m_stats.nTotalDroppedBytesAfterDequeue;
 
   return m_stats;
@@ -789,14 +803,15 @@ QueueDisc::Run (void)
   if (RunBegin ())
     {
       uint32_t quota = m_quota;
-      while (Restart ())
+      uint32_t packets = 0;
+      while (Restart (packets))
         {
-          quota -= 1;
-          if (quota <= 0)
+          if (packets >= quota)
             {
               /// \todo netif_schedule (q);
               break;
             }
+          quota -= packets;
         }
       RunEnd ();
     }
@@ -823,7 +838,7 @@ QueueDisc::RunEnd (void)
 }
 
 bool
-QueueDisc::Restart (void)
+QueueDisc::Restart (uint32_t &packets)
 {
   NS_LOG_FUNCTION (this);
   Ptr<QueueDiscItem> item = DequeuePacket();
@@ -833,6 +848,13 @@ QueueDisc::Restart (void)
       return false;
     }
 
+  if (!m_bulk.empty ())
+    {
+      packets = m_bulk.size ();
+      return TransmitBulk ();
+    }
+
+  packets = 1;
   return Transmit (item);
 }
 
@@ -844,15 +866,15 @@ QueueDisc::DequeuePacket ()
   Ptr<QueueDiscItem> item;
 
   // First check if there is a requeued packet
-  if (m_requeued != 0)
+  if (!m_requeued.empty ())
     {
         // If the queue where the requeued packet is destined to is not stopped, return
         // the requeued packet; otherwise, return an empty packet.
         // If the device does not support flow control, the device queue is never stopped
-        if (!m_devQueueIface->GetTxQueue (m_requeued->GetTxQueueIndex ())->IsStopped ())
+        if (!m_devQueueIface->GetTxQueue (m_requeued.front ()->GetTxQueueIndex ())->IsStopped ())
           {
-            item = m_requeued;
-            m_requeued = 0;
+            item = m_requeued.front ();
+            m_requeued.pop_front ();
           }
     }
   else
@@ -869,18 +891,62 @@ QueueDisc::DequeuePacket ()
           if (item != 0)
             {
               item->AddHeader ();
+
+              // Bulk dequeue is only performed on single-queue devices, so that
+              // all the packets in the batch are destined to the same device queue
+              if (m_maxBulkBytes > 0 && m_devQueueIface->GetNTxQueues () == 1)
+                {
+                  BulkDequeue (item);
+                }
             }
-          // Here, Linux tries bulk dequeues
         }
     }
   return item;
 }
 
+void
+QueueDisc::BulkDequeue (Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+  NS_ASSERT (m_bulk.empty ());
+
+  // The byte limit is given by the MaxBulkBytes attribute and, if queue limits
+  // are installed on the device queue, by the number of bytes they allow to queue
+  int64_t limit = m_maxBulkBytes;
+  Ptr<QueueLimits> ql = m_devQueueIface->GetTxQueue (0)->GetQueueLimits ();
+  if (ql)
+    {
+      limit = std::min<int64_t> (limit, ql->Available ());
+    }
+  limit -= item->GetSize ();
+
+  while (limit > 0)
+    {
+      Ptr<QueueDiscItem> next = Dequeue ();
+      if (next == 0)
+        {
+          break;
+        }
+      next->AddHeader ();
+      if (m_bulk.empty ())
+        {
+          m_bulk.push_back (item);
+        }
+      m_bulk.push_back (next);
+      limit -= next->GetSize ();
+    }
+
+  if (!m_bulk.empty ())
+    {
+      NS_LOG_LOGIC ("Dequeued " << m_bulk.size () << " packets in bulk");
+    }
+}
+
 void
 QueueDisc::Requeue (Ptr<QueueDiscItem> item)
 {
   NS_LOG_FUNCTION (this << item);
-  m_requeued = item;
+  m_requeued.push_back (item);
   /// \todo netif_schedule (q);
 
   m_stats.nTotalRequeuedPackets++;
@@ -937,4 +1003,42 @@ QueueDisc::Transmit (Ptr<QueueDiscItem> item)
   return true;
 }
 
+bool
+QueueDisc::TransmitBulk (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_devQueueIface && m_devQueueIface->GetNTxQueues () == 1);
+
+  // packets are only dequeued in bulk if the (unique) device queue is not
+  // stopped, and the device queue cannot be stopped while dequeuing
+  NS_ASSERT (!m_devQueueIface->GetTxQueue (0)->IsStopped ());
+
+  // a single queue device makes no use of the priority tag
+  SocketPriorityTag priorityTag;
+  for (auto& item : m_bulk)
+    {
+      item->GetPacket ()->RemovePacketTag (priorityTag);
+    }
+
+  uint32_t sent = m_device->SendBatch (m_bulk);
+  NS_ASSERT (sent <= m_bulk.size ());
+
+  // Differently from Transmit, which never requeues a packet passed to the
+  // device, the packets of the batch that the device did not accept because
+  // its transmission queue was stopped are requeued (in order)
+  bool allSent = (sent == m_bulk.size ());
+  for (uint32_t i = sent; i < m_bulk.size (); i++)
+    {
+      Requeue (m_bulk[i]);
+    }
+  m_bulk.clear ();
+
+  if (!allSent || GetNPackets () == 0 || m_devQueueIface->GetTxQueue (0)->IsStopped ())
+    {
+      return false;
+    }
+
+  return true;
+}
+
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/net-device.h"
 #include "ns3/queue-item.h"
 #include <vector>
+#include <list>
 #include <map>
 #include <functional>
 #include <string>
@@ -119,6 +120,15 @@ private:
  * is room for another packet in its transmission queue, but the transmission queue
  * is stopped. Waking a queue disc is equivalent to make it run.
  *
+ * If the MaxBulkBytes attribute is set to a non-zero value and the netdevice has
+ * a single transmission queue, every time a packet is dequeued the queue disc
+ * tries to dequeue further packets (bulk dequeue), until the number of dequeued
+ * bytes exceeds the value of the MaxBulkBytes attribute or, if queue limits (e.g.,
+ * DynamicQueueLimits) are installed on the transmission queue, the number of bytes
+ * the transmission queue is allowed to accept. The packets so dequeued are passed
+ * to the netdevice in a single call to NetDevice::SendBatch. Packets not accepted
+ * by the netdevice (because its transmission queue got stopped) are requeued.
+ *
  * Every queue disc collects statistics about the total number of packets/bytes
  * received from the upper layers (in case of root queue disc) or from the parent
  * queue disc (in case of child queue disc), enqueued, dequeued, requeued, dropped,
@@ -130,7 +140,7 @@ private:
  * - dropped = dropped before enqueue + dropped after dequeue
  * - received = dropped before enqueue + enqueued
  * - queued = enqueued - dequeued
- * - sent = dequeued - dropped after dequeue (- 1 if there is a requeued packet)
+ * - sent = dequeued - dropped after dequeue (- requeued packets, if any)
  *
  * Separate counters are also kept for each possible reason to drop a packet.
  * When a packet is dropped by an internal queue, e.g., because the queue is full,
@@ -250,7 +260,7 @@ public:
    * \brief Get the number of packets stored by the queue disc
    * \return the number of packets stored by the queue disc.
    *
-   * The requeued packet, if any, is counted.
+   * The requeued packets, if any, are counted.
    */
   uint32_t GetNPackets (void) const;
 
@@ -258,7 +268,7 @@ public:
    * \brief Get the amount of bytes stored by the queue disc
    * \return the amount of bytes stored by the queue disc.
    *
-   * The requeued packet, if any, is counted.
+   * The requeued packets, if any, are counted.
    */
   uint32_t GetNBytes (void) const;
 
@@ -437,6 +447,29 @@ protected:
    */
   void DoInitialize (void);
 
+  /**
+   *  \brief Perform the actions required when the queue disc is notified of
+   *         a packet enqueue
+   *  \param item item that was enqueued
+   *
+   *  This method is automatically called when a packet is enqueued in an
+   *  internal queue or in a child queue disc. Subclasses storing packets by
+   *  other means must call it to record that a packet was enqueued.
+   */
+  void PacketEnqueued (Ptr<const QueueDiscItem> item);
+
+  /**
+   *  \brief Perform the actions required when the queue disc is notified of
+   *         a packet dequeue
+   *  \param item item that was dequeued
+   *
+   *  This method is automatically called when a packet is dequeued from an
+   *  internal queue or from a child queue disc. Subclasses storing packets by
+   *  other means must call it to record that a packet was dequeued (even if
+   *  the packet is then dropped).
+   */
+  void PacketDequeued (Ptr<const QueueDiscItem> item);
+
   /**
    *  \brief Perform the actions required when the queue disc is notified of
    *         a packet dropped before enqueue
@@ -530,17 +563,30 @@ private:
 
   /**
    * Modelled after the Linux function qdisc_restart (net/sched/sch_generic.c)
-   * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling Transmit).
-   * \return true if a packet is successfully sent to the device.
+   * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling
+   * Transmit), or send the batch of packets dequeued in bulk (by calling TransmitBulk).
+   * \param packets set to the number of packets dequeued
+   * \return true if the packets are successfully sent to the device.
    */
-  bool Restart (void);
+  bool Restart (uint32_t &packets);
 
   /**
    * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
+   * If bulk dequeue is enabled, the packets dequeued along with the returned
+   * one are stored in m_bulk.
    * \return the requeued packet, if any, or the packet dequeued by the queue disc, otherwise.
    */
   Ptr<QueueDiscItem> DequeuePacket (void);
 
+  /**
+   * Modelled after the Linux function try_bulk_dequeue_skb (net/sched/sch_generic.c)
+   * Dequeue further packets, until the bulk byte limit is exceeded, and store
+   * them in m_bulk, after the given packet. Nothing is stored in m_bulk if no
+   * other packet can be dequeued.
+   * \param item the packet just dequeued
+   */
+  void BulkDequeue (Ptr<QueueDiscItem> item);
+
   /**
    * Modelled after the Linux function dev_requeue_skb (net/sched/sch_generic.c)
    * Requeues a packet whose transmission failed.
@@ -558,18 +604,12 @@ private:
   bool Transmit (Ptr<QueueDiscItem> item);
 
   /**
-   *  \brief Perform the actions required when the queue disc is notified of
-   *         a packet enqueue
-   *  \param item item that was enqueued
+   * Send the packets stored in m_bulk to the device through a single call to
+   * NetDevice::SendBatch, and requeue the packets the device did not accept.
+   * \return true if all the packets have been accepted, the device queue is not
+   *         stopped and the queue disc is not empty
    */
-  void PacketEnqueued (Ptr<const QueueDiscItem> item);
-
-  /**
-   *  \brief Perform the actions required when the queue disc is notified of
-   *         a packet dequeue
-   *  \param item item that was dequeued
-   */
-  void PacketDequeued (Ptr<const QueueDiscItem> item);
+  bool TransmitBulk (void);
 
   static const uint32_t DEFAULT_QUOTA = 64; //!< Default quota (as in /proc/sys/net/core/dev_weight)
 
@@ -583,10 +623,12 @@ private:
 
   Stats m_stats;                    //!< The collected statistics
   uint32_t m_quota;                 //!< Maximum number of packets dequeued in a qdisc run
+  uint32_t m_maxBulkBytes;          //!< Maximum number of bytes dequeued in bulk (0 disables bulk dequeue)
   Ptr<NetDevice> m_device;          //!< The NetDevice on which this queue discipline is installed
   Ptr<NetDeviceQueueInterface> m_devQueueIface;   //!< NetDevice queue interface
   bool m_running;                   //!< The queue disc is performing multiple dequeue operations
-  Ptr<QueueDiscItem> m_requeued;    //!< The last packet that failed to be transmitted
+  std::list<Ptr<QueueDiscItem> > m_requeued;    //!< The packets that failed to be transmitted
+  std::vector<Ptr<QueueDiscItem> > m_bulk;       //!< The packets dequeued in bulk
   std::string m_childQueueDiscDropMsg;  //!< Reason why a packet was dropped by a child queue disc
 
   /// Traced callback: fired when a packet is enqueued
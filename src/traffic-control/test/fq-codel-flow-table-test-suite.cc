@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief FqCoDel Flow Table Test Item, storing the flow it belongs to
+ */
+class FqCoDelFlowTableTestItem : public QueueDiscItem {
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet stored in this item
+   * \param flow the flow the packet belongs to
+   * \param id the packet identifier
+   */
+  FqCoDelFlowTableTestItem (Ptr<Packet> p, uint32_t flow, uint32_t id);
+  virtual ~FqCoDelFlowTableTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+  /**
+   * \return the flow the packet belongs to
+   */
+  uint32_t GetFlow (void) const;
+  /**
+   * \return the packet identifier
+   */
+  uint32_t GetId (void) const;
+
+private:
+  FqCoDelFlowTableTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  FqCoDelFlowTableTestItem (const FqCoDelFlowTableTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  FqCoDelFlowTableTestItem &operator = (const FqCoDelFlowTableTestItem &);
+  uint32_t m_flow;  //!< the flow the packet belongs to
+  uint32_t m_id;    //!< the packet identifier
+};
+
+FqCoDelFlowTableTestItem::FqCoDelFlowTableTestItem (Ptr<Packet> p, uint32_t flow, uint32_t id)
+  : QueueDiscItem (p, Address (), 0),
+    m_flow (flow),
+    m_id (id)
+{
+}
+
+FqCoDelFlowTableTestItem::~FqCoDelFlowTableTestItem ()
+{
+}
+
+void
+FqCoDelFlowTableTestItem::AddHeader (void)
+{
+}
+
+bool
+FqCoDelFlowTableTestItem::Mark (void)
+{
+  return false;
+}
+
+uint32_t
+FqCoDelFlowTableTestItem::GetFlow (void) const
+{
+  return m_flow;
+}
+
+uint32_t
+FqCoDelFlowTableTestItem::GetId (void) const
+{
+  return m_id;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Packet filter classifying FqCoDelFlowTableTestItem objects by flow
+ */
+class FqCoDelFlowTableTestFilter : public PacketFilter {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+private:
+  virtual bool CheckProtocol (Ptr<QueueDiscItem> item) const;
+  virtual int32_t DoClassify (Ptr<QueueDiscItem> item) const;
+};
+
+TypeId
+FqCoDelFlowTableTestFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FqCoDelFlowTableTestFilter")
+    .SetParent<PacketFilter> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<FqCoDelFlowTableTestFilter> ()
+  ;
+  return tid;
+}
+
+bool
+FqCoDelFlowTableTestFilter::CheckProtocol (Ptr<QueueDiscItem> item) const
+{
+  return true;
+}
+
+int32_t
+FqCoDelFlowTableTestFilter::DoClassify (Ptr<QueueDiscItem> item) const
+{
+  return StaticCast<FqCoDelFlowTableTestItem> (item)->GetFlow ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Check that the flow table behaves as the class-based implementation
+ *
+ * The same sequence of enqueue and dequeue operations is performed on two
+ * FqCoDel queue discs, one using classes and one using the flow table. Packets
+ * arrive faster than they are dequeued, so that both the CoDel algorithm and
+ * the packet limit cause drops. The two queue discs must dequeue the same
+ * packets in the same order.
+ */
+class FqCoDelFlowTableEquivalenceTestCase : public TestCase
+{
+public:
+  FqCoDelFlowTableEquivalenceTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a FqCoDel queue disc
+   * \param useFlowTable whether the flow table has to be used
+   * \return the queue disc
+   */
+  Ptr<FqCoDelQueueDisc> CreateQueueDisc (bool useFlowTable);
+  /**
+   * Enqueue packets in both the queue discs and dequeue packets from both
+   * \param step the step number
+   */
+  void Step (uint32_t step);
+
+  Ptr<FqCoDelQueueDisc> m_classes;     //!< the queue disc using classes
+  Ptr<FqCoDelQueueDisc> m_flowTable;   //!< the queue disc using the flow table
+  uint32_t m_nextId;                   //!< identifier of the next packet
+  uint32_t m_random;                   //!< state of the pseudo-random generator
+  std::vector<uint32_t> m_classesIds;  //!< ids of the packets dequeued by m_classes
+  std::vector<uint32_t> m_tableIds;    //!< ids of the packets dequeued by m_flowTable
+};
+
+FqCoDelFlowTableEquivalenceTestCase::FqCoDelFlowTableEquivalenceTestCase ()
+  : TestCase ("Check that the flow table behaves as the class-based implementation"),
+    m_nextId (0),
+    m_random (12345)
+{
+}
+
+Ptr<FqCoDelQueueDisc>
+FqCoDelFlowTableEquivalenceTestCase::CreateQueueDisc (bool useFlowTable)
+{
+  Ptr<FqCoDelQueueDisc> queueDisc = CreateObjectWithAttributes<FqCoDelQueueDisc> ("PacketLimit", UintegerValue (200),
+                                                                                    "Flows", UintegerValue (64),
+                                                                                    "DropBatchSize", UintegerValue (8),
+                                                                                    "UseFlowTable", BooleanValue (useFlowTable));
+  queueDisc->AddPacketFilter (CreateObject<FqCoDelFlowTableTestFilter> ());
+  queueDisc->SetQuantum (1500);
+  queueDisc->Initialize ();
+  return queueDisc;
+}
+
+void
+FqCoDelFlowTableEquivalenceTestCase::Step (uint32_t step)
+{
+  // 3 packets of random flows and sizes are enqueued and 2 packets are dequeued
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      m_random = m_random * 1103515245 + 12345;
+      // the first packets create the flows in order, so that flows have the
+      // same index in both the queue discs
+      uint32_t flow = (m_nextId < 32 ? m_nextId : (m_random >> 16) % 32);
+      uint32_t size = 100 + (m_random >> 8) % 1400;
+      Ptr<Packet> p = Create<Packet> (size);
+      m_classes->Enqueue (Create<FqCoDelFlowTableTestItem> (p, flow, m_nextId));
+      m_flowTable->Enqueue (Create<FqCoDelFlowTableTestItem> (p->Copy (), flow, m_nextId));
+      m_nextId++;
+    }
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<QueueDiscItem> item = m_classes->Dequeue ();
+      if (item)
+        {
+          m_classesIds.push_back (StaticCast<FqCoDelFlowTableTestItem> (item)->GetId ());
+        }
+      item = m_flowTable->Dequeue ();
+      if (item)
+        {
+          m_tableIds.push_back (StaticCast<FqCoDelFlowTableTestItem> (item)->GetId ());
+        }
+    }
+}
+
+void
+FqCoDelFlowTableEquivalenceTestCase::DoRun (void)
+{
+  m_classes = CreateQueueDisc (false);
+  m_flowTable = CreateQueueDisc (true);
+
+  for (uint32_t step = 0; step < 1000; step++)
+    {
+      Simulator::Schedule (MilliSeconds (step), &FqCoDelFlowTableEquivalenceTestCase::Step, this, step);
+    }
+  Simulator::Run ();
+
+  // drain both queue discs
+  while (Ptr<QueueDiscItem> item = m_classes->Dequeue ())
+    {
+      m_classesIds.push_back (StaticCast<FqCoDelFlowTableTestItem> (item)->GetId ());
+    }
+  while (Ptr<QueueDiscItem> item = m_flowTable->Dequeue ())
+    {
+      m_tableIds.push_back (StaticCast<FqCoDelFlowTableTestItem> (item)->GetId ());
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_flowTable->GetNQueueDiscClasses (), 0, "No class must be created with the flow table");
+  NS_TEST_EXPECT_MSG_EQ (m_classes->GetNQueueDiscClasses (), 32, "A class must be created for each flow");
+
+  QueueDisc::Stats classesStats = m_classes->GetStats ();
+  QueueDisc::Stats tableStats = m_flowTable->GetStats ();
+  NS_TEST_EXPECT_MSG_GT (tableStats.GetNDroppedPackets (FqCoDelQueueDisc::TARGET_EXCEEDED_DROP), 0,
+                         "CoDel should have dropped packets");
+  NS_TEST_EXPECT_MSG_GT (tableStats.GetNDroppedPackets (FqCoDelQueueDisc::OVERLIMIT_DROP), 0,
+                         "Packets should have been dropped because of the packet limit");
+  NS_TEST_EXPECT_MSG_EQ (tableStats.nTotalDroppedPackets, classesStats.nTotalDroppedPackets,
+                         "Different number of dropped packets");
+  NS_TEST_EXPECT_MSG_EQ (tableStats.nTotalSentPackets, classesStats.nTotalSentPackets,
+                         "Different number of sent packets");
+  NS_TEST_EXPECT_MSG_EQ (tableStats.nTotalSentBytes, classesStats.nTotalSentBytes,
+                         "Different number of sent bytes");
+  NS_TEST_EXPECT_MSG_EQ (m_flowTable->GetNPackets (), 0, "The queue disc must be empty");
+
+  NS_TEST_ASSERT_MSG_EQ (m_tableIds.size (), m_classesIds.size (), "Different number of dequeued packets");
+  for (uint32_t i = 0; i < m_tableIds.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_tableIds[i], m_classesIds[i], "Different packet dequeued at position " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Check that the flow table handles a large number of flows
+ */
+class FqCoDelFlowTableManyFlowsTestCase : public TestCase
+{
+public:
+  FqCoDelFlowTableManyFlowsTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+FqCoDelFlowTableManyFlowsTestCase::FqCoDelFlowTableManyFlowsTestCase ()
+  : TestCase ("Check that the flow table handles a large number of flows")
+{
+}
+
+void
+FqCoDelFlowTableManyFlowsTestCase::DoRun (void)
+{
+  uint32_t nFlows = 4096;
+  Ptr<FqCoDelQueueDisc> queueDisc = CreateObjectWithAttributes<FqCoDelQueueDisc> ("Flows", UintegerValue (nFlows),
+                                                                                    "UseFlowTable", BooleanValue (true));
+  queueDisc->AddPacketFilter (CreateObject<FqCoDelFlowTableTestFilter> ());
+  queueDisc->SetQuantum (1500);
+  queueDisc->Initialize ();
+
+  // two packets per flow
+  for (uint32_t i = 0; i < 2 * nFlows; i++)
+    {
+      queueDisc->Enqueue (Create<FqCoDelFlowTableTestItem> (Create<Packet> (1000), i % nFlows, i));
+    }
+  NS_TEST_EXPECT_MSG_EQ (queueDisc->GetNPackets (), 2 * nFlows, "Unexpected number of packets in the queue disc");
+
+  // With a quantum of 1500 bytes, every new flow can send two packets before
+  // becoming an old flow, hence flows are served in order of arrival
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      Ptr<FqCoDelFlowTableTestItem> item = StaticCast<FqCoDelFlowTableTestItem> (queueDisc->Dequeue ());
+      NS_TEST_ASSERT_MSG_NE (item, 0, "A packet must be dequeued");
+      NS_TEST_EXPECT_MSG_EQ (item->GetFlow (), i, "Unexpected flow served");
+      item = StaticCast<FqCoDelFlowTableTestItem> (queueDisc->Dequeue ());
+      NS_TEST_ASSERT_MSG_NE (item, 0, "A packet must be dequeued");
+      NS_TEST_EXPECT_MSG_EQ (item->GetFlow (), i, "Unexpected flow served");
+    }
+  NS_TEST_EXPECT_MSG_EQ (queueDisc->Dequeue (), 0, "The queue disc must be empty");
+  NS_TEST_EXPECT_MSG_EQ (queueDisc->GetNQueueDiscClasses (), 0, "No class must be created with the flow table");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief FqCoDel Flow Table Test Suite
+ */
+static class FqCoDelFlowTableTestSuite : public TestSuite
+{
+public:
+  FqCoDelFlowTableTestSuite ()
+    : TestSuite ("fq-codel-flow-table", UNIT)
+  {
+    AddTestCase (new FqCoDelFlowTableEquivalenceTestCase (), TestCase::QUICK);
+    AddTestCase (new FqCoDelFlowTableManyFlowsTestCase (), TestCase::QUICK);
+  }
+} g_fqCoDelFlowTableTestSuite; ///< the test suite
@@ -383,6 +383,146 @@ TcFlowControlTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Traffic Control Bulk Dequeue Test Case
+ */
+class TcBulkDequeueTestCase : public TestCase
+{
+public:
+  TcBulkDequeueTestCase ();
+  virtual ~TcBulkDequeueTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Instruct a node to send a specified number of packets
+   * \param n the node
+   * \param nPackets the number of packets to send
+   */
+  void SendPackets (Ptr<Node> n, uint16_t nPackets);
+  /**
+   * Check the number of packets stored in the device queue and the number of
+   * packets requeued by the queue disc
+   * \param dev the device
+   * \param nPackets the expected number of packets stored in the device queue
+   * \param nRequeued the expected number of packets requeued by the queue disc
+   * \param msg the message to print if the numbers are different
+   */
+  void CheckPackets (Ptr<NetDevice> dev, uint16_t nPackets, uint32_t nRequeued, const char* msg);
+  /**
+   * Count the packets dequeued from the device queue
+   * \param p the packet
+   */
+  void DeviceDequeue (Ptr<const Packet> p);
+  uint32_t m_txPackets; //!< number of packets dequeued from the device queue
+};
+
+TcBulkDequeueTestCase::TcBulkDequeueTestCase ()
+  : TestCase ("Test the operation of the bulk dequeue mechanism"),
+    m_txPackets (0)
+{
+}
+
+TcBulkDequeueTestCase::~TcBulkDequeueTestCase ()
+{
+}
+
+void
+TcBulkDequeueTestCase::SendPackets (Ptr<Node> n, uint16_t nPackets)
+{
+  Ptr<TrafficControlLayer> tc = n->GetObject<TrafficControlLayer> ();
+  for (uint16_t i = 0; i < nPackets; i++)
+    {
+      tc->Send (n->GetDevice (0), Create<QueueDiscTestItem> (Create<Packet> (1000)));
+    }
+}
+
+void
+TcBulkDequeueTestCase::CheckPackets (Ptr<NetDevice> dev, uint16_t nPackets, uint32_t nRequeued, const char* msg)
+{
+  PointerValue ptr;
+  dev->GetAttributeFailSafe ("TxQueue", ptr);
+  Ptr<Queue<Packet> > queue = ptr.Get<Queue<Packet> > ();
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), nPackets, msg);
+
+  Ptr<TrafficControlLayer> tc = dev->GetNode ()->GetObject<TrafficControlLayer> ();
+  Ptr<QueueDisc> qdisc = tc->GetRootQueueDiscOnDevice (dev);
+  NS_TEST_EXPECT_MSG_EQ (qdisc->GetStats ().nTotalRequeuedPackets, nRequeued, msg);
+}
+
+void
+TcBulkDequeueTestCase::DeviceDequeue (Ptr<const Packet> p)
+{
+  m_txPackets++;
+}
+
+void
+TcBulkDequeueTestCase::DoRun (void)
+{
+  NodeContainer n;
+  n.Create (2);
+
+  n.Get (0)->AggregateObject (CreateObject<TrafficControlLayer> ());
+  n.Get (1)->AggregateObject (CreateObject<TrafficControlLayer> ());
+
+  Ptr<Queue<Packet> > queue;
+  queue = CreateObjectWithAttributes<DropTailQueue<Packet> > ("Mode", EnumValue (QueueBase::QUEUE_MODE_PACKETS),
+                                                              "MaxPackets", UintegerValue (5));
+
+  // link the two nodes
+  Ptr<SimpleNetDevice> txDev, rxDev;
+  txDev = CreateObjectWithAttributes<SimpleNetDevice> ("TxQueue", PointerValue (queue),
+                                                       "DataRate", DataRateValue (DataRate ("1Mb/s")));
+  rxDev = CreateObject<SimpleNetDevice> ();
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel> ();
+  txDev->SetChannel (channel1);
+  rxDev->SetChannel (channel1);
+  queue->TraceConnectWithoutContext ("Dequeue", MakeCallback (&TcBulkDequeueTestCase::DeviceDequeue, this));
+
+  txDev->SetMtu (2500);
+
+  TrafficControlHelper tch = TrafficControlHelper::Default ();
+  QueueDiscContainer qdiscs = tch.Install (txDev);
+  qdiscs.Get (0)->SetAttribute ("MaxBulkBytes", UintegerValue (10000));
+
+  // transmit 10 packets at time 0
+  Simulator::Schedule (Time (Seconds (0)), &TcBulkDequeueTestCase::SendPackets,
+                      this, n.Get (0), 10);
+
+  /*
+   * Packets are sent to the queue disc one at a time, hence no bulk dequeue
+   * occurs until the device wakes the queue disc, which then stores 4 packets.
+   * These are all dequeued in bulk, but the device only accepts one of them,
+   * and the other 3 packets are requeued. Requeued packets are then transmitted
+   * one at a time as the device wakes the queue disc.
+   */
+
+  // The transmission of each packet takes 1000B/1Mbps = 8ms
+  // After 1ms, we have 5 packets in the device queue and no requeued packet
+  Simulator::Schedule (Time (MilliSeconds (1)), &TcBulkDequeueTestCase::CheckPackets,
+                      this, txDev, 5, 0, "There must be 5 packets in the device queue and none requeued after 1ms");
+
+  // After 9ms, we have 5 packets in the device queue and 3 requeued packets
+  Simulator::Schedule (Time (MilliSeconds (9)), &TcBulkDequeueTestCase::CheckPackets,
+                      this, txDev, 5, 3, "There must be 5 packets in the device queue and 3 requeued after 9ms");
+
+  // After 81ms, all packets must have been transmitted
+  Simulator::Schedule (Time (MilliSeconds (81)), &TcBulkDequeueTestCase::CheckPackets,
+                      this, txDev, 0, 3, "The device queue must be empty after 81ms");
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_txPackets, 10, "All the packets must have been transmitted");
+  NS_TEST_EXPECT_MSG_EQ (qdiscs.Get (0)->GetStats ().nTotalSentPackets, 10, "All the packets must have been sent");
+  NS_TEST_EXPECT_MSG_EQ (qdiscs.Get (0)->GetStats ().nTotalDroppedPackets, 0, "No packet must have been dropped");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup traffic-control-test
  * \ingroup tests
@@ -397,5 +537,6 @@ public:
   {
     AddTestCase (new TcFlowControlTestCase (TcFlowControlTestCase::PACKET_MODE), TestCase::QUICK);
     AddTestCase (new TcFlowControlTestCase (TcFlowControlTestCase::BYTE_MODE), TestCase::QUICK);
+    AddTestCase (new TcBulkDequeueTestCase (), TestCase::QUICK);
   }
 } g_tcFlowControlTestSuite; ///< the test suite
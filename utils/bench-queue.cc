@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the storage of the items of a
+// DropTailQueue in a RingBuffer (the default) against the storage in a
+// std::list. Each iteration enqueues a burst of 'burst' packets and then
+// dequeues all of them, for 'n' iterations.
+// Sample usage:  ./waf --run 'bench-queue --n=100000 --burst=64'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/uinteger.h"
+#include <iostream>
+#include <list>
+
+using namespace ns3;
+
+/// Item stored in a queue using the default storage (RingBuffer)
+class RingItem : public SimpleRefCount<RingItem>
+{
+public:
+  /**
+   * Constructor
+   * \param p the packet
+   */
+  RingItem (Ptr<Packet> p) : m_packet (p) {}
+  /**
+   * \return the size of the packet
+   */
+  uint32_t GetSize (void) const { return m_packet->GetSize (); }
+private:
+  Ptr<Packet> m_packet; //!< the packet
+};
+
+/// Item stored in a queue using a std::list
+class ListItem : public SimpleRefCount<ListItem>
+{
+public:
+  /**
+   * Constructor
+   * \param p the packet
+   */
+  ListItem (Ptr<Packet> p) : m_packet (p) {}
+  /**
+   * \return the size of the packet
+   */
+  uint32_t GetSize (void) const { return m_packet->GetSize (); }
+private:
+  Ptr<Packet> m_packet; //!< the packet
+};
+
+namespace ns3 {
+
+/// Store the ListItems in a std::list
+template <>
+struct QueueStorage<ListItem>
+{
+  /// Container storing the items
+  typedef std::list<Ptr<ListItem> > Container;
+};
+
+NS_OBJECT_TEMPLATE_CLASS_DEFINE (Queue,RingItem);
+NS_OBJECT_TEMPLATE_CLASS_DEFINE (DropTailQueue,RingItem);
+NS_OBJECT_TEMPLATE_CLASS_DEFINE (Queue,ListItem);
+NS_OBJECT_TEMPLATE_CLASS_DEFINE (DropTailQueue,ListItem);
+
+} // namespace ns3
+
+/**
+ * Enqueue and dequeue bursts of packets
+ * \param n the number of bursts
+ * \param burst the number of packets per burst
+ * \return the elapsed time in milliseconds
+ */
+template <typename Item>
+static int64_t
+RunBench (uint32_t n, uint32_t burst)
+{
+  Ptr<DropTailQueue<Item> > queue = CreateObject<DropTailQueue<Item> > ();
+  queue->SetAttribute ("MaxPackets", UintegerValue (burst));
+  Ptr<Packet> p = Create<Packet> (1000);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < burst; j++)
+        {
+          queue->Enqueue (Create<Item> (p));
+        }
+      while (queue->Dequeue ())
+        {
+        }
+    }
+  return clock.End ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t burst = 64;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "number of bursts", n);
+  cmd.AddValue ("burst", "number of packets per burst", burst);
+  cmd.Parse (argc, argv);
+
+  std::cout << "list:        " << RunBench<ListItem> (n, burst) << " ms" << std::endl;
+  std::cout << "ring buffer: " << RunBench<RingItem> (n, burst) << " ms" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program prints the log messages recorded in a binary log (see
+// LogBinaryEnable) as the text logging would print them.
+// Sample usage:
+//   NS_LOG="UdpEchoClientApplication=level_all" NS_LOG_BINARY=echo.blog ./waf --run first
+//   ./waf --run 'print-binary-log --file=echo.blog'
+
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string file;
+
+  CommandLine cmd;
+  cmd.AddValue ("file", "the binary log to print", file);
+  cmd.Parse (argc, argv);
+
+  std::ifstream is (file.c_str (), std::ios::binary);
+  if (!is)
+    {
+      std::cerr << "Can not open " << file << std::endl;
+      return 1;
+    }
+  if (!LogBinaryPrint (is, std::cout))
+    {
+      std::cerr << file << " is not a valid binary log" << std::endl;
+      return 1;
+    }
+  return 0;
+}